@@ -9,5 +9,16 @@ layout(set = 2, binding = 0) uniform sampler2D texSampler;
 
 void main()
 {
-	outColor = vec4(fragColor * texture(texSampler, fragTextCoord).rgb, 1.0);
+	vec4 textureColor = texture(texSampler, fragTextCoord);
+
+#ifdef ALPHA_TEST
+	if (textureColor.a < 0.5)
+		discard;
+#endif
+
+#ifdef UNLIT
+	outColor = vec4(textureColor.rgb, 1.0);
+#else
+	outColor = vec4(fragColor * textureColor.rgb, 1.0);
+#endif
 }
\ No newline at end of file
@@ -3,6 +3,11 @@
 layout(binding = 0) uniform UniformModelData
 {	
 	mat4 model;
+	// Reads the quantized vertex formats back, identity for the float one
+	vec4 positionScale;
+	vec4 positionOffset;
+	// xy scale, zw offset
+	vec4 textCoordScaleOffset;
 } ModelData;
 
 layout(set = 1, binding = 0) uniform UniformCameraData
@@ -12,15 +17,48 @@ layout(set = 1, binding = 0) uniform UniformCameraData
 } CameraData;
 
 layout(location = 0) in vec3 inPosition;
+#ifndef VERTEX_NO_COLOR
 layout(location = 1) in vec3 inColor;
+#endif
 layout(location = 2) in vec2 inTextCoord;
+#ifdef VERTEX_NORMAL
+// Octahedral encoding
+layout(location = 3) in vec2 inNormal;
+#endif
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTextCoord;
+#ifdef VERTEX_NORMAL
+layout(location = 2) out vec3 fragNormal;
+
+vec3 DecodeOctahedral(vec2 _Encoded)
+{
+	vec3 normal = vec3(_Encoded, 1.0 - abs(_Encoded.x) - abs(_Encoded.y));
+
+	// Unfolds the corners of the square back on the lower half of the octahedron
+	float fold = max(-normal.z, 0.0);
+	normal.x += normal.x >= 0.0 ? -fold : fold;
+	normal.y += normal.y >= 0.0 ? -fold : fold;
+
+	return normalize(normal);
+}
+#endif
 
 void main()
 {
-	gl_Position =  CameraData.projection * CameraData.view * ModelData.model * vec4(inPosition, 1.0);
-    fragColor = inColor;
-	fragTextCoord = inTextCoord;
+	vec3 position = inPosition * ModelData.positionScale.xyz + ModelData.positionOffset.xyz;
+
+	gl_Position =  CameraData.projection * CameraData.view * ModelData.model * vec4(position, 1.0);
+
+#ifdef VERTEX_NO_COLOR
+	fragColor = vec3(1.0);
+#else
+	fragColor = inColor;
+#endif
+
+	fragTextCoord = inTextCoord * ModelData.textCoordScaleOffset.xy + ModelData.textCoordScaleOffset.zw;
+
+#ifdef VERTEX_NORMAL
+	fragNormal = mat3(ModelData.model) * DecodeOctahedral(inNormal);
+#endif
 }
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include "Window.h"
 
 #include "Renderer.h"
+#include "RendererBenchmarks.h"
 
 #include "Camera.h"
 
+#include "RHI/RenderGraph.h"
+
 namespace Core
 {
 	class Application
@@ -13,6 +16,24 @@ namespace Core
 	private:
 		Window m_Window;
 		Renderer m_Renderer;
+		// Selected on the command line, none by default
+		RendererBenchmarks m_Benchmarks;
+
+		RenderGraph m_FrameGraph;
+
+		// Size of the framebuffer the frame graph was built for
+		int m_FrameGraphWidth = 0;
+		int m_FrameGraphHeight = 0;
+
+		/// <summary>
+		/// Declares the passes of a frame and compiles the graph
+		/// </summary>
+		void BuildFrameGraph();
+
+		/// <summary>
+		/// Rebuilds the frame graph when the framebuffer size changed, the descriptions of its textures follow the swap chain
+		/// </summary>
+		void UpdateFrameGraphSize();
 
 	public:
 		static inline LowRenderer::Camera appCamera;
@@ -54,8 +75,10 @@ namespace Core
 		/// <summary>
 		/// Initialize the application
 		/// </summary>
+		/// <param name="_Argc">: Argument count of main </param>
+		/// <param name="_Argv">: Arguments of main, names of the renderer benchmarks to run </param>
 		/// <returns></returns>
-		const bool Initialize();
+		const bool Initialize(int _Argc, char** _Argv);
 
 		/// <summary>
 		/// Terminate the application
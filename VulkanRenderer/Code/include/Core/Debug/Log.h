@@ -4,6 +4,7 @@
 #include <fstream>
 #include <iostream>
 #include <chrono>
+#include <mutex>
 #include <Windows.h>
 
 #define LOG_FOLDER_PATH "Logs/"
@@ -61,6 +62,9 @@ namespace Core
 		private:
 			static inline std::ofstream m_LogFile;
 
+			// Messages can come from the worker threads
+			static inline std::mutex m_OutputMutex;
+
 			// TODO: REFACTOR AND ENCAPSULATE THIS SHIT MEN
 			static int LogPrint(const LogType _Type, const char* _Format, va_list _Args);
 
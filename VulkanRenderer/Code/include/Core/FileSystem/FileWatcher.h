@@ -0,0 +1,100 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace Core
+{
+	/// <summary>
+	/// Watches the files of a directory and its sub directories with the events of the OS
+	/// ReadDirectoryChangesW on Windows, inotify on Linux with one watch per directory, the sub directories created later included
+	/// Events are collected on a background thread and read by the main thread with PollChanges
+	/// </summary>
+	class FileWatcher
+	{
+	private:
+		std::filesystem::path m_Directory;
+
+		std::thread m_WatchThread;
+		std::atomic<bool> m_IsRunning = false;
+
+		// Files changed since the last poll, without duplicates
+		std::mutex m_ChangesMutex;
+		std::vector<std::filesystem::path> m_ChangedFiles;
+		std::chrono::steady_clock::time_point m_FirstChangeTime;
+		std::chrono::steady_clock::time_point m_LastChangeTime;
+
+#ifdef _WIN32
+		HANDLE m_DirectoryHandle = INVALID_HANDLE_VALUE;
+#elif defined(__linux__)
+		int m_InotifyDescriptor = -1;
+
+		// Directory of each inotify watch, written by the main thread and by the watch thread for the new sub directories
+		std::mutex m_WatchesMutex;
+		std::unordered_map<int, std::filesystem::path> m_WatchedDirectories;
+
+		/// <summary>
+		/// Adds an inotify watch on a directory and on all its sub directories
+		/// </summary>
+		/// <param name="_Directory">: Directory to watch </param>
+		/// <returns>false if the directory itself cannot be watched</returns>
+		const bool AddWatchRecursive(const std::filesystem::path& _Directory);
+#endif
+
+		/// <summary>
+		/// Loop of the background thread, waits for the events until Stop is called
+		/// </summary>
+		void WatchLoop();
+
+		void AddChange(const std::filesystem::path& _File);
+
+	public:
+		FileWatcher() = default;
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		/// <summary>
+		/// Starts watching a directory
+		/// </summary>
+		/// <param name="_Directory">: Directory to watch </param>
+		/// <returns></returns>
+		const bool Start(const std::filesystem::path& _Directory);
+
+		/// <summary>
+		/// Watches another directory with the same watcher, for files used from outside the started directory (includes...)
+		/// Does nothing for a directory already watched, outside of the started directory it is only supported on Linux
+		/// </summary>
+		/// <param name="_Directory">: Directory to watch </param>
+		/// <returns></returns>
+		const bool WatchDirectory(const std::filesystem::path& _Directory);
+
+		/// <summary>
+		/// Stops the background thread and releases the OS handles
+		/// </summary>
+		void Stop();
+
+		/// <summary>
+		/// Gives the files changed once no event has been received for a while,
+		/// editors often write a file in several steps and it should only be read once complete
+		/// </summary>
+		/// <param name="_ChangedFiles">: Receives the changed files </param>
+		/// <param name="_FirstChangeTime">: Receives the time of the first event of the changes </param>
+		/// <param name="_QuietTime">: Time without event required before giving the changes </param>
+		/// <returns>true if there are changes</returns>
+		const bool PollChanges(std::vector<std::filesystem::path>& _ChangedFiles, std::chrono::steady_clock::time_point& _FirstChangeTime,
+			std::chrono::milliseconds _QuietTime = std::chrono::milliseconds(50));
+
+		inline bool IsRunning() const { return m_IsRunning; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	enum JsonType
+	{
+		JSON_NULL,
+		JSON_BOOL,
+		JSON_NUMBER,
+		JSON_STRING,
+		JSON_ARRAY,
+		JSON_OBJECT
+	};
+
+	/// <summary>
+	/// Value of a parsed JSON document, arrays and objects own their children
+	/// Missing members and out of range elements read as null, so lookups can be chained without checks
+	/// </summary>
+	class JsonValue
+	{
+	private:
+		JsonType m_Type = JSON_NULL;
+		bool m_Bool = false;
+		double m_Number = 0.0;
+		std::string m_String;
+
+		// Elements of an array or values of an object
+		std::vector<JsonValue> m_Elements;
+		// Keys of an object, in the order of the values
+		std::vector<std::string> m_Keys;
+
+		friend class JsonDocument;
+
+	public:
+
+		/// <summary>
+		/// Member of an object
+		/// </summary>
+		/// <param name="_Key">: Name of the member </param>
+		/// <returns>nullptr if the value is not an object or has no such member</returns>
+		const JsonValue* Find(const char* _Key) const;
+
+		const JsonValue& operator[](const char* _Key) const;
+		const JsonValue& operator[](size_t _Index) const;
+
+		inline JsonType GetType() const { return m_Type; }
+		inline bool IsNull() const { return m_Type == JSON_NULL; }
+		inline bool IsNumber() const { return m_Type == JSON_NUMBER; }
+		inline bool IsString() const { return m_Type == JSON_STRING; }
+		inline bool IsArray() const { return m_Type == JSON_ARRAY; }
+		inline bool IsObject() const { return m_Type == JSON_OBJECT; }
+
+		inline bool GetBool(bool _Default = false) const { return m_Type == JSON_BOOL ? m_Bool : _Default; }
+		inline double GetNumber(double _Default = 0.0) const { return m_Type == JSON_NUMBER ? m_Number : _Default; }
+		inline int GetInt(int _Default = 0) const { return m_Type == JSON_NUMBER ? static_cast<int>(m_Number) : _Default; }
+		inline const std::string& GetString() const { return m_String; }
+
+		// Elements of an array or members of an object
+		inline size_t GetSize() const { return m_Elements.size(); }
+		inline const std::string& GetKey(size_t _Index) const { return m_Keys[_Index]; }
+	};
+
+	/// <summary>
+	/// Recursive descent parser of RFC 8259 JSON, the whole document is read into a tree of values
+	/// </summary>
+	class JsonDocument
+	{
+	private:
+		// Deeper documents are rejected instead of overflowing the stack
+		static inline const unsigned int MAX_DEPTH = 128;
+
+		JsonValue m_Root;
+
+		const char* m_Cursor = nullptr;
+		const char* m_End = nullptr;
+
+		void SkipWhitespaces();
+		const bool ParseValue(JsonValue& _Value, unsigned int _Depth);
+		const bool ParseString(std::string& _String);
+		const bool ParseNumber(double& _Number);
+		const bool ParseLiteral(const char* _Literal);
+
+	public:
+
+		/// <summary>
+		/// Parses a document
+		/// </summary>
+		/// <param name="_Data">: UTF-8 text, it does not need to end with a null character </param>
+		/// <param name="_Size">: Size of the text in bytes </param>
+		/// <returns>false if the text is not valid JSON</returns>
+		const bool Parse(const char* _Data, size_t _Size);
+
+		inline const JsonValue& GetRoot() const { return m_Root; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace Core
+{
+	/// <summary>
+	/// Read only view of a whole file mapped in memory, pages are loaded by the OS when they are first read
+	/// </summary>
+	class MappedFile
+	{
+	private:
+		const unsigned char* m_Data = nullptr;
+		size_t m_Size = 0;
+
+#ifdef _WIN32
+		HANDLE m_FileHandle = INVALID_HANDLE_VALUE;
+		HANDLE m_MappingHandle = nullptr;
+#else
+		int m_FileDescriptor = -1;
+#endif
+
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/// <summary>
+		/// Maps a file, the file mapped before is closed
+		/// </summary>
+		/// <param name="_Path">: Path of the file </param>
+		/// <returns>false if the file cannot be opened or is empty</returns>
+		const bool Open(const std::filesystem::path& _Path);
+
+		/// <summary>
+		/// Unmaps the file, the pointers given by GetData are not valid anymore
+		/// </summary>
+		void Close();
+
+		inline const unsigned char* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+		inline bool IsOpen() const { return m_Data != nullptr; }
+	};
+}
\ No newline at end of file
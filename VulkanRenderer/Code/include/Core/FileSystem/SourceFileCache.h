@@ -0,0 +1,82 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Core
+{
+	struct SourceFile
+	{
+		std::string content;
+		// FNV-1a of the content
+		unsigned long long hash = 0;
+		std::filesystem::file_time_type writeTime;
+	};
+
+	/// <summary>
+	/// File a compiled result depends on, with the hash of the content it was built from
+	/// </summary>
+	struct SourceDependency
+	{
+		std::filesystem::path path;
+		unsigned long long hash = 0;
+	};
+
+	/// <summary>
+	/// Contents of the text files read by the shader compilations, a file included by several shaders is read once
+	/// An entry is read again when the write time of its file changes
+	/// </summary>
+	class SourceFileCache
+	{
+	private:
+		static inline std::unordered_map<std::string, std::shared_ptr<const SourceFile>> m_Files;
+
+		// Shaders are compiled by several threads at once
+		static inline std::mutex m_FilesMutex;
+
+		static std::string GetEntryName(const std::filesystem::path& _Path);
+
+	public:
+
+		/// <summary>
+		/// Reads a whole file in one call
+		/// </summary>
+		/// <param name="_Path">: Path of the file </param>
+		/// <param name="_Content">: Receives the content </param>
+		/// <returns></returns>
+		static const bool ReadFile(const std::filesystem::path& _Path, std::string& _Content);
+
+		/// <summary>
+		/// Gives the content of a file, read from the disk only if it is not cached or changed since
+		/// </summary>
+		/// <param name="_Path">: Path of the file </param>
+		/// <returns>nullptr if the file cannot be read, the content stays valid while the pointer is kept</returns>
+		static std::shared_ptr<const SourceFile> Read(const std::filesystem::path& _Path);
+
+		/// <summary>
+		/// Forgets a file, the next read goes to the disk
+		/// </summary>
+		/// <param name="_Path">: Path of the file </param>
+		static void Invalidate(const std::filesystem::path& _Path);
+
+		/// <summary>
+		/// Tells if all the files still have the content they had when the dependencies were recorded
+		/// </summary>
+		/// <param name="_Dependencies">: Files and hashes recorded </param>
+		/// <returns></returns>
+		static const bool IsUpToDate(const std::vector<SourceDependency>& _Dependencies);
+
+		/// <summary>
+		/// Hashes a content like the cached files
+		/// </summary>
+		/// <param name="_Content">: Text hashed </param>
+		/// <returns></returns>
+		static unsigned long long ComputeHash(const std::string& _Content);
+
+		static void Clear();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+
+namespace Core
+{
+	/// <summary>
+	/// Destruction waiting for the frames that may still use the resource
+	/// </summary>
+	struct PendingDeletion
+	{
+		// Last frame allowed to use the resource
+		unsigned long long frame = 0;
+
+		std::function<void()> destroy;
+	};
+
+	/// <summary>
+	/// Delays the destruction of GPU resources until the frames that could use them are finished
+	/// so they can be released at runtime without waiting for the device to be idle
+	/// </summary>
+	class DeletionQueue
+	{
+	private:
+		// Sorted by frame because frames only increase
+		std::deque<PendingDeletion> m_PendingDeletions;
+
+	public:
+
+		/// <summary>
+		/// Registers a destruction
+		/// </summary>
+		/// <param name="_Frame">: Last frame allowed to use the resource, usually the frame being recorded </param>
+		/// <param name="_Destroy">: Destroys the resource </param>
+		void Push(unsigned long long _Frame, const std::function<void()>& _Destroy);
+
+		/// <summary>
+		/// Executes the destructions of the resources only used by completed frames
+		/// </summary>
+		/// <param name="_CompletedFrame">: Most recent frame whose fence has been signaled </param>
+		void Flush(unsigned long long _CompletedFrame);
+
+		/// <summary>
+		/// Executes all the destructions, the device has to be idle
+		/// </summary>
+		void FlushAll();
+
+		inline size_t GetPendingCount() const { return m_PendingDeletions.size(); }
+	};
+}
\ No newline at end of file
@@ -100,13 +100,13 @@ namespace Core
 		///////////////////////////////////////////////////////////////////////
 
 		/// <summary>
-		/// 
+		/// Creates a graphics pipeline, can be called from a worker thread
 		/// </summary>
-		/// <param name="_Device"></param>
-		/// <param name="_Swapchain"></param>
-		/// <param name="_ShadersInfos"></param>
-		/// <returns></returns>
-		virtual IPipeline* InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos) = 0;
+		/// <param name="_Device">: Device creating the pipeline </param>
+		/// <param name="_Swapchain">: Swap chain giving the default formats of the render targets </param>
+		/// <param name="_Description">: Shaders and states of the pipeline </param>
+		/// <returns>nullptr if the creation failed</returns>
+		virtual IPipeline* InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description) = 0;
 
 		/// <summary>
 		/// 
@@ -267,5 +267,48 @@ namespace Core
 
 		virtual IBuffer* CreateBuffer(IDevice* _Device, BufferType _BufferType, size_t _BufferSize) = 0;
 		virtual void DestroyBuffer(IBuffer* _Buffer, IDevice* _Device);
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Upload manager related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Creates the upload manager used to batch the transfers of meshes and textures
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_StagingSize">: Size in bytes of the staging ring buffer </param>
+		/// <returns></returns>
+		virtual IUploadManager* InstantiateUploadManager(IDevice* _Device, size_t _StagingSize) = 0;
+
+		/// <summary>
+		/// Waits for the pending uploads and destroys the upload manager
+		/// </summary>
+		/// <param name="_UploadManager">: Upload manager to destroy </param>
+		/// <param name="_Device">: Device </param>
+		virtual void DestroyUploadManager(IUploadManager* _UploadManager, IDevice* _Device);
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Render graph related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Creates the textures of a compiled render graph in its aliased memory blocks
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_SwapChain">: Swap chain whose images are the imported textures </param>
+		/// <param name="_Graph">: Compiled render graph </param>
+		/// <returns></returns>
+		virtual IRenderGraphResources* InstantiateRenderGraphResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph) = 0;
+
+		/// <summary>
+		/// Destroys the textures of a render graph, the GPU must not use them anymore
+		/// </summary>
+		/// <param name="_Resources">: Render graph resources to destroy </param>
+		/// <param name="_Device">: Device </param>
+		virtual void DestroyRenderGraphResources(IRenderGraphResources* _Resources, IDevice* _Device);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "RHI/RHITypes.h"
+
+#include <vector>
+
+namespace Core
+{
+	class IShader;
+
+	struct PipelineShaderInfos
+	{
+		IShader* shader;
+		ShaderType shaderType;
+		const char* functionEntry;
+	};
+
+	// Presets of the vertex layouts, see VertexLayout::Get
+	enum VertexFormat
+	{
+		// 32 bytes, float position, color and texture coordinate
+		RHI_VERTEX_FORMAT_DEFAULT,
+		// 16 bytes, 16 bits normalized position, octahedral normal and 16 bits normalized texture coordinate
+		RHI_VERTEX_FORMAT_COMPACT,
+		// 16 bytes, same as the compact format with a half float position
+		RHI_VERTEX_FORMAT_COMPACT_HALF,
+		// 16 + 4 bytes, the compact format with a color stream
+		RHI_VERTEX_FORMAT_COMPACT_COLOR
+	};
+
+	enum CullMode
+	{
+		RHI_CULL_NONE,
+		RHI_CULL_BACK,
+		RHI_CULL_FRONT
+	};
+
+	enum CompareOperation
+	{
+		RHI_COMPARE_NEVER,
+		RHI_COMPARE_LESS,
+		RHI_COMPARE_EQUAL,
+		RHI_COMPARE_LESS_OR_EQUAL,
+		RHI_COMPARE_GREATER,
+		RHI_COMPARE_GREATER_OR_EQUAL,
+		RHI_COMPARE_ALWAYS
+	};
+
+	enum BlendMode
+	{
+		RHI_BLEND_OPAQUE,
+		// Source color weighted by its alpha
+		RHI_BLEND_ALPHA,
+		RHI_BLEND_ADDITIVE
+	};
+
+	struct RasterState
+	{
+		CullMode cullMode = RHI_CULL_BACK;
+		bool isFrontFaceCounterClockwise = true;
+		bool isWireframe = false;
+		bool isDepthBiasEnabled = false;
+		float depthBiasConstantFactor = 0.f;
+		float depthBiasSlopeFactor = 0.f;
+	};
+
+	struct DepthState
+	{
+		bool isTestEnabled = true;
+		bool isWriteEnabled = true;
+		CompareOperation compareOperation = RHI_COMPARE_LESS;
+	};
+
+	struct BlendState
+	{
+		BlendMode mode = RHI_BLEND_OPAQUE;
+		// RGBA bits
+		unsigned int colorWriteMask = 0xF;
+	};
+
+	/// <summary>
+	/// Every state needed to build a graphics pipeline
+	/// </summary>
+	struct PipelineDescription
+	{
+		// The shaders have to stay alive while a pipeline is built from the description
+		std::vector<PipelineShaderInfos> shaders;
+
+		VertexFormat vertexFormat = RHI_VERTEX_FORMAT_DEFAULT;
+		RasterState raster;
+		DepthState depth;
+		BlendState blend;
+
+		// Native formats of the render targets, 0 uses the formats of the swap chain
+		unsigned int colorFormat = 0;
+		unsigned int depthFormat = 0;
+
+		/// <summary>
+		/// Hashes the states and the code of the shaders with FNV-1a, the same description gives the same hash on every run
+		/// </summary>
+		/// <returns></returns>
+		unsigned long long ComputeHash() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "RHI/PipelineDescription.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+	class IRendererHardware;
+	class IDevice;
+	class ISwapChain;
+	class IPipeline;
+	class ThreadPool;
+
+	/// <summary>
+	/// Pipelines indexed by the hash of their description
+	/// A missing pipeline is compiled on the thread pool, the fallback pipeline is given until it is ready so a new description never stalls a frame
+	/// </summary>
+	class PipelineStateCache
+	{
+	private:
+		struct CacheEntry
+		{
+			// Written once by the compilation job, an entry whose compilation failed is erased
+			std::atomic<IPipeline*> pipeline = nullptr;
+		};
+
+		IRendererHardware* m_RHI = nullptr;
+		IDevice* m_Device = nullptr;
+		ISwapChain* m_SwapChain = nullptr;
+		ThreadPool* m_ThreadPool = nullptr;
+
+		// Not owned, drawn with while the requested pipeline compiles
+		IPipeline* m_FallbackPipeline = nullptr;
+
+		// The jobs keep a pointer on their entry, only a failed job erases its own entry before Terminate
+		std::unordered_map<unsigned long long, std::unique_ptr<CacheEntry>> m_Entries;
+		std::mutex m_EntriesMutex;
+
+		std::vector<std::future<void>> m_PendingCompilations;
+
+		std::atomic<unsigned int> m_HitCount = 0;
+		std::atomic<unsigned int> m_MissCount = 0;
+
+		/// <summary>
+		/// Builds the pipeline of an entry, executed by a worker
+		/// </summary>
+		/// <param name="_Description">: Description of the pipeline </param>
+		/// <param name="_Hash">: Hash of the description, key of the entry </param>
+		/// <param name="_Entry">: Entry receiving the pipeline </param>
+		void CompilePipeline(const PipelineDescription& _Description, unsigned long long _Hash, CacheEntry* _Entry);
+
+	public:
+		PipelineStateCache() = default;
+
+		PipelineStateCache(const PipelineStateCache&) = delete;
+		PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+		/// <summary>
+		/// Prepares the cache, the fallback pipeline is found under its own description
+		/// </summary>
+		/// <param name="_RHI">: RHI creating the pipelines </param>
+		/// <param name="_Device">: Device creating the pipelines </param>
+		/// <param name="_SwapChain">: Swap chain giving the default formats of the render targets </param>
+		/// <param name="_ThreadPool">: Pool compiling the missing pipelines </param>
+		/// <param name="_FallbackPipeline">: Pipeline given while a compilation is pending, it stays owned by the caller </param>
+		void Initialize(IRendererHardware* _RHI, IDevice* _Device, ISwapChain* _SwapChain, ThreadPool* _ThreadPool, IPipeline* _FallbackPipeline);
+
+		/// <summary>
+		/// Waits for the pending compilations and destroys the pipelines of the cache, the GPU must not use them anymore
+		/// </summary>
+		void Terminate();
+
+		/// <summary>
+		/// Gives the pipeline of a description, never blocks
+		/// </summary>
+		/// <param name="_Description">: Description of the pipeline, its shaders have to stay alive until the pipeline is ready </param>
+		/// <param name="_Hash">: Hash given by ComputeHash of the description, computed once by the caller </param>
+		/// <returns>The fallback pipeline while the pipeline compiles, a failed compilation is started again by the next request</returns>
+		IPipeline* GetPipeline(const PipelineDescription& _Description, unsigned long long _Hash);
+
+		/// <summary>
+		/// Waits for all the pending compilations
+		/// </summary>
+		void WaitPendingCompilations();
+
+		/// <summary>
+		/// Finds the fallback pipeline under its current description, after a reload changed its shaders
+		/// </summary>
+		void RegisterFallbackPipeline();
+
+		inline IPipeline* GetFallbackPipeline() const { return m_FallbackPipeline; }
+
+		inline unsigned int GetHitCount() const { return m_HitCount; }
+		inline unsigned int GetMissCount() const { return m_MissCount; }
+	};
+}
\ No newline at end of file
@@ -23,9 +23,16 @@ namespace Core
 		RHI_UNIFORM_BUFFER
 	};
 
+	enum IndexType
+	{
+		RHI_INDEX_UINT16,
+		RHI_INDEX_UINT32
+	};
+
 	enum DescriptorType
 	{
 		RHI_DESCRIPTOR_UNIRFORM,
-		RHI_DESCRIPTOR_SAMPLER
+		RHI_DESCRIPTOR_SAMPLER,
+		RHI_DESCRIPTOR_STORAGE_BUFFER
 	};
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Vectors/Vector4.h"
 #include "Vectors/Vector2.h"
 
+#include <vector>
+
 namespace Core
 {
 	class IDevice;
@@ -13,6 +15,7 @@ namespace Core
 	class IPipeline;
 	class VulkanCommandBuffer;
 	class IDescriptor;
+	struct Submesh;
 
 	class ICommandBuffer
 	{
@@ -36,6 +39,8 @@ namespace Core
 		virtual void BindVertexBuffer(IMesh* _Mesh) const = 0;
 		virtual void BindIndexBuffer(IMesh* _Mesh) const = 0;
 		virtual void DrawIndexed(IMesh* _Mesh) const = 0;
+		// Draws ranges of the bound index buffer, each relative to its own first vertex
+		virtual void DrawIndexed(const std::vector<Submesh>& _Ranges) const = 0;
 		virtual void EndRenderPass() const = 0;
 	};
 }
\ No newline at end of file
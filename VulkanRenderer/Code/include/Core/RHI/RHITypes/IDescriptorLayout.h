@@ -11,6 +11,10 @@ namespace Core
 		unsigned int binding;
 		DescriptorType type;
 		ShaderType entryShader;
+		// Size of the array of descriptors
+		unsigned int count = 1;
+		// Stages using the binding (see GetShaderStageBit), entryShader is used when it is 0
+		unsigned int stages = 0;
 	};
 
 	class IDevice;
@@ -2,6 +2,8 @@
 
 #include "RHI/RHITypes/RHIResult.h"
 #include "RHI/RHITypes.h"
+#include "RHI/ShaderReflection.h"
+#include "RHI/PipelineDescription.h"
 
 #include <vector>
 
@@ -13,26 +15,57 @@ namespace Core
 	class VulkanPipeline;
 	class IDescriptorLayout;
 
-	struct PipelineShaderInfos
-	{
-		IShader* shader;
-		ShaderType shaderType;
-		const char* functionEntry;
-	};
-
 	class IPipeline
 	{
 	protected:
+		// Indexed by set, identical sets share the same layout
 		std::vector<IDescriptorLayout*> p_DescriptorSetLayouts{};
 
+		// Interface of the shaders the layouts are built from
+		PipelineReflection p_Reflection;
+
+		// States the pipeline was created with, its shaders are not kept alive
+		PipelineDescription p_Description;
+		unsigned long long p_DescriptionHash = 0;
+
 	public:
 		virtual ~IPipeline() = default;
 
-		virtual RHI_RESULT CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos) = 0;
+		virtual RHI_RESULT CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description) = 0;
 		virtual RHI_RESULT DestroyPipeline(IDevice* _Device) = 0;
 
+		/// <summary>
+		/// Builds the pipeline again with new shaders, the current one stays in use, can be called from a worker thread
+		/// Render pass and layouts are kept so the framebuffers and descriptor sets remain valid, it fails if the shaders need another layout
+		/// </summary>
+		/// <param name="_Device">: Device creating the pipeline </param>
+		/// <param name="_ShadersInfos">: New shader stages </param>
+		/// <returns></returns>
+		virtual RHI_RESULT CreateReloadedPipeline(IDevice* _Device, const std::vector<PipelineShaderInfos>& _ShadersInfos) = 0;
+
+		/// <summary>
+		/// Replaces the pipeline by the reloaded one, has to be called between two frames
+		/// The previous pipeline is destroyed once the frames in flight using it are finished
+		/// </summary>
+		virtual void SwapReloadedPipeline() = 0;
+
 		virtual VulkanPipeline* CastToVulkan() = 0;
 
 		virtual std::vector<IDescriptorLayout*> GetDescriptorLayouts() { return p_DescriptorSetLayouts; }
+
+		/// <summary>
+		/// Gives the layout of the set containing a resource of the shaders, found by its decorations so the SPIR-V can be stripped of its names
+		/// </summary>
+		/// <param name="_Set">: Set of the resource in the shaders </param>
+		/// <param name="_Binding">: Binding of the resource in its set </param>
+		/// <returns>nullptr if the shaders do not use the binding</returns>
+		inline IDescriptorLayout* GetDescriptorLayout(unsigned int _Set, unsigned int _Binding) const
+		{
+			return p_Reflection.FindBinding(_Set, _Binding) != nullptr && _Set < p_DescriptorSetLayouts.size() ? p_DescriptorSetLayouts[_Set] : nullptr;
+		}
+
+		inline const PipelineReflection& GetReflection() const { return p_Reflection; }
+		inline const PipelineDescription& GetDescription() const { return p_Description; }
+		inline unsigned long long GetDescriptionHash() const { return p_DescriptionHash; }
 	};
 }
\ No newline at end of file
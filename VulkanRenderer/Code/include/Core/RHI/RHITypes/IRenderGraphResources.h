@@ -0,0 +1,49 @@
+#pragma once
+
+#include "RHI/RHITypes/RHIResult.h"
+#include "RHI/RenderGraph.h"
+
+namespace Core
+{
+	class IDevice;
+	class ISwapChain;
+	class ICommandBuffer;
+	class VulkanRenderGraphResources;
+
+	/// <summary>
+	/// GPU side of a compiled render graph - creates its transient textures in the aliased memory blocks
+	/// and records its barriers, the imported textures are the images of the swap chain
+	/// </summary>
+	class IRenderGraphResources
+	{
+	public:
+		virtual ~IRenderGraphResources() = default;
+
+		/// <summary>
+		/// Creates the transient textures of the graph and binds the textures sharing a block to the same memory
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_SwapChain">: Swap chain whose images are the imported textures </param>
+		/// <param name="_Graph">: Compiled render graph </param>
+		/// <returns></returns>
+		virtual const RHI_RESULT CreateResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph) = 0;
+
+		/// <summary>
+		/// Destroys the transient textures and their memory, they must not be used by the GPU anymore
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <returns></returns>
+		virtual const RHI_RESULT DestroyResources(IDevice* _Device) = 0;
+
+		/// <summary>
+		/// Records the barriers the graph gives before a pass or at the end of the frame
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_CommandBuffer">: Command buffer of the frame, it has to be recording outside of a render pass </param>
+		/// <param name="_Barriers">: Barriers of the pass </param>
+		/// <param name="_ImageIndex">: Swap chain image the imported textures stand for </param>
+		virtual void RecordBarriers(IDevice* _Device, ICommandBuffer* _CommandBuffer, const std::vector<RenderGraphBarrier>& _Barriers, unsigned int _ImageIndex) = 0;
+
+		virtual VulkanRenderGraphResources* CastToVulkan() = 0;
+	};
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RHI/RHITypes/RHIResult.h"
+#include "RHI/RenderGraph.h"
 
 namespace Core
 {
@@ -11,6 +12,7 @@ namespace Core
 	class ISemaphore;
 	class IFence;
 	class ICommandBuffer;
+	class IRenderGraphResources;
 
 	class ISwapChain
 	{
@@ -26,6 +28,16 @@ namespace Core
 		virtual VulkanSwapChain* CastToVulkan() = 0;
 
 		virtual RHI_RESULT CreateSwapChainFramebuffers(IDevice* _Device, IPipeline* _Pipeline) = 0;
+
+		/// <summary>
+		/// Recreates the framebuffers with the depth texture of the render graph
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_Pipeline">: Pipeline giving the render pass of the framebuffers </param>
+		/// <param name="_Resources">: Textures of the render graph </param>
+		/// <param name="_Depth">: Depth resource of the graph, at least as large as the swap chain </param>
+		/// <returns></returns>
+		virtual RHI_RESULT SetDepthAttachment(IDevice* _Device, IPipeline* _Pipeline, IRenderGraphResources* _Resources, RenderGraphResource _Depth) = 0;
 		virtual void AcquireNextImage(Window* _Window, IDevice* _Device, IPipeline* _Pipeline, unsigned int _Timeout, ISemaphore* _ImageAvailableSemaphore, unsigned int& _ImageIndex) = 0;
 
 		virtual RHI_RESULT SubmitGraphicsQueue(IDevice* _Device, ICommandBuffer* _CommandBuffer, ISemaphore* _ImageAvailableSemaphore, ISemaphore* _RenderFinishSemaphore, IFence* _InFlightFence) = 0;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "RHI/RHITypes/RHIResult.h"
+
+namespace Core
+{
+	class IDevice;
+	class VulkanUploadManager;
+
+	/// <summary>
+	/// Gathers all the CPU to GPU copies (meshes, textures...) in batches
+	/// so many resources can be uploaded with a single submission
+	/// </summary>
+	class IUploadManager
+	{
+	public:
+		virtual ~IUploadManager() = default;
+
+		/// <summary>
+		/// Creates the persistent staging memory and the objects used to record the batches
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <param name="_StagingSize">: Size in bytes of the staging ring buffer </param>
+		/// <returns></returns>
+		virtual const RHI_RESULT CreateUploadManager(IDevice* _Device, size_t _StagingSize) = 0;
+
+		/// <summary>
+		/// Waits for the pending uploads and destroys the upload manager
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		/// <returns></returns>
+		virtual const RHI_RESULT DestroyUploadManager(IDevice* _Device) = 0;
+
+		/// <summary>
+		/// Submits all the uploads recorded since the last flush without waiting for them
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		virtual void FlushUploads(IDevice* _Device) = 0;
+
+		/// <summary>
+		/// Flushes the uploads and blocks until all of them are completed on the GPU
+		/// </summary>
+		/// <param name="_Device">: Device </param>
+		virtual void WaitUploads(IDevice* _Device) = 0;
+
+		/// <summary>
+		/// Returns the number of queue submissions done by the upload manager
+		/// </summary>
+		/// <returns></returns>
+		virtual unsigned int GetSubmissionCount() const = 0;
+
+		/// <summary>
+		/// Uploads each resource with its own staging buffer and waits for the queue, as before the batches
+		/// Only kept to measure the batches against it
+		/// </summary>
+		/// <param name="_IsImmediate">: True to upload immediately, false to go back to the batches </param>
+		virtual void SetImmediateUploads(const bool _IsImmediate) = 0;
+
+		virtual VulkanUploadManager* CastToVulkan() = 0;
+	};
+}
\ No newline at end of file
@@ -11,4 +11,6 @@
 #include "RHI/RHITypes/IQueue.h"
 #include "RHI/RHITypes/ISwapChain.h"
 #include "RHI/RHITypes/ISemaphore.h"
-#include "RHI/RHITypes/IFence.h"
\ No newline at end of file
+#include "RHI/RHITypes/IFence.h"
+#include "RHI/RHITypes/IUploadManager.h"
+#include "RHI/RHITypes/IRenderGraphResources.h"
\ No newline at end of file
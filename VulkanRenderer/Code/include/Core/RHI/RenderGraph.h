@@ -0,0 +1,246 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace Core
+{
+	// Index of a resource in the render graph
+	typedef unsigned int RenderGraphResource;
+
+	// Index of a pass in the render graph
+	typedef unsigned int RenderGraphPassHandle;
+
+	/// <summary>
+	/// How a pass uses a resource, translated to layouts / stages / accesses by the RHI
+	/// Bits so the accesses of a pass reading and writing the same resource can be combined in one barrier
+	/// </summary>
+	enum RenderGraphAccess
+	{
+		RG_ACCESS_NONE = 0,
+		RG_ACCESS_COLOR_ATTACHMENT = 1 << 0,
+		RG_ACCESS_DEPTH_ATTACHMENT = 1 << 1,
+		RG_ACCESS_SHADER_READ = 1 << 2,
+		RG_ACCESS_TRANSFER_READ = 1 << 3,
+		RG_ACCESS_TRANSFER_WRITE = 1 << 4,
+		RG_ACCESS_PRESENT = 1 << 5
+	};
+
+	// Combination of RenderGraphAccess bits
+	typedef unsigned int RenderGraphAccessFlags;
+
+	enum RenderGraphFormat
+	{
+		RG_FORMAT_RGBA8,
+		RG_FORMAT_RGBA16F,
+		RG_FORMAT_DEPTH32
+	};
+
+	struct RenderGraphTextureDesc
+	{
+		unsigned int width = 0;
+		unsigned int height = 0;
+		RenderGraphFormat format = RG_FORMAT_RGBA8;
+	};
+
+	struct RenderGraphResourceNode
+	{
+		std::string name;
+		RenderGraphTextureDesc desc;
+
+		// Imported resources are owned outside of the graph (swapchain images...), they are never aliased
+		bool imported = false;
+		RenderGraphAccess initialAccess = RG_ACCESS_NONE;
+		RenderGraphAccess finalAccess = RG_ACCESS_NONE;
+
+		// Written for someone outside of the graph, the passes producing it are never culled
+		bool isOutput = false;
+
+		// Filled by the compilation - position of the first and last passes using it in the execution order
+		int firstUse = -1;
+		int lastUse = -1;
+
+		// Filled by the compilation - memory block planned for the transient resources, nothing is allocated by the graph
+		int physicalIndex = -1;
+	};
+
+	struct RenderGraphResourceAccess
+	{
+		RenderGraphResource resource = 0;
+		RenderGraphAccess access = RG_ACCESS_NONE;
+	};
+
+	struct RenderGraphBarrier
+	{
+		RenderGraphResource resource = 0;
+		// Several bits when the previous or the next pass reads and writes the resource
+		RenderGraphAccessFlags srcAccess = RG_ACCESS_NONE;
+		RenderGraphAccessFlags dstAccess = RG_ACCESS_NONE;
+	};
+
+	struct RenderGraphPass
+	{
+		std::string name;
+
+		std::vector<RenderGraphResourceAccess> reads;
+		std::vector<RenderGraphResourceAccess> writes;
+
+		// Passes with side effects (readback, debug...) are kept even if nothing reads what they write
+		bool hasSideEffects = false;
+
+		std::function<void()> execute;
+
+		// Filled by the compilation
+		bool isCulled = true;
+		std::vector<RenderGraphPassHandle> dependencies;
+		std::vector<RenderGraphBarrier> barriers;
+	};
+
+	/// <summary>
+	/// Memory block shared by transient resources whose lifetimes do not overlap
+	/// The size is an estimation from the formats, the RHI allocates the block with the real requirements of its textures
+	/// </summary>
+	struct RenderGraphPhysicalResource
+	{
+		size_t size = 0;
+
+		// Execution position of the last pass using the block
+		int lastUse = -1;
+	};
+
+	/// <summary>
+	/// Frame graph - passes declare the resources they read and write,
+	/// the compilation culls the useless passes, orders them, deduces the barriers and plans the aliasing of the transient resources
+	/// Independent from the RHI so it can be compiled without GPU, the aliasing plans the blocks and IRenderGraphResources allocates them
+	/// The descriptions hold the size of the textures, the graph has to be rebuilt when the swap chain is resized
+	/// </summary>
+	class RenderGraph
+	{
+	private:
+		std::vector<RenderGraphResourceNode> m_Resources;
+		std::vector<RenderGraphPass> m_Passes;
+
+		std::vector<RenderGraphPassHandle> m_ExecutionOrder;
+		std::vector<RenderGraphPhysicalResource> m_PhysicalResources;
+
+		// Barriers moving the imported resources to their final access at the end of the frame
+		std::vector<RenderGraphBarrier> m_FinalBarriers;
+
+		size_t m_UnaliasedMemorySize = 0;
+		double m_CompileTime = 0.0;
+
+		bool m_IsCompiled = false;
+
+		void BuildDependencies();
+		void CullPasses();
+		void ComputeBarriers();
+		void AliasTransientResources();
+
+	public:
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Declaration related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Declares a texture created and owned by the graph, its memory can be shared with other transient textures
+		/// </summary>
+		/// <param name="_Name">: Debug name </param>
+		/// <param name="_Desc">: Size and format </param>
+		/// <returns></returns>
+		RenderGraphResource CreateTexture(const std::string& _Name, const RenderGraphTextureDesc& _Desc);
+
+		/// <summary>
+		/// Declares a resource owned outside of the graph
+		/// </summary>
+		/// <param name="_Name">: Debug name </param>
+		/// <param name="_Desc">: Size and format </param>
+		/// <param name="_InitialAccess">: Access of the resource when the frame starts </param>
+		/// <param name="_FinalAccess">: Access the resource has to be in when the frame ends </param>
+		/// <returns></returns>
+		RenderGraphResource ImportTexture(const std::string& _Name, const RenderGraphTextureDesc& _Desc, RenderGraphAccess _InitialAccess, RenderGraphAccess _FinalAccess);
+
+		/// <summary>
+		/// Adds a pass, it is executed in declaration order relatively to the passes it depends on
+		/// </summary>
+		/// <param name="_Name">: Debug name </param>
+		/// <param name="_Execute">: Records the commands of the pass </param>
+		/// <returns></returns>
+		RenderGraphPassHandle AddPass(const std::string& _Name, const std::function<void()>& _Execute);
+
+		void Read(RenderGraphPassHandle _Pass, RenderGraphResource _Resource, RenderGraphAccess _Access);
+		void Write(RenderGraphPassHandle _Pass, RenderGraphResource _Resource, RenderGraphAccess _Access);
+
+		inline void SetSideEffects(RenderGraphPassHandle _Pass) { m_Passes[_Pass].hasSideEffects = true; m_IsCompiled = false; }
+		inline void MarkOutput(RenderGraphResource _Resource) { m_Resources[_Resource].isOutput = true; m_IsCompiled = false; }
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Compilation and execution methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Culls, orders the passes, computes the barriers and plans the aliasing of the transient resources
+		/// </summary>
+		/// <returns></returns>
+		const bool Compile();
+
+		/// <summary>
+		/// Executes the passes in the compiled order
+		/// </summary>
+		/// <param name="_RecordBarriers">: Called before a pass with the barriers it needs, can be empty when the RHI handles them itself </param>
+		void Execute(const std::function<void(const std::vector<RenderGraphBarrier>&)>& _RecordBarriers = nullptr);
+
+		/// <summary>
+		/// Removes all passes and resources
+		/// </summary>
+		void Clear();
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Getters
+
+		///////////////////////////////////////////////////////////////////////
+
+		inline const std::vector<RenderGraphPassHandle>& GetExecutionOrder() const { return m_ExecutionOrder; }
+		inline const RenderGraphPass& GetPass(RenderGraphPassHandle _Pass) const { return m_Passes[_Pass]; }
+		inline const RenderGraphResourceNode& GetResource(RenderGraphResource _Resource) const { return m_Resources[_Resource]; }
+		inline const std::vector<RenderGraphPhysicalResource>& GetPhysicalResources() const { return m_PhysicalResources; }
+		inline const std::vector<RenderGraphBarrier>& GetFinalBarriers() const { return m_FinalBarriers; }
+
+		inline size_t GetPassCount() const { return m_Passes.size(); }
+		inline size_t GetResourceCount() const { return m_Resources.size(); }
+
+		/// <summary>
+		/// Memory the transient resources would use once aliased, estimated from their formats
+		/// </summary>
+		/// <returns></returns>
+		size_t GetTransientMemorySize() const;
+
+		/// <summary>
+		/// Memory the transient resources would use without aliasing
+		/// </summary>
+		/// <returns></returns>
+		inline size_t GetUnaliasedMemorySize() const { return m_UnaliasedMemorySize; }
+
+		/// <summary>
+		/// Duration of the last compilation in milliseconds
+		/// </summary>
+		/// <returns></returns>
+		inline double GetCompileTime() const { return m_CompileTime; }
+
+		inline bool IsCompiled() const { return m_IsCompiled; }
+
+		/// <summary>
+		/// Tells if one of the accesses writes the resource
+		/// </summary>
+		/// <param name="_Access">: Access bits </param>
+		/// <returns></returns>
+		static bool IsWriteAccess(RenderGraphAccessFlags _Access);
+		static size_t GetFormatSize(RenderGraphFormat _Format);
+	};
+}
\ No newline at end of file
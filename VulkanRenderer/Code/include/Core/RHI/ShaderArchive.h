@@ -0,0 +1,185 @@
+#pragma once
+
+#include "RHI/ShaderReflection.h"
+#include "FileSystem/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	// Layout of an archive, every offset is from the start of the file and every block is 8 bytes aligned
+	// Header | Entries sorted by key | SPIR-V and reflection of each entry | Names
+
+	struct ShaderArchiveHeader
+	{
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		uint32_t entryCount = 0;
+		uint32_t reserved = 0;
+	};
+
+	struct ShaderArchiveEntry
+	{
+		// See ShaderArchive::ComputeKey
+		uint64_t key = 0;
+		uint32_t stage = 0;
+		uint32_t nameOffset = 0;
+		uint32_t spirVOffset = 0;
+		uint32_t spirVWordCount = 0;
+		uint32_t reflectionOffset = 0;
+		uint32_t reserved = 0;
+	};
+
+	// Reflection block - header followed by the bindings, the vertex inputs then the push constant ranges
+	struct ShaderArchiveReflectionHeader
+	{
+		uint32_t bindingCount = 0;
+		uint32_t vertexInputCount = 0;
+		uint32_t pushConstantCount = 0;
+		uint32_t reserved = 0;
+	};
+
+	struct ShaderArchiveBinding
+	{
+		uint32_t nameOffset;
+		uint32_t set;
+		uint32_t binding;
+		uint32_t type;
+		uint32_t count;
+		uint32_t stages;
+	};
+
+	struct ShaderArchiveVertexInput
+	{
+		uint32_t nameOffset;
+		uint32_t location;
+		uint32_t baseType;
+		uint32_t componentCount;
+		uint32_t componentWidth;
+		uint32_t reserved;
+	};
+
+	struct ShaderArchivePushConstant
+	{
+		uint32_t offset;
+		uint32_t size;
+		uint32_t stages;
+		uint32_t reserved;
+	};
+
+	/// <summary>
+	/// Shaders compiled ahead of time by the ShaderBaker tool, with all their variants and their reflection
+	/// The file is mapped in memory, a lookup is a binary search and the SPIR-V is given to the driver without any copy
+	/// </summary>
+	class ShaderArchive
+	{
+	private:
+		// "SHAR"
+		static inline const uint32_t ARCHIVE_MAGIC_NUMBER = 0x52414853;
+		// Bumped when the layout of the archive changes
+		static inline const uint32_t ARCHIVE_VERSION = 1;
+
+		// Archive used by the shaders, null when the shaders are compiled at runtime
+		static inline ShaderArchive* m_MainArchive = nullptr;
+
+		MappedFile m_File;
+
+		const ShaderArchiveHeader* m_Header = nullptr;
+		const ShaderArchiveEntry* m_Entries = nullptr;
+
+		const char* GetString(uint32_t _Offset) const;
+
+		friend class ShaderArchiveBuilder;
+
+	public:
+		ShaderArchive() = default;
+
+		ShaderArchive(const ShaderArchive&) = delete;
+		ShaderArchive& operator=(const ShaderArchive&) = delete;
+
+		/// <summary>
+		/// Key of a shader, the file name of its source and the macros of its variant in any order
+		/// </summary>
+		/// <param name="_Name">: File name of the GLSL source </param>
+		/// <param name="_MacroDefinitions">: Macros of the variant, "NAME" or "NAME=VALUE" </param>
+		/// <returns></returns>
+		static unsigned long long ComputeKey(const std::string& _Name, const std::vector<std::string>& _MacroDefinitions);
+
+		/// <summary>
+		/// Maps an archive and checks its header and its table of entries
+		/// </summary>
+		/// <param name="_Path">: Path of the archive </param>
+		/// <returns></returns>
+		const bool Open(const std::filesystem::path& _Path);
+
+		void Close();
+
+		/// <summary>
+		/// Finds the entry of a shader
+		/// </summary>
+		/// <param name="_Key">: Key computed with ComputeKey </param>
+		/// <returns>nullptr if the archive does not contain the shader</returns>
+		const ShaderArchiveEntry* Find(unsigned long long _Key) const;
+
+		/// <summary>
+		/// SPIR-V of an entry, it points in the mapped file
+		/// </summary>
+		/// <param name="_Entry">: Entry given by Find </param>
+		/// <returns></returns>
+		inline const uint32_t* GetSpirV(const ShaderArchiveEntry& _Entry) const { return reinterpret_cast<const uint32_t*>(m_File.GetData() + _Entry.spirVOffset); }
+
+		/// <summary>
+		/// Copies the reflection of an entry
+		/// </summary>
+		/// <param name="_Entry">: Entry given by Find </param>
+		/// <param name="_Reflection">: Receives the reflection </param>
+		void GetReflection(const ShaderArchiveEntry& _Entry, ShaderReflection& _Reflection) const;
+
+		inline const char* GetName(const ShaderArchiveEntry& _Entry) const { return GetString(_Entry.nameOffset); }
+		inline unsigned int GetEntryCount() const { return m_Header != nullptr ? m_Header->entryCount : 0; }
+
+		static inline void SetMainArchive(ShaderArchive* _Archive) { m_MainArchive = _Archive; }
+		static inline ShaderArchive* GetMainArchive() { return m_MainArchive; }
+	};
+
+	/// <summary>
+	/// Gathers compiled shaders and writes them in the layout read by ShaderArchive
+	/// </summary>
+	class ShaderArchiveBuilder
+	{
+	private:
+		struct PendingShader
+		{
+			unsigned long long key;
+			// Name of the variant, only for debugging
+			std::string name;
+			std::vector<uint32_t> spirV;
+			ShaderReflection reflection;
+		};
+
+		std::vector<PendingShader> m_Shaders;
+
+	public:
+
+		/// <summary>
+		/// Adds a compiled shader
+		/// </summary>
+		/// <param name="_Name">: File name of the GLSL source </param>
+		/// <param name="_MacroDefinitions">: Macros of the variant </param>
+		/// <param name="_SpirV">: Compiled code </param>
+		/// <param name="_Reflection">: Interface of the shader, read before the names are stripped </param>
+		/// <returns>false if the same shader is already added</returns>
+		const bool AddShader(const std::string& _Name, const std::vector<std::string>& _MacroDefinitions, const std::vector<uint32_t>& _SpirV, const ShaderReflection& _Reflection);
+
+		/// <summary>
+		/// Writes the archive
+		/// </summary>
+		/// <param name="_Path">: Path of the archive </param>
+		/// <returns></returns>
+		const bool Write(const std::filesystem::path& _Path) const;
+
+		inline size_t GetShaderCount() const { return m_Shaders.size(); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "FileSystem/SourceFileCache.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <atomic>
+
+namespace Core
+{
+	/// <summary>
+	/// Everything that changes the SPIR-V produced for a shader
+	/// </summary>
+	struct ShaderCacheKeyInfos
+	{
+		// Source after the preprocessing for ComputeKey, includes and macros are already expanded in it
+		// Source as written for ComputeDependencyKey
+		const std::string* source = nullptr;
+		// Path of the GLSL file, includes are resolved from it, only part of the dependency key
+		std::string sourcePath;
+		int shaderKind = 0;
+		// Description of the compile options (optimization level, target environment...)
+		std::string options;
+		unsigned int compilerVersion = 0;
+		unsigned int compilerRevision = 0;
+	};
+
+	/// <summary>
+	/// On-disk cache of compiled SPIR-V, a hit avoids the compilation of the shader
+	/// Files are named after a 64 bits hash of the key infos
+	/// </summary>
+	class ShaderCache
+	{
+	private:
+		// Bumped when the layout of the cached files changes
+		static inline const unsigned int CACHE_FORMAT_VERSION = 2;
+
+		static inline const uint32_t SPIRV_MAGIC_NUMBER = 0x07230203;
+
+		static inline std::filesystem::path m_CacheDirectory = "Cache/Shaders";
+
+		// Shaders can be compiled by several threads at once
+		static inline std::atomic<unsigned int> m_HitCount = 0;
+		static inline std::atomic<unsigned int> m_MissCount = 0;
+
+		static std::filesystem::path GetEntryPath(unsigned long long _Key);
+		static std::filesystem::path GetDependencyRecordPath(unsigned long long _Key);
+
+		/// <summary>
+		/// Writes a file next to its final path then renames it so a partial write is never read
+		/// The temporary file is unique per thread so the same entry can be written concurrently
+		/// </summary>
+		/// <param name="_Path">: Final path </param>
+		/// <param name="_Data">: Content of the file </param>
+		/// <param name="_Size">: Size of the content in bytes </param>
+		/// <returns></returns>
+		static const bool WriteEntry(const std::filesystem::path& _Path, const void* _Data, size_t _Size);
+
+	public:
+
+		/// <summary>
+		/// Hashes the infos with FNV-1a
+		/// </summary>
+		/// <param name="_Infos">: Source, kind, options and compiler version of the shader </param>
+		/// <returns></returns>
+		static unsigned long long ComputeKey(const ShaderCacheKeyInfos& _Infos);
+
+		/// <summary>
+		/// Reads the SPIR-V stored for a key
+		/// </summary>
+		/// <param name="_Key">: Key computed with ComputeKey </param>
+		/// <param name="_SpirV">: Filled with the SPIR-V words on a hit </param>
+		/// <returns></returns>
+		static const bool Load(unsigned long long _Key, std::vector<uint32_t>& _SpirV);
+
+		/// <summary>
+		/// Writes the SPIR-V of a key
+		/// </summary>
+		/// <param name="_Key">: Key computed with ComputeKey </param>
+		/// <param name="_SpirV">: Compiled shader </param>
+		/// <returns></returns>
+		static const bool Store(unsigned long long _Key, const std::vector<uint32_t>& _SpirV);
+
+		/// <summary>
+		/// Hashes the infos before the preprocessing, the key of the dependency record of a shader
+		/// </summary>
+		/// <param name="_Infos">: Source as written, path, kind, options and compiler version of the shader </param>
+		/// <returns></returns>
+		static unsigned long long ComputeDependencyKey(const ShaderCacheKeyInfos& _Infos);
+
+		/// <summary>
+		/// Reads the files a shader included and the key of its SPIR-V, the preprocessing is skipped when none of the files changed
+		/// </summary>
+		/// <param name="_DependencyKey">: Key computed with ComputeDependencyKey </param>
+		/// <param name="_Key">: Receives the key of the SPIR-V, computed with ComputeKey </param>
+		/// <param name="_Dependencies">: Receives the included files with the hash of their content </param>
+		/// <returns></returns>
+		static const bool LoadDependencies(unsigned long long _DependencyKey, unsigned long long& _Key, std::vector<SourceDependency>& _Dependencies);
+
+		/// <summary>
+		/// Writes the dependency record of a shader
+		/// </summary>
+		/// <param name="_DependencyKey">: Key computed with ComputeDependencyKey </param>
+		/// <param name="_Key">: Key of the SPIR-V </param>
+		/// <param name="_Dependencies">: Files included by the shader </param>
+		/// <returns></returns>
+		static const bool StoreDependencies(unsigned long long _DependencyKey, unsigned long long _Key, const std::vector<SourceDependency>& _Dependencies);
+
+		static inline void SetCacheDirectory(const std::filesystem::path& _Directory) { m_CacheDirectory = _Directory; }
+		static inline const std::filesystem::path& GetCacheDirectory() { return m_CacheDirectory; }
+
+		static inline unsigned int GetHitCount() { return m_HitCount; }
+		static inline unsigned int GetMissCount() { return m_MissCount; }
+	};
+}
\ No newline at end of file
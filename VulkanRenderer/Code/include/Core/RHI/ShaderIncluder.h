@@ -0,0 +1,46 @@
+#pragma once
+
+#include "FileSystem/SourceFileCache.h"
+
+#ifdef SHADER_RUNTIME_COMPILATION
+#include <shaderc/shaderc.hpp>
+
+namespace Core
+{
+	/// <summary>
+	/// Resolves the includes of a shader through the SourceFileCache and records every file included
+	/// Quoted includes are relative to the including file, the others to the directory of the compiled shader
+	/// </summary>
+	class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface
+	{
+	private:
+		// Kept alive until shaderc releases the include
+		struct IncludeData
+		{
+			std::shared_ptr<const SourceFile> file;
+			std::string name;
+			std::string errorMessage;
+			shaderc_include_result result;
+		};
+
+		std::filesystem::path m_SourcePath;
+		// Name given to shaderc for the compiled shader, it requests the includes of the main file with it
+		std::string m_SourceName;
+
+		std::vector<SourceDependency>& m_Dependencies;
+
+	public:
+
+		/// <summary>
+		/// Creates the includer of one compilation
+		/// </summary>
+		/// <param name="_SourcePath">: Path of the compiled GLSL file </param>
+		/// <param name="_SourceName">: Name of the shader given to the compiler </param>
+		/// <param name="_Dependencies">: Receives the files included, must outlive the includer </param>
+		ShaderIncluder(const std::filesystem::path& _SourcePath, const std::string& _SourceName, std::vector<SourceDependency>& _Dependencies);
+
+		shaderc_include_result* GetInclude(const char* _RequestedSource, shaderc_include_type _Type, const char* _RequestingSource, size_t _IncludeDepth) override;
+		void ReleaseInclude(shaderc_include_result* _Data) override;
+	};
+}
+#endif
\ No newline at end of file
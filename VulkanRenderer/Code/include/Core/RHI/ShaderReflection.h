@@ -0,0 +1,118 @@
+#pragma once
+
+#include "RHI/RHITypes.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	// Bit of a stage in the stage masks of the reflection
+	inline unsigned int GetShaderStageBit(ShaderType _ShaderType) { return 1u << static_cast<unsigned int>(_ShaderType); }
+
+	enum ReflectedBaseType
+	{
+		REFLECTED_FLOAT,
+		REFLECTED_INT,
+		REFLECTED_UINT
+	};
+
+	struct ReflectedDescriptorBinding
+	{
+		// Name of the variable in the shader, only for the logs - empty when the SPIR-V is stripped
+		std::string name;
+		unsigned int set = 0;
+		unsigned int binding = 0;
+		DescriptorType type = RHI_DESCRIPTOR_UNIRFORM;
+		// Size of the array of descriptors, 1 when it is not an array
+		unsigned int count = 1;
+		// Stages using the binding, see GetShaderStageBit
+		unsigned int stages = 0;
+
+		bool operator==(const ReflectedDescriptorBinding& _Other) const;
+	};
+
+	struct ReflectedVertexInput
+	{
+		std::string name;
+		unsigned int location = 0;
+		ReflectedBaseType baseType = REFLECTED_FLOAT;
+		unsigned int componentCount = 1;
+		// In bits
+		unsigned int componentWidth = 32;
+	};
+
+	struct ReflectedPushConstantRange
+	{
+		unsigned int offset = 0;
+		unsigned int size = 0;
+		unsigned int stages = 0;
+	};
+
+	/// <summary>
+	/// Interface of one shader stage read from its SPIR-V
+	/// </summary>
+	struct ShaderReflection
+	{
+		ShaderType stage = RHI_VERTEX;
+
+		std::vector<ReflectedDescriptorBinding> bindings;
+		// Only filled for the vertex stage, sorted by location
+		std::vector<ReflectedVertexInput> vertexInputs;
+		// Empty when the stage has no push constant block
+		std::vector<ReflectedPushConstantRange> pushConstants;
+	};
+
+	/// <summary>
+	/// Interface of all the stages of a pipeline
+	/// </summary>
+	struct PipelineReflection
+	{
+		// Indexed by set then sorted by binding, sets not used by the shaders are empty
+		std::vector<std::vector<ReflectedDescriptorBinding>> sets;
+		std::vector<ReflectedVertexInput> vertexInputs;
+		std::vector<ReflectedPushConstantRange> pushConstants;
+
+		/// <summary>
+		/// Tells if the pipelines can share their layout, the descriptor sets and the push constants are the same
+		/// </summary>
+		/// <param name="_Other">: Reflection of the other pipeline </param>
+		/// <returns></returns>
+		bool IsLayoutCompatible(const PipelineReflection& _Other) const;
+
+		/// <summary>
+		/// Finds a resource by its decorations
+		/// </summary>
+		/// <param name="_Set">: Set of the resource </param>
+		/// <param name="_Binding">: Binding of the resource in its set </param>
+		/// <returns>nullptr if the shaders do not use the binding</returns>
+		const ReflectedDescriptorBinding* FindBinding(unsigned int _Set, unsigned int _Binding) const;
+	};
+
+	/// <summary>
+	/// Minimal SPIR-V parser reading the descriptors, push constants and vertex inputs of a module
+	/// Independent from the RHI so it can run without GPU
+	/// </summary>
+	class SpirVReflection
+	{
+	public:
+
+		/// <summary>
+		/// Reads the interface of a module
+		/// </summary>
+		/// <param name="_Code">: SPIR-V words </param>
+		/// <param name="_WordCount">: Number of words </param>
+		/// <param name="_Reflection">: Receives the interface </param>
+		/// <returns></returns>
+		static const bool Reflect(const uint32_t* _Code, size_t _WordCount, ShaderReflection& _Reflection);
+
+		/// <summary>
+		/// Merges the stages of a pipeline, a binding used by several stages is kept once with all the stages
+		/// </summary>
+		/// <param name="_Stages">: Reflection of every stage </param>
+		/// <param name="_Reflection">: Receives the interface of the pipeline </param>
+		/// <returns>false if two stages declare the same binding differently</returns>
+		static const bool MergeStages(const std::vector<const ShaderReflection*>& _Stages, PipelineReflection& _Reflection);
+	};
+}
\ No newline at end of file
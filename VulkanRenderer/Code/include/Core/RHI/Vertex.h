@@ -2,6 +2,8 @@
 
 #include "Vectors/Vector3.h"
 #include "Vectors/Vector2.h"
+#include "RHI/ShaderReflection.h"
+#include "RHI/VertexLayout.h"
 #include <vulkan/vulkan.h>
 
 #include <array>
@@ -9,24 +11,29 @@
 namespace Core
 {
 	/// <summary>
-	/// Vertex structure
+	/// Vertex as imported, it is converted to the layout of the mesh before the upload
 	/// </summary>
 	struct Vertex
 	{
 		Math::Vector3 position;
 		Math::Vector3 color;
 		Math::Vector2 textCoord;
+		Math::Vector3 normal;
 
 		/// <summary>
-		/// Describes how a complete vertex is in memory
+		/// Describes the vertex streams of a layout, the interleaved one then the color one if the layout has it
 		/// </summary>
-		/// <returns></returns>
-		static VkVertexInputBindingDescription GetBindingDescription();
+		/// <param name="_Layout">: Layout of the vertex buffers </param>
+		/// <param name="_BindingDescriptions">: Receives one description per stream </param>
+		static void GetBindingDescriptions(const VertexLayout& _Layout, std::vector<VkVertexInputBindingDescription>& _BindingDescriptions);
 
 		/// <summary>
-		/// Describes each attributes of the vertex
+		/// Describes the attributes of the layout read by a vertex shader
 		/// </summary>
-		/// <returns></returns>
-		static std::array<VkVertexInputAttributeDescription, 3> GetAttributeDescriptions();
+		/// <param name="_Layout">: Layout of the vertex buffers </param>
+		/// <param name="_Inputs">: Inputs reflected from the vertex shader </param>
+		/// <param name="_AttributeDescriptions">: Receives one description per input </param>
+		/// <returns>false if an input is not stored by the layout or does not match its type</returns>
+		static const bool GetAttributeDescriptions(const VertexLayout& _Layout, const std::vector<ReflectedVertexInput>& _Inputs, std::vector<VkVertexInputAttributeDescription>& _AttributeDescriptions);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "RHI/PipelineDescription.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Core
+{
+	struct Vertex;
+
+	enum VertexPositionFormat
+	{
+		// 12 bytes, read as is
+		RHI_POSITION_FLOAT32,
+		// 8 bytes, half floats in the bounds of the mesh mapped to [-1, 1]
+		RHI_POSITION_HALF,
+		// 8 bytes, 16 bits normalized integers in the bounds of the mesh mapped to [-1, 1]
+		RHI_POSITION_SNORM16
+	};
+
+	enum VertexNormalFormat
+	{
+		RHI_NORMAL_NONE,
+		// 4 bytes, unit vector folded on an octahedron then on a square, two 16 bits normalized integers
+		RHI_NORMAL_OCTAHEDRAL_SNORM16
+	};
+
+	enum VertexTextCoordFormat
+	{
+		// 8 bytes, read as is
+		RHI_TEXTCOORD_FLOAT32,
+		// 4 bytes, 16 bits normalized integers in the bounds of the coordinates when they leave [0, 1]
+		RHI_TEXTCOORD_UNORM16
+	};
+
+	enum VertexColorFormat
+	{
+		RHI_COLOR_NONE,
+		// 12 bytes interleaved with the other attributes, the layout of the default format
+		RHI_COLOR_FLOAT32,
+		// 4 bytes in a second vertex stream, meshes without colors do not pay for it in the first one
+		RHI_COLOR_UNORM8_STREAM
+	};
+
+	enum VertexAttributeType
+	{
+		RHI_ATTRIBUTE_FLOAT32,
+		RHI_ATTRIBUTE_FLOAT16,
+		RHI_ATTRIBUTE_SNORM16,
+		RHI_ATTRIBUTE_UNORM16,
+		RHI_ATTRIBUTE_UNORM8
+	};
+
+	/// <summary>
+	/// Where and how a vertex shader input is stored in the vertex streams
+	/// </summary>
+	struct VertexAttribute
+	{
+		// 0 for the interleaved stream, 1 for the color stream
+		unsigned int binding = 0;
+		uint32_t offset = 0;
+		VertexAttributeType type = RHI_ATTRIBUTE_FLOAT32;
+		unsigned int componentCount = 0;
+	};
+
+	/// <summary>
+	/// Scale and offset turning the stored values back into the original ones, laid out like the end of the ModelData uniform buffer
+	/// Identity for the float formats
+	/// </summary>
+	struct VertexDequantization
+	{
+		// xyz used, position = stored * scale + offset
+		float positionScale[4] = { 1.f, 1.f, 1.f, 0.f };
+		float positionOffset[4] = { 0.f, 0.f, 0.f, 0.f };
+		// xy scale, zw offset
+		float textCoordScaleOffset[4] = { 1.f, 1.f, 0.f, 0.f };
+	};
+
+	/// <summary>
+	/// Largest differences between the vertices imported and the vertices the shader reads back
+	/// </summary>
+	struct VertexEncodingStatistics
+	{
+		// In the units of the mesh, on one axis
+		float maxPositionError = 0.f;
+		float maxTextCoordError = 0.f;
+		// In degrees
+		float maxNormalError = 0.f;
+		float maxColorError = 0.f;
+	};
+
+	/// <summary>
+	/// Encoding of every attribute of a vertex in the GPU buffers
+	/// Attributes are interleaved in the first stream in the order position, color, normal, texture coordinate
+	/// </summary>
+	struct VertexLayout
+	{
+		// Locations of the inputs of the vertex shaders
+		static inline const unsigned int POSITION_LOCATION = 0;
+		static inline const unsigned int COLOR_LOCATION = 1;
+		static inline const unsigned int TEXTCOORD_LOCATION = 2;
+		static inline const unsigned int NORMAL_LOCATION = 3;
+
+		VertexPositionFormat positionFormat = RHI_POSITION_FLOAT32;
+		VertexColorFormat colorFormat = RHI_COLOR_FLOAT32;
+		VertexNormalFormat normalFormat = RHI_NORMAL_NONE;
+		VertexTextCoordFormat textCoordFormat = RHI_TEXTCOORD_FLOAT32;
+
+		/// <summary>
+		/// Layout of a format used by the pipelines
+		/// </summary>
+		/// <param name="_Format">: Format of the pipeline description </param>
+		/// <returns></returns>
+		static VertexLayout Get(VertexFormat _Format);
+
+		/// <summary>
+		/// Describes the member of the vertex read by a shader location
+		/// </summary>
+		/// <param name="_Location">: Location of the input in the vertex shader </param>
+		/// <param name="_Attribute">: Receives the stream, offset and type of the member </param>
+		/// <returns>false if the layout does not store the location</returns>
+		const bool GetAttribute(unsigned int _Location, VertexAttribute& _Attribute) const;
+
+		/// <summary>
+		/// Size of a vertex in the interleaved stream
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetStride() const;
+
+		/// <summary>
+		/// Size of a vertex in the color stream
+		/// </summary>
+		/// <returns>0 when the colors are not in their own stream</returns>
+		uint32_t GetColorStride() const;
+
+		inline bool HasColorStream() const { return colorFormat == RHI_COLOR_UNORM8_STREAM; }
+		inline bool HasColor() const { return colorFormat != RHI_COLOR_NONE; }
+		inline bool HasNormal() const { return normalFormat != RHI_NORMAL_NONE; }
+	};
+
+	/// <summary>
+	/// Converts imported vertices to the buffers of a layout, independent from the RHI so it can run without GPU
+	/// </summary>
+	class VertexEncoder
+	{
+	public:
+
+		/// <summary>
+		/// Encodes the vertices, the quantized positions and texture coordinates are relative to their bounds
+		/// </summary>
+		/// <param name="_Vertices">: Imported vertices </param>
+		/// <param name="_Layout">: Layout of the buffers </param>
+		/// <param name="_VertexData">: Receives the interleaved stream </param>
+		/// <param name="_ColorData">: Receives the color stream, left empty when the layout has none </param>
+		/// <param name="_Dequantization">: Receives the transforms the shader applies to read the original values back </param>
+		/// <param name="_Statistics">: Receives the quantization errors, they are not measured when null </param>
+		static void Encode(const std::vector<Vertex>& _Vertices, const VertexLayout& _Layout, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData,
+			VertexDequantization& _Dequantization, VertexEncodingStatistics* _Statistics = nullptr);
+
+		/// <summary>
+		/// Rounds to the nearest half float, out of range values become infinite
+		/// </summary>
+		/// <param name="_Value">: Float to convert </param>
+		/// <returns>Bits of the half float</returns>
+		static uint16_t FloatToHalf(float _Value);
+		static float HalfToFloat(uint16_t _Half);
+
+		/// <summary>
+		/// Folds a unit vector on the octahedron, the closest of the four quantized neighbours is kept
+		/// </summary>
+		/// <param name="_Normal">: x, y and z of the vector, it does not need to be normalized </param>
+		/// <param name="_Encoded">: Receives the two 16 bits normalized integers </param>
+		static void EncodeOctahedral(const float* _Normal, int16_t* _Encoded);
+
+		/// <summary>
+		/// Unfolds a normal like the vertex shader does
+		/// </summary>
+		/// <param name="_Encoded">: Two 16 bits normalized integers </param>
+		/// <param name="_Normal">: Receives the normalized x, y and z </param>
+		static void DecodeOctahedral(const int16_t* _Encoded, float* _Normal);
+
+		static int16_t QuantizeSnorm16(float _Value);
+		static uint16_t QuantizeUnorm16(float _Value);
+		static float DequantizeSnorm16(int16_t _Value);
+		static float DequantizeUnorm16(uint16_t _Value);
+	};
+}
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include "RHI/IRendererHardware.h"
 
 #include <vulkan/vulkan.h>
-#include <shaderc/shaderc.hpp>
 
 #include <vector>
 #include <optional>
@@ -73,7 +72,7 @@ namespace Core
 		
 		///////////////////////////////////////////////////////////////////////
 
-		IPipeline* InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos) override;
+		IPipeline* InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description) override;
 
 		///////////////////////////////////////////////////////////////////////
 
@@ -138,5 +137,21 @@ namespace Core
 		///////////////////////////////////////////////////////////////////////
 
 		IBuffer* CreateBuffer(IDevice* _Device, BufferType _BufferType, size_t _BufferSize) override;
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Upload manager related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		IUploadManager* InstantiateUploadManager(IDevice* _Device, size_t _StagingSize) override;
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Render graph related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		IRenderGraphResources* InstantiateRenderGraphResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph) override;
 	};
 }
\ No newline at end of file
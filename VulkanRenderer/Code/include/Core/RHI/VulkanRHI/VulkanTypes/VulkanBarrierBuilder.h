@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RHI/VulkanRHI/VulkanRenderer.h"
+
+namespace Core
+{
+	class VulkanDevice;
+
+	/// <summary>
+	/// Collects memory, buffer and image barriers and records all of them with a single pipeline barrier
+	/// Uses vkCmdPipelineBarrier2 when synchronization2 is enabled on the device, vkCmdPipelineBarrier otherwise
+	/// </summary>
+	class VulkanBarrierBuilder
+	{
+	private:
+		std::vector<VkMemoryBarrier2KHR> m_MemoryBarriers;
+		std::vector<VkBufferMemoryBarrier2KHR> m_BufferBarriers;
+		std::vector<VkImageMemoryBarrier2KHR> m_ImageBarriers;
+
+		/// <summary>
+		/// Records the barriers with the legacy command, the stages of all barriers are merged
+		/// </summary>
+		/// <param name="_CommandBuffer">: Command buffer receiving the barriers </param>
+		void FlushLegacy(VkCommandBuffer _CommandBuffer);
+
+	public:
+
+		/// <summary>
+		/// Adds a global memory barrier
+		/// </summary>
+		/// <param name="_SrcStage">: Stages that have to be finished </param>
+		/// <param name="_SrcAccess">: Writes that have to be available </param>
+		/// <param name="_DstStage">: Stages waiting for the barrier </param>
+		/// <param name="_DstAccess">: Accesses the writes are made visible to </param>
+		void AddMemoryBarrier(VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess);
+
+		/// <summary>
+		/// Adds a barrier on a range of a buffer, it can also transfer the buffer to another queue family
+		/// </summary>
+		/// <param name="_Buffer">: Buffer concerned by the barrier </param>
+		/// <param name="_Offset">: Start of the range </param>
+		/// <param name="_Size">: Size of the range </param>
+		/// <param name="_SrcStage">: Stages that have to be finished </param>
+		/// <param name="_SrcAccess">: Writes that have to be available </param>
+		/// <param name="_DstStage">: Stages waiting for the barrier </param>
+		/// <param name="_DstAccess">: Accesses the writes are made visible to </param>
+		/// <param name="_SrcQueueFamily">: Family releasing the buffer </param>
+		/// <param name="_DstQueueFamily">: Family acquiring the buffer </param>
+		void AddBufferBarrier(VkBuffer _Buffer, VkDeviceSize _Offset, VkDeviceSize _Size, VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess,
+			uint32_t _SrcQueueFamily = VK_QUEUE_FAMILY_IGNORED, uint32_t _DstQueueFamily = VK_QUEUE_FAMILY_IGNORED);
+
+		/// <summary>
+		/// Adds a barrier on the first mip and layer of an image, it can change its layout and its queue family
+		/// </summary>
+		/// <param name="_Image">: Image concerned by the barrier </param>
+		/// <param name="_Aspect">: Aspect of the image (color, depth...) </param>
+		/// <param name="_OldLayout">: Current layout of the image </param>
+		/// <param name="_NewLayout">: Layout after the barrier </param>
+		/// <param name="_SrcStage">: Stages that have to be finished </param>
+		/// <param name="_SrcAccess">: Writes that have to be available </param>
+		/// <param name="_DstStage">: Stages waiting for the barrier </param>
+		/// <param name="_DstAccess">: Accesses the writes are made visible to </param>
+		/// <param name="_SrcQueueFamily">: Family releasing the image </param>
+		/// <param name="_DstQueueFamily">: Family acquiring the image </param>
+		void AddImageBarrier(VkImage _Image, VkImageAspectFlags _Aspect, VkImageLayout _OldLayout, VkImageLayout _NewLayout, VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess,
+			uint32_t _SrcQueueFamily = VK_QUEUE_FAMILY_IGNORED, uint32_t _DstQueueFamily = VK_QUEUE_FAMILY_IGNORED);
+
+		/// <summary>
+		/// Adds a layout transition, stages and accesses are deduced from the layouts
+		/// </summary>
+		/// <param name="_Image">: Image that you want to change the layout </param>
+		/// <param name="_Format">: Format of the image </param>
+		/// <param name="_OldLayout">: Old layout of the image </param>
+		/// <param name="_NewLayout">: New layout of the image </param>
+		void AddImageTransition(VkImage _Image, VkFormat _Format, VkImageLayout _OldLayout, VkImageLayout _NewLayout);
+
+		/// <summary>
+		/// Records all the barriers collected in one pipeline barrier and clears the builder
+		/// </summary>
+		/// <param name="_Device">: Device telling if synchronization2 is available </param>
+		/// <param name="_CommandBuffer">: Command buffer receiving the barriers, it has to be recording </param>
+		void Flush(VulkanDevice* _Device, VkCommandBuffer _CommandBuffer);
+
+		void Clear();
+
+		inline bool IsEmpty() const { return m_MemoryBarriers.empty() && m_BufferBarriers.empty() && m_ImageBarriers.empty(); }
+	};
+}
\ No newline at end of file
@@ -13,8 +13,8 @@ namespace Core
 	private:
 
 	public:
-		VkBuffer m_Buffer;
-		VkDeviceMemory m_BufferMemory;
+		VkBuffer m_Buffer = VK_NULL_HANDLE;
+		VkDeviceMemory m_BufferMemory = VK_NULL_HANDLE;
 
 		~VulkanBuffer() override;
 
@@ -52,6 +52,7 @@ namespace Core
 		void BindVertexBuffer(IMesh* _Mesh) const override;
 		void BindIndexBuffer(IMesh* _Mesh) const override;
 		void DrawIndexed(IMesh* _Mesh) const override;
+		void DrawIndexed(const std::vector<Submesh>& _Ranges) const override;
 		void EndRenderPass() const override;
 	};
 }
\ No newline at end of file
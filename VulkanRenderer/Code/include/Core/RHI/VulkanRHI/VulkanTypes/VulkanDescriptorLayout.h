@@ -4,13 +4,31 @@
 
 #include "RHI/VulkanRHI/VulkanRenderer.h"
 
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
 namespace Core
 {
 	class VulkanDescriptorLayout : public IDescriptorLayout
 	{
 	private:
+		struct SharedLayout
+		{
+			VulkanDescriptorLayout* layout = nullptr;
+			unsigned int referenceCount = 0;
+		};
+
+		// Identical layouts requested by several pipelines are created once, keyed by the description of their bindings
+		static inline std::unordered_map<std::string, SharedLayout> m_SharedLayouts;
+		static inline std::mutex m_SharedLayoutsMutex;
+
 		VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
 
+		std::string m_SharedKey;
+
+		static std::string ComputeSharedKey(const std::vector<DescriptorLayoutInfos>& _Infos);
+
 	public:
 
 		~VulkanDescriptorLayout() override;
@@ -18,6 +36,21 @@ namespace Core
 		const RHI_RESULT CreateDescriptorSetLayout(IDevice* _Device, std::vector<DescriptorLayoutInfos> _Infos) override;
 		const void DestroyDescriptorSetLayout(IDevice* _Device) override;
 
+		/// <summary>
+		/// Gives the layout matching the bindings, it is created only if no other pipeline uses the same one
+		/// </summary>
+		/// <param name="_Device">: Device creating the layout </param>
+		/// <param name="_Infos">: Bindings of the set </param>
+		/// <returns>nullptr if the creation failed</returns>
+		static VulkanDescriptorLayout* Acquire(IDevice* _Device, const std::vector<DescriptorLayoutInfos>& _Infos);
+
+		/// <summary>
+		/// Releases a layout given by Acquire, it is destroyed when its last user releases it
+		/// </summary>
+		/// <param name="_Device">: Device that created the layout </param>
+		/// <param name="_Layout">: Layout to release </param>
+		static void Release(IDevice* _Device, VulkanDescriptorLayout* _Layout);
+
 		inline VulkanDescriptorLayout* CastToVulkan() override { return this; }
 
 		inline VkDescriptorSetLayout GetType() { return m_DescriptorSetLayout; }
@@ -5,6 +5,10 @@
 
 #include "RHI/VulkanRHI/VulkanTypes/VulkanQueue.h"
 
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+
 namespace Core
 {
 	class VulkanDevice : public IDevice
@@ -38,6 +42,21 @@ namespace Core
 		VkQueue m_PresentationQueue;
 		VkQueue m_TransferQueue;
 
+		// Loaded only when VK_KHR_synchronization2 is supported and enabled, null otherwise
+		PFN_vkCmdPipelineBarrier2KHR m_CmdPipelineBarrier2 = nullptr;
+
+		// Compiled pipelines of the previous runs, saved when the device is terminated
+		VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
+		std::filesystem::path m_PipelineCachePath = "Cache/Pipelines/PipelineCache.bin";
+
+		// Caches filled by the worker threads, merged into m_PipelineCache by the main thread
+		std::vector<VkPipelineCache> m_WorkerPipelineCaches;
+		std::mutex m_WorkerPipelineCachesMutex;
+
+		// Shared by the pipeline creations, exclusive for the merges that need the cache to be externally synchronized
+		std::shared_mutex m_PipelineCacheMutex;
+
 		///////////////////////////////////////////////////////////////////////
 
 		/// Setup related methods
@@ -149,6 +168,38 @@ namespace Core
 		/// <returns></returns>
 		const bool CheckDeviceExtensionSupport(VkPhysicalDevice _Device);
 
+		/// <summary>
+		/// Checks if the device supports VK_KHR_synchronization2 and its feature
+		/// </summary>
+		/// <param name="_Device">: Physical device to check </param>
+		/// <returns></returns>
+		const bool CheckSynchronization2Support(VkPhysicalDevice _Device);
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Pipeline cache related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Creates the pipeline cache with the data saved by the previous run
+		/// The data is ignored if it was written by another driver or another GPU
+		/// </summary>
+		/// <returns></returns>
+		const RHI_RESULT CreatePipelineCache();
+
+		/// <summary>
+		/// Checks that the header of a saved pipeline cache matches the current device
+		/// </summary>
+		/// <param name="_Data">: Content of the saved cache </param>
+		/// <returns></returns>
+		const bool IsPipelineCacheDataValid(const std::vector<char>& _Data);
+
+		/// <summary>
+		/// Writes the pipeline cache on disk and destroys it
+		/// </summary>
+		void DestroyPipelineCache();
+
 	public:
 
 		///////////////////////////////////////////////////////////////////////
@@ -183,6 +234,41 @@ namespace Core
 		inline VkQueue GetPresentationQueue() { return m_PresentationQueue; }
 		inline VkQueue GetTransferQueue() { return m_TransferQueue; }
 
+		/// <summary>
+		/// Returns vkCmdPipelineBarrier2KHR, null if synchronization2 is not enabled
+		/// </summary>
+		/// <returns></returns>
+		inline PFN_vkCmdPipelineBarrier2KHR GetCmdPipelineBarrier2() { return m_CmdPipelineBarrier2; }
+
+		/// <summary>
+		/// Returns the pipeline cache used by the pipelines created on the main thread
+		/// </summary>
+		/// <returns></returns>
+		inline VkPipelineCache GetPipelineCache() { return m_PipelineCache; }
+
+		/// <summary>
+		/// Returns the mutex guarding the pipeline cache against a merge while pipelines are created
+		/// </summary>
+		/// <returns></returns>
+		inline std::shared_mutex& GetPipelineCacheMutex() { return m_PipelineCacheMutex; }
+
+		/// <summary>
+		/// Creates an empty cache for the pipelines created by a worker thread, the shared cache is not locked by the driver during their compilation
+		/// </summary>
+		/// <returns></returns>
+		VkPipelineCache CreateWorkerPipelineCache();
+
+		/// <summary>
+		/// Gives back a cache created with CreateWorkerPipelineCache, it is merged on the main thread then destroyed
+		/// </summary>
+		/// <param name="_PipelineCache">: Cache of the worker </param>
+		void SubmitWorkerPipelineCache(VkPipelineCache _PipelineCache);
+
+		/// <summary>
+		/// Merges the caches given back by the workers into the pipeline cache, has to be called from the main thread
+		/// </summary>
+		void MergeWorkerPipelineCaches();
+
 		///////////////////////////////////////////////////////////////////////
 
 		/// Initialization and termination methods
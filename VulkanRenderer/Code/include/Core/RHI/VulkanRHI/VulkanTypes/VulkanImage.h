@@ -9,7 +9,7 @@ namespace Core
 	class VulkanImage
 	{
 	private:
-		VkImage m_Image;
+		VkImage m_Image = VK_NULL_HANDLE;
 
 	public:
 
@@ -26,15 +26,6 @@ namespace Core
 		/// <param name="_ImageMemory">: Variable for the memory of the image </param>
 		void CreateImage(IDevice* _Device, uint32_t _Width, uint32_t _Height, VkFormat _Format, VkImageTiling _Tiling, VkImageUsageFlags _Usage, VkMemoryPropertyFlags _Properties, VkImage& _Image, VkDeviceMemory& _ImageMemory);
 
-		/// <summary>
-		/// Transitions the image from one layout to new one
-		/// </summary>
-		/// <param name="_Image">: Image that you want to change the layout </param>
-		/// <param name="_Format">: Format of the image </param>
-		/// <param name="_OldLayout">: Old layout of the image </param>
-		/// <param name="_NewLayout">: New layout of the image </param>
-		void TransitionImageLayout(VulkanDevice* _Device, VkImage _Image, VkFormat _Format, VkImageLayout _OldLayout, VkImageLayout _NewLayout);
-
 		/// <summary>
 		/// Creates a depth texture to store the depth buffer
 		/// </summary>
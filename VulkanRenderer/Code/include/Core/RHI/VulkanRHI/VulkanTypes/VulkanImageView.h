@@ -7,7 +7,7 @@ namespace Core
 	class VulkanImageView
 	{
 	private:
-		VkImageView m_ImageView;
+		VkImageView m_ImageView = VK_NULL_HANDLE;
 
 	public:
 		/// <summary>
@@ -11,20 +11,27 @@ namespace Core
 	{
 	private:
 		VulkanBuffer m_VertexBuffer;
+		// Only created when the layout stores the colors in their own stream
+		VulkanBuffer m_ColorBuffer;
+		bool m_HasColorStream = false;
 		VulkanBuffer m_IndexBuffer;
 
 		size_t m_IndexNbr = 0;
+		VkIndexType m_IndexType = VK_INDEX_TYPE_UINT32;
 
 	public:
 
-		RHI_RESULT CreateVertexBuffer(Core::IDevice* _Device, std::vector<Vertex>& _VerticesList) override;
-		RHI_RESULT CreateIndexBuffer(Core::IDevice* _Device, std::vector<uint32_t>& _IndicesList) override;
+		RHI_RESULT CreateVertexStreams(Core::IDevice* _Device, const void* _VertexData, size_t _VertexDataSize, const void* _ColorData, size_t _ColorDataSize) override;
+		RHI_RESULT CreateIndexStream(Core::IDevice* _Device, const void* _Indices, size_t _IndexCount, IndexType _IndexType) override;
 
 		RHI_RESULT DestroyBuffers(Core::IDevice* _Device) override;
 
 		inline VulkanMesh* CastToVulkan() override { return this; }
 		inline VulkanBuffer GetVertexBuffer() { return m_VertexBuffer; }
+		inline VulkanBuffer GetColorBuffer() { return m_ColorBuffer; }
+		inline bool HasColorStream() const { return m_HasColorStream; }
 		inline VulkanBuffer GetIndexBuffer() { return m_IndexBuffer; }
 		inline size_t GetIndexNumber() { return m_IndexNbr; }
+		inline VkIndexType GetVulkanIndexType() const { return m_IndexType; }
 	};
 }
\ No newline at end of file
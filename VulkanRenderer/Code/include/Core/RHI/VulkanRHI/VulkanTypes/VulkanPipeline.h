@@ -13,26 +13,58 @@ namespace Core
 	class VulkanPipeline : public IPipeline
 	{
 	private:
-		VkPipeline m_GraphicsPipeline;
-		VkRenderPass m_RenderPass;
+		VkPipeline m_GraphicsPipeline = VK_NULL_HANDLE;
+		VkRenderPass m_RenderPass = VK_NULL_HANDLE;
 
-		VkPipelineLayout m_PipelineLayout;
+		VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+
+		// Built in the background with new shaders, waiting for a frame boundary to replace m_GraphicsPipeline
+		VkPipeline m_ReloadedPipeline = VK_NULL_HANDLE;
+		// Description of the reloaded pipeline, becomes the one of the pipeline with the swap
+		PipelineDescription m_ReloadedDescription;
+
+		RHI_RESULT CreatePipelineLayout(VulkanDevice* _Device);
+
+		/// <summary>
+		/// Creates a graphics pipeline with the render pass and the layout of this pipeline
+		/// </summary>
+		/// <param name="_Device">: Device creating the pipeline </param>
+		/// <param name="_Description">: Shader stages and states of the pipeline </param>
+		/// <param name="_Reflection">: Interface of the shader stages </param>
+		/// <param name="_PipelineCache">: Cache the pipeline is looked up in and added to </param>
+		/// <param name="_Pipeline">: Receives the pipeline created </param>
+		/// <returns></returns>
+		RHI_RESULT CreateGraphicsPipeline(VulkanDevice* _Device, const PipelineDescription& _Description, const PipelineReflection& _Reflection, VkPipelineCache _PipelineCache, VkPipeline& _Pipeline) const;
+
+		/// <summary>
+		/// Merges the reflection of the shader stages
+		/// </summary>
+		/// <param name="_ShadersInfos">: Shader stages, already compiled </param>
+		/// <param name="_Reflection">: Receives the interface of the pipeline </param>
+		/// <returns></returns>
+		static const bool ReflectShaders(const std::vector<PipelineShaderInfos>& _ShadersInfos, PipelineReflection& _Reflection);
 
 	public:
 		~VulkanPipeline() override;
 
 		/// <summary>
-		/// Creates a simple graphics pipeline to draw on screen
+		/// Creates a graphics pipeline drawing on screen, can be called from a worker thread
 		/// </summary>
-		RHI_RESULT CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos) override;
+		RHI_RESULT CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description) override;
 		RHI_RESULT DestroyPipeline(IDevice* _Device) override;
 
-		void CreateDescriptorSetLayout(IDevice* _Device);
+		RHI_RESULT CreateReloadedPipeline(IDevice* _Device, const std::vector<PipelineShaderInfos>& _ShadersInfos) override;
+		void SwapReloadedPipeline() override;
+
+		/// <summary>
+		/// Creates the layout of every set used by the shaders, identical sets share their layout
+		/// </summary>
+		RHI_RESULT CreateDescriptorSetLayout(IDevice* _Device);
 
 		/// <summary>
 		/// Creates a render pass object that will descibes the attachments of a framebuffer
 		/// </summary>
-		void CreateRenderPass(VulkanDevice* _Device, VulkanSwapChain* _Swapchain);
+		void CreateRenderPass(VulkanDevice* _Device, VkFormat _ColorFormat, VkFormat _DepthFormat);
 
 		inline VkPipeline GetPipeline() const { return m_GraphicsPipeline; }
 		inline VkRenderPass GetRenderPass() const { return m_RenderPass; }
@@ -32,7 +32,8 @@ namespace Core
 		inline VkQueue& GetQueue() { return m_Queue; }
 
 		/// <summary>
-		/// Find all queue famillies suporting features required by the application (Graphics and presentation)
+		/// Find all queue famillies suporting features required by the application (Graphics, presentation and transfer)
+		/// The transfer family is a family without graphics when the GPU has one, the graphics family otherwise
 		/// </summary>
 		/// <param name="_Device">: Physical device containing queue families </param>
 		/// <returns></returns>
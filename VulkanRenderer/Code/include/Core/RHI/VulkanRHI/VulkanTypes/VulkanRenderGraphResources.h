@@ -0,0 +1,69 @@
+#pragma once
+
+#include "RHI/RHITypes/IRenderGraphResources.h"
+
+#include "RHI/VulkanRHI/VulkanRenderer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanImageView.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanBarrierBuilder.h"
+
+namespace Core
+{
+	class VulkanSwapChain;
+
+	/// <summary>
+	/// Texture of the render graph on the GPU, the image of an imported texture is the swap chain image of the frame
+	/// </summary>
+	struct VulkanRenderGraphTexture
+	{
+		VkImage image = VK_NULL_HANDLE;
+		VkImageView imageView = VK_NULL_HANDLE;
+		VkFormat format = VK_FORMAT_UNDEFINED;
+		VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		VkExtent2D extent{};
+
+		bool imported = false;
+
+		// Its memory block is shared with other textures, the passes before it may still write the memory
+		bool isAliased = false;
+	};
+
+	class VulkanRenderGraphResources : public IRenderGraphResources
+	{
+	private:
+		VulkanSwapChain* m_SwapChain = nullptr;
+
+		// One per resource of the graph, the culled transients have no image
+		std::vector<VulkanRenderGraphTexture> m_Textures;
+
+		// One per physical resource of the graph, every texture of a block is bound at its start
+		std::vector<VkDeviceMemory> m_Memories;
+
+		VulkanBarrierBuilder m_Barriers;
+
+		/// <summary>
+		/// Gives the layout, the stages and the accesses of a combination of render graph accesses
+		/// </summary>
+		/// <param name="_Access">: Render graph access bits </param>
+		/// <param name="_IsDepth">: The texture has a depth format </param>
+		/// <param name="_Layout">: Layout the texture needs, general when the accesses need different layouts </param>
+		/// <param name="_Stages">: Stages doing the accesses </param>
+		/// <param name="_Accesses">: Memory accesses </param>
+		static void GetAccessInfos(RenderGraphAccessFlags _Access, bool _IsDepth, VkImageLayout& _Layout, VkPipelineStageFlags2KHR& _Stages, VkAccessFlags2KHR& _Accesses);
+
+	public:
+
+		const RHI_RESULT CreateResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph) override;
+		const RHI_RESULT DestroyResources(IDevice* _Device) override;
+
+		void RecordBarriers(IDevice* _Device, ICommandBuffer* _CommandBuffer, const std::vector<RenderGraphBarrier>& _Barriers, unsigned int _ImageIndex) override;
+
+		inline VulkanRenderGraphResources* CastToVulkan() override { return this; }
+
+		/// <summary>
+		/// Texture created for a transient resource of the graph
+		/// </summary>
+		/// <param name="_Resource">: Resource of the graph </param>
+		/// <returns>Null when the resource is imported or used by no pass</returns>
+		const VulkanRenderGraphTexture* GetTexture(RenderGraphResource _Resource) const;
+	};
+}
\ No newline at end of file
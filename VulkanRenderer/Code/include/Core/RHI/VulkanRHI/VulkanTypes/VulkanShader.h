@@ -4,33 +4,73 @@
 
 #include "RHI/VulkanRHI/VulkanRenderer.h"
 
+#ifdef SHADER_RUNTIME_COMPILATION
 #include <shaderc/shaderc.hpp>
+#endif
 
 namespace Core
 {
+#ifdef SHADER_RUNTIME_COMPILATION
 	struct CompilationInfos
 	{
 		const char* fileName;
 		shaderc_shader_kind shaderKind;
 		std::string* sourceCode;
-		shaderc::CompileOptions options;
+		const shaderc::CompileOptions* options;
 	};
+#endif
 
 	class VulkanShader : public IShader
 	{
 	private:
-		VkShaderModule m_ShaderModule;
+		VkShaderModule m_ShaderModule = VK_NULL_HANDLE;
+
+#ifdef SHADER_RUNTIME_COMPILATION
+		// Writes the SPIR-V assembly of every compiled shader next to the cache, only for debugging
+		static inline bool m_DumpAssembly = false;
+
+		/// <summary>
+		/// Compiler shared by all the shaders, creating one is expensive
+		/// </summary>
+		/// <returns></returns>
+		static shaderc::Compiler& GetCompiler();
+
+		/// <summary>
+		/// Options depending on the build type, optimized without debug infos in release
+		/// </summary>
+		/// <returns></returns>
+		static const shaderc::CompileOptions& GetCompileOptions();
+
+		/// <summary>
+		/// Describes the options returned by GetCompileOptions, it is part of the cache key
+		/// </summary>
+		/// <returns></returns>
+		static const std::string& GetCompileOptionsDescription();
+#endif
 
 	public:
 		inline VkShaderModule GetShaderModule() { return m_ShaderModule; }
 
-		RHI_RESULT PreprocessShader(shaderc::Compiler& _Compiler, CompilationInfos _Infos);
-		RHI_RESULT SpirVAssemblyCompilation(shaderc::Compiler& _Compiler, CompilationInfos _Infos);
-		std::vector<uint32_t> SpirVBinaryCompilation(shaderc::Compiler& _Compiler, CompilationInfos _Infos);
+#ifdef SHADER_RUNTIME_COMPILATION
+		RHI_RESULT PreprocessShader(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos);
+		std::vector<uint32_t> SpirVBinaryCompilation(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos);
+
+		/// <summary>
+		/// Writes the SPIR-V assembly of a shader in the cache directory
+		/// </summary>
+		/// <param name="_Compiler">: Compiler used </param>
+		/// <param name="_Infos">: Shader already preprocessed </param>
+		/// <returns></returns>
+		RHI_RESULT DumpSpirVAssembly(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos);
+
+		static inline void SetDumpAssembly(bool _DumpAssembly) { m_DumpAssembly = _DumpAssembly; }
+#endif
 
 		const bool CompileShader(Core::IDevice* _Device, const char* _ShaderName, std::string _ShaderSourceCode, Core::ShaderType _ShaderType) override;
+		const bool CreateFromSpirV(Core::IDevice* _Device, const uint32_t* _Code, size_t _WordCount) override;
 
-		RHI_RESULT CreateShaderModule(VulkanDevice _Device, const std::vector<uint32_t>& _ShaderBinaryCode);
+		RHI_RESULT CreateShaderModule(VulkanDevice& _Device, const std::vector<uint32_t>& _ShaderBinaryCode);
+		RHI_RESULT CreateShaderModule(VulkanDevice& _Device, const uint32_t* _Code, size_t _WordCount);
 		RHI_RESULT DestroyShaderModule(Core::IDevice* _Device) override;
 
 		inline VulkanShader* CastToVulkan() override { return this; }
@@ -35,16 +35,16 @@ namespace Core
 
 		std::vector<VulkanFramebuffer> m_SwapChainFramebuffers;
 
-		VulkanImage m_DepthImage;
-		VulkanImageView m_DepthImageView;
-		VkDeviceMemory m_DepthImageMemory;
+		// Depth texture owned by the render graph resources, the framebuffers are created once it is set
+		VkImageView m_DepthImageView = VK_NULL_HANDLE;
+		VkExtent2D m_DepthExtent{};
 
 		/// <summary>
 		/// Checks if the extensions needed for our program are supported by our GPU
 		/// </summary>
 		/// <param name="_Device">: Logical device which we check extensions support </param>
 		/// <returns></returns>
-		const bool CheckDeviceExtensionSupport(VulkanDevice _Device, const std::vector<const char*> _DeviceExtensions);
+		const bool CheckDeviceExtensionSupport(VulkanDevice& _Device, const std::vector<const char*> _DeviceExtensions);
 
 		/// <summary>
 		/// Selects the best format available for the swapchain
@@ -105,11 +105,15 @@ namespace Core
 
 		inline VulkanFramebuffer GetSwapchainFramebuffers(size_t _Index) { return m_SwapChainFramebuffers[_Index]; }
 
+		inline VkImage GetSwapchainImage(size_t _Index) { return m_SwapChainImages[_Index]; }
+
 		/// <summary>
 		/// Creates all the swap chain frames buffers for each image view
 		/// </summary>
 		RHI_RESULT CreateSwapChainFramebuffers(IDevice* _Device, IPipeline* _Pipeline) override;
 
+		RHI_RESULT SetDepthAttachment(IDevice* _Device, IPipeline* _Pipeline, IRenderGraphResources* _Resources, RenderGraphResource _Depth) override;
+
 		/// <summary>
 		/// Checks if the SwapChain is supported bu our GPU
 		/// </summary>
@@ -13,9 +13,9 @@ namespace Core
 	private:
 		VulkanImage m_TextureImage;
 		VulkanImageView m_TextureImageView;
-		VkDeviceMemory m_TextureImageMemory;
+		VkDeviceMemory m_TextureImageMemory = VK_NULL_HANDLE;
 
-		VkSampler m_TextureSampler;
+		VkSampler m_TextureSampler = VK_NULL_HANDLE;
 
 		/// <summary>
 		/// Creates an image that can be used in Vulkan with a texture loaded with STB Image
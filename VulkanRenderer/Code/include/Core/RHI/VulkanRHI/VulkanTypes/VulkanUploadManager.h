@@ -0,0 +1,197 @@
+#pragma once
+
+#include "RHI/RHITypes/IUploadManager.h"
+
+#include "RHI/VulkanRHI/VulkanRenderer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanBarrierBuilder.h"
+
+#include <deque>
+
+namespace Core
+{
+	class VulkanImage;
+
+	/// <summary>
+	/// Staging memory that does not fit in the ring buffer and is released with its batch
+	/// </summary>
+	struct UploadOverflowBuffer
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+	};
+
+	/// <summary>
+	/// Copy from the staging memory to a buffer, recorded when the batch is submitted
+	/// </summary>
+	struct UploadBufferCopy
+	{
+		VkBuffer source = VK_NULL_HANDLE;
+		VkBuffer destination = VK_NULL_HANDLE;
+		VkBufferCopy region{};
+	};
+
+	/// <summary>
+	/// Copy from the staging memory to an image, recorded when the batch is submitted
+	/// </summary>
+	struct UploadImageCopy
+	{
+		VkBuffer source = VK_NULL_HANDLE;
+		VkImage destination = VK_NULL_HANDLE;
+		VkBufferImageCopy region{};
+	};
+
+	/// <summary>
+	/// A command buffer recording copies and the fence signaled when the GPU executed them
+	/// With a dedicated transfer queue, a second command buffer acquires the resources on the graphics queue
+	/// </summary>
+	struct UploadBatch
+	{
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkCommandBuffer acquireCommandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+
+		// Signaled by the transfer submission and waited by the acquire submission
+		VkSemaphore semaphore = VK_NULL_HANDLE;
+
+		std::vector<UploadBufferCopy> bufferCopies;
+		std::vector<UploadImageCopy> imageCopies;
+
+		// Each group of barriers is flushed at once at submission: before the copies, after the copies, and on the graphics queue
+		VulkanBarrierBuilder preCopyBarriers;
+		VulkanBarrierBuilder postCopyBarriers;
+		VulkanBarrierBuilder acquireBarriers;
+
+		// Position of the ring head when the batch was submitted, the tail moves here once the batch is retired
+		VkDeviceSize ringEnd = 0;
+
+		std::vector<UploadOverflowBuffer> overflowBuffers;
+	};
+
+	class VulkanUploadManager : public IUploadManager
+	{
+	private:
+		IDevice* m_Device = nullptr;
+		VkDevice m_LogicalDevice = VK_NULL_HANDLE;
+
+		VkQueue m_TransferQueue = VK_NULL_HANDLE;
+		VkQueue m_GraphicsQueue = VK_NULL_HANDLE;
+
+		uint32_t m_TransferFamily = 0;
+		uint32_t m_GraphicsFamily = 0;
+
+		// Number of batches submitted since the creation of the manager
+		unsigned int m_SubmissionCount = 0;
+
+		// False when the GPU has no transfer only family, the uploads are then submitted on the graphics queue
+		bool m_DedicatedTransferQueue = false;
+
+		// Uploads go through a staging buffer of their own and a single time command buffer, see SetImmediateUploads
+		bool m_IsImmediate = false;
+
+		VkCommandPool m_CommandPool = VK_NULL_HANDLE;
+		VkCommandPool m_AcquireCommandPool = VK_NULL_HANDLE;
+
+		// Persistently mapped staging ring buffer
+		VkBuffer m_StagingBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory m_StagingMemory = VK_NULL_HANDLE;
+		unsigned char* m_StagingData = nullptr;
+
+		VkDeviceSize m_Capacity = 0;
+		VkDeviceSize m_Head = 0;
+		VkDeviceSize m_Tail = 0;
+
+		// Batch currently recorded, its command buffer is VK_NULL_HANDLE when no upload is pending
+		UploadBatch m_CurrentBatch;
+
+		// Batches submitted and not yet retired, in submission order
+		std::deque<UploadBatch> m_InFlightBatches;
+
+		// Retired batches kept to reuse their command buffer and fence
+		std::vector<UploadBatch> m_FreeBatches;
+
+		/// <summary>
+		/// Opens the current batch if needed and returns its command buffer
+		/// </summary>
+		/// <returns></returns>
+		VkCommandBuffer GetBatchCommandBuffer();
+
+		/// <summary>
+		/// Reserves space in the ring buffer, flushes and waits for older batches when the ring is full
+		/// </summary>
+		/// <param name="_Size">: Size of the data to copy </param>
+		/// <param name="_Alignment">: Alignment required by the copy command </param>
+		/// <param name="_Buffer">: Staging buffer where the data has to be written </param>
+		/// <param name="_Offset">: Offset of the reserved space in the staging buffer </param>
+		/// <returns>: Pointer where the data has to be written </returns>
+		unsigned char* AllocateStaging(VkDeviceSize _Size, VkDeviceSize _Alignment, VkBuffer& _Buffer, VkDeviceSize& _Offset);
+
+		/// <summary>
+		/// Tries to reserve space in the ring buffer without waiting
+		/// </summary>
+		const bool TryAllocateRing(VkDeviceSize _Size, VkDeviceSize _Alignment, VkDeviceSize& _Offset);
+
+		/// <summary>
+		/// Allocates the command buffers and the synchronization objects of a new batch
+		/// </summary>
+		/// <param name="_Batch">: Batch to fill </param>
+		/// <returns></returns>
+		const RHI_RESULT CreateBatch(UploadBatch& _Batch);
+
+		/// <summary>
+		/// Submits the current batch to the transfer queue, and its acquire part to the graphics queue
+		/// </summary>
+		void SubmitCurrentBatch();
+
+		/// <summary>
+		/// Releases the batches that the GPU finished
+		/// </summary>
+		/// <param name="_WaitOldest">: Blocks until the oldest batch is finished </param>
+		void RetireBatches(const bool _WaitOldest);
+
+		/// <summary>
+		/// Creates a staging buffer holding a copy of the data, destroyed by the caller once the copy is done
+		/// </summary>
+		/// <param name="_Data">: Data on the CPU </param>
+		/// <param name="_Size">: Size of the data </param>
+		/// <param name="_Staging">: Receives the staging buffer and its memory </param>
+		void CreateImmediateStaging(const void* _Data, VkDeviceSize _Size, UploadOverflowBuffer& _Staging);
+
+		void UploadToBufferImmediate(VkBuffer _Destination, const void* _Data, VkDeviceSize _Size, VkDeviceSize _DestinationOffset);
+		void UploadToImageImmediate(VulkanImage& _Image, VkFormat _Format, const void* _Data, VkDeviceSize _Size, uint32_t _Width, uint32_t _Height);
+
+	public:
+		~VulkanUploadManager() override;
+
+		const RHI_RESULT CreateUploadManager(IDevice* _Device, size_t _StagingSize) override;
+		const RHI_RESULT DestroyUploadManager(IDevice* _Device) override;
+
+		void FlushUploads(IDevice* _Device) override;
+		void WaitUploads(IDevice* _Device) override;
+
+		inline VulkanUploadManager* CastToVulkan() override { return this; }
+
+		inline unsigned int GetSubmissionCount() const override { return m_SubmissionCount; }
+
+		void SetImmediateUploads(const bool _IsImmediate) override;
+
+		/// <summary>
+		/// Copies data into a device local buffer through the staging ring
+		/// </summary>
+		/// <param name="_Destination">: Buffer receiving the data </param>
+		/// <param name="_Data">: Data on the CPU, it can be freed as soon as the method returns </param>
+		/// <param name="_Size">: Size of the data </param>
+		/// <param name="_DestinationOffset">: Offset in the destination buffer </param>
+		void UploadToBuffer(VkBuffer _Destination, const void* _Data, VkDeviceSize _Size, VkDeviceSize _DestinationOffset = 0);
+
+		/// <summary>
+		/// Copies pixels into an image and leaves it ready to be sampled by shaders
+		/// </summary>
+		/// <param name="_Image">: Image receiving the data, its layout must be undefined </param>
+		/// <param name="_Format">: Format of the image </param>
+		/// <param name="_Data">: Pixels on the CPU, they can be freed as soon as the method returns </param>
+		/// <param name="_Size">: Size of the pixels </param>
+		/// <param name="_Width">: Width of the image </param>
+		/// <param name="_Height">: Height of the image </param>
+		void UploadToImage(VulkanImage& _Image, VkFormat _Format, const void* _Data, VkDeviceSize _Size, uint32_t _Width, uint32_t _Height);
+	};
+}
\ No newline at end of file
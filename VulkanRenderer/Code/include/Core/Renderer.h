@@ -2,8 +2,28 @@
 
 #include "RHI/IRendererHardware.h"
 #include "RHI/RHITypes.h"
+#include "RHI/DeletionQueue.h"
+#include "RHI/PipelineStateCache.h"
+#include "RHI/ShaderArchive.h"
+#include "Threading/ThreadPool.h"
+#include "ShaderVariantSet.h"
+#include "FileSystem/FileWatcher.h"
 #include "Model.h"
 #include "Camera.h"
+#include "ClusterCuller.h"
+#include "ResourceManager.h"
+
+// Uncomment to cull the meshlets of the models on the CPU every frame, only their visible ranges are drawn
+//#define CLUSTER_CULLING
+
+// Uncomment to load the meshes in the compact vertex format, 16 bytes per vertex instead of 32, they are drawn with their own pipeline
+//#define COMPACT_VERTEX_FORMAT
+
+// Edited shaders are recompiled and swapped in while running, only in debug
+// The shader archive is not used with it, the shaders are always compiled from their sources
+#if !defined(NDEBUG) && defined(SHADER_RUNTIME_COMPILATION)
+#define SHADER_HOT_RELOAD
+#endif
 
 namespace Core
 {
@@ -22,6 +42,73 @@ namespace Core
 		static inline IPipeline* m_SimplePipeline = nullptr;
 		static inline ICommandAllocator* m_CommandAllocator = nullptr;
 		static inline IDescriptorAllocator* m_DescriptorAllocator = nullptr;
+		static inline IUploadManager* m_UploadManager = nullptr;
+		// Textures of the frame graph, recreated with the graph
+		IRenderGraphResources* m_FrameGraphResources = nullptr;
+		static inline ThreadPool* m_ThreadPool = nullptr;
+		static inline ResourceManager* m_ResourceManager = nullptr;
+
+		// Permutations of BasicShader.frag, the simple pipeline uses the default one
+		static inline ShaderVariantSet* m_BasicFragmentVariants = nullptr;
+		// Permutations of BasicShader.vert, one per vertex format, the simple pipeline uses the default one
+		static inline ShaderVariantSet* m_BasicVertexVariants = nullptr;
+		static inline PipelineDescription m_SimplePipelineDescription;
+
+		// Shaders baked by the ShaderBaker tool, null when the archive does not exist
+		static inline ShaderArchive* m_ShaderArchive = nullptr;
+
+		// Pipelines of the models with their own description, the simple pipeline is the fallback
+		static inline PipelineStateCache* m_PipelineStateCache = nullptr;
+		// Pipeline bound in the command buffer being recorded, avoids binding the same one again
+		IPipeline* m_BoundPipeline = nullptr;
+		// Ranges of the visible meshlets of the model being drawn, kept to reuse its memory
+		std::vector<Submesh> m_ClusterDraws;
+
+		// Drawn instead of the meshes and textures still loading
+		static inline IMesh* m_PlaceholderMesh = nullptr;
+		static inline ITexture* m_PlaceholderTexture = nullptr;
+
+		// Shader hot reload - the pipeline is rebuilt on the thread pool then swapped at the start of a frame
+		FileWatcher m_ShaderWatcher;
+		std::future<bool> m_ShaderReload;
+		std::chrono::steady_clock::time_point m_ShaderEditTime;
+		// Written by the reload job, read once m_ShaderReload is ready
+		ShaderVariantSet* m_ReloadedFragmentVariants = nullptr;
+		ShaderVariantSet* m_ReloadedVertexVariants = nullptr;
+		std::vector<std::filesystem::path> m_ReloadedShaderDependencies;
+		// Files the simple pipeline was compiled from, found by the includer, only their changes start a reload
+		std::vector<std::filesystem::path> m_ShaderDependencies;
+
+		/// <summary>
+		/// Swaps the reloaded pipeline when its job is done, starts a new reload when a shader it uses changed
+		/// </summary>
+		void UpdateShaderHotReload();
+
+		/// <summary>
+		/// Watches the directories of the shader dependencies, the includes can be outside of the shader directory
+		/// </summary>
+		void WatchShaderDependencies();
+
+		/// <summary>
+		/// Compiles the shaders of the simple pipeline and builds its replacement, executed by a worker
+		/// </summary>
+		/// <returns></returns>
+		const bool ReloadSimplePipeline();
+
+		/// <summary>
+		/// Gives their pipeline to the models with their own description or whose mesh is not in the default vertex format, starts its compilation
+		/// </summary>
+		void SetupModelPipelines();
+
+		/// <summary>
+		/// Creates the quad and the checkerboard drawn while the assets load
+		/// </summary>
+		void CreatePlaceholders();
+
+		/// <summary>
+		/// Requests the meshes and textures of the scene, they are drawn once the thread pool decoded them and a frame uploaded them
+		/// </summary>
+		void LoadSceneAssets();
 
 		std::vector<ICommandBuffer*> m_CommandBuffers;
 
@@ -32,22 +119,42 @@ namespace Core
 		unsigned int m_CurrentFrame = 0;
 		unsigned int imageIndex = 0;
 
+		// Number of frames submitted since the start, used to know when a deferred destruction is safe
+		static inline unsigned long long m_FrameNumber = 0;
+		static inline DeletionQueue m_DeletionQueue;
+
 	public:
-		IMesh* mesh = nullptr;
-		ITexture* texture = nullptr;
-		IMesh* mcMesh = nullptr;
-		ITexture* mctexture = nullptr;
+		MeshHandle mesh;
+		TextureHandle texture;
+		MeshHandle mcMesh;
+		TextureHandle mctexture;
 		static inline LowRenderer::Model model;
 		static inline LowRenderer::Model mcModel;
 
 		static inline const int MAX_FRAMES_IN_FLIGHT = 2;
+		static inline const size_t UPLOAD_STAGING_SIZE = 64 * 1024 * 1024;
+
+		// Vertex format the meshes of the scene are loaded in
+#ifdef COMPACT_VERTEX_FORMAT
+		static inline const VertexFormat MESH_VERTEX_FORMAT = RHI_VERTEX_FORMAT_COMPACT;
+#else
+		static inline const VertexFormat MESH_VERTEX_FORMAT = RHI_VERTEX_FORMAT_DEFAULT;
+#endif
 
 		static inline IRendererHardware* GetRHI() { return m_RHI; }
 		static inline RendererType GetRHIType() { return m_RendererType; }
 		static inline IDevice* GetDevice() { return m_Device; }
 		static inline ICommandAllocator* GetCommandAllocator() { return m_CommandAllocator; }
 		static inline IDescriptorAllocator* GetDescriptorAllocator() { return m_DescriptorAllocator; }
+		static inline IUploadManager* GetUploadManager() { return m_UploadManager; }
+		static inline ThreadPool* GetThreadPool() { return m_ThreadPool; }
+		static inline ResourceManager* GetResourceManager() { return m_ResourceManager; }
 		static inline IPipeline* GetPipeline() { return m_SimplePipeline; }
+		static inline PipelineStateCache* GetPipelineStateCache() { return m_PipelineStateCache; }
+		static inline const PipelineDescription& GetSimplePipelineDescription() { return m_SimplePipelineDescription; }
+		static inline ShaderVariantSet* GetBasicFragmentVariants() { return m_BasicFragmentVariants; }
+		static inline unsigned long long GetFrameNumber() { return m_FrameNumber; }
+		static inline size_t GetPendingDestructionCount() { return m_DeletionQueue.GetPendingCount(); }
 
 		Renderer() = default;
 
@@ -56,13 +163,66 @@ namespace Core
 		const bool Initialize(Window* _Window);
 		void CreateSimplePipeline();
 
+		/// <summary>
+		/// Loads and compiles a shader on the thread pool
+		/// </summary>
+		/// <param name="_Shader">: Shader created by the RHI, it must not be used before the future is ready </param>
+		/// <param name="_ResourcePath">: Path of the GLSL file </param>
+		/// <returns>Future telling if the shader has been compiled</returns>
+		static std::future<bool> LoadShaderAsync(IShader* _Shader, const std::filesystem::path& _ResourcePath);
+
+		/// <summary>
+		/// Copies the simple pipeline description for the vertex format of a mesh
+		/// </summary>
+		/// <param name="_Mesh">: Mesh drawn with the pipeline </param>
+		/// <returns>The vertex shader is null if its variant failed to compile</returns>
+		static PipelineDescription CreateMeshPipelineDescription(IMesh* _Mesh);
+
 		void StartFrame(Window* _Window, LowRenderer::Camera* _Camera);
 		void EndFrame(Window* _Window);
 
+		/// <summary>
+		/// Recreates the textures of the frame graph and gives its depth to the framebuffers of the swap chain, waits for the GPU
+		/// </summary>
+		/// <param name="_Graph">: Compiled frame graph </param>
+		/// <param name="_Depth">: Depth texture of the graph used by the textured model pass </param>
+		/// <returns></returns>
+		const bool CreateFrameGraphResources(const RenderGraph& _Graph, RenderGraphResource _Depth);
+
+		/// <summary>
+		/// Records barriers of the frame graph in the command buffer of the frame
+		/// </summary>
+		/// <param name="_Barriers">: Barriers given by the graph before a pass or at the end of the frame </param>
+		void RecordFrameGraphBarriers(const std::vector<RenderGraphBarrier>& _Barriers);
+
 		void SetupTexturedModelPass();
 		void TexturedModelPass(LowRenderer::Camera* _Camera, LowRenderer::Model* _Model);
 		void FinishTexturedModelPass();
 
 		const bool Terminate(LowRenderer::Camera* _Camera);
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// Deferred destruction related methods
+
+		///////////////////////////////////////////////////////////////////////
+
+		/// <summary>
+		/// Executes a destruction once all the frames in flight that could use the resource are finished
+		/// </summary>
+		/// <param name="_Destroy">: Destroys the resource </param>
+		static void DeferDestruction(const std::function<void()>& _Destroy);
+
+		/// <summary>
+		/// Unloads and deletes a mesh without waiting for the GPU
+		/// </summary>
+		/// <param name="_Mesh">: Mesh to destroy, it must not be used by the next frames </param>
+		static void DestroyMeshDeferred(IMesh* _Mesh);
+
+		/// <summary>
+		/// Unloads and deletes a texture without waiting for the GPU
+		/// </summary>
+		/// <param name="_Texture">: Texture to destroy, it must not be used by the next frames </param>
+		static void DestroyTextureDeferred(ITexture* _Texture);
 	};
 }
\ No newline at end of file
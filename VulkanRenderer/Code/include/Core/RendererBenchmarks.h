@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Renderer.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Core
+{
+	/// <summary>
+	/// Benchmarks and tests needing the device of the renderer, selected by their names on the command line of the renderer
+	/// The ones running on the CPU only are in the Benchmarks tool
+	/// </summary>
+	class RendererBenchmarks
+	{
+	private:
+		// Names given on the command line, nothing runs when it is empty
+		std::vector<std::string> m_Selected;
+
+		inline bool IsSelected(const char* _Name) const { return std::find(m_Selected.begin(), m_Selected.end(), _Name) != m_Selected.end(); }
+
+	public:
+		static inline const char* SHADER_COMPILATION = "shader_compilation";
+		static inline const char* SHADER_PERMUTATIONS = "shader_permutations";
+		static inline const char* GLTF_IMPORT = "gltf_import";
+		static inline const char* RESOURCE_DEDUPLICATION = "resource_deduplication";
+		static inline const char* ASYNC_LOADING = "async_loading";
+		static inline const char* UPLOAD_BATCHING = "upload_batching";
+		static inline const char* PIPELINE_STATE_CACHE = "pipeline_state_cache";
+		static inline const char* RESOURCE_CHURN = "resource_churn";
+
+		/// <summary>
+		/// Selects the benchmarks named by the arguments of the renderer
+		/// </summary>
+		/// <param name="_Argc">: Argument count of main </param>
+		/// <param name="_Argv">: Arguments of main, the first one is the executable </param>
+		/// <returns>False when a name is unknown</returns>
+		const bool Select(int _Argc, char** _Argv);
+
+		/// <summary>
+		/// Runs the selected benchmarks measured once, the renderer has to be initialized
+		/// </summary>
+		/// <param name="_Renderer">: Initialized renderer </param>
+		void RunStartup(Renderer& _Renderer);
+
+		/// <summary>
+		/// Runs the selected tests repeated every frame, before the frame starts
+		/// </summary>
+		/// <param name="_Renderer">: Renderer drawing the frame </param>
+		void RunFrame(Renderer& _Renderer);
+
+		/// <summary>
+		/// Compiles generated variants of a shader with 1, 2, 4, 8 and 16 threads and logs the times
+		/// </summary>
+		/// <param name="_ResourcePath">: GLSL file the variants are generated from </param>
+		/// <param name="_ShaderType">: Stage of the shader </param>
+		/// <param name="_VariantCount">: Number of variants compiled for each thread count </param>
+		static void BenchmarkShaderCompilation(const std::filesystem::path& _ResourcePath, ShaderType _ShaderType, unsigned int _VariantCount);
+
+		/// <summary>
+		/// Compiles all the variants of the basic fragment shader and measures the lookups
+		/// </summary>
+		/// <param name="_LookupCount">: Number of lookups timed </param>
+		static void BenchmarkShaderPermutations(unsigned int _LookupCount);
+
+		/// <summary>
+		/// Loads an OBJ file cold and from the mesh cache, writes it as a GLB in the default vertex format then imports the GLB, logs the times
+		/// </summary>
+		/// <param name="_ResourcePath">: OBJ file compared </param>
+		/// <param name="_RunCount">: Runs per format, the fastest is kept </param>
+		static void BenchmarkGltfImport(const std::filesystem::path& _ResourcePath, unsigned int _RunCount);
+
+		/// <summary>
+		/// Loads meshes and textures one after the other then decodes them on the thread pool and uploads them in batches, logs the times until they can all be drawn
+		/// </summary>
+		/// <param name="_MeshPaths">: OBJ or glTF files, cycled through </param>
+		/// <param name="_TexturePaths">: Images, cycled through </param>
+		/// <param name="_AssetCount">: Meshes and textures loaded by each run </param>
+		static void BenchmarkAsyncLoading(const std::vector<std::filesystem::path>& _MeshPaths, const std::vector<std::filesystem::path>& _TexturePaths, unsigned int _AssetCount);
+
+		/// <summary>
+		/// Uploads the same mesh many times with a staging buffer and a queue wait per buffer, then through the batches of the upload manager, logs both times
+		/// </summary>
+		/// <param name="_MeshPath">: OBJ or glTF file, decoded once </param>
+		/// <param name="_MeshCount">: Meshes uploaded by each run </param>
+		static void BenchmarkUploadBatching(const std::filesystem::path& _MeshPath, unsigned int _MeshCount);
+
+		/// <summary>
+		/// Requests a mesh and a texture under several spellings of their path, logs the loads and the upload submissions they cost
+		/// </summary>
+		/// <param name="_MeshPath">: OBJ file requested </param>
+		/// <param name="_TexturePath">: Image requested </param>
+		/// <param name="_RequestCount">: Requests of each resource </param>
+		static void TestResourceDeduplication(const std::filesystem::path& _MeshPath, const std::filesystem::path& _TexturePath, unsigned int _RequestCount);
+
+		/// <summary>
+		/// Gives a two sided version of the simple pipeline to a model, it is compiled in the background while the simple pipeline draws the model
+		/// </summary>
+		/// <param name="_Model">: Model drawn two sided </param>
+		static void TestPipelineStateCache(LowRenderer::Model& _Model);
+
+		/// <summary>
+		/// Replaces the mesh of a model and creates / destroys a texture every frame to stress the deferred destructions
+		/// </summary>
+		/// <param name="_Renderer">: Renderer whose second model is replaced </param>
+		static void StressTestResourceChurn(Renderer& _Renderer);
+	};
+}
\ No newline at end of file
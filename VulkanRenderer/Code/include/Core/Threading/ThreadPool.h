@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace Core
+{
+	/// <summary>
+	/// Fixed set of worker threads executing the jobs in submission order
+	/// </summary>
+	class ThreadPool
+	{
+	private:
+		std::vector<std::thread> m_Workers;
+		std::deque<std::function<void()>> m_Jobs;
+
+		std::mutex m_JobsMutex;
+		std::condition_variable m_JobsCondition;
+
+		bool m_IsStopping = false;
+
+		/// <summary>
+		/// Loop of a worker, takes jobs until the pool is stopped and the queue empty
+		/// </summary>
+		void WorkerLoop();
+
+	public:
+		/// <summary>
+		/// Starts the workers
+		/// </summary>
+		/// <param name="_ThreadCount">: Number of workers, 0 uses one worker per hardware thread except the main one </param>
+		ThreadPool(unsigned int _ThreadCount = 0);
+
+		/// <summary>
+		/// Finishes the jobs already submitted and joins the workers
+		/// </summary>
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/// <summary>
+		/// Queues a job
+		/// </summary>
+		/// <param name="_Job">: Function executed by a worker </param>
+		/// <returns>Future receiving the result of the job</returns>
+		template<typename Function>
+		auto Submit(Function&& _Job) -> std::future<decltype(_Job())>
+		{
+			using ReturnType = decltype(_Job());
+
+			// std::function needs a copyable callable, the packaged task is shared
+			std::shared_ptr<std::packaged_task<ReturnType()>> task = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<Function>(_Job));
+			std::future<ReturnType> future = task->get_future();
+
+			{
+				std::lock_guard<std::mutex> lock(m_JobsMutex);
+				m_Jobs.push_back([task]() { (*task)(); });
+			}
+
+			m_JobsCondition.notify_one();
+
+			return future;
+		}
+
+		/// <summary>
+		/// Runs a job for every index, the calling thread takes indices too
+		/// Never waits for a job still queued, so it can be called from a worker of the same pool
+		/// The first exception thrown by the job is rethrown once every index is done, the indices not started yet are skipped
+		/// </summary>
+		/// <param name="_Count">: Number of indices </param>
+		/// <param name="_Job">: Function called once per index, from any thread </param>
+		void ParallelFor(size_t _Count, const std::function<void(size_t)>& _Job);
+
+		inline unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_Workers.size()); }
+	};
+}
\ No newline at end of file
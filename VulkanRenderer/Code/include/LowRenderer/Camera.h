@@ -15,6 +15,9 @@ namespace LowRenderer
 	{
 	private:
 	public:
+		// Set and binding of UniformCameraData in the shaders
+		static inline const unsigned int DESCRIPTOR_SET = 1;
+		static inline const unsigned int DESCRIPTOR_BINDING = 0;
 
 		Math::Vector3 position = Math::Vector3(0.f, 0.f, -2.f);
 		Camera();
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MeshOptimizer.h"
+#include "Matrices/Matrix4.h"
+
+#include <vector>
+
+namespace LowRenderer
+{
+	/// <summary>
+	/// Meshlets tested and culled by a call of ClusterCuller::Cull
+	/// </summary>
+	struct ClusterCullingStatistics
+	{
+		unsigned int meshletCount = 0;
+		unsigned int frustumCulledCount = 0;
+		unsigned int backfaceCulledCount = 0;
+		// Draws left once the neighbouring visible meshlets are merged
+		unsigned int drawCount = 0;
+	};
+
+	/// <summary>
+	/// Frustum and eye of a camera in the space of a mesh
+	/// </summary>
+	struct ClusterCullingView
+	{
+		// Normalized planes a*x + b*y + c*z + d >= 0 inside: left, right, bottom, top, near, far
+		float planes[6][4] = {};
+		float eye[3] = { 0.f, 0.f, 0.f };
+		// 1 when the front faces have their normal towards the eye, -1 when the transforms mirror the mesh, 0 when back faces are drawn
+		float facing = 0.f;
+	};
+
+	/// <summary>
+	/// Culls the meshlets of a mesh on the CPU against the frustum and with their normal cone, the visible ones are drawn as ranges of the index buffer
+	/// </summary>
+	class ClusterCuller
+	{
+	public:
+
+		/// <summary>
+		/// Extracts the frustum and the eye from the matrix projecting the mesh
+		/// </summary>
+		/// <param name="_ClipFromModel">: Projection * view * model, in the order they are applied to a column vector </param>
+		/// <param name="_IsBackfaceCulled">: Whether the pipeline culls back faces, the normal cones are ignored otherwise </param>
+		/// <param name="_IsFrontFaceCounterClockwise">: Winding of the front faces in the pipeline </param>
+		/// <returns></returns>
+		static ClusterCullingView MakeView(Math::Matrix4 _ClipFromModel, bool _IsBackfaceCulled, bool _IsFrontFaceCounterClockwise);
+
+		/// <summary>
+		/// Keeps the meshlets inside the frustum with at least one triangle facing the eye
+		/// </summary>
+		/// <param name="_Meshlets">: Meshlets of the mesh </param>
+		/// <param name="_View">: Frustum and eye in the space of the mesh </param>
+		/// <param name="_Draws">: Receives the ranges to draw, consecutive visible meshlets are merged </param>
+		/// <param name="_Statistics">: Receives the culled meshlets, can be null </param>
+		static void Cull(const std::vector<Core::Meshlet>& _Meshlets, const ClusterCullingView& _View, std::vector<Core::Submesh>& _Draws, ClusterCullingStatistics* _Statistics = nullptr);
+	};
+}
\ No newline at end of file
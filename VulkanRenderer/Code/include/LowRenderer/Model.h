@@ -3,18 +3,46 @@
 #include "Object.h"
 #include "IMesh.h"
 #include "ITexture.h"
+#include "RHI/PipelineDescription.h"
 
 #include "Matrices/Matrix4.h"
 
+#include <optional>
+
+namespace Core
+{
+	class IPipeline;
+}
+
 namespace LowRenderer
 {
+	// Content of the uniform buffer of the model, std140 layout of UniformModelData in the vertex shader
+	struct ModelData
+	{
+		Math::Matrix4 modelMatrix = Math::Matrix4::identity;
+		// Identity unless the mesh is in a quantized vertex format
+		Core::VertexDequantization dequantization;
+	};
+
 	class Model : public Object
 	{
 	private:
 		Core::IMesh* m_Mesh;
 		Core::ITexture* m_Texture;
 
+		// Drawn with the simple pipeline when empty
+		std::optional<Core::PipelineDescription> m_PipelineDescription;
+		// Computed once when the description is set, the cache is looked up with it every frame
+		unsigned long long m_PipelineDescriptionHash = 0;
+
+		// Compiled pipeline of the description, kept once the cache has it so the next draws do not look it up
+		Core::IPipeline* m_Pipeline = nullptr;
+
 	public:
+		// Set and binding of UniformModelData in the shaders
+		static inline const unsigned int DESCRIPTOR_SET = 0;
+		static inline const unsigned int DESCRIPTOR_BINDING = 0;
+
 		Model() = default;
 		Model(Core::IMesh* _Mesh, Core::ITexture* _Texture);
 
@@ -24,6 +52,28 @@ namespace LowRenderer
 		inline void SetMesh(Core::IMesh* _Mesh) { m_Mesh = _Mesh; }
 		inline void SetTexture(Core::ITexture* _Texture) { m_Texture = _Texture; }
 
+		/// <summary>
+		/// Gives the pipeline used to draw the model, its shaders have to stay alive while the model is drawn
+		/// </summary>
+		/// <param name="_Description">: Description of the pipeline </param>
+		inline void SetPipelineDescription(const Core::PipelineDescription& _Description)
+		{
+			m_PipelineDescription = _Description;
+			m_PipelineDescriptionHash = _Description.ComputeHash();
+			m_Pipeline = nullptr;
+		}
+
+		inline const Core::PipelineDescription* GetPipelineDescription() const { return m_PipelineDescription.has_value() ? &m_PipelineDescription.value() : nullptr; }
+		inline unsigned long long GetPipelineDescriptionHash() const { return m_PipelineDescriptionHash; }
+
+		/// <summary>
+		/// Keeps the pipeline compiled for the description, it stays valid until the pipeline state cache is terminated
+		/// </summary>
+		/// <param name="_Pipeline">: Pipeline of the description </param>
+		inline void SetPipeline(Core::IPipeline* _Pipeline) { m_Pipeline = _Pipeline; }
+
+		inline Core::IPipeline* GetPipeline() const { return m_Pipeline; }
+
 		void DestroyDescriptors();
 
 		void Update() override;
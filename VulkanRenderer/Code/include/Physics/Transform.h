@@ -16,6 +16,9 @@ namespace Physics
 		Math::Vector3 m_Up = Math::Vector3::up;
 		Math::Vector3 m_Forward = Math::Vector3::forward;
 
+		// Transform the local one is relative to, null for a root
+		Transform* m_Parent = nullptr;
+
 
 	public:
 		bool isChanged = false;
@@ -29,6 +32,20 @@ namespace Physics
 
 		inline Math::Matrix4 GetLocalTRS() const { return m_LocalTRS; }
 
+		/// <summary>
+		/// Local matrix composed with the matrices of the parents, stored transposed like the local one
+		/// </summary>
+		/// <returns></returns>
+		Math::Matrix4 GetWorldTRS() const;
+
+		/// <summary>
+		/// Parent setter, the parent has to outlive the transform
+		/// </summary>
+		/// <param name="_Parent">: New parent, null to make the transform a root </param>
+		inline void SetParent(Transform* _Parent) { m_Parent = _Parent; }
+
+		inline Transform* GetParent() const { return m_Parent; }
+
 		/// <summary>
 		/// Position getter
 		/// </summary>
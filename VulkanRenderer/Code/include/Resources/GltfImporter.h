@@ -0,0 +1,222 @@
+#pragma once
+
+#include "RHI/RHITypes.h"
+#include "FileSystem/MappedFile.h"
+#include "FileSystem/JsonDocument.h"
+#include "MeshCache.h"
+#include "Transform.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	class IDevice;
+	class IMesh;
+	class IRendererHardware;
+	struct DecodedMesh;
+
+	/// <summary>
+	/// Node of an imported glTF scene
+	/// </summary>
+	struct GltfNode
+	{
+		std::string name;
+		// Index of the parent in the nodes of the scene, -1 for a root
+		int parent = -1;
+		// Local matrix of the node, its parent is the transform of the parent node
+		Physics::Transform transform;
+		// Shared by the nodes using the same glTF mesh, null when the node draws nothing
+		IMesh* mesh = nullptr;
+	};
+
+	/// <summary>
+	/// Meshes and node hierarchy of a glTF file, the nodes are never moved so their transforms can point to each other
+	/// </summary>
+	class GltfScene
+	{
+	private:
+		std::vector<IMesh*> m_Meshes;
+		std::vector<GltfNode> m_Nodes;
+
+		friend class GltfImporter;
+
+	public:
+		GltfScene() = default;
+
+		GltfScene(const GltfScene&) = delete;
+		GltfScene& operator=(const GltfScene&) = delete;
+
+		/// <summary>
+		/// Destroys the meshes and the nodes
+		/// </summary>
+		/// <param name="_RHI">: Renderer hardware the meshes were created with </param>
+		/// <param name="_Device">: Device owning the buffers </param>
+		void Unload(IRendererHardware* _RHI, IDevice* _Device);
+
+		inline const std::vector<IMesh*>& GetMeshes() const { return m_Meshes; }
+		inline std::vector<GltfNode>& GetNodes() { return m_Nodes; }
+	};
+
+	/// <summary>
+	/// Reads glTF 2.0 files, .glb or .gltf with external buffers, the binary buffers stay mapped in memory
+	/// Primitives whose accessors already match the layout of the mesh are uploaded straight from their buffer views
+	/// Only triangle lists are imported, materials, animations, skins and morph targets are ignored
+	/// </summary>
+	class GltfImporter
+	{
+	private:
+		// "glTF", "JSON" and "BIN\0" as little endian integers
+		static inline const uint32_t GLB_MAGIC_NUMBER = 0x46546C67;
+		static inline const uint32_t GLB_JSON_CHUNK = 0x4E4F534A;
+		static inline const uint32_t GLB_BIN_CHUNK = 0x004E4942;
+		static inline const uint32_t GLB_HEADER_SIZE = 12;
+		static inline const uint32_t GLB_CHUNK_HEADER_SIZE = 8;
+
+		// Data of the buffers, the binary chunk of a GLB or the files of a .gltf
+		struct Buffer
+		{
+			const unsigned char* data = nullptr;
+			size_t size = 0;
+		};
+
+		struct BufferView
+		{
+			const unsigned char* data = nullptr;
+			size_t size = 0;
+			// 0 when the elements are tightly packed
+			size_t stride = 0;
+		};
+
+		// Elements of an accessor, checked to fit in their buffer view
+		struct Accessor
+		{
+			int bufferView = -1;
+			const unsigned char* data = nullptr;
+			size_t byteOffset = 0;
+			size_t count = 0;
+			size_t stride = 0;
+			uint32_t componentType = 0;
+			uint32_t componentCount = 0;
+			bool isNormalized = false;
+		};
+
+		std::filesystem::path m_Path;
+
+		MappedFile m_File;
+		// Files of the external buffers of a .gltf
+		std::vector<std::unique_ptr<MappedFile>> m_BufferFiles;
+
+		JsonDocument m_Document;
+		std::vector<Buffer> m_Buffers;
+		std::vector<BufferView> m_BufferViews;
+
+		const bool ReadBufferViews();
+		const bool GetAccessor(int _Index, Accessor& _Accessor) const;
+
+		/// <summary>
+		/// Reads an element of an accessor as floats, normalized integers are mapped to [0, 1] or [-1, 1]
+		/// </summary>
+		/// <param name="_Accessor">: Accessor read </param>
+		/// <param name="_Element">: Index of the element </param>
+		/// <param name="_Values">: Receives the components </param>
+		/// <param name="_ValueCount">: Components written, the missing ones are left as they are </param>
+		static void ReadFloats(const Accessor& _Accessor, size_t _Element, float* _Values, uint32_t _ValueCount);
+		static uint32_t ReadIndex(const Accessor& _Accessor, size_t _Element);
+
+		/// <summary>
+		/// Gives the streams of a mesh whose primitives all read one interleaved buffer view laid out like the vertex format
+		/// </summary>
+		/// <param name="_Mesh">: glTF mesh </param>
+		/// <param name="_VertexFormat">: Format of the vertex buffer </param>
+		/// <param name="_Submeshes">: Receives one submesh per primitive </param>
+		/// <param name="_Meshlets">: Receives the clusters of the primitives </param>
+		/// <param name="_Streams">: Receives the streams pointing in the buffer views </param>
+		/// <returns>false if a primitive needs a conversion</returns>
+		const bool GetDirectStreams(const JsonValue& _Mesh, VertexFormat _VertexFormat, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const;
+
+		/// <summary>
+		/// Converts the attributes of the primitives to the vertex format
+		/// </summary>
+		/// <param name="_Mesh">: glTF mesh </param>
+		/// <param name="_VertexFormat">: Format of the vertex buffer </param>
+		/// <param name="_VertexData">: Receives the interleaved stream </param>
+		/// <param name="_ColorData">: Receives the color stream </param>
+		/// <param name="_Indices">: Receives the indices, relative to their submesh </param>
+		/// <param name="_ShortIndices">: Receives the indices converted when they fit in 16 bits </param>
+		/// <param name="_Submeshes">: Receives one submesh per primitive </param>
+		/// <param name="_Meshlets">: Receives the clusters of the primitives </param>
+		/// <param name="_Streams">: Receives the streams pointing in the arrays </param>
+		/// <returns></returns>
+		const bool ConvertStreams(const JsonValue& _Mesh, VertexFormat _VertexFormat, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData,
+			std::vector<uint32_t>& _Indices, std::vector<uint16_t>& _ShortIndices, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const;
+
+		/// <summary>
+		/// Reads the local matrix of a node, written transposed like the matrices of the transforms
+		/// </summary>
+		/// <param name="_Node">: glTF node </param>
+		/// <param name="_Transform">: Receives the matrix, and the position, rotation and scale when the node gives them </param>
+		static void ReadNodeTransform(const JsonValue& _Node, Physics::Transform& _Transform);
+
+	public:
+		GltfImporter() = default;
+
+		GltfImporter(const GltfImporter&) = delete;
+		GltfImporter& operator=(const GltfImporter&) = delete;
+
+		/// <summary>
+		/// Maps a .glb or .gltf file and its buffers then parses its JSON
+		/// </summary>
+		/// <param name="_Path">: Path of the file </param>
+		/// <returns>false if the file is not valid glTF 2.0</returns>
+		const bool Open(const std::filesystem::path& _Path);
+
+		/// <summary>
+		/// Unmaps the file and its buffers
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// Reads the streams of a mesh on the CPU, they point in the buffer views of the importer when no conversion is needed
+		/// </summary>
+		/// <param name="_VertexFormat">: Format the vertices are converted to </param>
+		/// <param name="_MeshIndex">: Index of the glTF mesh </param>
+		/// <param name="_Decoded">: Receives the streams and the arrays of a conversion, the importer has to outlive it </param>
+		/// <param name="_IsDirect">: Receives whether the buffer views are used without conversion, can be null </param>
+		/// <returns></returns>
+		const bool DecodeMesh(VertexFormat _VertexFormat, size_t _MeshIndex, DecodedMesh& _Decoded, bool* _IsDirect = nullptr);
+
+		/// <summary>
+		/// Creates the buffers of a mesh, its primitives become the submeshes
+		/// </summary>
+		/// <param name="_Mesh">: Mesh receiving the buffers, in the vertex format it was given </param>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_MeshIndex">: Index of the glTF mesh </param>
+		/// <param name="_IsDirect">: Receives whether the buffer views were uploaded without conversion, can be null </param>
+		/// <returns></returns>
+		const bool LoadMesh(IMesh* _Mesh, IDevice* _Device, size_t _MeshIndex, bool* _IsDirect = nullptr);
+
+		/// <summary>
+		/// Imports every mesh and node of the file, the parents of the transforms follow the hierarchy of the nodes
+		/// </summary>
+		/// <param name="_RHI">: Renderer hardware creating the meshes </param>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_VertexFormat">: Format of the meshes </param>
+		/// <param name="_Scene">: Receives the meshes and the nodes </param>
+		/// <returns></returns>
+		const bool ImportScene(IRendererHardware* _RHI, IDevice* _Device, VertexFormat _VertexFormat, GltfScene& _Scene);
+
+		inline size_t GetMeshCount() const { return m_Document.GetRoot()["meshes"].GetSize(); }
+
+		/// <summary>
+		/// Writes a mesh as a GLB whose buffer views are laid out like the default vertex format, one primitive per submesh
+		/// </summary>
+		/// <param name="_Path">: Path of the GLB file </param>
+		/// <param name="_Streams">: Streams in the default vertex format </param>
+		/// <returns></returns>
+		static const bool WriteGlb(const std::filesystem::path& _Path, const MeshStreams& _Streams);
+	};
+}
\ No newline at end of file
@@ -3,21 +3,115 @@
 #include "IResource.h"
 
 #include "RHI/Vertex.h"
+#include "MeshOptimizer.h"
+#include "MeshCache.h"
+
+#include <atomic>
+#include <memory>
+
+// Uncomment to log the simulated vertex cache and vertex fetch efficiency of every mesh before and after its optimization
+//#define MESH_OPTIMIZATION_STATISTICS
 
 namespace Core 
 {
 	class VulkanMesh;
+	class GltfImporter;
+
+	/// <summary>
+	/// CPU side of a mesh load, decoded on any thread then uploaded by the thread recording the copies
+	/// </summary>
+	struct DecodedMesh
+	{
+		MeshStreams streams;
+
+		// Memory the streams point in: the mapped cache entry, the mapped glTF buffers or the arrays of an import
+		MeshCache cache;
+		std::unique_ptr<GltfImporter> importer;
+		std::vector<uint8_t> vertexData;
+		std::vector<uint8_t> colorData;
+		std::vector<uint32_t> indices;
+		std::vector<uint16_t> shortIndices;
+		std::vector<Submesh> submeshes;
+		std::vector<Meshlet> meshlets;
+
+		DecodedMesh();
+		~DecodedMesh();
+	};
 
 	class IMesh : public IResource
 	{
-	private:
+	protected:
+		// Layout the vertices are converted to, the pipelines drawing the mesh must use the same format
+		VertexFormat p_VertexFormat = RHI_VERTEX_FORMAT_DEFAULT;
+		// Given to the vertex shader to read the quantized positions and texture coordinates back
+		VertexDequantization p_Dequantization;
+
+		// Drawn one after the other, a single submesh covers the whole index buffer unless the mesh was split for 16 bits indices
+		std::vector<Submesh> p_Submeshes;
+		IndexType p_IndexType = RHI_INDEX_UINT32;
+		MeshBounds p_Bounds;
+		// Clusters of the submeshes culled one by one, empty when the mesh was created from lists of vertices and indices
+		std::vector<Meshlet> p_Meshlets;
+
+		// Bytes of the vertex streams and of the index buffer on the GPU
+		size_t p_VertexMemorySize = 0;
+		size_t p_IndexMemorySize = 0;
+
+		// Index memory saved by the 16 bits indices minus the vertices duplicated to split meshes, for all the meshes loaded
+		static inline std::atomic<long long> p_SavedIndexMemory = 0;
+
+		/// <summary>
+		/// Imports the OBJ file then welds, optimizes and encodes its vertices and indices
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the 3D model </param>
+		/// <param name="_VertexData">: Receives the interleaved stream </param>
+		/// <param name="_ColorData">: Receives the color stream </param>
+		/// <param name="_Indices">: Receives the indices, relative to their submesh </param>
+		/// <param name="_ShortIndices">: Receives the indices converted when they fit in 16 bits </param>
+		/// <param name="_Submeshes">: Receives the ranges of the indices </param>
+		/// <param name="_Meshlets">: Receives the clusters of the submeshes </param>
+		/// <param name="_Streams">: Receives the streams pointing in the arrays </param>
+		/// <returns></returns>
+		const bool Import(const std::filesystem::path& _ResourcePath, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData, std::vector<uint32_t>& _Indices,
+			std::vector<uint16_t>& _ShortIndices, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const;
+
+		/// <summary>
+		/// Converts the indices to 16 bits when they all fit
+		/// </summary>
+		/// <param name="_Indices">: Triangle list </param>
+		/// <param name="_ShortIndices">: Receives the converted indices, left empty when they do not fit </param>
+		/// <returns>Type of the indices to upload</returns>
+		static IndexType ShrinkIndices(const std::vector<uint32_t>& _Indices, std::vector<uint16_t>& _ShortIndices);
+
 	public:
+		// Indices of the meshes with more vertices do not fit in 16 bits
+		static inline const size_t MAX_SHORT_INDEX_VERTEX_COUNT = 65536;
+		// Cache miss ratio the overdraw order may add to the cache order, relative to it
+		static inline const float OVERDRAW_CACHE_THRESHOLD = 1.05f;
+
 		/// <summary>
-		/// Loads a 3D model with TINY OBJ specified with a path
+		/// Decodes then uploads the mesh
 		/// </summary>
 		/// <param name="_ResourcePath">: Path of the 3D model </param>
 		/// <returns></returns>
 		const bool Load(Core::IDevice* _Device, std::filesystem::path _ResourcePath) override;
+
+		/// <summary>
+		/// Reads the first mesh of a glTF file, or reads an OBJ file from the mesh cache and imports it then writes its cache entry on a miss
+		/// Touches neither the GPU nor the mesh, so meshes can be decoded on several threads at once
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the 3D model </param>
+		/// <param name="_Decoded">: Receives the streams in the vertex format of the mesh </param>
+		/// <returns></returns>
+		const bool Decode(const std::filesystem::path& _ResourcePath, DecodedMesh& _Decoded) const;
+
+		/// <summary>
+		/// Creates the buffers of a decoded mesh, on the thread owning the upload manager
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_Decoded">: Streams given by Decode </param>
+		/// <returns></returns>
+		const bool Upload(Core::IDevice* _Device, const DecodedMesh& _Decoded);
 		
 		/// <summary>
 		/// Unloads the 3D model
@@ -27,9 +121,69 @@ namespace Core
 		
 		virtual VulkanMesh* CastToVulkan() = 0;
 
-		virtual RHI_RESULT CreateVertexBuffer(Core::IDevice* _Device, std::vector<Vertex>& _VerticesList) = 0;
-		virtual RHI_RESULT CreateIndexBuffer(Core::IDevice* _Device, std::vector<uint32_t>& _IndicesList) = 0;
+		/// <summary>
+		/// Creates the buffers of the streams and keeps their description
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_Streams">: Imported, cached or glTF streams </param>
+		/// <returns></returns>
+		RHI_RESULT CreateBuffers(Core::IDevice* _Device, const MeshStreams& _Streams);
+
+		/// <summary>
+		/// Converts the vertices to the layout of the mesh then creates its vertex streams
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_VerticesList">: Imported vertices </param>
+		/// <param name="_Statistics">: Receives the quantization errors, they are not measured when null </param>
+		/// <returns></returns>
+		RHI_RESULT CreateVertexBuffer(Core::IDevice* _Device, const std::vector<Vertex>& _VerticesList, VertexEncodingStatistics* _Statistics = nullptr);
+
+		/// <summary>
+		/// Creates the buffers of vertices already encoded
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffers </param>
+		/// <param name="_VertexData">: Interleaved stream </param>
+		/// <param name="_VertexDataSize">: Size of the interleaved stream in bytes </param>
+		/// <param name="_ColorData">: Color stream, null when the layout has none </param>
+		/// <param name="_ColorDataSize">: Size of the color stream in bytes </param>
+		/// <returns></returns>
+		virtual RHI_RESULT CreateVertexStreams(Core::IDevice* _Device, const void* _VertexData, size_t _VertexDataSize, const void* _ColorData, size_t _ColorDataSize) = 0;
+
+		/// <summary>
+		/// Creates the index buffer with 16 bits indices when they all fit
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffer </param>
+		/// <param name="_IndicesList">: Triangle list </param>
+		/// <param name="_Submeshes">: Ranges drawn with their own vertex offset, empty to draw all the indices at once </param>
+		/// <returns></returns>
+		RHI_RESULT CreateIndexBuffer(Core::IDevice* _Device, const std::vector<uint32_t>& _IndicesList, const std::vector<Submesh>& _Submeshes = {});
+
+		/// <summary>
+		/// Creates the buffer of indices already converted
+		/// </summary>
+		/// <param name="_Device">: Device creating the buffer </param>
+		/// <param name="_Indices">: First index </param>
+		/// <param name="_IndexCount">: Number of indices </param>
+		/// <param name="_IndexType">: Size of an index </param>
+		/// <returns></returns>
+		virtual RHI_RESULT CreateIndexStream(Core::IDevice* _Device, const void* _Indices, size_t _IndexCount, IndexType _IndexType) = 0;
 		
 		virtual RHI_RESULT DestroyBuffers(Core::IDevice* _Device) = 0;
+
+		/// <summary>
+		/// Chooses the layout of the vertices, has to be called before they are loaded
+		/// </summary>
+		/// <param name="_VertexFormat">: Format of the vertex buffers </param>
+		inline void SetVertexFormat(VertexFormat _VertexFormat) { p_VertexFormat = _VertexFormat; }
+
+		inline VertexFormat GetVertexFormat() const { return p_VertexFormat; }
+		inline const VertexDequantization& GetDequantization() const { return p_Dequantization; }
+		inline const std::vector<Submesh>& GetSubmeshes() const { return p_Submeshes; }
+		inline IndexType GetIndexType() const { return p_IndexType; }
+		inline const MeshBounds& GetBounds() const { return p_Bounds; }
+		inline const std::vector<Meshlet>& GetMeshlets() const { return p_Meshlets; }
+		inline size_t GetMemorySize() const { return p_VertexMemorySize + p_IndexMemorySize; }
+
+		static inline long long GetSavedIndexMemory() { return p_SavedIndexMemory; }
 	};
 }
\ No newline at end of file
@@ -7,10 +7,22 @@
 
 namespace Core
 {
+	enum ResourceState
+	{
+		// Decoded on a worker or waiting for its upload, a placeholder is drawn instead
+		RESOURCE_LOADING,
+		RESOURCE_READY,
+		RESOURCE_FAILED
+	};
+
 	class IResource
 	{
 	private:
 
+	protected:
+		// Resources loaded synchronously or created from memory are ready as soon as they exist
+		ResourceState p_State = RESOURCE_READY;
+
 	public:
 		/// <summary>
 		/// Loads a resource specified by a path
@@ -24,5 +36,9 @@ namespace Core
 		/// </summary>
 		/// <returns></returns>
 		virtual const bool Unload(Core::IDevice* _Device) = 0;
+
+		inline void SetState(ResourceState _State) { p_State = _State; }
+		inline ResourceState GetState() const { return p_State; }
+		inline bool IsReady() const { return p_State == RESOURCE_READY; }
 	};
 }
\ No newline at end of file
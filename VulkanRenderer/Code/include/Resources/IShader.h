@@ -2,6 +2,11 @@
 
 #include "IResource.h"
 #include "RHI/RHITypes.h"
+#include "RHI/ShaderReflection.h"
+#include "FileSystem/SourceFileCache.h"
+
+// SHADER_RUNTIME_COMPILATION is defined by the project with shaderc linked, set ShaderRuntimeCompilation to false in VulkanRenderer.vcxproj
+// to only load the shaders baked by the ShaderBaker tool
 
 namespace Core
 {
@@ -9,7 +14,22 @@ namespace Core
 
 	class IShader : public IResource
 	{
-	private:
+	protected:
+		// Macros defined before the compilation, "NAME" or "NAME=VALUE"
+		std::vector<std::string> p_MacroDefinitions;
+
+		// Interface read from the SPIR-V of the last compilation
+		ShaderReflection p_Reflection;
+
+		// Identifies the compiled code, stable between runs
+		unsigned long long p_CodeHash = 0;
+
+		// GLSL file compiled, includes are resolved from its directory
+		std::filesystem::path p_SourcePath;
+
+		// Files the last compilation read, the GLSL file first then its includes
+		std::vector<SourceDependency> p_Dependencies;
+
 	public:
 		/// <summary>
 		/// Loads a GLSL shader specified with a path
@@ -34,6 +54,23 @@ namespace Core
 		/// <returns></returns>
 		virtual const bool CompileShader(Core::IDevice* _Device, const char* _ShaderName, std::string _ShaderSourceCode, Core::ShaderType _ShaderType) = 0;
 
+		/// <summary>
+		/// Creates the shader module from SPIR-V already compiled, the reflection is not read from it
+		/// </summary>
+		/// <param name="_Device">: Device creating the shader module </param>
+		/// <param name="_Code">: SPIR-V words, only read during the call </param>
+		/// <param name="_WordCount">: Number of words </param>
+		/// <returns></returns>
+		virtual const bool CreateFromSpirV(Core::IDevice* _Device, const uint32_t* _Code, size_t _WordCount) = 0;
+
+		/// <summary>
+		/// Creates the shader from the main shader archive with the macros already defined
+		/// </summary>
+		/// <param name="_Device">: Device creating the shader module </param>
+		/// <param name="_Name">: File name of the GLSL source </param>
+		/// <returns>false if there is no archive or the shader is not in it</returns>
+		const bool LoadFromArchive(Core::IDevice* _Device, const std::string& _Name);
+
 		/// <summary>
 		/// 
 		/// </summary>
@@ -41,6 +78,40 @@ namespace Core
 		/// <returns></returns>
 		virtual RHI_RESULT DestroyShaderModule(Core::IDevice* _Device) = 0;
 
+		/// <summary>
+		/// Defines a macro for the next compilations of the shader
+		/// </summary>
+		/// <param name="_Name">: Name of the macro </param>
+		/// <param name="_Value">: Value of the macro, can be empty </param>
+		inline void AddMacroDefinition(const std::string& _Name, const std::string& _Value = "") { p_MacroDefinitions.push_back(_Value.empty() ? _Name : _Name + "=" + _Value); }
+
+		inline const std::vector<std::string>& GetMacroDefinitions() const { return p_MacroDefinitions; }
+
+		inline const ShaderReflection& GetReflection() const { return p_Reflection; }
+
+		inline unsigned long long GetCodeHash() const { return p_CodeHash; }
+
+		inline void SetSourcePath(const std::filesystem::path& _SourcePath) { p_SourcePath = _SourcePath; }
+		inline const std::filesystem::path& GetSourcePath() const { return p_SourcePath; }
+
+		inline const std::vector<SourceDependency>& GetDependencies() const { return p_Dependencies; }
+
+		/// <summary>
+		/// Deduces the stage of a shader from its extension
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the GLSL file </param>
+		/// <param name="_ShaderType">: Filled with the stage </param>
+		/// <returns></returns>
+		static const bool GetShaderType(const std::filesystem::path& _ResourcePath, Core::ShaderType& _ShaderType);
+
+		/// <summary>
+		/// Reads the GLSL source of a shader through the SourceFileCache
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the GLSL file </param>
+		/// <param name="_ShaderCode">: Receives the source </param>
+		/// <returns></returns>
+		static const bool ReadShaderSource(const std::filesystem::path& _ResourcePath, std::string& _ShaderCode);
+
 		virtual VulkanShader* CastToVulkan() = 0;
 	};
 }
\ No newline at end of file
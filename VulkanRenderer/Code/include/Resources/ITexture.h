@@ -4,19 +4,39 @@
 
 #include "RHI/RHITypes/RHIResult.h"
 
+#include <memory>
+#include <vector>
+
 namespace Core
 {
 	class IDescriptor;
 	class VulkanTexture;
 
+	/// <summary>
+	/// CPU side of a texture load, decoded on any thread then uploaded by the thread recording the copies
+	/// </summary>
+	struct DecodedTexture
+	{
+		// RGBA8 pixels allocated by STB Image
+		std::unique_ptr<unsigned char, void(*)(void*)> pixels = { nullptr, nullptr };
+		int width = 0;
+		int height = 0;
+	};
+
 	class ITexture : public IResource
 	{
 	private:
 
 	protected:
 		std::vector<IDescriptor*> p_Descriptors;
+		// Bytes of the image on the GPU
+		size_t p_MemorySize = 0;
 
 	public:
+		// Set and binding of the sampler in the fragment shaders
+		static inline const unsigned int DESCRIPTOR_SET = 2;
+		static inline const unsigned int DESCRIPTOR_BINDING = 0;
+
 		/// <summary>
 		/// Loads a texture with STB Image specified with a path
 		/// </summary>
@@ -24,6 +44,24 @@ namespace Core
 		/// <returns></returns>
 		virtual const bool Load(IDevice* _Device, std::filesystem::path _ResourcePath);
 
+		/// <summary>
+		/// Reads an image with STB Image, can run on several threads at once
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the image </param>
+		/// <param name="_Decoded">: Receives the pixels </param>
+		/// <returns></returns>
+		static const bool Decode(const std::filesystem::path& _ResourcePath, DecodedTexture& _Decoded);
+
+		/// <summary>
+		/// Creates the image and its descriptors, on the thread owning the upload manager
+		/// </summary>
+		/// <param name="_Device">: Device creating the image </param>
+		/// <param name="_Pixels">: RGBA8 pixels </param>
+		/// <param name="_Width">: Width in pixels </param>
+		/// <param name="_Height">: Height in pixels </param>
+		/// <returns></returns>
+		const bool Upload(IDevice* _Device, unsigned char* _Pixels, int _Width, int _Height);
+
 		/// <summary>
 		/// Unloads the 3D model
 		/// </summary>
@@ -35,6 +73,7 @@ namespace Core
 		virtual RHI_RESULT DestroyTexture(IDevice* _Device) = 0;
 
 		inline IDescriptor* GetDescriptor(unsigned int _CurrentFrame) { return p_Descriptors[_CurrentFrame]; }
+		inline size_t GetMemorySize() const { return p_MemorySize; }
 
 		void DestroyDescriptor();
 
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "RHI/RHITypes.h"
+#include "RHI/VertexLayout.h"
+#include "FileSystem/MappedFile.h"
+#include "MeshOptimizer.h"
+
+#include <cstdint>
+#include <atomic>
+#include <filesystem>
+
+namespace Core
+{
+	// Layout of a cached mesh, every offset is from the start of the file and every block is 8 bytes aligned
+	// Header | Submeshes | LODs | Vertex stream | Color stream | Indices | Meshlets
+	// Streams are stored encoded like the GPU buffers, they go from the mapped file to the staging memory without any conversion
+
+	struct MeshCacheHeader
+	{
+		uint32_t magic = 0;
+		uint32_t version = 0;
+
+		// Source the mesh was imported from, the entry stays valid while the size and the write time match or the content hashes the same
+		uint64_t sourceSize = 0;
+		int64_t sourceWriteTime = 0;
+		uint64_t sourceHash = 0;
+
+		uint32_t vertexFormat = 0;
+		uint32_t indexType = 0;
+		uint32_t vertexCount = 0;
+		uint32_t vertexStride = 0;
+		uint32_t colorStride = 0;
+		uint32_t indexCount = 0;
+		uint32_t submeshCount = 0;
+		uint32_t lodCount = 0;
+		// Added when the mesh was split for 16 bits indices
+		uint32_t duplicatedVertexCount = 0;
+		uint32_t meshletCount = 0;
+
+		MeshBounds bounds;
+		VertexDequantization dequantization;
+
+		// Time the import took, logged next to the time of the cached load
+		double importTime = 0.0;
+
+		uint64_t submeshOffset = 0;
+		uint64_t lodOffset = 0;
+		uint64_t vertexOffset = 0;
+		uint64_t colorOffset = 0;
+		uint64_t indexOffset = 0;
+		uint64_t meshletOffset = 0;
+	};
+
+	/// <summary>
+	/// Submeshes drawn at a level of detail, the import only produces the full detail one
+	/// </summary>
+	struct MeshLod
+	{
+		uint32_t firstSubmesh = 0;
+		uint32_t submeshCount = 0;
+		// Distance to the full detail surface in the units of the mesh, 0 for the full detail
+		float error = 0.f;
+		uint32_t reserved = 0;
+	};
+
+	/// <summary>
+	/// Everything the GPU buffers of a mesh are created from, points either in the imported arrays or in a mapped cache entry
+	/// </summary>
+	struct MeshStreams
+	{
+		VertexFormat vertexFormat = RHI_VERTEX_FORMAT_DEFAULT;
+		VertexDequantization dequantization;
+		MeshBounds bounds;
+
+		const void* vertexData = nullptr;
+		size_t vertexDataSize = 0;
+		uint32_t vertexCount = 0;
+		// Null when the layout has no color stream
+		const void* colorData = nullptr;
+		size_t colorDataSize = 0;
+
+		const void* indexData = nullptr;
+		size_t indexCount = 0;
+		IndexType indexType = RHI_INDEX_UINT32;
+
+		const Submesh* submeshes = nullptr;
+		size_t submeshCount = 0;
+		const MeshLod* lods = nullptr;
+		size_t lodCount = 0;
+		// Clusters of the submeshes, none when the mesh was not split
+		const Meshlet* meshlets = nullptr;
+		size_t meshletCount = 0;
+
+		uint32_t duplicatedVertexCount = 0;
+		double importTime = 0.0;
+	};
+
+	/// <summary>
+	/// On-disk cache of imported meshes, written on the first import then mapped in memory on the next loads
+	/// Files are named after a hash of the path of the source and of the vertex format
+	/// </summary>
+	class MeshCache
+	{
+	private:
+		// "MESH"
+		static inline const uint32_t CACHE_MAGIC_NUMBER = 0x4853454D;
+		// Bumped when the layout of the entries or the import changes
+		static inline const uint32_t CACHE_FORMAT_VERSION = 2;
+
+		static inline std::filesystem::path m_CacheDirectory = "Cache/Meshes";
+
+		// Meshes can be loaded by several threads at once
+		static inline std::atomic<unsigned int> m_HitCount = 0;
+		static inline std::atomic<unsigned int> m_MissCount = 0;
+
+		MappedFile m_File;
+
+		static std::filesystem::path GetEntryPath(const std::filesystem::path& _SourcePath, VertexFormat _VertexFormat);
+
+		/// <summary>
+		/// Size and last write time of the source
+		/// </summary>
+		/// <param name="_SourcePath">: Path of the source </param>
+		/// <param name="_Size">: Receives the size in bytes </param>
+		/// <param name="_WriteTime">: Receives the write time in the ticks of the file clock </param>
+		/// <returns>false if the source does not exist</returns>
+		static const bool GetSourceStatus(const std::filesystem::path& _SourcePath, uint64_t& _Size, int64_t& _WriteTime);
+
+		/// <summary>
+		/// Hashes the content of the source with FNV-1a
+		/// </summary>
+		/// <param name="_SourcePath">: Path of the source </param>
+		/// <param name="_Hash">: Receives the hash </param>
+		/// <returns>false if the source cannot be read</returns>
+		static const bool HashSource(const std::filesystem::path& _SourcePath, uint64_t& _Hash);
+
+	public:
+		MeshCache() = default;
+
+		MeshCache(const MeshCache&) = delete;
+		MeshCache& operator=(const MeshCache&) = delete;
+
+		/// <summary>
+		/// Maps the entry of a mesh and checks it against its source, the source is only hashed when its write time changed
+		/// </summary>
+		/// <param name="_SourcePath">: Path of the OBJ file </param>
+		/// <param name="_VertexFormat">: Format the vertices are encoded in </param>
+		/// <param name="_Streams">: Receives the streams, they point in the mapped file until Close </param>
+		/// <returns>false if there is no valid entry</returns>
+		const bool Open(const std::filesystem::path& _SourcePath, VertexFormat _VertexFormat, MeshStreams& _Streams);
+
+		void Close();
+
+		/// <summary>
+		/// Writes the entry of a mesh, the temporary file is renamed so a partial write is never read
+		/// </summary>
+		/// <param name="_SourcePath">: Path of the OBJ file </param>
+		/// <param name="_Streams">: Streams created from the import </param>
+		/// <returns></returns>
+		static const bool Store(const std::filesystem::path& _SourcePath, const MeshStreams& _Streams);
+
+		static inline void SetCacheDirectory(const std::filesystem::path& _Directory) { m_CacheDirectory = _Directory; }
+		static inline const std::filesystem::path& GetCacheDirectory() { return m_CacheDirectory; }
+
+		static inline unsigned int GetHitCount() { return m_HitCount; }
+		static inline unsigned int GetMissCount() { return m_MissCount; }
+	};
+}
\ No newline at end of file
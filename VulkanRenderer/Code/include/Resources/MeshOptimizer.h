@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Core
+{
+	/// <summary>
+	/// Result of the post-transform cache simulation of an index buffer
+	/// </summary>
+	struct VertexCacheStatistics
+	{
+		unsigned int triangleCount = 0;
+		// Vertices referenced by the indices
+		unsigned int vertexCount = 0;
+		// Vertices missed in the cache, each one is shaded again
+		unsigned int transformCount = 0;
+		// Average cache miss ratio, transforms per triangle, 0.5 is the best a regular grid can reach
+		float acmr = 0.f;
+		// Average transform to vertex ratio, 1 when every vertex is shaded once
+		float atvr = 0.f;
+	};
+
+	/// <summary>
+	/// Result of the memory cache simulation of the vertex fetches
+	/// </summary>
+	struct VertexFetchStatistics
+	{
+		unsigned int bytesFetched = 0;
+		// Bytes fetched over the size of the vertices referenced, 1 when every vertex is read once
+		float overfetch = 0.f;
+	};
+
+	/// <summary>
+	/// Range of the index buffer drawn with one call, its indices are relative to its first vertex
+	/// </summary>
+	struct Submesh
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		uint32_t vertexOffset = 0;
+	};
+
+	/// <summary>
+	/// Axis aligned box around the positions of a mesh
+	/// </summary>
+	struct MeshBounds
+	{
+		float min[3] = { 0.f, 0.f, 0.f };
+		float max[3] = { 0.f, 0.f, 0.f };
+	};
+
+	/// <summary>
+	/// Cluster of neighbouring triangles culled as a whole, 16 bytes aligned so a shader can read an array of them
+	/// </summary>
+	struct Meshlet
+	{
+		// Sphere around the vertices, in the space of the mesh
+		float center[3] = { 0.f, 0.f, 0.f };
+		float radius = 0.f;
+		// Average direction the triangles face and sine of the angle they spread around it, 1 when they face too many directions to be culled together
+		float coneAxis[3] = { 0.f, 0.f, 0.f };
+		float coneCutoff = 1.f;
+		// Consecutive triangles of the index buffer, drawn with the vertex offset of their submesh
+		uint32_t firstIndex = 0;
+		uint32_t triangleCount = 0;
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+	};
+
+	/// <summary>
+	/// Reorders the triangles and the vertices of an indexed mesh so the GPU caches hit more
+	/// Only works on indices and positions, it runs on the CPU without any device
+	/// </summary>
+	class MeshOptimizer
+	{
+	public:
+		// FIFO size of the simulated post-transform cache, close to the hardware ones
+		static inline const unsigned int DEFAULT_CACHE_SIZE = 16;
+
+		// Limits of a meshlet, the ones mesh shaders are usually tuned for
+		static inline const size_t MESHLET_MAX_VERTICES = 64;
+		static inline const size_t MESHLET_MAX_TRIANGLES = 124;
+
+		/// <summary>
+		/// Tipsify, orders the triangles as fans around vertices still in the cache
+		/// </summary>
+		/// <param name="_Indices">: Triangle list reordered in place </param>
+		/// <param name="_VertexCount">: Number of vertices the indices point in </param>
+		/// <param name="_CacheSize">: Size of the cache the order is built for </param>
+		static void OptimizeVertexCache(std::vector<uint32_t>& _Indices, size_t _VertexCount, unsigned int _CacheSize = DEFAULT_CACHE_SIZE);
+
+		/// <summary>
+		/// Splits the cache-optimized triangles in clusters then draws the clusters facing outward first, they hide the others
+		/// A cluster boundary is only placed where the cache miss ratio stays under the threshold
+		/// </summary>
+		/// <param name="_Indices">: Triangle list already optimized with OptimizeVertexCache, reordered in place </param>
+		/// <param name="_Positions">: First position, three floats </param>
+		/// <param name="_PositionStride">: Bytes between two positions </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_Threshold">: Cache miss ratio allowed compared to the input, 1.05 allows 5 percent more </param>
+		/// <param name="_CacheSize">: Size of the cache the order was built for </param>
+		static void OptimizeOverdraw(std::vector<uint32_t>& _Indices, const float* _Positions, size_t _PositionStride, size_t _VertexCount, float _Threshold = 1.05f, unsigned int _CacheSize = DEFAULT_CACHE_SIZE);
+
+		/// <summary>
+		/// Numbers the vertices in the order the indices first use them, the vertex fetches become sequential
+		/// </summary>
+		/// <param name="_Indices">: Triangle list rewritten with the new vertex numbers </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_Remap">: Receives the new position of every vertex, apply it with RemapVertices </param>
+		static void OptimizeVertexFetch(std::vector<uint32_t>& _Indices, size_t _VertexCount, std::vector<uint32_t>& _Remap);
+
+		/// <summary>
+		/// Orders the triangles for the cache, keeps the order against overdraw when it stays in the cache budget and does not fetch more, then numbers the vertices
+		/// </summary>
+		/// <param name="_Indices">: Triangle list reordered and rewritten with the new vertex numbers </param>
+		/// <param name="_Positions">: First position, three floats </param>
+		/// <param name="_PositionStride">: Bytes between two positions </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_VertexSize">: Size of a vertex once uploaded, the fetches of both orders are compared with it </param>
+		/// <param name="_OverdrawThreshold">: Cache miss ratio the overdraw order may add to the cache order, relative to it </param>
+		/// <param name="_Remap">: Receives the new position of every vertex, apply it with RemapVertices </param>
+		static void OptimizeMesh(std::vector<uint32_t>& _Indices, const float* _Positions, size_t _PositionStride, size_t _VertexCount, size_t _VertexSize, float _OverdrawThreshold,
+			std::vector<uint32_t>& _Remap);
+
+		/// <summary>
+		/// Moves the vertices to the positions given by OptimizeVertexFetch
+		/// </summary>
+		/// <param name="_Vertices">: Vertices reordered in place </param>
+		/// <param name="_Remap">: New position of every vertex </param>
+		template<typename T>
+		static void RemapVertices(std::vector<T>& _Vertices, const std::vector<uint32_t>& _Remap);
+
+		/// <summary>
+		/// Splits the triangles in consecutive submeshes using at most _MaxVertexCount vertices each so their indices fit in 16 bits
+		/// Every submesh gets its own copy of the vertices it uses, the vertices shared by two submeshes are duplicated
+		/// </summary>
+		/// <param name="_Indices">: Triangle list rewritten relative to the first vertex of each submesh </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_VertexSources">: Receives the vertex copied at every position of the new vertex list, apply it with GatherVertices </param>
+		/// <param name="_Submeshes">: Receives the submeshes in the order of the triangles </param>
+		/// <param name="_MaxVertexCount">: Vertices allowed per submesh </param>
+		static void SplitSubmeshes(std::vector<uint32_t>& _Indices, size_t _VertexCount, std::vector<uint32_t>& _VertexSources, std::vector<Submesh>& _Submeshes, size_t _MaxVertexCount = 65536);
+
+		/// <summary>
+		/// Builds the vertex list given by SplitSubmeshes
+		/// </summary>
+		/// <param name="_Vertices">: Vertices replaced by the new list </param>
+		/// <param name="_Sources">: Vertex copied at every position </param>
+		template<typename T>
+		static void GatherVertices(std::vector<T>& _Vertices, const std::vector<uint32_t>& _Sources);
+
+		/// <summary>
+		/// Simulates a FIFO post-transform cache
+		/// </summary>
+		/// <param name="_Indices">: Triangle list </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_CacheSize">: Size of the simulated cache </param>
+		/// <returns></returns>
+		static VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& _Indices, size_t _VertexCount, unsigned int _CacheSize = DEFAULT_CACHE_SIZE);
+
+		/// <summary>
+		/// Simulates a direct mapped memory cache of 16 KB with lines of 64 bytes reading the vertices
+		/// </summary>
+		/// <param name="_Indices">: Triangle list </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <param name="_VertexSize">: Size of a vertex in bytes </param>
+		/// <returns></returns>
+		static VertexFetchStatistics AnalyzeVertexFetch(const std::vector<uint32_t>& _Indices, size_t _VertexCount, size_t _VertexSize);
+
+		/// <summary>
+		/// Box around the positions
+		/// </summary>
+		/// <param name="_Positions">: First position, three floats </param>
+		/// <param name="_PositionStride">: Bytes between two positions </param>
+		/// <param name="_VertexCount">: Number of vertices </param>
+		/// <returns>An empty box at the origin without vertices</returns>
+		static MeshBounds ComputeBounds(const float* _Positions, size_t _PositionStride, size_t _VertexCount);
+
+		/// <summary>
+		/// Cuts every submesh in meshlets of consecutive triangles, the order of the indices is kept so a meshlet is a range of the index buffer
+		/// The cache-optimized order keeps the triangles of a meshlet close to each other
+		/// </summary>
+		/// <param name="_Indices">: Triangle list, relative to the first vertex of each submesh </param>
+		/// <param name="_Submeshes">: Ranges of the indices </param>
+		/// <param name="_SubmeshCount">: Number of submeshes </param>
+		/// <param name="_Positions">: First position, three floats </param>
+		/// <param name="_PositionStride">: Bytes between two positions </param>
+		/// <param name="_Meshlets">: Receives the meshlets with their bounding sphere and normal cone </param>
+		static void BuildMeshlets(const uint32_t* _Indices, const Submesh* _Submeshes, size_t _SubmeshCount, const float* _Positions, size_t _PositionStride, std::vector<Meshlet>& _Meshlets);
+		static void BuildMeshlets(const uint16_t* _Indices, const Submesh* _Submeshes, size_t _SubmeshCount, const float* _Positions, size_t _PositionStride, std::vector<Meshlet>& _Meshlets);
+	};
+
+	template<typename T>
+	void MeshOptimizer::RemapVertices(std::vector<T>& _Vertices, const std::vector<uint32_t>& _Remap)
+	{
+		std::vector<T> remappedVertices(_Vertices.size());
+
+		for (size_t i = 0; i < _Vertices.size(); ++i)
+			remappedVertices[_Remap[i]] = _Vertices[i];
+
+		_Vertices.swap(remappedVertices);
+	}
+
+	template<typename T>
+	void MeshOptimizer::GatherVertices(std::vector<T>& _Vertices, const std::vector<uint32_t>& _Sources)
+	{
+		std::vector<T> gatheredVertices(_Sources.size());
+
+		for (size_t i = 0; i < _Sources.size(); ++i)
+			gatheredVertices[i] = _Vertices[_Sources[i]];
+
+		_Vertices.swap(gatheredVertices);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <filesystem>
+
+namespace Core
+{
+	class ThreadPool;
+
+	/// <summary>
+	/// Attributes of a triangle corner, 0 based, -1 when the face does not give the attribute
+	/// </summary>
+	struct ObjIndex
+	{
+		int position = -1;
+		int textCoord = -1;
+		int normal = -1;
+	};
+
+	/// <summary>
+	/// Attributes of an OBJ file and its faces as triangles, in the order of the file
+	/// </summary>
+	struct ObjData
+	{
+		// x, y, z
+		std::vector<float> positions;
+		// u, v
+		std::vector<float> textCoords;
+		// x, y, z
+		std::vector<float> normals;
+		// Three corners per triangle
+		std::vector<ObjIndex> indices;
+	};
+
+	enum ObjParseResult
+	{
+		OBJ_PARSE_SUCCESS,
+		OBJ_PARSE_ERROR,
+		// Polygons of more than 4 vertices, parse them with ParseReference
+		OBJ_PARSE_UNSUPPORTED_POLYGON
+	};
+
+	/// <summary>
+	/// Reads the geometry of an OBJ file mapped in memory, line aligned chunks of the file are parsed in parallel then merged
+	/// Gives the same triangles as tinyobjloader, quads are split along their shortest diagonal
+	/// Groups, materials, lines and points are ignored
+	/// </summary>
+	class ObjParser
+	{
+	private:
+		// Smaller chunks cost more to merge than to parse
+		static inline const size_t MIN_CHUNK_SIZE = 64 * 1024;
+		// Chunks per thread, the threads finishing first take the remaining ones
+		static inline const size_t CHUNKS_PER_THREAD = 4;
+
+	public:
+
+		/// <summary>
+		/// Parses a file
+		/// </summary>
+		/// <param name="_Path">: Path of the OBJ file </param>
+		/// <param name="_Data">: Receives the attributes and the triangles </param>
+		/// <param name="_ThreadPool">: Pool helping the calling thread, the file is parsed on the calling thread only when null </param>
+		/// <returns></returns>
+		static ObjParseResult Parse(const std::filesystem::path& _Path, ObjData& _Data, ThreadPool* _ThreadPool = nullptr);
+
+		/// <summary>
+		/// Parses a file with tinyobjloader
+		/// </summary>
+		/// <param name="_Path">: Path of the OBJ file </param>
+		/// <param name="_Data">: Receives the attributes and the triangles </param>
+		/// <returns></returns>
+		static const bool ParseReference(const std::filesystem::path& _Path, ObjData& _Data);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "IMesh.h"
+#include "ITexture.h"
+#include "Threading/ThreadPool.h"
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Core
+{
+	class IRendererHardware;
+	class IDevice;
+
+	// Shared by everything drawing the resource, the last handle released destroys it
+	using MeshHandle = std::shared_ptr<IMesh>;
+	using TextureHandle = std::shared_ptr<ITexture>;
+
+	// Told whether the resource could be loaded, called on the thread processing the loads
+	using LoadCallback = std::function<void(bool)>;
+
+	enum ResourceType
+	{
+		RESOURCE_MESH,
+		RESOURCE_TEXTURE
+	};
+
+	/// <summary>
+	/// Resource loaded by the manager and still used
+	/// </summary>
+	struct ResourceStatistics
+	{
+		ResourceType type = RESOURCE_MESH;
+		std::string path;
+		// Bytes of the buffers or of the image on the GPU
+		size_t memorySize = 0;
+		// Handles alive
+		long useCount = 0;
+	};
+
+	/// <summary>
+	/// Loads every file once for the same import settings, the resources are shared through handles and unloaded when the last one is released
+	/// Files are decoded on the thread pool, the uploads and the callbacks happen in ProcessLoads on the thread owning the upload manager
+	/// </summary>
+	class ResourceManager
+	{
+	private:
+		// The same file loaded with other import settings is another resource
+		struct ResourceKey
+		{
+			ResourceType type = RESOURCE_MESH;
+			std::string path;
+			uint32_t settings = 0;
+
+			bool operator==(const ResourceKey& _Other) const { return type == _Other.type && settings == _Other.settings && path == _Other.path; }
+		};
+
+		struct ResourceKeyHash
+		{
+			size_t operator()(const ResourceKey& _Key) const;
+		};
+
+		struct ResourceEntry
+		{
+			// Does not keep the resource alive
+			std::weak_ptr<IResource> resource;
+			// Tells an entry from the one of a resource loaded again after its release
+			IResource* pointer = nullptr;
+			size_t memorySize = 0;
+		};
+
+		// Resource decoded on a worker and not uploaded yet
+		struct PendingLoad
+		{
+			ResourceKey key;
+			// Keeps the resource alive until its upload, so the last handle is never released by a worker
+			std::shared_ptr<IResource> resource;
+			std::future<bool> decoded;
+			std::function<bool()> upload;
+			std::vector<LoadCallback> callbacks;
+		};
+
+		IRendererHardware* m_RHI = nullptr;
+		IDevice* m_Device = nullptr;
+		ThreadPool* m_ThreadPool = nullptr;
+		// Runs the destruction once the frames in flight are done with the resource
+		std::function<void(const std::function<void()>&)> m_DeferDestruction;
+
+		std::unordered_map<ResourceKey, ResourceEntry, ResourceKeyHash> m_Entries;
+		std::mutex m_EntriesMutex;
+
+		// Only touched by the thread processing the loads
+		std::vector<PendingLoad> m_PendingLoads;
+
+		std::atomic<unsigned int> m_HitCount = 0;
+		std::atomic<unsigned int> m_MissCount = 0;
+
+		/// <summary>
+		/// Gives the resource of a key if a handle still uses it, the entries mutex has to be locked
+		/// </summary>
+		/// <param name="_Key">: Key of the resource </param>
+		/// <returns>nullptr if the resource was never loaded or was released</returns>
+		std::shared_ptr<IResource> FindResource(const ResourceKey& _Key);
+
+		/// <summary>
+		/// Counts a request of a resource already known, its callback waits for the load when it is still pending
+		/// </summary>
+		/// <param name="_Resource">: Resource requested </param>
+		/// <param name="_OnLoaded">: Callback of the request, can be empty </param>
+		void ShareResource(IResource* _Resource, const LoadCallback& _OnLoaded);
+
+		/// <summary>
+		/// Registers a resource created by a request and the decode job loading it
+		/// </summary>
+		/// <param name="_Load">: Key, resource, decode job and upload of the load </param>
+		/// <param name="_OnLoaded">: Callback of the request, can be empty </param>
+		void AddPendingLoad(PendingLoad&& _Load, const LoadCallback& _OnLoaded);
+
+		/// <summary>
+		/// Waits for the decode of a load, uploads the resource and calls the callbacks
+		/// </summary>
+		/// <param name="_Load">: Load removed from the pending ones </param>
+		void FinishLoad(PendingLoad& _Load);
+
+		/// <summary>
+		/// Finishes the pending load of a resource, does nothing when it is not pending
+		/// </summary>
+		/// <param name="_Resource">: Resource waited for </param>
+		void WaitLoad(IResource* _Resource);
+
+		/// <summary>
+		/// Removes the entry of a resource whose last handle was released
+		/// </summary>
+		/// <param name="_Key">: Key of the resource </param>
+		/// <param name="_Resource">: Resource released </param>
+		void Release(const ResourceKey& _Key, IResource* _Resource);
+
+		void DestroyMesh(IMesh* _Mesh);
+		void DestroyTexture(ITexture* _Texture);
+
+	public:
+		ResourceManager() = default;
+
+		ResourceManager(const ResourceManager&) = delete;
+		ResourceManager& operator=(const ResourceManager&) = delete;
+
+		/// <summary>
+		/// Prepares the manager
+		/// </summary>
+		/// <param name="_RHI">: RHI creating the resources </param>
+		/// <param name="_Device">: Device loading the resources </param>
+		/// <param name="_ThreadPool">: Workers decoding the files </param>
+		/// <param name="_DeferDestruction">: Executes a destruction once the GPU does not use the resource anymore </param>
+		void Initialize(IRendererHardware* _RHI, IDevice* _Device, ThreadPool* _ThreadPool, const std::function<void(const std::function<void()>&)>& _DeferDestruction);
+
+		/// <summary>
+		/// Drops the pending loads and forgets the resources, every handle has to be released before
+		/// </summary>
+		void Terminate();
+
+		/// <summary>
+		/// Gives the mesh of a file, loads it if no handle uses it and waits until it is uploaded
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the OBJ or glTF file </param>
+		/// <param name="_VertexFormat">: Format the vertices are converted to </param>
+		/// <returns>nullptr if the file could not be loaded</returns>
+		MeshHandle LoadMesh(const std::filesystem::path& _ResourcePath, VertexFormat _VertexFormat = RHI_VERTEX_FORMAT_DEFAULT);
+
+		/// <summary>
+		/// Gives the texture of a file, loads it if no handle uses it and waits until it is uploaded
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the image </param>
+		/// <returns>nullptr if the file could not be loaded</returns>
+		TextureHandle LoadTexture(const std::filesystem::path& _ResourcePath);
+
+		/// <summary>
+		/// Gives the mesh of a file right away, it is decoded on the thread pool and stays in the loading state until ProcessLoads uploads it
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the OBJ or glTF file </param>
+		/// <param name="_VertexFormat">: Format the vertices are converted to </param>
+		/// <param name="_OnLoaded">: Called once the mesh is ready or failed, can be empty </param>
+		/// <returns></returns>
+		MeshHandle LoadMeshAsync(const std::filesystem::path& _ResourcePath, VertexFormat _VertexFormat = RHI_VERTEX_FORMAT_DEFAULT, const LoadCallback& _OnLoaded = LoadCallback());
+
+		/// <summary>
+		/// Gives the texture of a file right away, it is decoded on the thread pool and stays in the loading state until ProcessLoads uploads it
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the image </param>
+		/// <param name="_OnLoaded">: Called once the texture is ready or failed, can be empty </param>
+		/// <returns></returns>
+		TextureHandle LoadTextureAsync(const std::filesystem::path& _ResourcePath, const LoadCallback& _OnLoaded = LoadCallback());
+
+		/// <summary>
+		/// Uploads the resources whose decode is over and calls their callbacks, never waits for a worker
+		/// The copies are recorded in the upload manager and sent by its next flush
+		/// </summary>
+		/// <returns>Number of resources finished</returns>
+		unsigned int ProcessLoads();
+
+		/// <summary>
+		/// Finishes every pending load, including the ones requested by the callbacks
+		/// </summary>
+		void WaitPendingLoads();
+
+		inline unsigned int GetPendingLoadCount() const { return static_cast<unsigned int>(m_PendingLoads.size()); }
+
+		/// <summary>
+		/// Lists the resources still used
+		/// </summary>
+		/// <returns></returns>
+		std::vector<ResourceStatistics> GetStatistics();
+
+		/// <summary>
+		/// Logs the memory and the handles of every resource still used
+		/// </summary>
+		void LogStatistics();
+
+		/// <summary>
+		/// Gives the same key to the paths of the same file, relative or absolute and with any separator
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the file </param>
+		/// <returns></returns>
+		static std::string NormalizePath(const std::filesystem::path& _ResourcePath);
+
+		// Requests given a resource already loaded, and requests that loaded their resource
+		inline unsigned int GetHitCount() const { return m_HitCount; }
+		inline unsigned int GetMissCount() const { return m_MissCount; }
+	};
+}
\ No newline at end of file
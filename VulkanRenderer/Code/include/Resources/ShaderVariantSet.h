@@ -0,0 +1,96 @@
+#pragma once
+
+#include "IShader.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Core
+{
+	// Bitmask of the features enabled in a variant, bit i is the feature i given to Load
+	typedef uint32_t ShaderVariantKey;
+
+	/// <summary>
+	/// All the permutations of a GLSL file, every feature is a macro defined when its bit is set in the key
+	/// Variants are compiled on their first use or precompiled at startup, then found with a direct index
+	/// The variants baked in the shader archive are loaded from it instead of being compiled
+	/// </summary>
+	class ShaderVariantSet
+	{
+	private:
+		// 2^12 pointers per set at most
+		static inline const unsigned int MAX_FEATURES = 12;
+
+		std::filesystem::path m_ResourcePath;
+		ShaderType m_ShaderType = RHI_VERTEX;
+		std::string m_SourceCode;
+
+		std::vector<std::string> m_Features;
+
+		// Indexed by the key, a slot is written once when its variant is compiled then only read
+		std::unique_ptr<std::atomic<IShader*>[]> m_Variants;
+		size_t m_VariantCount = 0;
+
+		/// <summary>
+		/// Creates and compiles a variant
+		/// </summary>
+		/// <param name="_Device">: Device creating the shader module </param>
+		/// <param name="_Key">: Features of the variant </param>
+		/// <returns></returns>
+		IShader* CompileVariant(IDevice* _Device, ShaderVariantKey _Key);
+
+	public:
+		ShaderVariantSet() = default;
+
+		ShaderVariantSet(const ShaderVariantSet&) = delete;
+		ShaderVariantSet& operator=(const ShaderVariantSet&) = delete;
+
+		/// <summary>
+		/// Reads the source of the shader, no variant is compiled
+		/// </summary>
+		/// <param name="_ResourcePath">: Path of the GLSL file </param>
+		/// <param name="_Features">: Macros that can be enabled, the order gives their bit in the keys </param>
+		/// <returns></returns>
+		const bool Load(const std::filesystem::path& _ResourcePath, const std::vector<std::string>& _Features);
+
+		/// <summary>
+		/// Destroys all the variants compiled
+		/// </summary>
+		/// <param name="_Device">: Device that created the variants </param>
+		void Unload(IDevice* _Device);
+
+		/// <summary>
+		/// Gives a variant, compiles it if it is the first time it is requested
+		/// Threads requesting the same missing variant may both compile it, only one result is kept
+		/// </summary>
+		/// <param name="_Device">: Device creating the shader module </param>
+		/// <param name="_Key">: Features of the variant </param>
+		/// <returns>nullptr if the compilation failed</returns>
+		IShader* GetVariant(IDevice* _Device, ShaderVariantKey _Key);
+
+		/// <summary>
+		/// Compiles variants on the thread pool and waits for them
+		/// </summary>
+		/// <param name="_Device">: Device creating the shader modules </param>
+		/// <param name="_Keys">: Variants used from the start </param>
+		/// <returns></returns>
+		const bool Precompile(IDevice* _Device, const std::vector<ShaderVariantKey>& _Keys);
+
+		/// <summary>
+		/// Bit of a feature
+		/// </summary>
+		/// <param name="_Feature">: Name of the macro </param>
+		/// <returns>0 if the feature does not exist</returns>
+		ShaderVariantKey GetFeatureBit(const std::string& _Feature) const;
+
+		/// <summary>
+		/// Gives a variant only if it is compiled, never blocks
+		/// </summary>
+		/// <param name="_Key">: Features of the variant </param>
+		/// <returns></returns>
+		inline IShader* FindVariant(ShaderVariantKey _Key) const { return _Key < m_VariantCount ? m_Variants[_Key].load(std::memory_order_acquire) : nullptr; }
+
+		inline size_t GetVariantCount() const { return m_VariantCount; }
+		inline ShaderType GetShaderType() const { return m_ShaderType; }
+	};
+}
\ No newline at end of file
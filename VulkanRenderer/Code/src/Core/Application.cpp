@@ -5,10 +5,13 @@ namespace Core
 	Application::Application()
 	{}
 
-	const bool Application::Initialize()
+	const bool Application::Initialize(int _Argc, char** _Argv)
 	{
 		Debug::Log::OpenFile("Logs/LogFile.log");
 
+		if (!m_Benchmarks.Select(_Argc, _Argv))
+			return false;
+
 		m_Window.Initialize(m_Renderer.GetRendererType());
 
 		if (!m_Renderer.Initialize(&m_Window))
@@ -19,9 +22,72 @@ namespace Core
 
 		appCamera.SetupDescriptors();
 
+		BuildFrameGraph();
+
+		m_Benchmarks.RunStartup(m_Renderer);
+
 		return true;
 	}
 
+	void Application::BuildFrameGraph()
+	{
+		// Same size as the swap chain, the window size is not updated on resize
+		glfwGetFramebufferSize(m_Window.GetWindowPointer(), &m_FrameGraphWidth, &m_FrameGraphHeight);
+
+		m_FrameGraph.Clear();
+
+		RenderGraphTextureDesc colorDesc;
+		colorDesc.width = static_cast<unsigned int>(m_FrameGraphWidth);
+		colorDesc.height = static_cast<unsigned int>(m_FrameGraphHeight);
+		colorDesc.format = RG_FORMAT_RGBA8;
+
+		RenderGraphTextureDesc depthDesc = colorDesc;
+		depthDesc.format = RG_FORMAT_DEPTH32;
+
+		RenderGraphResource backbuffer = m_FrameGraph.ImportTexture("Backbuffer", colorDesc, RG_ACCESS_NONE, RG_ACCESS_PRESENT);
+		RenderGraphResource depth = m_FrameGraph.CreateTexture("Depth", depthDesc);
+
+		RenderGraphPassHandle texturedModelPass = m_FrameGraph.AddPass("TexturedModel", [this]()
+			{
+				m_Renderer.SetupTexturedModelPass();
+
+				// Here call all objects to draw
+				m_Renderer.TexturedModelPass(&appCamera, &Core::Renderer::model);
+				m_Renderer.TexturedModelPass(&appCamera, &Core::Renderer::mcModel);
+
+				m_Renderer.FinishTexturedModelPass();
+			});
+
+		m_FrameGraph.Write(texturedModelPass, backbuffer, RG_ACCESS_COLOR_ATTACHMENT);
+		m_FrameGraph.Write(texturedModelPass, depth, RG_ACCESS_DEPTH_ATTACHMENT);
+
+		// New passes (shadow / skybox etc) only have to declare what they read and write here
+
+		m_FrameGraph.MarkOutput(backbuffer);
+
+		m_FrameGraph.Compile();
+
+		DEBUG_LOG("Frame graph compiled in %f ms, %u passes executed", m_FrameGraph.GetCompileTime(), static_cast<unsigned int>(m_FrameGraph.GetExecutionOrder().size()));
+
+		// The depth of the framebuffers is the transient depth of the graph
+		m_Renderer.CreateFrameGraphResources(m_FrameGraph, depth);
+	}
+
+	void Application::UpdateFrameGraphSize()
+	{
+		int width = 0, height = 0;
+		glfwGetFramebufferSize(m_Window.GetWindowPointer(), &width, &height);
+
+		// Minimized, the swap chain is not recreated until the window comes back
+		if (width == 0 || height == 0)
+			return;
+
+		if (width == m_FrameGraphWidth && height == m_FrameGraphHeight)
+			return;
+
+		BuildFrameGraph();
+	}
+
 	const bool Application::Terminate()
 	{
 		bool returnValue = true;
@@ -41,16 +107,18 @@ namespace Core
 
 	void Application::Draw()
 	{
-		m_Renderer.StartFrame(&m_Window, &appCamera);
-		m_Renderer.SetupTexturedModelPass();
+		m_Benchmarks.RunFrame(m_Renderer);
 
-		// Here call all objects to draw
-		m_Renderer.TexturedModelPass(&appCamera, &Core::Renderer::model);
-		m_Renderer.TexturedModelPass(&appCamera, &Core::Renderer::mcModel);
+		m_Renderer.StartFrame(&m_Window, &appCamera);
 
-		m_Renderer.FinishTexturedModelPass();
+		// The swap chain may have been recreated by the start of the frame
+		UpdateFrameGraphSize();
 
-		// Can create new pipelines for shadow / skybox etc
+		// The render passes keep the layouts the barriers of the graph give to their attachments
+		m_FrameGraph.Execute([this](const std::vector<RenderGraphBarrier>& _Barriers)
+			{
+				m_Renderer.RecordFrameGraphBarriers(_Barriers);
+			});
 
 		m_Renderer.EndFrame(&m_Window);
 	}
@@ -85,7 +85,8 @@ namespace Core
 						break;
 						// float case
 					case 'f':
-						finalPrint << va_arg(_Args, float);
+						// Floats are promoted to double when passed to a variadic function
+						finalPrint << va_arg(_Args, double);
 						break;
 						// string case
 					case 's':
@@ -105,6 +106,8 @@ namespace Core
 			std::string strForm = finalPrint.str();
 			std::string finalForm;
 
+			std::lock_guard<std::mutex> lock(m_OutputMutex);
+
 			switch (_Type)
 			{
 			default: case LogType::LOG:
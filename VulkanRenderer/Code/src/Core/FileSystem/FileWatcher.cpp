@@ -0,0 +1,256 @@
+#include "FileSystem/FileWatcher.h"
+
+#include "Debug/Log.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	const bool FileWatcher::Start(const std::filesystem::path& _Directory)
+	{
+		if (m_IsRunning)
+			Stop();
+
+		m_Directory = _Directory;
+
+#ifdef _WIN32
+		// Backup semantics are needed to open a directory
+		m_DirectoryHandle = CreateFileW(_Directory.wstring().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+
+		if (m_DirectoryHandle == INVALID_HANDLE_VALUE)
+		{
+			DEBUG_ERROR("Failed to watch directory %s, Error Code: %d", _Directory.string().c_str(), static_cast<int>(GetLastError()));
+			return false;
+		}
+#elif defined(__linux__)
+		m_InotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+		if (m_InotifyDescriptor < 0)
+		{
+			DEBUG_ERROR("Failed to initialize inotify");
+			return false;
+		}
+
+		if (!AddWatchRecursive(_Directory))
+		{
+			close(m_InotifyDescriptor);
+			m_InotifyDescriptor = -1;
+			return false;
+		}
+#else
+		DEBUG_WARN("File watching is not supported on this platform");
+		return false;
+#endif
+
+		m_IsRunning = true;
+		m_WatchThread = std::thread(&FileWatcher::WatchLoop, this);
+
+		return true;
+	}
+
+	const bool FileWatcher::WatchDirectory(const std::filesystem::path& _Directory)
+	{
+		if (!m_IsRunning)
+			return false;
+
+		std::error_code error;
+		std::filesystem::path directory = std::filesystem::weakly_canonical(_Directory, error);
+		std::filesystem::path root = std::filesystem::weakly_canonical(m_Directory, error);
+
+		// Sub directories are already covered by the watch of the started directory
+		std::filesystem::path relative = directory.lexically_relative(root);
+
+		if (!relative.empty() && *relative.begin() != "..")
+			return true;
+
+#if defined(__linux__)
+		return AddWatchRecursive(directory);
+#else
+		DEBUG_WARN("Directory %s is outside of the watched directory, its changes are not seen", directory.string().c_str());
+		return false;
+#endif
+	}
+
+#if defined(__linux__)
+	const bool FileWatcher::AddWatchRecursive(const std::filesystem::path& _Directory)
+	{
+		// Closing after a write and moving a file in cover the editors saving in place and through a temporary file, a created directory is watched too
+		const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+		int watch = inotify_add_watch(m_InotifyDescriptor, _Directory.string().c_str(), mask);
+
+		if (watch < 0)
+		{
+			DEBUG_ERROR("Failed to watch directory %s", _Directory.string().c_str());
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(m_WatchesMutex);
+
+		// Watching the same directory twice gives back the same watch
+		m_WatchedDirectories[watch] = _Directory;
+
+		std::error_code error;
+
+		for (std::filesystem::recursive_directory_iterator it(_Directory, error), end; !error && it != end; it.increment(error))
+		{
+			if (!it->is_directory(error))
+				continue;
+
+			int subWatch = inotify_add_watch(m_InotifyDescriptor, it->path().string().c_str(), mask);
+
+			if (subWatch >= 0)
+				m_WatchedDirectories[subWatch] = it->path();
+		}
+
+		return true;
+	}
+#endif
+
+	void FileWatcher::Stop()
+	{
+		if (!m_IsRunning)
+			return;
+
+		m_IsRunning = false;
+
+#ifdef _WIN32
+		// Wakes up ReadDirectoryChangesW
+		CancelIoEx(m_DirectoryHandle, nullptr);
+#endif
+
+		if (m_WatchThread.joinable())
+			m_WatchThread.join();
+
+#ifdef _WIN32
+		CloseHandle(m_DirectoryHandle);
+		m_DirectoryHandle = INVALID_HANDLE_VALUE;
+#elif defined(__linux__)
+		close(m_InotifyDescriptor);
+		m_InotifyDescriptor = -1;
+
+		std::lock_guard<std::mutex> lock(m_WatchesMutex);
+		m_WatchedDirectories.clear();
+#endif
+	}
+
+	void FileWatcher::WatchLoop()
+	{
+#ifdef _WIN32
+		alignas(DWORD) char buffer[16 * 1024];
+
+		while (m_IsRunning)
+		{
+			DWORD bytesReturned = 0;
+
+			// Blocks until an event or CancelIoEx
+			if (!ReadDirectoryChangesW(m_DirectoryHandle, buffer, sizeof(buffer), TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, &bytesReturned, nullptr, nullptr))
+				break;
+
+			// The buffer overflowed, the events are lost
+			if (bytesReturned == 0)
+				continue;
+
+			size_t offset = 0;
+
+			while (true)
+			{
+				const FILE_NOTIFY_INFORMATION* notification = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+
+				if (notification->Action == FILE_ACTION_ADDED || notification->Action == FILE_ACTION_MODIFIED || notification->Action == FILE_ACTION_RENAMED_NEW_NAME)
+					AddChange(m_Directory / std::wstring(notification->FileName, notification->FileNameLength / sizeof(WCHAR)));
+
+				if (notification->NextEntryOffset == 0)
+					break;
+
+				offset += notification->NextEntryOffset;
+			}
+		}
+#elif defined(__linux__)
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		while (m_IsRunning)
+		{
+			// Wakes up regularly to see if the watcher has been stopped
+			pollfd descriptor{};
+			descriptor.fd = m_InotifyDescriptor;
+			descriptor.events = POLLIN;
+
+			if (poll(&descriptor, 1, 100) <= 0)
+				continue;
+
+			ssize_t length = read(m_InotifyDescriptor, buffer, sizeof(buffer));
+
+			if (length <= 0)
+				continue;
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+				std::filesystem::path directory;
+
+				{
+					std::lock_guard<std::mutex> lock(m_WatchesMutex);
+					std::unordered_map<int, std::filesystem::path>::const_iterator watched = m_WatchedDirectories.find(event->wd);
+
+					if (watched != m_WatchedDirectories.end())
+						directory = watched->second;
+				}
+
+				if (event->len > 0 && !directory.empty())
+				{
+					// Files may be written in a new directory before it is watched, they are only seen from their next change
+					if (event->mask & IN_ISDIR)
+						AddWatchRecursive(directory / event->name);
+					else
+						AddChange(directory / event->name);
+				}
+
+				offset += sizeof(inotify_event) + event->len;
+			}
+		}
+#endif
+	}
+
+	void FileWatcher::AddChange(const std::filesystem::path& _File)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		std::lock_guard<std::mutex> lock(m_ChangesMutex);
+
+		if (m_ChangedFiles.empty())
+			m_FirstChangeTime = now;
+
+		m_LastChangeTime = now;
+
+		if (std::find(m_ChangedFiles.begin(), m_ChangedFiles.end(), _File) == m_ChangedFiles.end())
+			m_ChangedFiles.push_back(_File);
+	}
+
+	const bool FileWatcher::PollChanges(std::vector<std::filesystem::path>& _ChangedFiles, std::chrono::steady_clock::time_point& _FirstChangeTime, std::chrono::milliseconds _QuietTime)
+	{
+		std::lock_guard<std::mutex> lock(m_ChangesMutex);
+
+		if (m_ChangedFiles.empty() || std::chrono::steady_clock::now() - m_LastChangeTime < _QuietTime)
+			return false;
+
+		_ChangedFiles.swap(m_ChangedFiles);
+		m_ChangedFiles.clear();
+		_FirstChangeTime = m_FirstChangeTime;
+
+		return true;
+	}
+}
\ No newline at end of file
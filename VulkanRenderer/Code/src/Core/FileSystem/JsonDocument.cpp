@@ -0,0 +1,324 @@
+#include "FileSystem/JsonDocument.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace Core
+{
+	static const JsonValue NULL_VALUE;
+
+	const JsonValue* JsonValue::Find(const char* _Key) const
+	{
+		if (m_Type != JSON_OBJECT)
+			return nullptr;
+
+		for (size_t i = 0; i < m_Keys.size(); ++i)
+		{
+			if (m_Keys[i] == _Key)
+				return &m_Elements[i];
+		}
+
+		return nullptr;
+	}
+
+	const JsonValue& JsonValue::operator[](const char* _Key) const
+	{
+		const JsonValue* value = Find(_Key);
+
+		return value != nullptr ? *value : NULL_VALUE;
+	}
+
+	const JsonValue& JsonValue::operator[](size_t _Index) const
+	{
+		return m_Type == JSON_ARRAY && _Index < m_Elements.size() ? m_Elements[_Index] : NULL_VALUE;
+	}
+
+	static void AppendUtf8(std::string& _String, uint32_t _CodePoint)
+	{
+		if (_CodePoint < 0x80)
+		{
+			_String += static_cast<char>(_CodePoint);
+		}
+		else if (_CodePoint < 0x800)
+		{
+			_String += static_cast<char>(0xC0 | (_CodePoint >> 6));
+			_String += static_cast<char>(0x80 | (_CodePoint & 0x3F));
+		}
+		else if (_CodePoint < 0x10000)
+		{
+			_String += static_cast<char>(0xE0 | (_CodePoint >> 12));
+			_String += static_cast<char>(0x80 | ((_CodePoint >> 6) & 0x3F));
+			_String += static_cast<char>(0x80 | (_CodePoint & 0x3F));
+		}
+		else
+		{
+			_String += static_cast<char>(0xF0 | (_CodePoint >> 18));
+			_String += static_cast<char>(0x80 | ((_CodePoint >> 12) & 0x3F));
+			_String += static_cast<char>(0x80 | ((_CodePoint >> 6) & 0x3F));
+			_String += static_cast<char>(0x80 | (_CodePoint & 0x3F));
+		}
+	}
+
+	const bool JsonDocument::Parse(const char* _Data, size_t _Size)
+	{
+		m_Root = JsonValue();
+		m_Cursor = _Data;
+		m_End = _Data + _Size;
+
+		bool isValid = ParseValue(m_Root, 0);
+
+		SkipWhitespaces();
+
+		// Nothing but whitespaces after the root, the padding of the GLB chunks is made of spaces
+		if (!isValid || m_Cursor != m_End)
+		{
+			m_Root = JsonValue();
+			return false;
+		}
+
+		return true;
+	}
+
+	void JsonDocument::SkipWhitespaces()
+	{
+		while (m_Cursor < m_End && (*m_Cursor == ' ' || *m_Cursor == '\t' || *m_Cursor == '\n' || *m_Cursor == '\r'))
+			++m_Cursor;
+	}
+
+	const bool JsonDocument::ParseValue(JsonValue& _Value, unsigned int _Depth)
+	{
+		if (_Depth > MAX_DEPTH)
+			return false;
+
+		SkipWhitespaces();
+
+		if (m_Cursor >= m_End)
+			return false;
+
+		switch (*m_Cursor)
+		{
+		case '{':
+		{
+			_Value.m_Type = JSON_OBJECT;
+			++m_Cursor;
+			SkipWhitespaces();
+
+			if (m_Cursor < m_End && *m_Cursor == '}')
+			{
+				++m_Cursor;
+				return true;
+			}
+
+			while (true)
+			{
+				SkipWhitespaces();
+
+				std::string key;
+
+				if (!ParseString(key))
+					return false;
+
+				SkipWhitespaces();
+
+				if (m_Cursor >= m_End || *m_Cursor != ':')
+					return false;
+
+				++m_Cursor;
+
+				_Value.m_Keys.push_back(std::move(key));
+				_Value.m_Elements.emplace_back();
+
+				if (!ParseValue(_Value.m_Elements.back(), _Depth + 1))
+					return false;
+
+				SkipWhitespaces();
+
+				if (m_Cursor < m_End && *m_Cursor == ',')
+				{
+					++m_Cursor;
+					continue;
+				}
+
+				if (m_Cursor < m_End && *m_Cursor == '}')
+				{
+					++m_Cursor;
+					return true;
+				}
+
+				return false;
+			}
+		}
+		case '[':
+		{
+			_Value.m_Type = JSON_ARRAY;
+			++m_Cursor;
+			SkipWhitespaces();
+
+			if (m_Cursor < m_End && *m_Cursor == ']')
+			{
+				++m_Cursor;
+				return true;
+			}
+
+			while (true)
+			{
+				_Value.m_Elements.emplace_back();
+
+				if (!ParseValue(_Value.m_Elements.back(), _Depth + 1))
+					return false;
+
+				SkipWhitespaces();
+
+				if (m_Cursor < m_End && *m_Cursor == ',')
+				{
+					++m_Cursor;
+					continue;
+				}
+
+				if (m_Cursor < m_End && *m_Cursor == ']')
+				{
+					++m_Cursor;
+					return true;
+				}
+
+				return false;
+			}
+		}
+		case '"':
+			_Value.m_Type = JSON_STRING;
+			return ParseString(_Value.m_String);
+		case 't':
+			_Value.m_Type = JSON_BOOL;
+			_Value.m_Bool = true;
+			return ParseLiteral("true");
+		case 'f':
+			_Value.m_Type = JSON_BOOL;
+			_Value.m_Bool = false;
+			return ParseLiteral("false");
+		case 'n':
+			_Value.m_Type = JSON_NULL;
+			return ParseLiteral("null");
+		default:
+			_Value.m_Type = JSON_NUMBER;
+			return ParseNumber(_Value.m_Number);
+		}
+	}
+
+	const bool JsonDocument::ParseString(std::string& _String)
+	{
+		if (m_Cursor >= m_End || *m_Cursor != '"')
+			return false;
+
+		++m_Cursor;
+
+		while (m_Cursor < m_End)
+		{
+			char character = *m_Cursor++;
+
+			if (character == '"')
+				return true;
+
+			// Control characters have to be escaped
+			if (static_cast<unsigned char>(character) < 0x20)
+				return false;
+
+			if (character != '\\')
+			{
+				_String += character;
+				continue;
+			}
+
+			if (m_Cursor >= m_End)
+				return false;
+
+			char escaped = *m_Cursor++;
+
+			switch (escaped)
+			{
+			case '"': _String += '"'; break;
+			case '\\': _String += '\\'; break;
+			case '/': _String += '/'; break;
+			case 'b': _String += '\b'; break;
+			case 'f': _String += '\f'; break;
+			case 'n': _String += '\n'; break;
+			case 'r': _String += '\r'; break;
+			case 't': _String += '\t'; break;
+			case 'u':
+			{
+				auto parseCodeUnit = [this](uint32_t& _CodeUnit)
+					{
+						if (m_End - m_Cursor < 4)
+							return false;
+
+						std::from_chars_result parsed = std::from_chars(m_Cursor, m_Cursor + 4, _CodeUnit, 16);
+
+						if (parsed.ec != std::errc() || parsed.ptr != m_Cursor + 4)
+							return false;
+
+						m_Cursor += 4;
+
+						return true;
+					};
+
+				uint32_t codePoint = 0;
+
+				if (!parseCodeUnit(codePoint))
+					return false;
+
+				// Characters out of the basic plane are written as a surrogate pair
+				if (codePoint >= 0xD800 && codePoint < 0xDC00)
+				{
+					uint32_t lowSurrogate = 0;
+
+					if (m_End - m_Cursor < 2 || m_Cursor[0] != '\\' || m_Cursor[1] != 'u')
+						return false;
+
+					m_Cursor += 2;
+
+					if (!parseCodeUnit(lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate >= 0xE000)
+						return false;
+
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+				}
+
+				AppendUtf8(_String, codePoint);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+	const bool JsonDocument::ParseNumber(double& _Number)
+	{
+		// from_chars also accepts what JSON forbids (inf, nan, hexadecimal), only the JSON characters are given to it
+		const char* numberEnd = m_Cursor;
+
+		while (numberEnd < m_End && (strchr("+-.eE", *numberEnd) != nullptr || (*numberEnd >= '0' && *numberEnd <= '9')))
+			++numberEnd;
+
+		std::from_chars_result parsed = std::from_chars(m_Cursor, numberEnd, _Number);
+
+		if (parsed.ec != std::errc() || parsed.ptr != numberEnd || numberEnd == m_Cursor)
+			return false;
+
+		m_Cursor = numberEnd;
+
+		return true;
+	}
+
+	const bool JsonDocument::ParseLiteral(const char* _Literal)
+	{
+		size_t length = strlen(_Literal);
+
+		if (static_cast<size_t>(m_End - m_Cursor) < length || memcmp(m_Cursor, _Literal, length) != 0)
+			return false;
+
+		m_Cursor += length;
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "FileSystem/MappedFile.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	const bool MappedFile::Open(const std::filesystem::path& _Path)
+	{
+		Close();
+
+#ifdef _WIN32
+		m_FileHandle = CreateFileW(_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (m_FileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+
+		// A mapping of an empty file cannot be created
+		if (!GetFileSizeEx(m_FileHandle, &fileSize) || fileSize.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (m_MappingHandle == nullptr)
+		{
+			Close();
+			return false;
+		}
+
+		m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+#else
+		m_FileDescriptor = open(_Path.c_str(), O_RDONLY);
+
+		if (m_FileDescriptor < 0)
+			return false;
+
+		struct stat fileStatus;
+
+		if (fstat(m_FileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+		{
+			Close();
+			return false;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+
+		m_Data = data != MAP_FAILED ? static_cast<const unsigned char*>(data) : nullptr;
+		m_Size = static_cast<size_t>(fileStatus.st_size);
+#endif
+
+		if (m_Data == nullptr)
+		{
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+#ifdef _WIN32
+		if (m_Data != nullptr)
+			UnmapViewOfFile(m_Data);
+
+		if (m_MappingHandle != nullptr)
+			CloseHandle(m_MappingHandle);
+
+		if (m_FileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle(m_FileHandle);
+
+		m_MappingHandle = nullptr;
+		m_FileHandle = INVALID_HANDLE_VALUE;
+#else
+		if (m_Data != nullptr)
+			munmap(const_cast<unsigned char*>(m_Data), m_Size);
+
+		if (m_FileDescriptor >= 0)
+			close(m_FileDescriptor);
+
+		m_FileDescriptor = -1;
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+}
\ No newline at end of file
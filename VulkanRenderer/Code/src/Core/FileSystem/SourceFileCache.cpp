@@ -0,0 +1,115 @@
+#include "FileSystem/SourceFileCache.h"
+
+#include <fstream>
+
+namespace Core
+{
+	static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	static void HashBytes(unsigned long long& _Hash, const void* _Data, size_t _Size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_Data);
+
+		for (size_t i = 0; i < _Size; ++i)
+		{
+			_Hash ^= bytes[i];
+			_Hash *= FNV_PRIME;
+		}
+	}
+
+	std::string SourceFileCache::GetEntryName(const std::filesystem::path& _Path)
+	{
+		// The same file reached through different relative paths has one entry
+		std::error_code error;
+		std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(_Path, error);
+
+		return error ? _Path.lexically_normal().string() : canonicalPath.string();
+	}
+
+	const bool SourceFileCache::ReadFile(const std::filesystem::path& _Path, std::string& _Content)
+	{
+		std::ifstream file(_Path, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+			return false;
+
+		size_t fileSize = static_cast<size_t>(file.tellg());
+
+		_Content.resize(fileSize);
+
+		file.seekg(0);
+		file.read(_Content.data(), fileSize);
+
+		return static_cast<bool>(file);
+	}
+
+	std::shared_ptr<const SourceFile> SourceFileCache::Read(const std::filesystem::path& _Path)
+	{
+		std::string name = GetEntryName(_Path);
+
+		std::error_code error;
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(_Path, error);
+
+		if (error)
+			return nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(m_FilesMutex);
+
+			auto file = m_Files.find(name);
+
+			if (file != m_Files.end() && file->second->writeTime == writeTime)
+				return file->second;
+		}
+
+		// Read without the lock, two threads may read the same file and the last one is kept
+		std::shared_ptr<SourceFile> file = std::make_shared<SourceFile>();
+		file->writeTime = writeTime;
+
+		if (!ReadFile(_Path, file->content))
+			return nullptr;
+
+		file->hash = ComputeHash(file->content);
+
+		std::lock_guard<std::mutex> lock(m_FilesMutex);
+		m_Files[name] = file;
+
+		return file;
+	}
+
+	void SourceFileCache::Invalidate(const std::filesystem::path& _Path)
+	{
+		std::string name = GetEntryName(_Path);
+
+		std::lock_guard<std::mutex> lock(m_FilesMutex);
+		m_Files.erase(name);
+	}
+
+	const bool SourceFileCache::IsUpToDate(const std::vector<SourceDependency>& _Dependencies)
+	{
+		for (const SourceDependency& dependency : _Dependencies)
+		{
+			std::shared_ptr<const SourceFile> file = Read(dependency.path);
+
+			if (file == nullptr || file->hash != dependency.hash)
+				return false;
+		}
+
+		return true;
+	}
+
+	unsigned long long SourceFileCache::ComputeHash(const std::string& _Content)
+	{
+		unsigned long long hash = FNV_OFFSET_BASIS;
+		HashBytes(hash, _Content.data(), _Content.size());
+
+		return hash;
+	}
+
+	void SourceFileCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_FilesMutex);
+		m_Files.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "RHI/DeletionQueue.h"
+
+namespace Core
+{
+	void DeletionQueue::Push(unsigned long long _Frame, const std::function<void()>& _Destroy)
+	{
+		PendingDeletion deletion;
+		deletion.frame = _Frame;
+		deletion.destroy = _Destroy;
+
+		m_PendingDeletions.push_back(deletion);
+	}
+
+	void DeletionQueue::Flush(unsigned long long _CompletedFrame)
+	{
+		while (!m_PendingDeletions.empty() && m_PendingDeletions.front().frame <= _CompletedFrame)
+		{
+			// Pops before calling so a destruction can push new ones
+			std::function<void()> destroy = m_PendingDeletions.front().destroy;
+			m_PendingDeletions.pop_front();
+
+			destroy();
+		}
+	}
+
+	void DeletionQueue::FlushAll()
+	{
+		while (!m_PendingDeletions.empty())
+		{
+			std::function<void()> destroy = m_PendingDeletions.front().destroy;
+			m_PendingDeletions.pop_front();
+
+			destroy();
+		}
+	}
+}
\ No newline at end of file
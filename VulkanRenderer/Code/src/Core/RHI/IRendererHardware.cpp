@@ -100,4 +100,20 @@ namespace Core
         delete _Buffer;
         _Buffer = nullptr;
     }
+
+    void IRendererHardware::DestroyUploadManager(IUploadManager* _UploadManager, IDevice* _Device)
+    {
+        _UploadManager->DestroyUploadManager(_Device);
+
+        delete _UploadManager;
+        _UploadManager = nullptr;
+    }
+
+    void IRendererHardware::DestroyRenderGraphResources(IRenderGraphResources* _Resources, IDevice* _Device)
+    {
+        _Resources->DestroyResources(_Device);
+
+        delete _Resources;
+        _Resources = nullptr;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "RHI/PipelineDescription.h"
+
+#include "IShader.h"
+
+#include <cstring>
+
+namespace Core
+{
+	static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	static void HashBytes(unsigned long long& _Hash, const void* _Data, size_t _Size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_Data);
+
+		for (size_t i = 0; i < _Size; ++i)
+		{
+			_Hash ^= bytes[i];
+			_Hash *= FNV_PRIME;
+		}
+	}
+
+	template<typename T>
+	static void HashValue(unsigned long long& _Hash, const T& _Value)
+	{
+		HashBytes(_Hash, &_Value, sizeof(T));
+	}
+
+	unsigned long long PipelineDescription::ComputeHash() const
+	{
+		unsigned long long hash = FNV_OFFSET_BASIS;
+
+		// Shaders are identified by their code and not by their address so the hash does not change between runs
+		HashValue(hash, shaders.size());
+
+		for (const PipelineShaderInfos& infos : shaders)
+		{
+			HashValue(hash, infos.shaderType);
+			HashValue(hash, infos.shader != nullptr ? infos.shader->GetCodeHash() : 0ULL);
+
+			size_t entrySize = infos.functionEntry != nullptr ? strlen(infos.functionEntry) : 0;
+			HashValue(hash, entrySize);
+			HashBytes(hash, infos.functionEntry, entrySize);
+		}
+
+		// Fields are hashed one by one, the padding of the structures is not initialized
+		HashValue(hash, vertexFormat);
+
+		HashValue(hash, raster.cullMode);
+		HashValue(hash, raster.isFrontFaceCounterClockwise);
+		HashValue(hash, raster.isWireframe);
+		HashValue(hash, raster.isDepthBiasEnabled);
+		HashValue(hash, raster.depthBiasConstantFactor);
+		HashValue(hash, raster.depthBiasSlopeFactor);
+
+		HashValue(hash, depth.isTestEnabled);
+		HashValue(hash, depth.isWriteEnabled);
+		HashValue(hash, depth.compareOperation);
+
+		HashValue(hash, blend.mode);
+		HashValue(hash, blend.colorWriteMask);
+
+		HashValue(hash, colorFormat);
+		HashValue(hash, depthFormat);
+
+		return hash;
+	}
+}
\ No newline at end of file
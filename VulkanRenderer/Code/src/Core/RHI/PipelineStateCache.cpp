@@ -0,0 +1,127 @@
+#include "RHI/PipelineStateCache.h"
+
+#include "RHI/IRendererHardware.h"
+#include "Threading/ThreadPool.h"
+
+#include <chrono>
+
+namespace Core
+{
+	void PipelineStateCache::Initialize(IRendererHardware* _RHI, IDevice* _Device, ISwapChain* _SwapChain, ThreadPool* _ThreadPool, IPipeline* _FallbackPipeline)
+	{
+		m_RHI = _RHI;
+		m_Device = _Device;
+		m_SwapChain = _SwapChain;
+		m_ThreadPool = _ThreadPool;
+		m_FallbackPipeline = _FallbackPipeline;
+
+		RegisterFallbackPipeline();
+	}
+
+	void PipelineStateCache::RegisterFallbackPipeline()
+	{
+		if (m_FallbackPipeline == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		// Requests of the fallback description are hits from the start
+		// An entry already compiled under this description is kept, Terminate destroys its pipeline
+		std::unique_ptr<CacheEntry>& entry = m_Entries[m_FallbackPipeline->GetDescriptionHash()];
+
+		if (entry != nullptr)
+			return;
+
+		entry = std::make_unique<CacheEntry>();
+		entry->pipeline = m_FallbackPipeline;
+	}
+
+	void PipelineStateCache::Terminate()
+	{
+		WaitPendingCompilations();
+
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		for (std::pair<const unsigned long long, std::unique_ptr<CacheEntry>>& entry : m_Entries)
+		{
+			IPipeline* pipeline = entry.second->pipeline.load();
+
+			if (pipeline != nullptr && pipeline != m_FallbackPipeline)
+				m_RHI->DestroyPipeline(pipeline, m_Device);
+		}
+
+		m_Entries.clear();
+		m_FallbackPipeline = nullptr;
+	}
+
+	IPipeline* PipelineStateCache::GetPipeline(const PipelineDescription& _Description, unsigned long long _Hash)
+	{
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		std::unordered_map<unsigned long long, std::unique_ptr<CacheEntry>>::iterator entry = m_Entries.find(_Hash);
+
+		if (entry != m_Entries.end())
+		{
+			++m_HitCount;
+
+			IPipeline* pipeline = entry->second->pipeline.load(std::memory_order_acquire);
+
+			return pipeline != nullptr ? pipeline : m_FallbackPipeline;
+		}
+
+		++m_MissCount;
+
+		CacheEntry* newEntry = (m_Entries[_Hash] = std::make_unique<CacheEntry>()).get();
+
+		// Finished compilations are not tracked anymore
+		std::erase_if(m_PendingCompilations, [](const std::future<void>& _Compilation)
+			{
+				return _Compilation.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+			});
+
+		m_PendingCompilations.push_back(m_ThreadPool->Submit([this, _Description, _Hash, newEntry]()
+			{
+				CompilePipeline(_Description, _Hash, newEntry);
+			}));
+
+		return m_FallbackPipeline;
+	}
+
+	void PipelineStateCache::CompilePipeline(const PipelineDescription& _Description, unsigned long long _Hash, CacheEntry* _Entry)
+	{
+		std::chrono::high_resolution_clock::time_point compileStart = std::chrono::high_resolution_clock::now();
+
+		IPipeline* pipeline = m_RHI->InstantiatePipeline(m_Device, m_SwapChain, _Description);
+
+		if (pipeline == nullptr)
+		{
+			DEBUG_ERROR("Failed to compile a pipeline of the pipeline state cache");
+
+			// The next request of the description compiles it again
+			std::lock_guard<std::mutex> lock(m_EntriesMutex);
+			m_Entries.erase(_Hash);
+
+			return;
+		}
+
+		_Entry->pipeline.store(pipeline, std::memory_order_release);
+
+		std::chrono::duration<double, std::milli> compileTime = std::chrono::high_resolution_clock::now() - compileStart;
+		DEBUG_LOG("Pipeline compiled in the background in %f ms", compileTime.count());
+	}
+
+	void PipelineStateCache::WaitPendingCompilations()
+	{
+		std::vector<std::future<void>> pendingCompilations;
+
+		{
+			std::lock_guard<std::mutex> lock(m_EntriesMutex);
+			pendingCompilations.swap(m_PendingCompilations);
+		}
+
+		for (std::future<void>& compilation : pendingCompilations)
+		{
+			compilation.wait();
+		}
+	}
+}
\ No newline at end of file
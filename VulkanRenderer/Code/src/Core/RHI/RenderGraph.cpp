@@ -0,0 +1,389 @@
+#include "RHI/RenderGraph.h"
+
+#include "Debug/Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Core
+{
+	RenderGraphResource RenderGraph::CreateTexture(const std::string& _Name, const RenderGraphTextureDesc& _Desc)
+	{
+		RenderGraphResourceNode resource;
+		resource.name = _Name;
+		resource.desc = _Desc;
+
+		m_Resources.push_back(resource);
+		m_IsCompiled = false;
+
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& _Name, const RenderGraphTextureDesc& _Desc, RenderGraphAccess _InitialAccess, RenderGraphAccess _FinalAccess)
+	{
+		RenderGraphResourceNode resource;
+		resource.name = _Name;
+		resource.desc = _Desc;
+		resource.imported = true;
+		resource.initialAccess = _InitialAccess;
+		resource.finalAccess = _FinalAccess;
+
+		m_Resources.push_back(resource);
+		m_IsCompiled = false;
+
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	RenderGraphPassHandle RenderGraph::AddPass(const std::string& _Name, const std::function<void()>& _Execute)
+	{
+		RenderGraphPass pass;
+		pass.name = _Name;
+		pass.execute = _Execute;
+
+		m_Passes.push_back(pass);
+		m_IsCompiled = false;
+
+		return static_cast<RenderGraphPassHandle>(m_Passes.size() - 1);
+	}
+
+	void RenderGraph::Read(RenderGraphPassHandle _Pass, RenderGraphResource _Resource, RenderGraphAccess _Access)
+	{
+		m_Passes[_Pass].reads.push_back({ _Resource, _Access });
+		m_IsCompiled = false;
+	}
+
+	void RenderGraph::Write(RenderGraphPassHandle _Pass, RenderGraphResource _Resource, RenderGraphAccess _Access)
+	{
+		m_Passes[_Pass].writes.push_back({ _Resource, _Access });
+		m_IsCompiled = false;
+	}
+
+	const bool RenderGraph::Compile()
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		for (RenderGraphResourceNode& resource : m_Resources)
+		{
+			resource.firstUse = -1;
+			resource.lastUse = -1;
+			resource.physicalIndex = -1;
+		}
+
+		for (RenderGraphPass& pass : m_Passes)
+		{
+			pass.isCulled = true;
+			pass.dependencies.clear();
+			pass.barriers.clear();
+		}
+
+		BuildDependencies();
+		CullPasses();
+
+		// A pass can only depend on passes declared before it, so the declaration order of the remaining passes is already a valid order
+		m_ExecutionOrder.clear();
+
+		for (RenderGraphPassHandle i = 0; i < m_Passes.size(); ++i)
+		{
+			if (!m_Passes[i].isCulled)
+				m_ExecutionOrder.push_back(i);
+		}
+
+		if (m_ExecutionOrder.empty())
+		{
+			DEBUG_WARN("Render graph has no pass producing an output");
+		}
+
+		ComputeBarriers();
+		AliasTransientResources();
+
+		std::chrono::duration<double, std::milli> compileTime = std::chrono::high_resolution_clock::now() - start;
+		m_CompileTime = compileTime.count();
+
+		m_IsCompiled = true;
+
+		return true;
+	}
+
+	void RenderGraph::BuildDependencies()
+	{
+		const int noWriter = -1;
+
+		// Last pass that wrote each resource and the passes that read it since
+		std::vector<int> lastWriters(m_Resources.size(), noWriter);
+		std::vector<std::vector<RenderGraphPassHandle>> readersSinceWrite(m_Resources.size());
+
+		for (RenderGraphPassHandle i = 0; i < m_Passes.size(); ++i)
+		{
+			RenderGraphPass& pass = m_Passes[i];
+
+			// Read after write
+			for (const RenderGraphResourceAccess& read : pass.reads)
+			{
+				if (lastWriters[read.resource] != noWriter && lastWriters[read.resource] != static_cast<int>(i))
+					pass.dependencies.push_back(static_cast<RenderGraphPassHandle>(lastWriters[read.resource]));
+
+				readersSinceWrite[read.resource].push_back(i);
+			}
+
+			for (const RenderGraphResourceAccess& write : pass.writes)
+			{
+				// Write after write
+				if (lastWriters[write.resource] != noWriter && lastWriters[write.resource] != static_cast<int>(i))
+					pass.dependencies.push_back(static_cast<RenderGraphPassHandle>(lastWriters[write.resource]));
+
+				// Write after read
+				for (RenderGraphPassHandle reader : readersSinceWrite[write.resource])
+				{
+					if (reader != i)
+						pass.dependencies.push_back(reader);
+				}
+
+				lastWriters[write.resource] = static_cast<int>(i);
+				readersSinceWrite[write.resource].clear();
+			}
+
+			std::sort(pass.dependencies.begin(), pass.dependencies.end());
+			pass.dependencies.erase(std::unique(pass.dependencies.begin(), pass.dependencies.end()), pass.dependencies.end());
+		}
+	}
+
+	void RenderGraph::CullPasses()
+	{
+		std::vector<RenderGraphPassHandle> stack;
+
+		// Roots are the passes visible from outside the graph
+		for (RenderGraphPassHandle i = 0; i < m_Passes.size(); ++i)
+		{
+			const RenderGraphPass& pass = m_Passes[i];
+
+			bool isRoot = pass.hasSideEffects;
+
+			for (const RenderGraphResourceAccess& write : pass.writes)
+			{
+				if (m_Resources[write.resource].isOutput || m_Resources[write.resource].imported)
+					isRoot = true;
+			}
+
+			if (isRoot)
+				stack.push_back(i);
+		}
+
+		// Everything a root depends on is kept, the rest is culled
+		while (!stack.empty())
+		{
+			RenderGraphPassHandle passIndex = stack.back();
+			stack.pop_back();
+
+			RenderGraphPass& pass = m_Passes[passIndex];
+
+			if (!pass.isCulled)
+				continue;
+
+			pass.isCulled = false;
+
+			for (RenderGraphPassHandle dependency : pass.dependencies)
+			{
+				if (m_Passes[dependency].isCulled)
+					stack.push_back(dependency);
+			}
+		}
+	}
+
+	void RenderGraph::ComputeBarriers()
+	{
+		// Current access of every resource while walking through the frame
+		std::vector<RenderGraphAccessFlags> currentAccesses(m_Resources.size(), RG_ACCESS_NONE);
+
+		for (size_t i = 0; i < m_Resources.size(); ++i)
+		{
+			currentAccesses[i] = m_Resources[i].initialAccess;
+		}
+
+		// Accesses of the pass being walked through, one entry per resource in the order they are used
+		std::vector<RenderGraphResourceAccess> passUses;
+		std::vector<RenderGraphAccessFlags> passAccesses;
+
+		for (size_t position = 0; position < m_ExecutionOrder.size(); ++position)
+		{
+			RenderGraphPass& pass = m_Passes[m_ExecutionOrder[position]];
+
+			passUses.clear();
+			passAccesses.clear();
+
+			// A resource read and written by the same pass needs both accesses in its barrier
+			auto useResource = [&](const RenderGraphResourceAccess& _Use)
+			{
+				for (size_t i = 0; i < passUses.size(); ++i)
+				{
+					if (passUses[i].resource == _Use.resource)
+					{
+						passAccesses[i] |= _Use.access;
+						return;
+					}
+				}
+
+				passUses.push_back(_Use);
+				passAccesses.push_back(_Use.access);
+			};
+
+			for (const RenderGraphResourceAccess& read : pass.reads)
+				useResource(read);
+
+			for (const RenderGraphResourceAccess& write : pass.writes)
+				useResource(write);
+
+			for (size_t i = 0; i < passUses.size(); ++i)
+			{
+				RenderGraphResource resourceIndex = passUses[i].resource;
+				RenderGraphResourceNode& resource = m_Resources[resourceIndex];
+
+				if (resource.firstUse < 0)
+					resource.firstUse = static_cast<int>(position);
+
+				resource.lastUse = static_cast<int>(position);
+
+				RenderGraphAccessFlags& currentAccess = currentAccesses[resourceIndex];
+
+				// Two reads of the same kind do not need any synchronization, everything else does
+				if (currentAccess != passAccesses[i] || IsWriteAccess(currentAccess))
+				{
+					pass.barriers.push_back({ resourceIndex, currentAccess, passAccesses[i] });
+					currentAccess = passAccesses[i];
+				}
+			}
+		}
+
+		// Gives back the imported resources in the state expected outside of the graph
+		m_FinalBarriers.clear();
+
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			const RenderGraphResourceNode& resource = m_Resources[i];
+
+			if (resource.imported && resource.finalAccess != RG_ACCESS_NONE && currentAccesses[i] != resource.finalAccess)
+				m_FinalBarriers.push_back({ i, currentAccesses[i], resource.finalAccess });
+		}
+	}
+
+	void RenderGraph::AliasTransientResources()
+	{
+		// Offsets and sizes only, binding the blocks to memory is left to the RHI (IRenderGraphResources)
+		m_PhysicalResources.clear();
+		m_UnaliasedMemorySize = 0;
+
+		std::vector<RenderGraphResource> transients;
+
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			if (!m_Resources[i].imported && m_Resources[i].firstUse >= 0)
+				transients.push_back(i);
+		}
+
+		// Resources are placed in the order they start living
+		std::sort(transients.begin(), transients.end(), [this](RenderGraphResource _A, RenderGraphResource _B)
+			{
+				return m_Resources[_A].firstUse < m_Resources[_B].firstUse;
+			});
+
+		for (RenderGraphResource resourceIndex : transients)
+		{
+			RenderGraphResourceNode& resource = m_Resources[resourceIndex];
+
+			size_t size = static_cast<size_t>(resource.desc.width) * resource.desc.height * GetFormatSize(resource.desc.format);
+			m_UnaliasedMemorySize += size;
+
+			// Best fit between the blocks free before the resource starts, otherwise the biggest free block that will grow
+			int bestFit = -1;
+			int largestFree = -1;
+
+			for (size_t i = 0; i < m_PhysicalResources.size(); ++i)
+			{
+				const RenderGraphPhysicalResource& physical = m_PhysicalResources[i];
+
+				if (physical.lastUse >= resource.firstUse)
+					continue;
+
+				if (physical.size >= size && (bestFit < 0 || physical.size < m_PhysicalResources[bestFit].size))
+					bestFit = static_cast<int>(i);
+
+				if (largestFree < 0 || physical.size > m_PhysicalResources[largestFree].size)
+					largestFree = static_cast<int>(i);
+			}
+
+			int chosen = bestFit >= 0 ? bestFit : largestFree;
+
+			if (chosen < 0)
+			{
+				m_PhysicalResources.push_back(RenderGraphPhysicalResource());
+				chosen = static_cast<int>(m_PhysicalResources.size() - 1);
+			}
+
+			RenderGraphPhysicalResource& physical = m_PhysicalResources[chosen];
+			physical.size = std::max(physical.size, size);
+			physical.lastUse = resource.lastUse;
+
+			resource.physicalIndex = chosen;
+		}
+	}
+
+	void RenderGraph::Execute(const std::function<void(const std::vector<RenderGraphBarrier>&)>& _RecordBarriers)
+	{
+		if (!m_IsCompiled)
+		{
+			DEBUG_ERROR("Render graph executed without being compiled");
+			return;
+		}
+
+		for (RenderGraphPassHandle passIndex : m_ExecutionOrder)
+		{
+			RenderGraphPass& pass = m_Passes[passIndex];
+
+			if (_RecordBarriers && !pass.barriers.empty())
+				_RecordBarriers(pass.barriers);
+
+			if (pass.execute)
+				pass.execute();
+		}
+
+		if (_RecordBarriers && !m_FinalBarriers.empty())
+			_RecordBarriers(m_FinalBarriers);
+	}
+
+	void RenderGraph::Clear()
+	{
+		m_Resources.clear();
+		m_Passes.clear();
+		m_ExecutionOrder.clear();
+		m_PhysicalResources.clear();
+		m_FinalBarriers.clear();
+
+		m_UnaliasedMemorySize = 0;
+		m_IsCompiled = false;
+	}
+
+	size_t RenderGraph::GetTransientMemorySize() const
+	{
+		size_t size = 0;
+
+		for (const RenderGraphPhysicalResource& physical : m_PhysicalResources)
+			size += physical.size;
+
+		return size;
+	}
+
+	bool RenderGraph::IsWriteAccess(RenderGraphAccessFlags _Access)
+	{
+		return (_Access & (RG_ACCESS_COLOR_ATTACHMENT | RG_ACCESS_DEPTH_ATTACHMENT | RG_ACCESS_TRANSFER_WRITE)) != 0;
+	}
+
+	size_t RenderGraph::GetFormatSize(RenderGraphFormat _Format)
+	{
+		switch (_Format)
+		{
+		case RG_FORMAT_RGBA16F:
+			return 8;
+		case RG_FORMAT_RGBA8: case RG_FORMAT_DEPTH32: default:
+			return 4;
+		}
+	}
+}
\ No newline at end of file
@@ -1,9 +1,58 @@
 #include "Renderer.h"
 
 #include "RHI/VulkanRHI/VulkanRenderer.h"
+#include "RHI/ShaderCache.h"
+#include "RHI/RenderGraph.h"
+#include "MeshCache.h"
+
+#include <algorithm>
 
 namespace Core
 {
+	static const char* BASIC_VERTEX_SHADER_PATH = "Assets/Shaders/BasicShader.vert";
+	static const char* BASIC_FRAGMENT_SHADER_PATH = "Assets/Shaders/BasicShader.frag";
+	static const std::vector<std::string> BASIC_VERTEX_FEATURES = { "VERTEX_NO_COLOR", "VERTEX_NORMAL" };
+	static const std::vector<std::string> BASIC_FRAGMENT_FEATURES = { "ALPHA_TEST", "UNLIT" };
+	static const char* SHADER_ARCHIVE_PATH = "Assets/Shaders/Shaders.archive";
+
+	// Variant of BasicShader.vert reading the attributes stored by a vertex format
+	static ShaderVariantKey GetBasicVertexVariantKey(const ShaderVariantSet* _Variants, VertexFormat _Format)
+	{
+		VertexLayout layout = VertexLayout::Get(_Format);
+		ShaderVariantKey key = 0;
+
+		if (!layout.HasColor())
+			key |= _Variants->GetFeatureBit("VERTEX_NO_COLOR");
+
+		if (layout.HasNormal())
+			key |= _Variants->GetFeatureBit("VERTEX_NORMAL");
+
+		return key;
+	}
+
+	// Files whose change reloads the simple pipeline, the sources are always in it even when their compilation failed
+	static std::vector<std::filesystem::path> GetSimplePipelineDependencies(const std::vector<const IShader*>& _Shaders)
+	{
+		std::vector<std::filesystem::path> dependencies = { std::filesystem::weakly_canonical(BASIC_VERTEX_SHADER_PATH), std::filesystem::weakly_canonical(BASIC_FRAGMENT_SHADER_PATH) };
+
+		for (const IShader* shader : _Shaders)
+		{
+			if (shader == nullptr)
+				continue;
+
+			// Recorded by the includer during the compilation
+			for (const SourceDependency& dependency : shader->GetDependencies())
+			{
+				std::filesystem::path path = std::filesystem::weakly_canonical(dependency.path);
+
+				if (std::find(dependencies.begin(), dependencies.end(), path) == dependencies.end())
+					dependencies.push_back(path);
+			}
+		}
+
+		return dependencies;
+	}
+
 	const bool Renderer::Initialize(Window* _Window)
 	{
 		switch (m_RendererType)
@@ -23,12 +72,27 @@ namespace Core
 
 		m_SwapChain = m_RHI->InstantiateSwapChain(_Window, m_Device);
 
+		m_ThreadPool = new ThreadPool();
+
 		CreateSimplePipeline();
 
+		m_PipelineStateCache = new PipelineStateCache;
+		m_PipelineStateCache->Initialize(m_RHI, m_Device, m_SwapChain, m_ThreadPool, m_SimplePipeline);
+
+#ifdef SHADER_HOT_RELOAD
+		if (m_ShaderWatcher.Start("Assets/Shaders"))
+			WatchShaderDependencies();
+#endif
+
 		m_CommandAllocator = m_RHI->InstantiateCommandAllocator(m_Device);
 
 		m_CommandBuffers = m_CommandAllocator->CreateCommandBuffers(m_Device, MAX_FRAMES_IN_FLIGHT);
 
+		m_UploadManager = m_RHI->InstantiateUploadManager(m_Device, UPLOAD_STAGING_SIZE);
+
+		m_ResourceManager = new ResourceManager;
+		m_ResourceManager->Initialize(m_RHI, m_Device, m_ThreadPool, &Renderer::DeferDestruction);
+
 		m_DescriptorAllocator = m_RHI->InstantiateDescriptorAllocator(m_Device, m_SwapChain);
 
 		m_SwapChain->RecreateSwapChain(_Window, m_Device, m_SimplePipeline);
@@ -44,31 +108,129 @@ namespace Core
 			m_InFlightFramesFences[i] = m_RHI->InstantiateFence(m_Device);
 		}
 
-		mesh = m_RHI->CreateMesh();
-		mesh->Load(m_Device, "Assets/Meshes/viking_room.obj");
-
-		texture = m_RHI->CreateTexture();
-		texture->Load(m_Device, "Assets/Textures/viking_room.png");
+		CreatePlaceholders();
 
-		mcMesh = m_RHI->CreateMesh();
-		mcMesh->Load(m_Device, "Assets/Meshes/minecraft.obj");
+		LoadSceneAssets();
 
-		mctexture = m_RHI->CreateTexture();
-		mctexture->Load(m_Device, "Assets/Textures/minecraft.png");
+		model = LowRenderer::Model(mesh.get(), texture.get());
+		mcModel = LowRenderer::Model(mcMesh.get(), mctexture.get());
 
-		model = LowRenderer::Model(mesh, texture);
-		mcModel = LowRenderer::Model(mcMesh, mctexture);
+		// The simple pipeline cannot stand in for the pipelines of the other vertex formats, they are ready before the first frame
+		SetupModelPipelines();
+		m_PipelineStateCache->WaitPendingCompilations();
 
 		return true;
 	}
 
+	void Renderer::CreatePlaceholders()
+	{
+		std::vector<Vertex> vertices = {
+			{ Math::Vector3(-0.5f, -0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(0.f, 0.f) },
+			{ Math::Vector3(0.5f, -0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(1.f, 0.f) },
+			{ Math::Vector3(0.5f, 0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(1.f, 1.f) },
+			{ Math::Vector3(-0.5f, 0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(0.f, 1.f) }
+		};
+
+		std::vector<uint32_t> indices = { 0, 1, 2, 2, 3, 0 };
+
+		// Drawn with the pipelines of the models, which read the vertex format of their meshes
+		m_PlaceholderMesh = m_RHI->CreateMesh();
+		m_PlaceholderMesh->SetVertexFormat(MESH_VERTEX_FORMAT);
+		m_PlaceholderMesh->CreateVertexBuffer(m_Device, vertices);
+		m_PlaceholderMesh->CreateIndexBuffer(m_Device, indices);
+
+		// Magenta and black checkerboard
+		std::vector<unsigned char> pixels = {
+			255, 0, 255, 255, 0, 0, 0, 255,
+			0, 0, 0, 255, 255, 0, 255, 255
+		};
+
+		m_PlaceholderTexture = m_RHI->CreateTexture();
+		m_PlaceholderTexture->Upload(m_Device, pixels.data(), 2, 2);
+	}
+
+	void Renderer::LoadSceneAssets()
+	{
+		std::chrono::high_resolution_clock::time_point loadStart = std::chrono::high_resolution_clock::now();
+
+		// Called on the main thread by the frame uploading the last asset
+		std::shared_ptr<unsigned int> remainingCount = std::make_shared<unsigned int>(4);
+
+		LoadCallback onLoaded = [remainingCount, loadStart](bool _IsLoaded)
+			{
+				if (!_IsLoaded)
+					DEBUG_WARN("A scene asset failed to load, its placeholder stays drawn");
+
+				if (--*remainingCount > 0)
+					return;
+
+				std::chrono::duration<double, std::milli> loadTime = std::chrono::high_resolution_clock::now() - loadStart;
+				DEBUG_LOG("Scene assets ready %f ms after their request, %u upload queue submissions, %u mesh cache hits, %u mesh cache misses", loadTime.count(),
+					m_UploadManager->GetSubmissionCount(), MeshCache::GetHitCount(), MeshCache::GetMissCount());
+				DEBUG_LOG("16 bits indices saved %d KB over the meshes loaded", static_cast<int>(IMesh::GetSavedIndexMemory() / 1024));
+				m_ResourceManager->LogStatistics();
+			};
+
+		mesh = m_ResourceManager->LoadMeshAsync("Assets/Meshes/viking_room.obj", MESH_VERTEX_FORMAT, onLoaded);
+		texture = m_ResourceManager->LoadTextureAsync("Assets/Textures/viking_room.png", onLoaded);
+
+		mcMesh = m_ResourceManager->LoadMeshAsync("Assets/Meshes/minecraft.obj", MESH_VERTEX_FORMAT, onLoaded);
+		mctexture = m_ResourceManager->LoadTextureAsync("Assets/Textures/minecraft.png", onLoaded);
+
+		// The first frame can start now, the placeholders are drawn until the workers are done
+		std::chrono::duration<double, std::milli> requestTime = std::chrono::high_resolution_clock::now() - loadStart;
+		DEBUG_LOG("Scene assets requested in %f ms", requestTime.count());
+	}
+
 	void Renderer::CreateSimplePipeline()
 	{
-		IShader* vertShader = m_RHI->CreateShader();
-		vertShader->Load(m_Device, "Assets/Shaders/BasicShader.vert");
+		std::chrono::high_resolution_clock::time_point shaderStart = std::chrono::high_resolution_clock::now();
+
+#ifndef SHADER_HOT_RELOAD
+		// Shaders missing from the archive are still compiled when the runtime compilation is enabled
+		m_ShaderArchive = new ShaderArchive;
+
+		if (m_ShaderArchive->Open(SHADER_ARCHIVE_PATH))
+		{
+			ShaderArchive::SetMainArchive(m_ShaderArchive);
+			DEBUG_LOG("Shader archive mapped, %u shaders", m_ShaderArchive->GetEntryCount());
+		}
+		else
+		{
+			delete m_ShaderArchive;
+			m_ShaderArchive = nullptr;
+		}
+#endif
+
+		// Variants of the other vertex formats are compiled when a model uses them
+		m_BasicVertexVariants = new ShaderVariantSet;
+
+		// Shaders are compiled in parallel, the pipeline waits for all of them
+		std::future<bool> vertLoaded = m_ThreadPool->Submit([]()
+			{
+				return m_BasicVertexVariants->Load(BASIC_VERTEX_SHADER_PATH, BASIC_VERTEX_FEATURES) && m_BasicVertexVariants->GetVariant(m_Device, 0) != nullptr;
+			});
+
+		// Other variants are compiled when a pipeline asks for them
+		m_BasicFragmentVariants = new ShaderVariantSet;
 
-		IShader* fragShader = m_RHI->CreateShader();
-		fragShader->Load(m_Device, "Assets/Shaders/BasicShader.frag");
+		bool fragCompiled = m_BasicFragmentVariants->Load(BASIC_FRAGMENT_SHADER_PATH, BASIC_FRAGMENT_FEATURES)
+			&& m_BasicFragmentVariants->Precompile(m_Device, { 0 });
+
+		IShader* fragShader = m_BasicFragmentVariants->FindVariant(0);
+
+		bool vertCompiled = vertLoaded.get();
+
+		IShader* vertShader = m_BasicVertexVariants->FindVariant(0);
+
+		if (!vertCompiled || !fragCompiled)
+		{
+			DEBUG_ERROR("Failed to compile the shaders of the simple pipeline");
+		}
+
+		// Cold start compiles everything, warm start only reads the SPIR-V cache, the archive needs neither
+		std::chrono::duration<double, std::milli> shaderTime = std::chrono::high_resolution_clock::now() - shaderStart;
+		DEBUG_LOG("Shaders loaded in %f ms, %u cache hits, %u cache misses", shaderTime.count(), ShaderCache::GetHitCount(), ShaderCache::GetMissCount());
 
 		PipelineShaderInfos vert;
 		vert.shader = vertShader;
@@ -80,21 +242,207 @@ namespace Core
 		frag.shaderType = RHI_FRAGMENT;
 		frag.functionEntry = "main";
 
-		std::vector<PipelineShaderInfos> shadersInfos = { vert, frag };
+		// Default states, opaque with depth test and back face culling
+		m_SimplePipelineDescription = PipelineDescription();
+		m_SimplePipelineDescription.shaders = { vert, frag };
+
+		std::chrono::high_resolution_clock::time_point pipelineStart = std::chrono::high_resolution_clock::now();
+
+		m_SimplePipeline = m_RHI->InstantiatePipeline(m_Device, m_SwapChain, m_SimplePipelineDescription);
+
+		// Warm start finds the pipeline in the pipeline cache of the previous run
+		std::chrono::duration<double, std::milli> pipelineTime = std::chrono::high_resolution_clock::now() - pipelineStart;
+		DEBUG_LOG("Simple pipeline created in %f ms", pipelineTime.count());
+
+		m_ShaderDependencies = GetSimplePipelineDependencies({ vertShader, fragShader });
+	}
+
+	void Renderer::UpdateShaderHotReload()
+	{
+		if (m_ShaderReload.valid())
+		{
+			// Never waits for the compilation, the frame is drawn with the current pipeline meanwhile
+			if (m_ShaderReload.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return;
+
+			if (m_ShaderReload.get())
+			{
+				// Pipelines compiling on the workers read the shaders of the previous variants
+				m_PipelineStateCache->WaitPendingCompilations();
+
+				m_SimplePipeline->SwapReloadedPipeline();
+				m_PipelineStateCache->RegisterFallbackPipeline();
+
+				ShaderVariantSet* previousVertexVariants = m_BasicVertexVariants;
+				ShaderVariantSet* previousFragmentVariants = m_BasicFragmentVariants;
+
+				m_BasicVertexVariants = m_ReloadedVertexVariants;
+				m_BasicFragmentVariants = m_ReloadedFragmentVariants;
+				m_ReloadedVertexVariants = nullptr;
+				m_ReloadedFragmentVariants = nullptr;
+
+				// Shader modules are not needed anymore once the pipelines are created, released with the previous pipeline
+				DeferDestruction([previousVertexVariants, previousFragmentVariants]()
+					{
+						previousVertexVariants->Unload(m_Device);
+						delete previousVertexVariants;
+
+						previousFragmentVariants->Unload(m_Device);
+						delete previousFragmentVariants;
+					});
+
+				m_ShaderDependencies = std::move(m_ReloadedShaderDependencies);
+				WatchShaderDependencies();
+
+				// The descriptions must not point to the variants destroyed
+				m_SimplePipelineDescription.shaders[0].shader = m_BasicVertexVariants->FindVariant(0);
+				m_SimplePipelineDescription.shaders[1].shader = m_BasicFragmentVariants->FindVariant(0);
+				SetupModelPipelines();
+
+				std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - m_ShaderEditTime;
+				DEBUG_LOG("Shaders reloaded, %f ms from the edit to the first frame recorded with them", latency.count());
+			}
+			else
+			{
+				DEBUG_WARN("Shader reload failed, the previous pipeline is kept");
+			}
+		}
+
+		std::vector<std::filesystem::path> changedFiles;
+
+		if (!m_ShaderWatcher.IsRunning() || !m_ShaderWatcher.PollChanges(changedFiles, m_ShaderEditTime))
+			return;
+
+		bool isDependencyChanged = false;
+
+		for (const std::filesystem::path& changedFile : changedFiles)
+		{
+			// The next compilations read the file again even if its write time did not change
+			SourceFileCache::Invalidate(changedFile);
+
+			std::filesystem::path path = std::filesystem::weakly_canonical(changedFile);
+
+			if (std::find(m_ShaderDependencies.begin(), m_ShaderDependencies.end(), path) != m_ShaderDependencies.end())
+				isDependencyChanged = true;
+		}
+
+		if (!isDependencyChanged)
+			return;
+
+		m_ShaderReload = m_ThreadPool->Submit([this]()
+			{
+				return ReloadSimplePipeline();
+			});
+	}
+
+	void Renderer::WatchShaderDependencies()
+	{
+		if (!m_ShaderWatcher.IsRunning())
+			return;
+
+		for (const std::filesystem::path& dependency : m_ShaderDependencies)
+			m_ShaderWatcher.WatchDirectory(dependency.parent_path());
+	}
+
+	const bool Renderer::ReloadSimplePipeline()
+	{
+		// Compiled on this worker only, waiting for other jobs from a job could block the pool
+		// The variants of the other vertex formats are compiled again when the models ask for their pipelines
+		ShaderVariantSet* vertVariants = new ShaderVariantSet;
+		ShaderVariantSet* fragVariants = new ShaderVariantSet;
+
+		bool isCompiled = vertVariants->Load(BASIC_VERTEX_SHADER_PATH, BASIC_VERTEX_FEATURES)
+			&& vertVariants->GetVariant(m_Device, 0) != nullptr
+			&& fragVariants->Load(BASIC_FRAGMENT_SHADER_PATH, BASIC_FRAGMENT_FEATURES)
+			&& fragVariants->GetVariant(m_Device, 0) != nullptr;
+
+		if (isCompiled)
+		{
+			PipelineShaderInfos vert;
+			vert.shader = vertVariants->FindVariant(0);
+			vert.shaderType = RHI_VERTEX;
+			vert.functionEntry = "main";
+
+			PipelineShaderInfos frag;
+			frag.shader = fragVariants->FindVariant(0);
+			frag.shaderType = RHI_FRAGMENT;
+			frag.functionEntry = "main";
+
+			isCompiled = m_SimplePipeline->CreateReloadedPipeline(m_Device, { vert, frag }) == RHI_SUCCESS;
+		}
+
+		if (isCompiled)
+			m_ReloadedShaderDependencies = GetSimplePipelineDependencies({ vertVariants->FindVariant(0), fragVariants->FindVariant(0) });
+
+		if (!isCompiled)
+		{
+			vertVariants->Unload(m_Device);
+			delete vertVariants;
+
+			fragVariants->Unload(m_Device);
+			delete fragVariants;
+			return false;
+		}
+
+		m_ReloadedVertexVariants = vertVariants;
+		m_ReloadedFragmentVariants = fragVariants;
+
+		return true;
+	}
+
+	PipelineDescription Renderer::CreateMeshPipelineDescription(IMesh* _Mesh)
+	{
+		PipelineDescription description = m_SimplePipelineDescription;
+		description.vertexFormat = _Mesh->GetVertexFormat();
+		description.shaders[0].shader = m_BasicVertexVariants->GetVariant(m_Device, GetBasicVertexVariantKey(m_BasicVertexVariants, description.vertexFormat));
+
+		return description;
+	}
+
+	void Renderer::SetupModelPipelines()
+	{
+		for (LowRenderer::Model* drawnModel : { &model, &mcModel })
+		{
+			const PipelineDescription* currentDescription = drawnModel->GetPipelineDescription();
+
+			// Drawn with the simple pipeline
+			if (currentDescription == nullptr && drawnModel->GetMesh()->GetVertexFormat() == RHI_VERTEX_FORMAT_DEFAULT)
+				continue;
+
+			PipelineDescription description = CreateMeshPipelineDescription(drawnModel->GetMesh());
+
+			// A model given its own raster state keeps it when the shaders are reloaded
+			if (currentDescription != nullptr)
+				description.raster = currentDescription->raster;
 
-		m_SimplePipeline = m_RHI->InstantiatePipeline(m_Device, m_SwapChain, shadersInfos);
+			if (description.shaders[0].shader == nullptr)
+			{
+				DEBUG_ERROR("No vertex shader for the vertex format %d, the model is not drawn", static_cast<int>(description.vertexFormat));
+				continue;
+			}
 
-		fragShader->Unload(m_Device);
-		vertShader->Unload(m_Device);
+			drawnModel->SetPipelineDescription(description);
 
-		m_RHI->DestroyShader(vertShader);
-		m_RHI->DestroyShader(fragShader);
+			// Starts the compilation
+			m_PipelineStateCache->GetPipeline(description, drawnModel->GetPipelineDescriptionHash());
+		}
 	}
 
 	void Renderer::StartFrame(Window* _Window, LowRenderer::Camera* _Camera)
 	{
 		m_InFlightFramesFences[m_CurrentFrame]->WaitFence(m_Device, UINT64_MAX);
 		m_InFlightFramesFences[m_CurrentFrame]->ResetFence(m_Device);
+
+		// The fence waited belongs to the frame submitted MAX_FRAMES_IN_FLIGHT frames ago, it and the previous ones are finished
+		if (m_FrameNumber >= MAX_FRAMES_IN_FLIGHT)
+		{
+			m_DeletionQueue.Flush(m_FrameNumber - MAX_FRAMES_IN_FLIGHT);
+		}
+
+		// Assets decoded since the last frame are uploaded with this one, they are drawn from it on
+		m_ResourceManager->ProcessLoads();
+
+		UpdateShaderHotReload();
 		
 		m_SwapChain->AcquireNextImage(_Window, m_Device, m_SimplePipeline, UINT64_MAX, m_ImageAvailableSemaphores[m_CurrentFrame], imageIndex);
 
@@ -112,71 +460,211 @@ namespace Core
 
 	void Renderer::EndFrame(Window* _Window)
 	{
+		// After the last barriers of the frame graph
+		m_CommandBuffers[m_CurrentFrame]->StopRecordingCommandBuffer();
+
+		// Resources created during the frame are uploaded before the frame is executed
+		m_UploadManager->FlushUploads(m_Device);
+
 		m_SwapChain->SubmitGraphicsQueue(m_Device, m_CommandBuffers[m_CurrentFrame], m_ImageAvailableSemaphores[m_CurrentFrame], m_RenderFinishedSemaphores[m_CurrentFrame], m_InFlightFramesFences[m_CurrentFrame]);
 		m_SwapChain->SubmitPresentQueue(_Window, m_Device, m_SimplePipeline, m_RenderFinishedSemaphores[m_CurrentFrame], imageIndex);
 
 		m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+		++m_FrameNumber;
+	}
+
+	const bool Renderer::CreateFrameGraphResources(const RenderGraph& _Graph, RenderGraphResource _Depth)
+	{
+		// The frames in flight still use the textures of the previous graph
+		m_Device->WaitDeviceIdle();
+
+		if (m_FrameGraphResources != nullptr)
+		{
+			m_RHI->DestroyRenderGraphResources(m_FrameGraphResources, m_Device);
+			m_FrameGraphResources = nullptr;
+		}
+
+		m_FrameGraphResources = m_RHI->InstantiateRenderGraphResources(m_Device, m_SwapChain, _Graph);
+
+		if (m_FrameGraphResources == nullptr)
+		{
+			DEBUG_ERROR("Failed to create the frame graph textures");
+			return false;
+		}
+
+		return m_SwapChain->SetDepthAttachment(m_Device, m_SimplePipeline, m_FrameGraphResources, _Depth);
+	}
+
+	void Renderer::RecordFrameGraphBarriers(const std::vector<RenderGraphBarrier>& _Barriers)
+	{
+		m_FrameGraphResources->RecordBarriers(m_Device, m_CommandBuffers[m_CurrentFrame], _Barriers, imageIndex);
 	}
 
 	void Renderer::SetupTexturedModelPass()
 	{
 		m_CommandBuffers[m_CurrentFrame]->StartRenderPass(m_SimplePipeline, m_SwapChain, imageIndex, Math::Vector4(0.1f, 0.3f, 1.f, 1.f));
 		m_CommandBuffers[m_CurrentFrame]->BindPipeline(m_SimplePipeline);
+		m_BoundPipeline = m_SimplePipeline;
 		m_CommandBuffers[m_CurrentFrame]->SetViewport(Math::Vector2::zero, m_SwapChain, 0.f, 1.f);
 		m_CommandBuffers[m_CurrentFrame]->SetScissor(Math::Vector2::zero, m_SwapChain);
 	}
 
 	void Renderer::TexturedModelPass(LowRenderer::Camera* _Camera, LowRenderer::Model* _Model)
 	{
-		Math::Matrix4 localTRS = _Model->m_Transform.m_LocalTRS;
+		// Assets still loading are replaced by the placeholders
+		IMesh* drawnMesh = _Model->GetMesh()->IsReady() ? _Model->GetMesh() : m_PlaceholderMesh;
+		ITexture* drawnTexture = _Model->GetTexture()->IsReady() ? _Model->GetTexture() : m_PlaceholderTexture;
+
+		LowRenderer::ModelData data;
+		data.modelMatrix = _Model->m_Transform.GetWorldTRS();
+		data.dequantization = drawnMesh->GetDequantization();
+
+		_Model->GetUBO(m_CurrentFrame)->UpdateUBO(m_Device, &data, sizeof(data));
+
+		// Never waits for a pipeline, the simple one is used while the model's one compiles
+		const PipelineDescription* description = _Model->GetPipelineDescription();
+		IPipeline* pipeline = _Model->GetPipeline();
+
+		if (pipeline == nullptr)
+		{
+			pipeline = description != nullptr ? m_PipelineStateCache->GetPipeline(*description, _Model->GetPipelineDescriptionHash()) : m_SimplePipeline;
+
+			// Once compiled, the next draws of the model do not go through the cache
+			if (description != nullptr && pipeline != m_PipelineStateCache->GetFallbackPipeline())
+				_Model->SetPipeline(pipeline);
+		}
+
+		// The simple pipeline reads the default vertex format only, the model waits for its own pipeline
+		if (pipeline->GetDescription().vertexFormat != drawnMesh->GetVertexFormat())
+			return;
+
+		if (pipeline != m_BoundPipeline)
+		{
+			m_CommandBuffers[m_CurrentFrame]->BindPipeline(pipeline);
+			m_BoundPipeline = pipeline;
+		}
 
-		_Model->GetUBO(m_CurrentFrame)->UpdateUBO(m_Device, &localTRS, sizeof(localTRS));
+		// Pipelines built from the same shaders share their set layouts, the descriptor sets are compatible
+		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(pipeline, _Model->GetDescriptor(m_CurrentFrame), 0); // TRS
+		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(pipeline, _Camera->GetDescriptor(m_CurrentFrame), 1);// Camera
+		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(pipeline, drawnTexture->GetDescriptor(m_CurrentFrame), 2); // Texture
 
-		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(m_SimplePipeline, _Model->GetDescriptor(m_CurrentFrame), 0); // TRS
-		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(m_SimplePipeline, _Camera->GetDescriptor(m_CurrentFrame), 1);// Camera
-		m_CommandBuffers[m_CurrentFrame]->BindDescriptorSet(m_SimplePipeline, _Model->GetTexture()->GetDescriptor(m_CurrentFrame), 2); // Texture
+		m_CommandBuffers[m_CurrentFrame]->BindVertexBuffer(drawnMesh);
+		m_CommandBuffers[m_CurrentFrame]->BindIndexBuffer(drawnMesh);
 
-		m_CommandBuffers[m_CurrentFrame]->BindVertexBuffer(_Model->GetMesh());
-		m_CommandBuffers[m_CurrentFrame]->BindIndexBuffer(_Model->GetMesh());
+#ifdef CLUSTER_CULLING
+		const std::vector<Meshlet>& meshlets = drawnMesh->GetMeshlets();
 
-		m_CommandBuffers[m_CurrentFrame]->DrawIndexed(_Model->GetMesh());
+		if (!meshlets.empty())
+		{
+			// Same transform as the vertex shader, the model matrix is stored transposed
+			Math::Matrix4 clipFromModel = _Camera->projectionMatrix.Multiply(_Camera->viewMatrix).Multiply(data.modelMatrix.Transpose());
+			const RasterState& raster = pipeline->GetDescription().raster;
+
+			LowRenderer::ClusterCullingView view = LowRenderer::ClusterCuller::MakeView(clipFromModel, raster.cullMode == RHI_CULL_BACK, raster.isFrontFaceCounterClockwise);
+			LowRenderer::ClusterCuller::Cull(meshlets, view, m_ClusterDraws);
+
+			m_CommandBuffers[m_CurrentFrame]->DrawIndexed(m_ClusterDraws);
+			return;
+		}
+#endif
+
+		m_CommandBuffers[m_CurrentFrame]->DrawIndexed(drawnMesh);
 	}
 
 	void Renderer::FinishTexturedModelPass()
 	{
 		m_CommandBuffers[m_CurrentFrame]->EndRenderPass();
-		m_CommandBuffers[m_CurrentFrame]->StopRecordingCommandBuffer();
 	}
 
 	const bool Renderer::Terminate(LowRenderer::Camera* _Camera)
 	{
+		m_ShaderWatcher.Stop();
+
+		// A reload still compiling uses the pipeline
+		if (m_ShaderReload.valid())
+			m_ShaderReload.get();
+
 		m_Device->WaitDeviceIdle();
+
+		// Nothing is used by the GPU anymore
+		m_DeletionQueue.FlushAll();
+
+		// Waits for the pipelines still compiling, they use the shaders and the swap chain
+		m_PipelineStateCache->Terminate();
+		delete m_PipelineStateCache;
+		m_PipelineStateCache = nullptr;
+
+		// Mesh put by the stress test
+		if (mcModel.GetMesh() != mcMesh.get())
+		{
+			mcModel.GetMesh()->Unload(m_Device);
+			m_RHI->DestroyMesh(mcModel.GetMesh());
+		}
 		
 		_Camera->DeleteDescriptors();
 
 		model.DestroyDescriptors();
 		mcModel.DestroyDescriptors();
 
-		mcMesh->Unload(m_Device);
-
-		m_RHI->DestroyMesh(mcMesh);
-
-		mctexture->Unload(m_Device);
+		// The last handles queue the destructions of the resources, run right away as the device is idle
+		mcMesh.reset();
+		mctexture.reset();
+		mesh.reset();
+		texture.reset();
 
-		m_RHI->DestroyTexture(mctexture);
+		// Loads still pending hold their resources
+		m_ResourceManager->Terminate();
 
-		mesh->Unload(m_Device);
+		m_DeletionQueue.FlushAll();
 
-		m_RHI->DestroyMesh(mesh);
+		delete m_ResourceManager;
+		m_ResourceManager = nullptr;
 
-		texture->Unload(m_Device);
+		m_PlaceholderMesh->Unload(m_Device);
+		m_RHI->DestroyMesh(m_PlaceholderMesh);
+		m_PlaceholderMesh = nullptr;
 
-		m_RHI->DestroyTexture(texture);
+		m_PlaceholderTexture->Unload(m_Device);
+		m_RHI->DestroyTexture(m_PlaceholderTexture);
+		m_PlaceholderTexture = nullptr;
 
 		m_RHI->DestroySwapChain(m_SwapChain, m_Device);
 
+		// Depth of the framebuffers destroyed with the swap chain
+		if (m_FrameGraphResources != nullptr)
+		{
+			m_RHI->DestroyRenderGraphResources(m_FrameGraphResources, m_Device);
+			m_FrameGraphResources = nullptr;
+		}
+
 		m_RHI->DestroyPipeline(m_SimplePipeline, m_Device);
 
+		m_BasicFragmentVariants->Unload(m_Device);
+		delete m_BasicFragmentVariants;
+		m_BasicFragmentVariants = nullptr;
+
+		m_BasicVertexVariants->Unload(m_Device);
+		delete m_BasicVertexVariants;
+		m_BasicVertexVariants = nullptr;
+
+		// Every shader module is created, nothing points in the archive anymore
+		ShaderArchive::SetMainArchive(nullptr);
+		delete m_ShaderArchive;
+		m_ShaderArchive = nullptr;
+
+		// Reload finished but never swapped
+		if (m_ReloadedFragmentVariants != nullptr)
+		{
+			m_ReloadedVertexVariants->Unload(m_Device);
+			delete m_ReloadedVertexVariants;
+			m_ReloadedVertexVariants = nullptr;
+
+			m_ReloadedFragmentVariants->Unload(m_Device);
+			delete m_ReloadedFragmentVariants;
+			m_ReloadedFragmentVariants = nullptr;
+		}
+
 		for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
 		{
 			m_RHI->DestroySemaphore(m_ImageAvailableSemaphores[i], m_Device);
@@ -188,13 +676,50 @@ namespace Core
 
 		m_RHI->DestroyCommandBuffers(m_Device, m_CommandBuffers);
 
+		m_RHI->DestroyUploadManager(m_UploadManager, m_Device);
+
 		m_RHI->DestroyCommandAllocator(m_CommandAllocator, m_Device);
 
 		m_RHI->DestroyDevice(m_Device);
 
+		delete m_ThreadPool;
+		m_ThreadPool = nullptr;
+
 		delete m_RHI;
 		m_RHI = nullptr;
 
 		return true;
 	}
+
+	void Renderer::DeferDestruction(const std::function<void()>& _Destroy)
+	{
+		// The frame being recorded may use the resource, so it is the last frame to wait for
+		m_DeletionQueue.Push(m_FrameNumber, _Destroy);
+	}
+
+	void Renderer::DestroyMeshDeferred(IMesh* _Mesh)
+	{
+		DeferDestruction([_Mesh]()
+			{
+				_Mesh->Unload(m_Device);
+				m_RHI->DestroyMesh(_Mesh);
+			});
+	}
+
+	void Renderer::DestroyTextureDeferred(ITexture* _Texture)
+	{
+		DeferDestruction([_Texture]()
+			{
+				_Texture->Unload(m_Device);
+				m_RHI->DestroyTexture(_Texture);
+			});
+	}
+
+	std::future<bool> Renderer::LoadShaderAsync(IShader* _Shader, const std::filesystem::path& _ResourcePath)
+	{
+		return m_ThreadPool->Submit([_Shader, _ResourcePath]()
+			{
+				return _Shader->Load(m_Device, _ResourcePath);
+			});
+	}
 }
\ No newline at end of file
@@ -0,0 +1,568 @@
+#include "RendererBenchmarks.h"
+
+#include "RHI/ShaderCache.h"
+#include "MeshCache.h"
+#include "GltfImporter.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Core
+{
+	static const char* BASIC_FRAGMENT_SHADER_PATH = "Assets/Shaders/BasicShader.frag";
+
+	const bool RendererBenchmarks::Select(int _Argc, char** _Argv)
+	{
+		const char* names[] = { SHADER_COMPILATION, SHADER_PERMUTATIONS, GLTF_IMPORT, RESOURCE_DEDUPLICATION, ASYNC_LOADING, UPLOAD_BATCHING, PIPELINE_STATE_CACHE, RESOURCE_CHURN };
+
+		for (int i = 1; i < _Argc; ++i)
+		{
+			if (std::find_if(std::begin(names), std::end(names), [_Argv, i](const char* _Name) { return std::strcmp(_Argv[i], _Name) == 0; }) == std::end(names))
+			{
+				DEBUG_ERROR("Unknown renderer benchmark: %s", _Argv[i]);
+				return false;
+			}
+
+			m_Selected.push_back(_Argv[i]);
+		}
+
+		return true;
+	}
+
+	void RendererBenchmarks::RunStartup(Renderer& _Renderer)
+	{
+		if (IsSelected(SHADER_COMPILATION))
+			BenchmarkShaderCompilation(BASIC_FRAGMENT_SHADER_PATH, RHI_FRAGMENT, 64);
+
+		if (IsSelected(SHADER_PERMUTATIONS))
+			BenchmarkShaderPermutations(10000000);
+
+		if (IsSelected(GLTF_IMPORT))
+		{
+			BenchmarkGltfImport("Assets/Meshes/viking_room.obj", 5);
+			BenchmarkGltfImport("Assets/Meshes/minecraft.obj", 5);
+		}
+
+		if (IsSelected(RESOURCE_DEDUPLICATION))
+			TestResourceDeduplication("Assets/Meshes/viking_room.obj", "Assets/Textures/viking_room.png", 1000);
+
+		if (IsSelected(ASYNC_LOADING))
+		{
+			// The scene is loaded first so every mesh of the benchmark is read from the mesh cache in both runs
+			Renderer::GetResourceManager()->WaitPendingLoads();
+			BenchmarkAsyncLoading({ "Assets/Meshes/viking_room.obj", "Assets/Meshes/minecraft.obj" }, { "Assets/Textures/viking_room.png", "Assets/Textures/minecraft.png" }, 100);
+		}
+
+		if (IsSelected(UPLOAD_BATCHING))
+			BenchmarkUploadBatching("Assets/Meshes/viking_room.obj", 500);
+
+		if (IsSelected(PIPELINE_STATE_CACHE))
+			TestPipelineStateCache(_Renderer.mcModel);
+	}
+
+	void RendererBenchmarks::RunFrame(Renderer& _Renderer)
+	{
+		if (IsSelected(RESOURCE_CHURN))
+			StressTestResourceChurn(_Renderer);
+	}
+
+	void RendererBenchmarks::BenchmarkShaderCompilation(const std::filesystem::path& _ResourcePath, ShaderType _ShaderType, unsigned int _VariantCount)
+	{
+		IRendererHardware* rhi = Renderer::GetRHI();
+		IDevice* device = Renderer::GetDevice();
+
+		std::ifstream shaderFile(_ResourcePath);
+
+		if (!shaderFile.is_open())
+		{
+			DEBUG_ERROR("Failed to open benchmark shader: %s", _ResourcePath.string().c_str());
+			return;
+		}
+
+		std::string versionLine;
+		std::getline(shaderFile, versionLine);
+
+		std::string body((std::istreambuf_iterator<char>(shaderFile)), std::istreambuf_iterator<char>());
+
+		// Every variant has a different preprocessed source, so none of them hits the cache of another one
+		std::vector<std::string> names(_VariantCount);
+		std::vector<std::string> sources(_VariantCount);
+
+		for (unsigned int i = 0; i < _VariantCount; ++i)
+		{
+			names[i] = _ResourcePath.filename().string() + "_variant" + std::to_string(i);
+			sources[i] = versionLine + "\n#define VARIANT_ID " + std::to_string(i) + "\nconst int variantId = VARIANT_ID;\n" + body;
+		}
+
+		std::filesystem::path cacheDirectory = ShaderCache::GetCacheDirectory();
+		std::filesystem::path benchmarkDirectory = cacheDirectory / "Benchmark";
+
+		const unsigned int threadCounts[] = { 1, 2, 4, 8, 16 };
+
+		for (unsigned int threadCount : threadCounts)
+		{
+			// Starts cold every time
+			std::error_code error;
+			std::filesystem::remove_all(benchmarkDirectory, error);
+			ShaderCache::SetCacheDirectory(benchmarkDirectory);
+
+			std::vector<IShader*> shaders(_VariantCount);
+
+			for (unsigned int i = 0; i < _VariantCount; ++i)
+				shaders[i] = rhi->CreateShader();
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			{
+				ThreadPool pool(threadCount);
+				std::vector<std::future<bool>> compilations;
+
+				for (unsigned int i = 0; i < _VariantCount; ++i)
+				{
+					compilations.push_back(pool.Submit([&, i]()
+						{
+							return shaders[i]->CompileShader(device, names[i].c_str(), sources[i], _ShaderType);
+						}));
+				}
+
+				for (std::future<bool>& compilation : compilations)
+					compilation.get();
+			}
+
+			std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+			DEBUG_LOG("%u shader variants compiled with %u threads in %f ms", _VariantCount, threadCount, time.count());
+
+			for (IShader* shader : shaders)
+			{
+				shader->Unload(device);
+				rhi->DestroyShader(shader);
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::remove_all(benchmarkDirectory, error);
+		ShaderCache::SetCacheDirectory(cacheDirectory);
+	}
+
+	void RendererBenchmarks::BenchmarkShaderPermutations(unsigned int _LookupCount)
+	{
+		IDevice* device = Renderer::GetDevice();
+		ShaderVariantSet* fragmentVariants = Renderer::GetBasicFragmentVariants();
+
+		std::vector<ShaderVariantKey> allKeys;
+
+		for (ShaderVariantKey key = 0; key < fragmentVariants->GetVariantCount(); ++key)
+			allKeys.push_back(key);
+
+		unsigned int hitsBefore = ShaderCache::GetHitCount();
+
+		std::chrono::high_resolution_clock::time_point compileStart = std::chrono::high_resolution_clock::now();
+
+		fragmentVariants->Precompile(device, allKeys);
+
+		std::chrono::duration<double, std::milli> compileTime = std::chrono::high_resolution_clock::now() - compileStart;
+		DEBUG_LOG("%u fragment variants ready in %f ms, %u from the cache", static_cast<unsigned int>(allKeys.size()), compileTime.count(), ShaderCache::GetHitCount() - hitsBefore);
+
+		// Same access pattern as a draw loop switching of material every draw
+		ShaderVariantKey mask = static_cast<ShaderVariantKey>(fragmentVariants->GetVariantCount() - 1);
+		size_t found = 0;
+
+		std::chrono::high_resolution_clock::time_point lookupStart = std::chrono::high_resolution_clock::now();
+
+		for (unsigned int i = 0; i < _LookupCount; ++i)
+		{
+			if (fragmentVariants->FindVariant((i * 2654435761u >> 16) & mask) != nullptr)
+				++found;
+		}
+
+		std::chrono::duration<double, std::milli> lookupTime = std::chrono::high_resolution_clock::now() - lookupStart;
+		DEBUG_LOG("%u variant lookups in %f ms, %f ns per lookup (%u found)", _LookupCount, lookupTime.count(), lookupTime.count() * 1000000.0 / _LookupCount, static_cast<unsigned int>(found));
+	}
+
+	void RendererBenchmarks::BenchmarkGltfImport(const std::filesystem::path& _ResourcePath, unsigned int _RunCount)
+	{
+		IRendererHardware* rhi = Renderer::GetRHI();
+		IDevice* device = Renderer::GetDevice();
+		IUploadManager* uploadManager = Renderer::GetUploadManager();
+
+		std::filesystem::path cacheDirectory = MeshCache::GetCacheDirectory();
+		std::filesystem::path benchmarkDirectory = cacheDirectory / "Benchmark";
+		std::filesystem::path glbPath = benchmarkDirectory / _ResourcePath.filename().replace_extension(".glb");
+
+		double importTime = 0.0;
+		double cachedTime = 0.0;
+		double glbTime = 0.0;
+		size_t nodeCount = 0;
+
+		auto measure = [](double& _BestTime, unsigned int _Run, std::chrono::high_resolution_clock::time_point _Start)
+			{
+				std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - _Start;
+				_BestTime = _Run == 0 ? time.count() : std::min(_BestTime, time.count());
+			};
+
+		for (unsigned int run = 0; run < _RunCount; ++run)
+		{
+			// Starts cold every time
+			std::error_code error;
+			std::filesystem::remove_all(benchmarkDirectory, error);
+			MeshCache::SetCacheDirectory(benchmarkDirectory);
+
+			IMesh* importedMesh = rhi->CreateMesh();
+			IMesh* cachedMesh = rhi->CreateMesh();
+			GltfScene scene;
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			bool isLoaded = importedMesh->Load(device, _ResourcePath);
+			measure(importTime, run, start);
+
+			start = std::chrono::high_resolution_clock::now();
+			isLoaded = isLoaded && cachedMesh->Load(device, _ResourcePath);
+			measure(cachedTime, run, start);
+
+			// The cached streams are in the default vertex format, the buffer views of the GLB are uploaded without conversion
+			MeshCache cache;
+			MeshStreams streams;
+			isLoaded = isLoaded && cache.Open(_ResourcePath, RHI_VERTEX_FORMAT_DEFAULT, streams) && GltfImporter::WriteGlb(glbPath, streams);
+			cache.Close();
+
+			if (isLoaded)
+			{
+				GltfImporter importer;
+
+				start = std::chrono::high_resolution_clock::now();
+				isLoaded = importer.Open(glbPath) && importer.ImportScene(rhi, device, RHI_VERTEX_FORMAT_DEFAULT, scene);
+				measure(glbTime, run, start);
+
+				nodeCount = scene.GetNodes().size();
+			}
+
+			// The copies of the meshes are done before their buffers are destroyed
+			uploadManager->WaitUploads(device);
+
+			importedMesh->Unload(device);
+			cachedMesh->Unload(device);
+			rhi->DestroyMesh(importedMesh);
+			rhi->DestroyMesh(cachedMesh);
+			scene.Unload(rhi, device);
+
+			if (!isLoaded)
+			{
+				DEBUG_ERROR("glTF import benchmark failed for %s", _ResourcePath.string().c_str());
+				break;
+			}
+		}
+
+		std::error_code error;
+		std::uintmax_t objSize = std::filesystem::file_size(_ResourcePath, error);
+		std::uintmax_t glbSize = std::filesystem::file_size(glbPath, error);
+
+		DEBUG_LOG("%s: OBJ import %f ms (%u KB), mesh cache %f ms, GLB %f ms (%u KB, %u nodes)", _ResourcePath.filename().string().c_str(), importTime,
+			static_cast<unsigned int>(objSize / 1024), cachedTime, glbTime, static_cast<unsigned int>(glbSize / 1024), static_cast<unsigned int>(nodeCount));
+
+		std::filesystem::remove_all(benchmarkDirectory, error);
+		MeshCache::SetCacheDirectory(cacheDirectory);
+	}
+
+	void RendererBenchmarks::BenchmarkAsyncLoading(const std::vector<std::filesystem::path>& _MeshPaths, const std::vector<std::filesystem::path>& _TexturePaths, unsigned int _AssetCount)
+	{
+		IRendererHardware* rhi = Renderer::GetRHI();
+		IDevice* device = Renderer::GetDevice();
+		IUploadManager* uploadManager = Renderer::GetUploadManager();
+		ThreadPool* threadPool = Renderer::GetThreadPool();
+
+		// Half meshes and half textures, created without the resource manager which would load each file once
+		std::vector<IResource*> assets(_AssetCount);
+		std::vector<std::filesystem::path> paths(_AssetCount);
+		double serialTime = 0.0;
+
+		for (unsigned int run = 0; run < 2; ++run)
+		{
+			for (unsigned int i = 0; i < _AssetCount; ++i)
+			{
+				if (i % 2 == 0)
+				{
+					IMesh* mesh = rhi->CreateMesh();
+					mesh->SetVertexFormat(Renderer::MESH_VERTEX_FORMAT);
+
+					assets[i] = mesh;
+					paths[i] = _MeshPaths[(i / 2) % _MeshPaths.size()];
+				}
+				else
+				{
+					assets[i] = rhi->CreateTexture();
+					paths[i] = _TexturePaths[(i / 2) % _TexturePaths.size()];
+				}
+			}
+
+			unsigned int submissionCount = uploadManager->GetSubmissionCount();
+			double requestTime = 0.0;
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			if (run == 0)
+			{
+				// Every decode and upload on the main thread, the first frame waits for all of them
+				for (unsigned int i = 0; i < _AssetCount; ++i)
+					assets[i]->Load(device, paths[i]);
+			}
+			else
+			{
+				std::vector<std::unique_ptr<DecodedMesh>> decodedMeshes(_AssetCount);
+				std::vector<std::unique_ptr<DecodedTexture>> decodedTextures(_AssetCount);
+				std::vector<std::future<bool>> decodes(_AssetCount);
+
+				for (unsigned int i = 0; i < _AssetCount; ++i)
+				{
+					if (i % 2 == 0)
+					{
+						IMesh* mesh = static_cast<IMesh*>(assets[i]);
+						DecodedMesh* decoded = (decodedMeshes[i] = std::make_unique<DecodedMesh>()).get();
+						std::filesystem::path path = paths[i];
+
+						decodes[i] = threadPool->Submit([mesh, decoded, path]() { return mesh->Decode(path, *decoded); });
+					}
+					else
+					{
+						DecodedTexture* decoded = (decodedTextures[i] = std::make_unique<DecodedTexture>()).get();
+						std::filesystem::path path = paths[i];
+
+						decodes[i] = threadPool->Submit([decoded, path]() { return ITexture::Decode(path, *decoded); });
+					}
+				}
+
+				// Placeholders could be drawn from here
+				std::chrono::duration<double, std::milli> requestDuration = std::chrono::high_resolution_clock::now() - start;
+				requestTime = requestDuration.count();
+
+				std::vector<bool> isUploaded(_AssetCount, false);
+
+				for (unsigned int next = 0; next < _AssetCount;)
+				{
+					decodes[next].wait();
+
+					// Every decode over by now joins the batch of the oldest one, the batch is sent in one submission
+					for (unsigned int i = next; i < _AssetCount; ++i)
+					{
+						if (isUploaded[i] || decodes[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+							continue;
+
+						if (decodes[i].get())
+						{
+							if (i % 2 == 0)
+								static_cast<IMesh*>(assets[i])->Upload(device, *decodedMeshes[i]);
+							else
+								static_cast<ITexture*>(assets[i])->Upload(device, decodedTextures[i]->pixels.get(), decodedTextures[i]->width, decodedTextures[i]->height);
+						}
+
+						// Freed as soon as the pixels are in the staging memory
+						decodedMeshes[i].reset();
+						decodedTextures[i].reset();
+						isUploaded[i] = true;
+					}
+
+					uploadManager->FlushUploads(device);
+
+					while (next < _AssetCount && isUploaded[next])
+						++next;
+				}
+			}
+
+			uploadManager->WaitUploads(device);
+
+			std::chrono::duration<double, std::milli> readyTime = std::chrono::high_resolution_clock::now() - start;
+
+			if (run == 0)
+			{
+				serialTime = readyTime.count();
+				DEBUG_LOG("Serial loading: %u assets ready in %f ms, %u upload queue submissions", _AssetCount, serialTime, uploadManager->GetSubmissionCount() - submissionCount);
+			}
+			else
+			{
+				DEBUG_LOG("Parallel loading on %u threads: %u assets requested in %f ms and ready in %f ms, %u upload queue submissions, %f times faster", threadPool->GetThreadCount(),
+					_AssetCount, requestTime, readyTime.count(), uploadManager->GetSubmissionCount() - submissionCount, serialTime / readyTime.count());
+			}
+
+			// Nothing uses them on the GPU once the uploads are done
+			for (unsigned int i = 0; i < _AssetCount; ++i)
+			{
+				assets[i]->Unload(device);
+
+				if (i % 2 == 0)
+					rhi->DestroyMesh(static_cast<IMesh*>(assets[i]));
+				else
+					rhi->DestroyTexture(static_cast<ITexture*>(assets[i]));
+			}
+		}
+	}
+
+	void RendererBenchmarks::BenchmarkUploadBatching(const std::filesystem::path& _MeshPath, unsigned int _MeshCount)
+	{
+		IRendererHardware* rhi = Renderer::GetRHI();
+		IDevice* device = Renderer::GetDevice();
+		IUploadManager* uploadManager = Renderer::GetUploadManager();
+
+		// Decoded once, only the uploads are measured
+		IMesh* decoder = rhi->CreateMesh();
+		decoder->SetVertexFormat(Renderer::MESH_VERTEX_FORMAT);
+
+		DecodedMesh decoded;
+		bool isDecoded = decoder->Decode(_MeshPath, decoded);
+
+		rhi->DestroyMesh(decoder);
+
+		if (!isDecoded)
+		{
+			DEBUG_ERROR("Failed to open upload batching benchmark file: %s", _MeshPath.string().c_str());
+			return;
+		}
+
+		std::vector<IMesh*> meshes(_MeshCount);
+		double immediateTime = 0.0;
+
+		for (unsigned int run = 0; run < 2; ++run)
+		{
+			bool isImmediate = run == 0;
+
+			for (unsigned int i = 0; i < _MeshCount; ++i)
+			{
+				meshes[i] = rhi->CreateMesh();
+				meshes[i]->SetVertexFormat(Renderer::MESH_VERTEX_FORMAT);
+			}
+
+			uploadManager->SetImmediateUploads(isImmediate);
+
+			unsigned int submissionCount = uploadManager->GetSubmissionCount();
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			// A staging buffer and a queue wait per buffer in the first run, the staging ring and a few batches in the second
+			for (unsigned int i = 0; i < _MeshCount; ++i)
+				meshes[i]->Upload(device, decoded);
+
+			uploadManager->WaitUploads(device);
+
+			std::chrono::duration<double, std::milli> uploadTime = std::chrono::high_resolution_clock::now() - start;
+
+			uploadManager->SetImmediateUploads(false);
+
+			if (isImmediate)
+			{
+				immediateTime = uploadTime.count();
+				DEBUG_LOG("Immediate uploads: %u meshes in %f ms, %u queue submissions", _MeshCount, immediateTime, uploadManager->GetSubmissionCount() - submissionCount);
+			}
+			else
+			{
+				DEBUG_LOG("Batched uploads: %u meshes in %f ms, %u queue submissions, %f times faster", _MeshCount, uploadTime.count(), uploadManager->GetSubmissionCount() - submissionCount,
+					immediateTime / uploadTime.count());
+			}
+
+			// Nothing uses them on the GPU once the uploads are done
+			for (IMesh* mesh : meshes)
+			{
+				mesh->Unload(device);
+				rhi->DestroyMesh(mesh);
+			}
+		}
+	}
+
+	void RendererBenchmarks::TestResourceDeduplication(const std::filesystem::path& _MeshPath, const std::filesystem::path& _TexturePath, unsigned int _RequestCount)
+	{
+		IDevice* device = Renderer::GetDevice();
+		IUploadManager* uploadManager = Renderer::GetUploadManager();
+		ResourceManager* resourceManager = Renderer::GetResourceManager();
+
+		// Spellings of the same files, they all have to share one resource
+		std::vector<std::filesystem::path> meshPaths = { _MeshPath, std::filesystem::path(".") / _MeshPath, _MeshPath.parent_path() / ".." / _MeshPath.parent_path().filename() / _MeshPath.filename(),
+			std::filesystem::absolute(_MeshPath) };
+		std::vector<std::filesystem::path> texturePaths = { _TexturePath, std::filesystem::path(".") / _TexturePath, std::filesystem::absolute(_TexturePath) };
+
+		unsigned int missCount = resourceManager->GetMissCount();
+		unsigned int submissionCount = uploadManager->GetSubmissionCount();
+
+		std::vector<MeshHandle> meshes;
+		std::vector<TextureHandle> textures;
+		meshes.reserve(_RequestCount);
+		textures.reserve(_RequestCount);
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		for (unsigned int i = 0; i < _RequestCount; ++i)
+		{
+			meshes.push_back(resourceManager->LoadMesh(meshPaths[i % meshPaths.size()], Renderer::MESH_VERTEX_FORMAT));
+			textures.push_back(resourceManager->LoadTexture(texturePaths[i % texturePaths.size()]));
+		}
+
+		uploadManager->FlushUploads(device);
+
+		std::chrono::duration<double, std::milli> requestTime = std::chrono::high_resolution_clock::now() - start;
+
+		unsigned int loadCount = resourceManager->GetMissCount() - missCount;
+		bool isShared = true;
+
+		for (unsigned int i = 1; i < _RequestCount; ++i)
+			isShared = isShared && meshes[i] == meshes[0] && textures[i] == textures[0];
+
+		DEBUG_LOG("Resource deduplication: %u requests in %f ms, %u loads, %u upload queue submissions, handles shared: %s", 2 * _RequestCount, requestTime.count(), loadCount,
+			uploadManager->GetSubmissionCount() - submissionCount, isShared ? "yes" : "no");
+
+		// The scene may already hold them, then nothing is loaded
+		if (loadCount > 2 || !isShared)
+			DEBUG_WARN("Resource deduplication: the same file was loaded more than once");
+
+		resourceManager->LogStatistics();
+	}
+
+	void RendererBenchmarks::TestPipelineStateCache(LowRenderer::Model& _Model)
+	{
+		// Same shaders, only the culling differs so the descriptor sets of the model stay compatible
+		PipelineDescription description = Renderer::CreateMeshPipelineDescription(_Model.GetMesh());
+		description.raster.cullMode = RHI_CULL_NONE;
+
+		// Kept by the renderer when the shaders are reloaded
+		_Model.SetPipelineDescription(description);
+	}
+
+	void RendererBenchmarks::StressTestResourceChurn(Renderer& _Renderer)
+	{
+		IRendererHardware* rhi = Renderer::GetRHI();
+		IDevice* device = Renderer::GetDevice();
+
+		// Quad replacing the minecraft model
+		std::vector<Vertex> vertices = {
+			{ Math::Vector3(-0.5f, -0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(0.f, 0.f) },
+			{ Math::Vector3(0.5f, -0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(1.f, 0.f) },
+			{ Math::Vector3(0.5f, 0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(1.f, 1.f) },
+			{ Math::Vector3(-0.5f, 0.5f, 0.f), Math::Vector3(1.f, 1.f, 1.f), Math::Vector2(0.f, 1.f) }
+		};
+
+		std::vector<uint32_t> indices = { 0, 1, 2, 2, 3, 0 };
+
+		// Same format as the mesh replaced, the pipeline of the model reads it
+		IMesh* churnMesh = rhi->CreateMesh();
+		churnMesh->SetVertexFormat(_Renderer.mcMesh->GetVertexFormat());
+		churnMesh->CreateVertexBuffer(device, vertices);
+		churnMesh->CreateIndexBuffer(device, indices);
+
+		// The previous mesh may still be drawn by the frames in flight
+		IMesh* previousMesh = Renderer::mcModel.GetMesh();
+		Renderer::mcModel.SetMesh(churnMesh);
+
+		if (previousMesh != _Renderer.mcMesh.get())
+		{
+			Renderer::DestroyMeshDeferred(previousMesh);
+		}
+
+		// Texture created and released right away, only the upload may still use it
+		std::vector<unsigned char> pixels(64 * 64 * 4, static_cast<unsigned char>(Renderer::GetFrameNumber() % 256));
+
+		ITexture* churnTexture = rhi->CreateTexture();
+		churnTexture->CreateTexture(device, pixels.data(), 64, 64);
+
+		Renderer::DestroyTextureDeferred(churnTexture);
+
+		if (Renderer::GetFrameNumber() % 1000 == 0)
+		{
+			DEBUG_LOG("Resource churn: frame %u, %u destructions pending", static_cast<unsigned int>(Renderer::GetFrameNumber()), static_cast<unsigned int>(Renderer::GetPendingDestructionCount()));
+		}
+	}
+}
\ No newline at end of file
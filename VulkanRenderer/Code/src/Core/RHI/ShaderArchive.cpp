@@ -0,0 +1,372 @@
+#include "RHI/ShaderArchive.h"
+
+#include "Debug/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Core
+{
+	static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	static void HashBytes(unsigned long long& _Hash, const void* _Data, size_t _Size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_Data);
+
+		for (size_t i = 0; i < _Size; ++i)
+		{
+			_Hash ^= bytes[i];
+			_Hash *= FNV_PRIME;
+		}
+	}
+
+	static size_t AlignBlock(size_t _Offset)
+	{
+		return (_Offset + 7) & ~static_cast<size_t>(7);
+	}
+
+	static size_t GetReflectionBlockSize(const ShaderArchiveReflectionHeader& _Header)
+	{
+		return sizeof(ShaderArchiveReflectionHeader)
+			+ _Header.bindingCount * sizeof(ShaderArchiveBinding)
+			+ _Header.vertexInputCount * sizeof(ShaderArchiveVertexInput)
+			+ _Header.pushConstantCount * sizeof(ShaderArchivePushConstant);
+	}
+
+	unsigned long long ShaderArchive::ComputeKey(const std::string& _Name, const std::vector<std::string>& _MacroDefinitions)
+	{
+		unsigned long long hash = FNV_OFFSET_BASIS;
+
+		size_t nameSize = _Name.size();
+		HashBytes(hash, &nameSize, sizeof(nameSize));
+		HashBytes(hash, _Name.data(), nameSize);
+
+		// The same variant is found whatever the order its macros were added in
+		std::vector<std::string> definitions = _MacroDefinitions;
+		std::sort(definitions.begin(), definitions.end());
+
+		for (const std::string& definition : definitions)
+		{
+			size_t definitionSize = definition.size();
+			HashBytes(hash, &definitionSize, sizeof(definitionSize));
+			HashBytes(hash, definition.data(), definitionSize);
+		}
+
+		return hash;
+	}
+
+	const bool ShaderArchive::Open(const std::filesystem::path& _Path)
+	{
+		Close();
+
+		if (!m_File.Open(_Path))
+			return false;
+
+		const unsigned char* data = m_File.GetData();
+		size_t size = m_File.GetSize();
+
+		const ShaderArchiveHeader* header = reinterpret_cast<const ShaderArchiveHeader*>(data);
+
+		if (size < sizeof(ShaderArchiveHeader) || header->magic != ARCHIVE_MAGIC_NUMBER || header->version != ARCHIVE_VERSION)
+		{
+			DEBUG_WARN("Ignoring invalid shader archive: %s", _Path.string().c_str());
+			Close();
+			return false;
+		}
+
+		// The names are the last block and all end with a null character
+		size_t entriesEnd = sizeof(ShaderArchiveHeader) + static_cast<size_t>(header->entryCount) * sizeof(ShaderArchiveEntry);
+
+		if (entriesEnd > size || data[size - 1] != '\0')
+		{
+			DEBUG_WARN("Ignoring truncated shader archive: %s", _Path.string().c_str());
+			Close();
+			return false;
+		}
+
+		const ShaderArchiveEntry* entries = reinterpret_cast<const ShaderArchiveEntry*>(data + sizeof(ShaderArchiveHeader));
+
+		// Checked once here so the lookups never read out of the file
+		for (uint32_t i = 0; i < header->entryCount; ++i)
+		{
+			const ShaderArchiveEntry& entry = entries[i];
+
+			bool isValid = entry.nameOffset < size
+				&& entry.spirVOffset % sizeof(uint32_t) == 0
+				&& entry.spirVOffset + static_cast<size_t>(entry.spirVWordCount) * sizeof(uint32_t) <= size
+				&& entry.reflectionOffset % sizeof(uint32_t) == 0
+				&& entry.reflectionOffset + sizeof(ShaderArchiveReflectionHeader) <= size
+				&& (i == 0 || entries[i - 1].key < entry.key);
+
+			if (isValid)
+			{
+				const ShaderArchiveReflectionHeader* reflection = reinterpret_cast<const ShaderArchiveReflectionHeader*>(data + entry.reflectionOffset);
+				isValid = entry.reflectionOffset + GetReflectionBlockSize(*reflection) <= size;
+			}
+
+			if (!isValid)
+			{
+				DEBUG_WARN("Ignoring corrupted shader archive: %s", _Path.string().c_str());
+				Close();
+				return false;
+			}
+		}
+
+		m_Header = header;
+		m_Entries = entries;
+
+		return true;
+	}
+
+	void ShaderArchive::Close()
+	{
+		m_Header = nullptr;
+		m_Entries = nullptr;
+
+		m_File.Close();
+	}
+
+	const char* ShaderArchive::GetString(uint32_t _Offset) const
+	{
+		return _Offset < m_File.GetSize() ? reinterpret_cast<const char*>(m_File.GetData() + _Offset) : "";
+	}
+
+	const ShaderArchiveEntry* ShaderArchive::Find(unsigned long long _Key) const
+	{
+		if (m_Header == nullptr)
+			return nullptr;
+
+		const ShaderArchiveEntry* end = m_Entries + m_Header->entryCount;
+		const ShaderArchiveEntry* entry = std::lower_bound(m_Entries, end, _Key, [](const ShaderArchiveEntry& _Entry, unsigned long long _Key)
+			{
+				return _Entry.key < _Key;
+			});
+
+		return entry != end && entry->key == _Key ? entry : nullptr;
+	}
+
+	void ShaderArchive::GetReflection(const ShaderArchiveEntry& _Entry, ShaderReflection& _Reflection) const
+	{
+		const unsigned char* block = m_File.GetData() + _Entry.reflectionOffset;
+		const ShaderArchiveReflectionHeader* header = reinterpret_cast<const ShaderArchiveReflectionHeader*>(block);
+
+		const ShaderArchiveBinding* bindings = reinterpret_cast<const ShaderArchiveBinding*>(block + sizeof(ShaderArchiveReflectionHeader));
+		const ShaderArchiveVertexInput* vertexInputs = reinterpret_cast<const ShaderArchiveVertexInput*>(bindings + header->bindingCount);
+		const ShaderArchivePushConstant* pushConstants = reinterpret_cast<const ShaderArchivePushConstant*>(vertexInputs + header->vertexInputCount);
+
+		_Reflection = ShaderReflection();
+		_Reflection.stage = static_cast<ShaderType>(_Entry.stage);
+
+		_Reflection.bindings.resize(header->bindingCount);
+
+		for (uint32_t i = 0; i < header->bindingCount; ++i)
+		{
+			ReflectedDescriptorBinding& binding = _Reflection.bindings[i];
+			binding.name = GetString(bindings[i].nameOffset);
+			binding.set = bindings[i].set;
+			binding.binding = bindings[i].binding;
+			binding.type = static_cast<DescriptorType>(bindings[i].type);
+			binding.count = bindings[i].count;
+			binding.stages = bindings[i].stages;
+		}
+
+		_Reflection.vertexInputs.resize(header->vertexInputCount);
+
+		for (uint32_t i = 0; i < header->vertexInputCount; ++i)
+		{
+			ReflectedVertexInput& vertexInput = _Reflection.vertexInputs[i];
+			vertexInput.name = GetString(vertexInputs[i].nameOffset);
+			vertexInput.location = vertexInputs[i].location;
+			vertexInput.baseType = static_cast<ReflectedBaseType>(vertexInputs[i].baseType);
+			vertexInput.componentCount = vertexInputs[i].componentCount;
+			vertexInput.componentWidth = vertexInputs[i].componentWidth;
+		}
+
+		_Reflection.pushConstants.resize(header->pushConstantCount);
+
+		for (uint32_t i = 0; i < header->pushConstantCount; ++i)
+		{
+			_Reflection.pushConstants[i].offset = pushConstants[i].offset;
+			_Reflection.pushConstants[i].size = pushConstants[i].size;
+			_Reflection.pushConstants[i].stages = pushConstants[i].stages;
+		}
+	}
+
+	const bool ShaderArchiveBuilder::AddShader(const std::string& _Name, const std::vector<std::string>& _MacroDefinitions, const std::vector<uint32_t>& _SpirV, const ShaderReflection& _Reflection)
+	{
+		unsigned long long key = ShaderArchive::ComputeKey(_Name, _MacroDefinitions);
+
+		for (const PendingShader& shader : m_Shaders)
+		{
+			if (shader.key == key)
+			{
+				DEBUG_WARN("Shader %s is already in the archive", shader.name.c_str());
+				return false;
+			}
+		}
+
+		PendingShader shader;
+		shader.key = key;
+		shader.name = _Name;
+
+		for (const std::string& definition : _MacroDefinitions)
+			shader.name += " " + definition;
+
+		shader.spirV = _SpirV;
+		shader.reflection = _Reflection;
+
+		m_Shaders.push_back(std::move(shader));
+
+		return true;
+	}
+
+	const bool ShaderArchiveBuilder::Write(const std::filesystem::path& _Path) const
+	{
+		// Entries are sorted for the binary search of ShaderArchive::Find
+		std::vector<const PendingShader*> shaders;
+		shaders.reserve(m_Shaders.size());
+
+		for (const PendingShader& shader : m_Shaders)
+			shaders.push_back(&shader);
+
+		std::sort(shaders.begin(), shaders.end(), [](const PendingShader* _A, const PendingShader* _B)
+			{
+				return _A->key < _B->key;
+			});
+
+		// Names are stored once, their offsets are moved after the data once its size is known
+		std::string names;
+
+		auto addName = [&names](const std::string& _Name)
+			{
+				uint32_t offset = static_cast<uint32_t>(names.size());
+				names += _Name;
+				names += '\0';
+				return offset;
+			};
+
+		std::vector<ShaderArchiveEntry> entries(shaders.size());
+		std::vector<ShaderArchiveReflectionHeader> reflectionHeaders(shaders.size());
+
+		size_t offset = AlignBlock(sizeof(ShaderArchiveHeader) + entries.size() * sizeof(ShaderArchiveEntry));
+
+		for (size_t i = 0; i < shaders.size(); ++i)
+		{
+			const PendingShader& shader = *shaders[i];
+
+			entries[i].key = shader.key;
+			entries[i].stage = static_cast<uint32_t>(shader.reflection.stage);
+			entries[i].nameOffset = addName(shader.name);
+
+			entries[i].spirVOffset = static_cast<uint32_t>(offset);
+			entries[i].spirVWordCount = static_cast<uint32_t>(shader.spirV.size());
+			offset = AlignBlock(offset + shader.spirV.size() * sizeof(uint32_t));
+
+			reflectionHeaders[i].bindingCount = static_cast<uint32_t>(shader.reflection.bindings.size());
+			reflectionHeaders[i].vertexInputCount = static_cast<uint32_t>(shader.reflection.vertexInputs.size());
+			reflectionHeaders[i].pushConstantCount = static_cast<uint32_t>(shader.reflection.pushConstants.size());
+
+			entries[i].reflectionOffset = static_cast<uint32_t>(offset);
+			offset = AlignBlock(offset + GetReflectionBlockSize(reflectionHeaders[i]));
+		}
+
+		size_t namesOffset = offset;
+
+		std::vector<unsigned char> data(namesOffset);
+
+		ShaderArchiveHeader header;
+		header.magic = ShaderArchive::ARCHIVE_MAGIC_NUMBER;
+		header.version = ShaderArchive::ARCHIVE_VERSION;
+		header.entryCount = static_cast<uint32_t>(entries.size());
+
+		memcpy(data.data(), &header, sizeof(header));
+
+		for (size_t i = 0; i < shaders.size(); ++i)
+		{
+			const PendingShader& shader = *shaders[i];
+			ShaderArchiveEntry& entry = entries[i];
+
+			entry.nameOffset += static_cast<uint32_t>(namesOffset);
+
+			memcpy(data.data() + entry.spirVOffset, shader.spirV.data(), shader.spirV.size() * sizeof(uint32_t));
+
+			unsigned char* block = data.data() + entry.reflectionOffset;
+			memcpy(block, &reflectionHeaders[i], sizeof(ShaderArchiveReflectionHeader));
+			block += sizeof(ShaderArchiveReflectionHeader);
+
+			for (const ReflectedDescriptorBinding& reflectedBinding : shader.reflection.bindings)
+			{
+				ShaderArchiveBinding binding{ addName(reflectedBinding.name) + static_cast<uint32_t>(namesOffset), reflectedBinding.set, reflectedBinding.binding,
+					static_cast<uint32_t>(reflectedBinding.type), reflectedBinding.count, reflectedBinding.stages };
+
+				memcpy(block, &binding, sizeof(binding));
+				block += sizeof(binding);
+			}
+
+			for (const ReflectedVertexInput& reflectedInput : shader.reflection.vertexInputs)
+			{
+				ShaderArchiveVertexInput vertexInput{ addName(reflectedInput.name) + static_cast<uint32_t>(namesOffset), reflectedInput.location,
+					static_cast<uint32_t>(reflectedInput.baseType), reflectedInput.componentCount, reflectedInput.componentWidth, 0 };
+
+				memcpy(block, &vertexInput, sizeof(vertexInput));
+				block += sizeof(vertexInput);
+			}
+
+			for (const ReflectedPushConstantRange& reflectedRange : shader.reflection.pushConstants)
+			{
+				ShaderArchivePushConstant pushConstant{ reflectedRange.offset, reflectedRange.size, reflectedRange.stages, 0 };
+
+				memcpy(block, &pushConstant, sizeof(pushConstant));
+				block += sizeof(pushConstant);
+			}
+		}
+
+		memcpy(data.data() + sizeof(ShaderArchiveHeader), entries.data(), entries.size() * sizeof(ShaderArchiveEntry));
+
+		// An empty archive still ends with a null character
+		if (names.empty())
+			names += '\0';
+
+		data.insert(data.end(), names.begin(), names.end());
+
+		std::error_code error;
+
+		if (_Path.has_parent_path())
+			std::filesystem::create_directories(_Path.parent_path(), error);
+
+		// Written next to the archive then renamed, a running renderer never maps a partial file
+		std::filesystem::path temporaryPath = _Path;
+		temporaryPath += ".tmp";
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			if (!file.is_open())
+			{
+				DEBUG_ERROR("Failed to write shader archive: %s", temporaryPath.string().c_str());
+				return false;
+			}
+
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+			if (!file)
+			{
+				DEBUG_ERROR("Failed to write shader archive: %s", temporaryPath.string().c_str());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, _Path, error);
+
+		if (error)
+		{
+			DEBUG_ERROR("Failed to write shader archive: %s", _Path.string().c_str());
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
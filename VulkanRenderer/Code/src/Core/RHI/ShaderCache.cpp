@@ -0,0 +1,216 @@
+#include "RHI/ShaderCache.h"
+
+#include "Debug/Log.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace Core
+{
+	static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	static void HashBytes(unsigned long long& _Hash, const void* _Data, size_t _Size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_Data);
+
+		for (size_t i = 0; i < _Size; ++i)
+		{
+			_Hash ^= bytes[i];
+			_Hash *= FNV_PRIME;
+		}
+	}
+
+	unsigned long long ShaderCache::ComputeKey(const ShaderCacheKeyInfos& _Infos)
+	{
+		unsigned long long hash = FNV_OFFSET_BASIS;
+
+		HashBytes(hash, &CACHE_FORMAT_VERSION, sizeof(CACHE_FORMAT_VERSION));
+		HashBytes(hash, &_Infos.compilerVersion, sizeof(_Infos.compilerVersion));
+		HashBytes(hash, &_Infos.compilerRevision, sizeof(_Infos.compilerRevision));
+		HashBytes(hash, &_Infos.shaderKind, sizeof(_Infos.shaderKind));
+
+		// Sizes are hashed before the strings so two different splits of the same bytes give different keys
+		size_t optionsSize = _Infos.options.size();
+		HashBytes(hash, &optionsSize, sizeof(optionsSize));
+		HashBytes(hash, _Infos.options.data(), optionsSize);
+
+		if (_Infos.source != nullptr)
+		{
+			size_t sourceSize = _Infos.source->size();
+			HashBytes(hash, &sourceSize, sizeof(sourceSize));
+			HashBytes(hash, _Infos.source->data(), sourceSize);
+		}
+
+		return hash;
+	}
+
+	unsigned long long ShaderCache::ComputeDependencyKey(const ShaderCacheKeyInfos& _Infos)
+	{
+		// Starts from the SPIR-V key of the source as written, the path is added so it never collides with a SPIR-V key
+		unsigned long long hash = ComputeKey(_Infos);
+
+		size_t pathSize = _Infos.sourcePath.size();
+		HashBytes(hash, &pathSize, sizeof(pathSize));
+		HashBytes(hash, _Infos.sourcePath.data(), pathSize);
+
+		return hash;
+	}
+
+	std::filesystem::path ShaderCache::GetEntryPath(unsigned long long _Key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.spv", _Key);
+
+		return m_CacheDirectory / name;
+	}
+
+	std::filesystem::path ShaderCache::GetDependencyRecordPath(unsigned long long _Key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.dep", _Key);
+
+		return m_CacheDirectory / name;
+	}
+
+	const bool ShaderCache::Load(unsigned long long _Key, std::vector<uint32_t>& _SpirV)
+	{
+		std::ifstream file(GetEntryPath(_Key), std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+		{
+			++m_MissCount;
+			return false;
+		}
+
+		size_t fileSize = static_cast<size_t>(file.tellg());
+
+		// A SPIR-V module is made of words and starts with its magic number
+		if (fileSize < sizeof(uint32_t) || fileSize % sizeof(uint32_t) != 0)
+		{
+			DEBUG_WARN("Ignoring corrupted shader cache entry: %s", GetEntryPath(_Key).string().c_str());
+			++m_MissCount;
+			return false;
+		}
+
+		_SpirV.resize(fileSize / sizeof(uint32_t));
+
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(_SpirV.data()), fileSize);
+
+		if (!file || _SpirV[0] != SPIRV_MAGIC_NUMBER)
+		{
+			DEBUG_WARN("Ignoring corrupted shader cache entry: %s", GetEntryPath(_Key).string().c_str());
+			_SpirV.clear();
+			++m_MissCount;
+			return false;
+		}
+
+		++m_HitCount;
+
+		return true;
+	}
+
+	const bool ShaderCache::Store(unsigned long long _Key, const std::vector<uint32_t>& _SpirV)
+	{
+		return WriteEntry(GetEntryPath(_Key), _SpirV.data(), _SpirV.size() * sizeof(uint32_t));
+	}
+
+	const bool ShaderCache::LoadDependencies(unsigned long long _DependencyKey, unsigned long long& _Key, std::vector<SourceDependency>& _Dependencies)
+	{
+		std::string record = "";
+
+		if (!SourceFileCache::ReadFile(GetDependencyRecordPath(_DependencyKey), record))
+			return false;
+
+		// First line is the key of the SPIR-V, then one line per included file: hash of its content then its path
+		std::istringstream stream(record);
+		std::string line = "";
+
+		if (!std::getline(stream, line) || sscanf(line.c_str(), "%llx", &_Key) != 1)
+		{
+			DEBUG_WARN("Ignoring corrupted shader dependency record: %s", GetDependencyRecordPath(_DependencyKey).string().c_str());
+			return false;
+		}
+
+		_Dependencies.clear();
+
+		while (std::getline(stream, line))
+		{
+			size_t separator = line.find(' ');
+			SourceDependency dependency;
+
+			if (separator == std::string::npos || sscanf(line.c_str(), "%llx", &dependency.hash) != 1)
+			{
+				DEBUG_WARN("Ignoring corrupted shader dependency record: %s", GetDependencyRecordPath(_DependencyKey).string().c_str());
+				return false;
+			}
+
+			dependency.path = line.substr(separator + 1);
+			_Dependencies.push_back(dependency);
+		}
+
+		return true;
+	}
+
+	const bool ShaderCache::StoreDependencies(unsigned long long _DependencyKey, unsigned long long _Key, const std::vector<SourceDependency>& _Dependencies)
+	{
+		char number[32];
+		snprintf(number, sizeof(number), "%016llx", _Key);
+
+		std::string record = std::string(number) + "\n";
+
+		for (const SourceDependency& dependency : _Dependencies)
+		{
+			snprintf(number, sizeof(number), "%016llx", dependency.hash);
+			record += std::string(number) + " " + dependency.path.string() + "\n";
+		}
+
+		return WriteEntry(GetDependencyRecordPath(_DependencyKey), record.data(), record.size());
+	}
+
+	const bool ShaderCache::WriteEntry(const std::filesystem::path& _Path, const void* _Data, size_t _Size)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(m_CacheDirectory, error);
+
+		if (error)
+		{
+			DEBUG_WARN("Failed to create shader cache directory: %s", m_CacheDirectory.string().c_str());
+			return false;
+		}
+
+		std::filesystem::path temporaryPath = _Path;
+		temporaryPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			if (!file.is_open())
+			{
+				DEBUG_WARN("Failed to write shader cache entry: %s", temporaryPath.string().c_str());
+				return false;
+			}
+
+			file.write(static_cast<const char*>(_Data), _Size);
+
+			if (!file)
+			{
+				DEBUG_WARN("Failed to write shader cache entry: %s", temporaryPath.string().c_str());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, _Path, error);
+
+		if (error)
+		{
+			DEBUG_WARN("Failed to write shader cache entry: %s", _Path.string().c_str());
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
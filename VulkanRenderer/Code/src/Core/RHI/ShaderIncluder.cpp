@@ -0,0 +1,64 @@
+#include "RHI/ShaderIncluder.h"
+
+#ifdef SHADER_RUNTIME_COMPILATION
+namespace Core
+{
+	ShaderIncluder::ShaderIncluder(const std::filesystem::path& _SourcePath, const std::string& _SourceName, std::vector<SourceDependency>& _Dependencies)
+		: m_SourcePath(_SourcePath), m_SourceName(_SourceName), m_Dependencies(_Dependencies)
+	{
+	}
+
+	shaderc_include_result* ShaderIncluder::GetInclude(const char* _RequestedSource, shaderc_include_type _Type, const char* _RequestingSource, size_t _IncludeDepth)
+	{
+		// Nested includes are requested with the path returned for their parent
+		std::filesystem::path directory = m_SourcePath.parent_path();
+
+		if (_Type == shaderc_include_type_relative && m_SourceName != _RequestingSource)
+			directory = std::filesystem::path(_RequestingSource).parent_path();
+
+		std::filesystem::path includePath = (directory / _RequestedSource).lexically_normal();
+
+		IncludeData* data = new IncludeData;
+		data->file = SourceFileCache::Read(includePath);
+		data->result.user_data = data;
+
+		if (data->file == nullptr)
+		{
+			// An empty name tells shaderc the include failed, the content is the error
+			data->errorMessage = "Cannot open include file: " + includePath.string();
+
+			data->result.source_name = "";
+			data->result.source_name_length = 0;
+			data->result.content = data->errorMessage.c_str();
+			data->result.content_length = data->errorMessage.size();
+
+			return &data->result;
+		}
+
+		data->name = includePath.string();
+
+		data->result.source_name = data->name.c_str();
+		data->result.source_name_length = data->name.size();
+		data->result.content = data->file->content.c_str();
+		data->result.content_length = data->file->content.size();
+
+		bool isRecorded = false;
+
+		for (const SourceDependency& dependency : m_Dependencies)
+		{
+			if (dependency.path == includePath)
+				isRecorded = true;
+		}
+
+		if (!isRecorded)
+			m_Dependencies.push_back({ includePath, data->file->hash });
+
+		return &data->result;
+	}
+
+	void ShaderIncluder::ReleaseInclude(shaderc_include_result* _Data)
+	{
+		delete static_cast<IncludeData*>(_Data->user_data);
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,496 @@
+#include "RHI/ShaderReflection.h"
+
+#include "Debug/Log.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Core
+{
+	// Subset of the SPIR-V specification used by the reflection
+	namespace SpirV
+	{
+		static const uint32_t MAGIC_NUMBER = 0x07230203;
+		static const size_t HEADER_WORD_COUNT = 5;
+
+		enum Op : uint32_t
+		{
+			OP_NAME = 5,
+			OP_ENTRY_POINT = 15,
+			OP_TYPE_INT = 21,
+			OP_TYPE_FLOAT = 22,
+			OP_TYPE_VECTOR = 23,
+			OP_TYPE_MATRIX = 24,
+			OP_TYPE_IMAGE = 25,
+			OP_TYPE_SAMPLER = 26,
+			OP_TYPE_SAMPLED_IMAGE = 27,
+			OP_TYPE_ARRAY = 28,
+			OP_TYPE_RUNTIME_ARRAY = 29,
+			OP_TYPE_STRUCT = 30,
+			OP_TYPE_POINTER = 32,
+			OP_CONSTANT = 43,
+			OP_VARIABLE = 59,
+			OP_DECORATE = 71,
+			OP_MEMBER_DECORATE = 72
+		};
+
+		enum Decoration : uint32_t
+		{
+			DECORATION_BLOCK = 2,
+			DECORATION_BUFFER_BLOCK = 3,
+			DECORATION_ARRAY_STRIDE = 6,
+			DECORATION_BUILT_IN = 11,
+			DECORATION_LOCATION = 30,
+			DECORATION_BINDING = 33,
+			DECORATION_DESCRIPTOR_SET = 34,
+			DECORATION_OFFSET = 35
+		};
+
+		enum StorageClass : uint32_t
+		{
+			STORAGE_UNIFORM_CONSTANT = 0,
+			STORAGE_INPUT = 1,
+			STORAGE_UNIFORM = 2,
+			STORAGE_PUSH_CONSTANT = 9,
+			STORAGE_STORAGE_BUFFER = 12
+		};
+
+		enum ExecutionModel : uint32_t
+		{
+			EXECUTION_VERTEX = 0,
+			EXECUTION_GEOMETRY = 3,
+			EXECUTION_FRAGMENT = 4
+		};
+	}
+
+	// Everything known about an id of the module
+	struct SpirVId
+	{
+		uint32_t opcode = 0;
+
+		// Types - component or element type, number of components / columns / members
+		uint32_t typeId = 0;
+		uint32_t count = 0;
+		uint32_t width = 0;
+		bool isSigned = false;
+		std::vector<uint32_t> members;
+		std::vector<uint32_t> memberOffsets;
+
+		// Pointers and variables
+		uint32_t storageClass = 0;
+
+		// Constants
+		uint32_t value = 0;
+
+		// Decorations
+		std::string name;
+		uint32_t set = 0;
+		uint32_t binding = 0;
+		uint32_t location = 0;
+		uint32_t arrayStride = 0;
+		bool hasBinding = false;
+		bool hasLocation = false;
+		bool isBuiltIn = false;
+		bool isBlock = false;
+		bool isBufferBlock = false;
+	};
+
+	static std::string ReadLiteralString(const uint32_t* _Words, size_t _WordCount)
+	{
+		// Nul terminated UTF-8 packed in little endian words
+		const char* characters = reinterpret_cast<const char*>(_Words);
+		size_t maxLength = _WordCount * sizeof(uint32_t);
+
+		return std::string(characters, std::find(characters, characters + maxLength, '\0'));
+	}
+
+	static uint32_t ComputeTypeSize(const std::unordered_map<uint32_t, SpirVId>& _Ids, uint32_t _TypeId)
+	{
+		std::unordered_map<uint32_t, SpirVId>::const_iterator type = _Ids.find(_TypeId);
+
+		if (type == _Ids.end())
+			return 0;
+
+		switch (type->second.opcode)
+		{
+		case SpirV::OP_TYPE_INT: case SpirV::OP_TYPE_FLOAT:
+			return type->second.width / 8;
+		case SpirV::OP_TYPE_VECTOR:
+			return type->second.count * ComputeTypeSize(_Ids, type->second.typeId);
+		case SpirV::OP_TYPE_MATRIX:
+			return type->second.count * ComputeTypeSize(_Ids, type->second.typeId);
+		case SpirV::OP_TYPE_ARRAY:
+		{
+			std::unordered_map<uint32_t, SpirVId>::const_iterator length = _Ids.find(type->second.count);
+			uint32_t elementCount = length != _Ids.end() ? length->second.value : 0;
+			uint32_t stride = type->second.arrayStride != 0 ? type->second.arrayStride : ComputeTypeSize(_Ids, type->second.typeId);
+			return elementCount * stride;
+		}
+		case SpirV::OP_TYPE_STRUCT:
+		{
+			// The block ends after its last member
+			uint32_t size = 0;
+
+			for (size_t i = 0; i < type->second.members.size(); ++i)
+			{
+				uint32_t offset = i < type->second.memberOffsets.size() ? type->second.memberOffsets[i] : 0;
+				size = std::max(size, offset + ComputeTypeSize(_Ids, type->second.members[i]));
+			}
+
+			return size;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	const bool SpirVReflection::Reflect(const uint32_t* _Code, size_t _WordCount, ShaderReflection& _Reflection)
+	{
+		_Reflection = ShaderReflection();
+
+		if (_Code == nullptr || _WordCount < SpirV::HEADER_WORD_COUNT || _Code[0] != SpirV::MAGIC_NUMBER)
+		{
+			DEBUG_ERROR("Cannot reflect shader, invalid SPIR-V module");
+			return false;
+		}
+
+		std::unordered_map<uint32_t, SpirVId> ids;
+		std::vector<uint32_t> variables;
+		bool hasEntryPoint = false;
+
+		// First pass - every instruction before the functions is recorded
+		for (size_t position = SpirV::HEADER_WORD_COUNT; position < _WordCount;)
+		{
+			uint32_t wordCount = _Code[position] >> 16;
+			uint32_t opcode = _Code[position] & 0xFFFF;
+			const uint32_t* operands = _Code + position + 1;
+
+			if (wordCount == 0 || position + wordCount > _WordCount)
+			{
+				DEBUG_ERROR("Cannot reflect shader, truncated SPIR-V instruction");
+				return false;
+			}
+
+			switch (opcode)
+			{
+			case SpirV::OP_NAME:
+				ids[operands[0]].name = ReadLiteralString(operands + 1, wordCount - 2);
+				break;
+			case SpirV::OP_ENTRY_POINT:
+				// Only the first entry point is reflected
+				if (!hasEntryPoint)
+				{
+					hasEntryPoint = true;
+
+					switch (operands[0])
+					{
+					case SpirV::EXECUTION_VERTEX: default:
+						_Reflection.stage = RHI_VERTEX;
+						break;
+					case SpirV::EXECUTION_FRAGMENT:
+						_Reflection.stage = RHI_FRAGMENT;
+						break;
+					case SpirV::EXECUTION_GEOMETRY:
+						_Reflection.stage = RHI_GEOMETRY;
+						break;
+					}
+				}
+				break;
+			case SpirV::OP_TYPE_INT:
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].width = operands[1];
+				ids[operands[0]].isSigned = operands[2] != 0;
+				break;
+			case SpirV::OP_TYPE_FLOAT:
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].width = operands[1];
+				break;
+			case SpirV::OP_TYPE_VECTOR: case SpirV::OP_TYPE_MATRIX: case SpirV::OP_TYPE_ARRAY:
+				// Component type and count, the count of an array is the id of a constant
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].typeId = operands[1];
+				ids[operands[0]].count = operands[2];
+				break;
+			case SpirV::OP_TYPE_RUNTIME_ARRAY: case SpirV::OP_TYPE_SAMPLED_IMAGE:
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].typeId = operands[1];
+				break;
+			case SpirV::OP_TYPE_IMAGE: case SpirV::OP_TYPE_SAMPLER:
+				ids[operands[0]].opcode = opcode;
+				break;
+			case SpirV::OP_TYPE_STRUCT:
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].members.assign(operands + 1, operands + wordCount - 1);
+				ids[operands[0]].memberOffsets.resize(wordCount - 2, 0);
+				break;
+			case SpirV::OP_TYPE_POINTER:
+				ids[operands[0]].opcode = opcode;
+				ids[operands[0]].storageClass = operands[1];
+				ids[operands[0]].typeId = operands[2];
+				break;
+			case SpirV::OP_CONSTANT:
+				// 64 bits constants are never used as array sizes
+				ids[operands[1]].opcode = opcode;
+				ids[operands[1]].value = operands[2];
+				break;
+			case SpirV::OP_VARIABLE:
+				ids[operands[1]].opcode = opcode;
+				ids[operands[1]].typeId = operands[0];
+				ids[operands[1]].storageClass = operands[2];
+				variables.push_back(operands[1]);
+				break;
+			case SpirV::OP_DECORATE:
+			{
+				SpirVId& target = ids[operands[0]];
+
+				switch (operands[1])
+				{
+				case SpirV::DECORATION_BLOCK:
+					target.isBlock = true;
+					break;
+				case SpirV::DECORATION_BUFFER_BLOCK:
+					target.isBufferBlock = true;
+					break;
+				case SpirV::DECORATION_BUILT_IN:
+					target.isBuiltIn = true;
+					break;
+				case SpirV::DECORATION_LOCATION:
+					target.location = operands[2];
+					target.hasLocation = true;
+					break;
+				case SpirV::DECORATION_BINDING:
+					target.binding = operands[2];
+					target.hasBinding = true;
+					break;
+				case SpirV::DECORATION_DESCRIPTOR_SET:
+					target.set = operands[2];
+					break;
+				case SpirV::DECORATION_ARRAY_STRIDE:
+					target.arrayStride = operands[2];
+					break;
+				}
+				break;
+			}
+			case SpirV::OP_MEMBER_DECORATE:
+				// Member offsets are needed for the size of the push constant blocks, decorations come before the types
+				if (operands[2] == SpirV::DECORATION_OFFSET)
+				{
+					SpirVId& target = ids[operands[0]];
+
+					if (target.memberOffsets.size() <= operands[1])
+						target.memberOffsets.resize(operands[1] + 1, 0);
+
+					target.memberOffsets[operands[1]] = operands[3];
+				}
+				break;
+			}
+
+			position += wordCount;
+		}
+
+		unsigned int stageBit = GetShaderStageBit(_Reflection.stage);
+
+		// Second pass - the variables are classified once all the types are known
+		for (uint32_t variableId : variables)
+		{
+			const SpirVId& variable = ids[variableId];
+			const SpirVId& pointer = ids[variable.typeId];
+
+			uint32_t typeId = pointer.typeId;
+
+			switch (variable.storageClass)
+			{
+			case SpirV::STORAGE_UNIFORM_CONSTANT: case SpirV::STORAGE_UNIFORM: case SpirV::STORAGE_STORAGE_BUFFER:
+			{
+				ReflectedDescriptorBinding binding;
+				binding.name = variable.name;
+				binding.set = variable.set;
+				binding.binding = variable.binding;
+				binding.stages = stageBit;
+
+				// Arrays of descriptors
+				if (ids[typeId].opcode == SpirV::OP_TYPE_ARRAY)
+				{
+					binding.count = ids[ids[typeId].count].value;
+					typeId = ids[typeId].typeId;
+				}
+				else if (ids[typeId].opcode == SpirV::OP_TYPE_RUNTIME_ARRAY)
+				{
+					binding.count = 0;
+					typeId = ids[typeId].typeId;
+				}
+
+				const SpirVId& type = ids[typeId];
+
+				if (variable.storageClass == SpirV::STORAGE_STORAGE_BUFFER || type.isBufferBlock)
+				{
+					binding.type = RHI_DESCRIPTOR_STORAGE_BUFFER;
+				}
+				else if (variable.storageClass == SpirV::STORAGE_UNIFORM)
+				{
+					binding.type = RHI_DESCRIPTOR_UNIRFORM;
+				}
+				else if (type.opcode == SpirV::OP_TYPE_SAMPLED_IMAGE)
+				{
+					binding.type = RHI_DESCRIPTOR_SAMPLER;
+				}
+				else
+				{
+					DEBUG_WARN("Descriptor %s is of a type not supported by the reflection, it is ignored", variable.name.c_str());
+					break;
+				}
+
+				if (!variable.hasBinding)
+					DEBUG_WARN("Descriptor %s has no binding decoration, binding 0 is used", variable.name.c_str());
+
+				_Reflection.bindings.push_back(binding);
+				break;
+			}
+			case SpirV::STORAGE_PUSH_CONSTANT:
+			{
+				ReflectedPushConstantRange range;
+				range.offset = 0;
+				range.size = ComputeTypeSize(ids, typeId);
+				range.stages = stageBit;
+
+				_Reflection.pushConstants.push_back(range);
+				break;
+			}
+			case SpirV::STORAGE_INPUT:
+			{
+				// Built-ins (gl_VertexIndex...) are not vertex attributes
+				if (_Reflection.stage != RHI_VERTEX || variable.isBuiltIn || ids[typeId].isBuiltIn || !variable.hasLocation)
+					break;
+
+				ReflectedVertexInput input;
+				input.name = variable.name;
+				input.location = variable.location;
+
+				const SpirVId* component = &ids[typeId];
+
+				if (component->opcode == SpirV::OP_TYPE_VECTOR)
+				{
+					input.componentCount = component->count;
+					component = &ids[component->typeId];
+				}
+
+				input.componentWidth = component->width;
+
+				if (component->opcode == SpirV::OP_TYPE_FLOAT)
+					input.baseType = REFLECTED_FLOAT;
+				else
+					input.baseType = component->isSigned ? REFLECTED_INT : REFLECTED_UINT;
+
+				_Reflection.vertexInputs.push_back(input);
+				break;
+			}
+			}
+		}
+
+		std::sort(_Reflection.vertexInputs.begin(), _Reflection.vertexInputs.end(), [](const ReflectedVertexInput& _A, const ReflectedVertexInput& _B)
+			{
+				return _A.location < _B.location;
+			});
+
+		return true;
+	}
+
+	const bool SpirVReflection::MergeStages(const std::vector<const ShaderReflection*>& _Stages, PipelineReflection& _Reflection)
+	{
+		_Reflection = PipelineReflection();
+
+		bool isValid = true;
+
+		for (const ShaderReflection* stage : _Stages)
+		{
+			for (const ReflectedDescriptorBinding& binding : stage->bindings)
+			{
+				if (_Reflection.sets.size() <= binding.set)
+					_Reflection.sets.resize(binding.set + 1);
+
+				std::vector<ReflectedDescriptorBinding>& set = _Reflection.sets[binding.set];
+
+				std::vector<ReflectedDescriptorBinding>::iterator existing = std::find_if(set.begin(), set.end(), [&binding](const ReflectedDescriptorBinding& _Binding)
+					{
+						return _Binding.binding == binding.binding;
+					});
+
+				if (existing == set.end())
+				{
+					set.push_back(binding);
+					continue;
+				}
+
+				if (existing->type != binding.type || existing->count != binding.count)
+				{
+					DEBUG_ERROR("Set %u binding %u is declared differently by two stages", binding.set, binding.binding);
+					isValid = false;
+				}
+
+				existing->stages |= binding.stages;
+			}
+
+			if (stage->stage == RHI_VERTEX)
+				_Reflection.vertexInputs = stage->vertexInputs;
+
+			// Every stage gets its own range, they all start at 0 with GLSL
+			for (const ReflectedPushConstantRange& range : stage->pushConstants)
+			{
+				if (_Reflection.pushConstants.empty())
+				{
+					_Reflection.pushConstants.push_back(range);
+					continue;
+				}
+
+				// One range visible by all the stages using push constants
+				ReflectedPushConstantRange& merged = _Reflection.pushConstants[0];
+				merged.size = std::max(merged.size, range.size);
+				merged.stages |= range.stages;
+			}
+		}
+
+		for (std::vector<ReflectedDescriptorBinding>& set : _Reflection.sets)
+		{
+			std::sort(set.begin(), set.end(), [](const ReflectedDescriptorBinding& _A, const ReflectedDescriptorBinding& _B)
+				{
+					return _A.binding < _B.binding;
+				});
+		}
+
+		return isValid;
+	}
+
+	bool ReflectedDescriptorBinding::operator==(const ReflectedDescriptorBinding& _Other) const
+	{
+		// The name does not change the layout
+		return set == _Other.set && binding == _Other.binding && type == _Other.type && count == _Other.count && stages == _Other.stages;
+	}
+
+	bool PipelineReflection::IsLayoutCompatible(const PipelineReflection& _Other) const
+	{
+		if (sets != _Other.sets || pushConstants.size() != _Other.pushConstants.size())
+			return false;
+
+		for (size_t i = 0; i < pushConstants.size(); ++i)
+		{
+			if (pushConstants[i].offset != _Other.pushConstants[i].offset || pushConstants[i].size != _Other.pushConstants[i].size || pushConstants[i].stages != _Other.pushConstants[i].stages)
+				return false;
+		}
+
+		return true;
+	}
+
+	const ReflectedDescriptorBinding* PipelineReflection::FindBinding(unsigned int _Set, unsigned int _Binding) const
+	{
+		if (_Set >= sets.size())
+			return nullptr;
+
+		for (const ReflectedDescriptorBinding& binding : sets[_Set])
+		{
+			if (binding.binding == _Binding)
+				return &binding;
+		}
+
+		return nullptr;
+	}
+}
\ No newline at end of file
@@ -1,43 +1,90 @@
 #include "RHI/Vertex.h"
 
+#include "Debug/Log.h"
+
 namespace Core
 {
-	VkVertexInputBindingDescription Vertex::GetBindingDescription()
+	void Vertex::GetBindingDescriptions(const VertexLayout& _Layout, std::vector<VkVertexInputBindingDescription>& _BindingDescriptions)
 	{
+		_BindingDescriptions.clear();
+
 		VkVertexInputBindingDescription bindingDescription{};
-		// Only one vertex so bind to 0
+		// Interleaved attributes bound to 0
 		bindingDescription.binding = 0;
 		// Stride or size of the complete type
-		bindingDescription.stride = sizeof(Vertex);
+		bindingDescription.stride = _Layout.GetStride();
 		// Input rate VK_VERTEX_INPUT_RATE_VERTEX -> send the next data after each summit
 		// VK_VERTEX_INPUT_RATE_INSTANCE -> send the next data after each instance
 		bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
-		return bindingDescription;
+		_BindingDescriptions.push_back(bindingDescription);
+
+		if (_Layout.HasColorStream())
+		{
+			bindingDescription.binding = 1;
+			bindingDescription.stride = _Layout.GetColorStride();
+
+			_BindingDescriptions.push_back(bindingDescription);
+		}
 	}
 
-	std::array<VkVertexInputAttributeDescription, 3> Vertex::GetAttributeDescriptions()
+	static VkFormat GetAttributeFormat(const VertexAttribute& _Attribute)
 	{
-		std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
-
-		attributeDescriptions[0].binding = 0;
-		// The binding in the shader
-		attributeDescriptions[0].location = 0;
-		// Format of the data here Vector3
-		attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-		// The offset between each data
-		attributeDescriptions[0].offset = offsetof(Vertex, position);
-
-		attributeDescriptions[1].binding = 0;
-		attributeDescriptions[1].location = 1;
-		attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-		attributeDescriptions[1].offset = offsetof(Vertex, color);
-
-		attributeDescriptions[2].binding = 0;
-		attributeDescriptions[2].location = 2;
-		attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-		attributeDescriptions[2].offset = offsetof(Vertex, textCoord);
-
-		return attributeDescriptions;
+		static const VkFormat float32Formats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+		static const VkFormat float16Formats[] = { VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT };
+		static const VkFormat snorm16Formats[] = { VK_FORMAT_R16_SNORM, VK_FORMAT_R16G16_SNORM, VK_FORMAT_R16G16B16_SNORM, VK_FORMAT_R16G16B16A16_SNORM };
+		static const VkFormat unorm16Formats[] = { VK_FORMAT_R16_UNORM, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16A16_UNORM };
+		static const VkFormat unorm8Formats[] = { VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8A8_UNORM };
+
+		if (_Attribute.componentCount < 1 || _Attribute.componentCount > 4)
+			return VK_FORMAT_UNDEFINED;
+
+		switch (_Attribute.type)
+		{
+		case RHI_ATTRIBUTE_FLOAT32: default:
+			return float32Formats[_Attribute.componentCount - 1];
+		case RHI_ATTRIBUTE_FLOAT16:
+			return float16Formats[_Attribute.componentCount - 1];
+		case RHI_ATTRIBUTE_SNORM16:
+			return snorm16Formats[_Attribute.componentCount - 1];
+		case RHI_ATTRIBUTE_UNORM16:
+			return unorm16Formats[_Attribute.componentCount - 1];
+		case RHI_ATTRIBUTE_UNORM8:
+			return unorm8Formats[_Attribute.componentCount - 1];
+		}
+	}
+
+	const bool Vertex::GetAttributeDescriptions(const VertexLayout& _Layout, const std::vector<ReflectedVertexInput>& _Inputs, std::vector<VkVertexInputAttributeDescription>& _AttributeDescriptions)
+	{
+		_AttributeDescriptions.resize(_Inputs.size());
+
+		for (size_t i = 0; i < _Inputs.size(); ++i)
+		{
+			VertexAttribute attribute;
+
+			if (!_Layout.GetAttribute(_Inputs[i].location, attribute))
+			{
+				DEBUG_ERROR("Vertex input %s at location %u is not stored by the vertex format", _Inputs[i].name.c_str(), _Inputs[i].location);
+				return false;
+			}
+
+			// Every stored type is converted to floats by the input assembly, the shader may read fewer components than stored
+			VkFormat format = GetAttributeFormat(attribute);
+
+			if (format == VK_FORMAT_UNDEFINED || _Inputs[i].baseType != REFLECTED_FLOAT || _Inputs[i].componentWidth != 32 || _Inputs[i].componentCount > attribute.componentCount)
+			{
+				DEBUG_ERROR("Vertex input %s does not match the type of its attribute", _Inputs[i].name.c_str());
+				return false;
+			}
+
+			_AttributeDescriptions[i].binding = attribute.binding;
+			// The binding in the shader
+			_AttributeDescriptions[i].location = _Inputs[i].location;
+			_AttributeDescriptions[i].format = format;
+			// The offset between each data
+			_AttributeDescriptions[i].offset = attribute.offset;
+		}
+
+		return true;
 	}
 }
\ No newline at end of file
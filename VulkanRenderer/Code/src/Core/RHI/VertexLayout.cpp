@@ -0,0 +1,510 @@
+#include "RHI/VertexLayout.h"
+
+#include "RHI/Vertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Core
+{
+	// Vector2 hides its members, it is two packed floats like in the vertex buffers
+	static const float* GetTextCoord(const Vertex& _Vertex)
+	{
+		return reinterpret_cast<const float*>(&_Vertex.textCoord);
+	}
+
+	static uint32_t GetPositionSize(VertexPositionFormat _Format)
+	{
+		// Quantized positions are padded to four components, three 16 bits components are not a mandatory vertex format
+		return _Format == RHI_POSITION_FLOAT32 ? 3 * sizeof(float) : 4 * sizeof(uint16_t);
+	}
+
+	static uint32_t GetInterleavedColorSize(VertexColorFormat _Format)
+	{
+		return _Format == RHI_COLOR_FLOAT32 ? 3 * sizeof(float) : 0;
+	}
+
+	static uint32_t GetNormalSize(VertexNormalFormat _Format)
+	{
+		return _Format == RHI_NORMAL_OCTAHEDRAL_SNORM16 ? 2 * sizeof(int16_t) : 0;
+	}
+
+	static uint32_t GetTextCoordSize(VertexTextCoordFormat _Format)
+	{
+		return _Format == RHI_TEXTCOORD_FLOAT32 ? 2 * sizeof(float) : 2 * sizeof(uint16_t);
+	}
+
+	VertexLayout VertexLayout::Get(VertexFormat _Format)
+	{
+		VertexLayout layout;
+
+		switch (_Format)
+		{
+		case RHI_VERTEX_FORMAT_DEFAULT: default:
+			break;
+		case RHI_VERTEX_FORMAT_COMPACT:
+			layout.positionFormat = RHI_POSITION_SNORM16;
+			layout.colorFormat = RHI_COLOR_NONE;
+			layout.normalFormat = RHI_NORMAL_OCTAHEDRAL_SNORM16;
+			layout.textCoordFormat = RHI_TEXTCOORD_UNORM16;
+			break;
+		case RHI_VERTEX_FORMAT_COMPACT_HALF:
+			layout.positionFormat = RHI_POSITION_HALF;
+			layout.colorFormat = RHI_COLOR_NONE;
+			layout.normalFormat = RHI_NORMAL_OCTAHEDRAL_SNORM16;
+			layout.textCoordFormat = RHI_TEXTCOORD_UNORM16;
+			break;
+		case RHI_VERTEX_FORMAT_COMPACT_COLOR:
+			layout.positionFormat = RHI_POSITION_SNORM16;
+			layout.colorFormat = RHI_COLOR_UNORM8_STREAM;
+			layout.normalFormat = RHI_NORMAL_OCTAHEDRAL_SNORM16;
+			layout.textCoordFormat = RHI_TEXTCOORD_UNORM16;
+			break;
+		}
+
+		return layout;
+	}
+
+	const bool VertexLayout::GetAttribute(unsigned int _Location, VertexAttribute& _Attribute) const
+	{
+		uint32_t colorOffset = GetPositionSize(positionFormat);
+		uint32_t normalOffset = colorOffset + GetInterleavedColorSize(colorFormat);
+		uint32_t textCoordOffset = normalOffset + GetNormalSize(normalFormat);
+
+		_Attribute = VertexAttribute();
+
+		switch (_Location)
+		{
+		case POSITION_LOCATION:
+			_Attribute.offset = 0;
+
+			switch (positionFormat)
+			{
+			case RHI_POSITION_FLOAT32: default:
+				_Attribute.type = RHI_ATTRIBUTE_FLOAT32;
+				_Attribute.componentCount = 3;
+				break;
+			case RHI_POSITION_HALF:
+				_Attribute.type = RHI_ATTRIBUTE_FLOAT16;
+				_Attribute.componentCount = 4;
+				break;
+			case RHI_POSITION_SNORM16:
+				_Attribute.type = RHI_ATTRIBUTE_SNORM16;
+				_Attribute.componentCount = 4;
+				break;
+			}
+
+			return true;
+		case COLOR_LOCATION:
+			if (colorFormat == RHI_COLOR_NONE)
+				return false;
+
+			if (colorFormat == RHI_COLOR_UNORM8_STREAM)
+			{
+				_Attribute.binding = 1;
+				_Attribute.offset = 0;
+				_Attribute.type = RHI_ATTRIBUTE_UNORM8;
+				_Attribute.componentCount = 4;
+				return true;
+			}
+
+			_Attribute.offset = colorOffset;
+			_Attribute.type = RHI_ATTRIBUTE_FLOAT32;
+			_Attribute.componentCount = 3;
+			return true;
+		case NORMAL_LOCATION:
+			if (normalFormat == RHI_NORMAL_NONE)
+				return false;
+
+			_Attribute.offset = normalOffset;
+			_Attribute.type = RHI_ATTRIBUTE_SNORM16;
+			_Attribute.componentCount = 2;
+			return true;
+		case TEXTCOORD_LOCATION:
+			_Attribute.offset = textCoordOffset;
+			_Attribute.type = textCoordFormat == RHI_TEXTCOORD_FLOAT32 ? RHI_ATTRIBUTE_FLOAT32 : RHI_ATTRIBUTE_UNORM16;
+			_Attribute.componentCount = 2;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint32_t VertexLayout::GetStride() const
+	{
+		return GetPositionSize(positionFormat) + GetInterleavedColorSize(colorFormat) + GetNormalSize(normalFormat) + GetTextCoordSize(textCoordFormat);
+	}
+
+	uint32_t VertexLayout::GetColorStride() const
+	{
+		return HasColorStream() ? 4 * sizeof(uint8_t) : 0;
+	}
+
+	void VertexEncoder::Encode(const std::vector<Vertex>& _Vertices, const VertexLayout& _Layout, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData,
+		VertexDequantization& _Dequantization, VertexEncodingStatistics* _Statistics)
+	{
+		_Dequantization = VertexDequantization();
+
+		VertexAttribute positionAttribute;
+		VertexAttribute colorAttribute;
+		VertexAttribute normalAttribute;
+		VertexAttribute textCoordAttribute;
+
+		_Layout.GetAttribute(VertexLayout::POSITION_LOCATION, positionAttribute);
+		_Layout.GetAttribute(VertexLayout::COLOR_LOCATION, colorAttribute);
+		_Layout.GetAttribute(VertexLayout::NORMAL_LOCATION, normalAttribute);
+		_Layout.GetAttribute(VertexLayout::TEXTCOORD_LOCATION, textCoordAttribute);
+
+		uint32_t stride = _Layout.GetStride();
+		uint32_t colorStride = _Layout.GetColorStride();
+
+		_VertexData.assign(_Vertices.size() * stride, 0);
+		_ColorData.assign(_Vertices.size() * colorStride, 0);
+
+		if (_Statistics != nullptr)
+			*_Statistics = VertexEncodingStatistics();
+
+		if (_Vertices.empty())
+			return;
+
+		// The quantized positions cover the bounds of the mesh, [-1, 1] is mapped on the box
+		if (_Layout.positionFormat != RHI_POSITION_FLOAT32)
+		{
+			float minimum[3] = { _Vertices[0].position.m_X, _Vertices[0].position.m_Y, _Vertices[0].position.m_Z };
+			float maximum[3] = { minimum[0], minimum[1], minimum[2] };
+
+			for (const Vertex& vertex : _Vertices)
+			{
+				const float* position = &vertex.position.m_X;
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					minimum[axis] = std::min(minimum[axis], position[axis]);
+					maximum[axis] = std::max(maximum[axis], position[axis]);
+				}
+			}
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float halfExtent = (maximum[axis] - minimum[axis]) * 0.5f;
+
+				_Dequantization.positionScale[axis] = halfExtent > 0.f ? halfExtent : 1.f;
+				_Dequantization.positionOffset[axis] = (minimum[axis] + maximum[axis]) * 0.5f;
+			}
+		}
+
+		// Coordinates in [0, 1] keep the full precision without transform, tiled ones are quantized in their bounds
+		if (_Layout.textCoordFormat == RHI_TEXTCOORD_UNORM16)
+		{
+			float minimum[2] = { GetTextCoord(_Vertices[0])[0], GetTextCoord(_Vertices[0])[1] };
+			float maximum[2] = { minimum[0], minimum[1] };
+
+			for (const Vertex& vertex : _Vertices)
+			{
+				const float* textCoord = GetTextCoord(vertex);
+
+				for (int axis = 0; axis < 2; ++axis)
+				{
+					minimum[axis] = std::min(minimum[axis], textCoord[axis]);
+					maximum[axis] = std::max(maximum[axis], textCoord[axis]);
+				}
+			}
+
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				if (minimum[axis] >= 0.f && maximum[axis] <= 1.f)
+					continue;
+
+				_Dequantization.textCoordScaleOffset[axis] = maximum[axis] > minimum[axis] ? maximum[axis] - minimum[axis] : 1.f;
+				_Dequantization.textCoordScaleOffset[2 + axis] = minimum[axis];
+			}
+		}
+
+		for (size_t i = 0; i < _Vertices.size(); ++i)
+		{
+			const Vertex& vertex = _Vertices[i];
+			uint8_t* output = _VertexData.data() + i * stride;
+
+			const float* position = &vertex.position.m_X;
+			float decodedPosition[3] = {};
+
+			switch (_Layout.positionFormat)
+			{
+			case RHI_POSITION_FLOAT32: default:
+				memcpy(output + positionAttribute.offset, position, 3 * sizeof(float));
+				memcpy(decodedPosition, position, 3 * sizeof(float));
+				break;
+			case RHI_POSITION_HALF: case RHI_POSITION_SNORM16:
+			{
+				uint16_t encoded[4] = {};
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					float normalized = (position[axis] - _Dequantization.positionOffset[axis]) / _Dequantization.positionScale[axis];
+					float stored = 0.f;
+
+					if (_Layout.positionFormat == RHI_POSITION_HALF)
+					{
+						encoded[axis] = FloatToHalf(normalized);
+						stored = HalfToFloat(encoded[axis]);
+					}
+					else
+					{
+						int16_t quantized = QuantizeSnorm16(normalized);
+						memcpy(&encoded[axis], &quantized, sizeof(quantized));
+						stored = DequantizeSnorm16(quantized);
+					}
+
+					decodedPosition[axis] = stored * _Dequantization.positionScale[axis] + _Dequantization.positionOffset[axis];
+				}
+
+				memcpy(output + positionAttribute.offset, encoded, sizeof(encoded));
+				break;
+			}
+			}
+
+			const float* color = &vertex.color.m_X;
+			float decodedColor[3] = { color[0], color[1], color[2] };
+
+			if (_Layout.colorFormat == RHI_COLOR_FLOAT32)
+			{
+				memcpy(output + colorAttribute.offset, color, 3 * sizeof(float));
+			}
+			else if (_Layout.colorFormat == RHI_COLOR_UNORM8_STREAM)
+			{
+				uint8_t encoded[4] = { 0, 0, 0, 255 };
+
+				for (int channel = 0; channel < 3; ++channel)
+				{
+					encoded[channel] = static_cast<uint8_t>(std::lround(std::clamp(color[channel], 0.f, 1.f) * 255.f));
+					decodedColor[channel] = encoded[channel] / 255.f;
+				}
+
+				memcpy(_ColorData.data() + i * colorStride, encoded, sizeof(encoded));
+			}
+
+			if (_Layout.HasNormal())
+			{
+				int16_t encoded[2] = {};
+				EncodeOctahedral(&vertex.normal.m_X, encoded);
+				memcpy(output + normalAttribute.offset, encoded, sizeof(encoded));
+
+				if (_Statistics != nullptr)
+				{
+					const float* normal = &vertex.normal.m_X;
+					float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+					if (length > 0.f)
+					{
+						float decodedNormal[3] = {};
+						DecodeOctahedral(encoded, decodedNormal);
+
+						float cosine = (normal[0] * decodedNormal[0] + normal[1] * decodedNormal[1] + normal[2] * decodedNormal[2]) / length;
+						float angle = std::acos(std::clamp(cosine, -1.f, 1.f)) * 57.2957795f;
+
+						_Statistics->maxNormalError = std::max(_Statistics->maxNormalError, angle);
+					}
+				}
+			}
+
+			const float* textCoord = GetTextCoord(vertex);
+			float decodedTextCoord[2] = { textCoord[0], textCoord[1] };
+
+			if (_Layout.textCoordFormat == RHI_TEXTCOORD_FLOAT32)
+			{
+				memcpy(output + textCoordAttribute.offset, textCoord, 2 * sizeof(float));
+			}
+			else
+			{
+				uint16_t encoded[2] = {};
+
+				for (int axis = 0; axis < 2; ++axis)
+				{
+					float scale = _Dequantization.textCoordScaleOffset[axis];
+					float offset = _Dequantization.textCoordScaleOffset[2 + axis];
+
+					encoded[axis] = QuantizeUnorm16((textCoord[axis] - offset) / scale);
+					decodedTextCoord[axis] = DequantizeUnorm16(encoded[axis]) * scale + offset;
+				}
+
+				memcpy(output + textCoordAttribute.offset, encoded, sizeof(encoded));
+			}
+
+			if (_Statistics == nullptr)
+				continue;
+
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				_Statistics->maxPositionError = std::max(_Statistics->maxPositionError, std::abs(decodedPosition[axis] - position[axis]));
+				_Statistics->maxColorError = std::max(_Statistics->maxColorError, std::abs(decodedColor[axis] - color[axis]));
+			}
+
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				_Statistics->maxTextCoordError = std::max(_Statistics->maxTextCoordError, std::abs(decodedTextCoord[axis] - textCoord[axis]));
+			}
+		}
+	}
+
+	uint16_t VertexEncoder::FloatToHalf(float _Value)
+	{
+		uint32_t bits = 0;
+		memcpy(&bits, &_Value, sizeof(bits));
+
+		uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		uint32_t floatExponent = (bits >> 23) & 0xFF;
+		uint32_t mantissa = bits & 0x7FFFFF;
+
+		// Infinity and NaN, NaN keeps a mantissa bit
+		if (floatExponent == 0xFF)
+			return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+
+		int exponent = static_cast<int>(floatExponent) - 127 + 15;
+
+		if (exponent >= 31)
+			return sign | 0x7C00;
+
+		// Subnormal half, the implicit bit of the float becomes explicit
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return sign;
+
+			mantissa |= 0x800000;
+
+			uint32_t shift = static_cast<uint32_t>(14 - exponent);
+			uint32_t half = mantissa >> shift;
+			uint32_t remainder = mantissa & ((1u << shift) - 1);
+			uint32_t halfway = 1u << (shift - 1);
+
+			// Rounds to the nearest, ties to even
+			if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+				++half;
+
+			return sign | static_cast<uint16_t>(half);
+		}
+
+		uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+		uint32_t remainder = mantissa & 0x1FFF;
+
+		// A carry out of the mantissa increments the exponent, the largest values round to infinity
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+			++half;
+
+		return sign | static_cast<uint16_t>(half);
+	}
+
+	float VertexEncoder::HalfToFloat(uint16_t _Half)
+	{
+		uint32_t sign = static_cast<uint32_t>(_Half & 0x8000) << 16;
+		uint32_t exponent = (_Half >> 10) & 0x1F;
+		uint32_t mantissa = _Half & 0x3FF;
+
+		if (exponent == 0)
+		{
+			float value = std::ldexp(static_cast<float>(mantissa), -24);
+			return sign != 0 ? -value : value;
+		}
+
+		uint32_t bits = exponent == 31 ? sign | 0x7F800000 | (mantissa << 13) : sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+		float value = 0.f;
+		memcpy(&value, &bits, sizeof(value));
+
+		return value;
+	}
+
+	void VertexEncoder::EncodeOctahedral(const float* _Normal, int16_t* _Encoded)
+	{
+		float length = std::abs(_Normal[0]) + std::abs(_Normal[1]) + std::abs(_Normal[2]);
+
+		// Decoded as (0, 0, 1)
+		if (length == 0.f)
+		{
+			_Encoded[0] = 0;
+			_Encoded[1] = 0;
+			return;
+		}
+
+		float u = _Normal[0] / length;
+		float v = _Normal[1] / length;
+
+		// The lower half of the octahedron is folded on the corners of the square
+		if (_Normal[2] < 0.f)
+		{
+			float foldedU = (1.f - std::abs(v)) * (u >= 0.f ? 1.f : -1.f);
+			float foldedV = (1.f - std::abs(u)) * (v >= 0.f ? 1.f : -1.f);
+
+			u = foldedU;
+			v = foldedV;
+		}
+
+		float euclideanLength = std::sqrt(_Normal[0] * _Normal[0] + _Normal[1] * _Normal[1] + _Normal[2] * _Normal[2]);
+
+		// Rounding each component alone is not always the closest direction, the four neighbours are compared
+		float baseU = std::floor(std::clamp(u, -1.f, 1.f) * 32767.f);
+		float baseV = std::floor(std::clamp(v, -1.f, 1.f) * 32767.f);
+
+		float bestCosine = -2.f;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			int16_t candidate[2] = {
+				static_cast<int16_t>(std::clamp(baseU + static_cast<float>(i & 1), -32767.f, 32767.f)),
+				static_cast<int16_t>(std::clamp(baseV + static_cast<float>(i >> 1), -32767.f, 32767.f))
+			};
+
+			float decoded[3] = {};
+			DecodeOctahedral(candidate, decoded);
+
+			float cosine = (_Normal[0] * decoded[0] + _Normal[1] * decoded[1] + _Normal[2] * decoded[2]) / euclideanLength;
+
+			if (cosine > bestCosine)
+			{
+				bestCosine = cosine;
+				_Encoded[0] = candidate[0];
+				_Encoded[1] = candidate[1];
+			}
+		}
+	}
+
+	void VertexEncoder::DecodeOctahedral(const int16_t* _Encoded, float* _Normal)
+	{
+		float x = DequantizeSnorm16(_Encoded[0]);
+		float y = DequantizeSnorm16(_Encoded[1]);
+		float z = 1.f - std::abs(x) - std::abs(y);
+
+		// Unfolds the corners of the square back on the lower half
+		float fold = std::max(-z, 0.f);
+		x += x >= 0.f ? -fold : fold;
+		y += y >= 0.f ? -fold : fold;
+
+		float length = std::sqrt(x * x + y * y + z * z);
+
+		_Normal[0] = x / length;
+		_Normal[1] = y / length;
+		_Normal[2] = z / length;
+	}
+
+	int16_t VertexEncoder::QuantizeSnorm16(float _Value)
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(_Value, -1.f, 1.f) * 32767.f));
+	}
+
+	uint16_t VertexEncoder::QuantizeUnorm16(float _Value)
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(_Value, 0.f, 1.f) * 65535.f));
+	}
+
+	float VertexEncoder::DequantizeSnorm16(int16_t _Value)
+	{
+		// -32768 and -32767 both give -1 like the GPU conversion
+		return std::max(static_cast<float>(_Value) / 32767.f, -1.f);
+	}
+
+	float VertexEncoder::DequantizeUnorm16(uint16_t _Value)
+	{
+		return static_cast<float>(_Value) / 65535.f;
+	}
+}
\ No newline at end of file
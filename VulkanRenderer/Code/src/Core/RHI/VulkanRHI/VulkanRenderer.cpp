@@ -11,6 +11,8 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDescriptorAllocator.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanSemaphore.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanFence.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanUploadManager.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanRenderGraphResources.h"
 
 #include <cstring>
 #include <set>
@@ -70,12 +72,17 @@ namespace Core
 		return vkSwapChain;
 	}
 
-	IPipeline* VulkanRenderer::InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos)
+	IPipeline* VulkanRenderer::InstantiatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description)
 	{
 		VulkanPipeline* vkPipeline = new VulkanPipeline;
 
-		if (!vkPipeline->CreatePipeline(_Device, _Swapchain, _ShadersInfos))
+		if (!vkPipeline->CreatePipeline(_Device, _Swapchain, _Description))
+		{
+			// Objects created before the failure are released
+			vkPipeline->DestroyPipeline(_Device);
+			delete vkPipeline;
 			return nullptr;
+		}
 
 		return vkPipeline;
 	}
@@ -147,4 +154,27 @@ namespace Core
 
 		return vkBuffer;
 	}
+
+	IUploadManager* VulkanRenderer::InstantiateUploadManager(IDevice* _Device, size_t _StagingSize)
+	{
+		VulkanUploadManager* vkUploadManager = new VulkanUploadManager;
+
+		if (!vkUploadManager->CreateUploadManager(_Device, _StagingSize))
+			return nullptr;
+
+		return vkUploadManager;
+	}
+
+	IRenderGraphResources* VulkanRenderer::InstantiateRenderGraphResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph)
+	{
+		VulkanRenderGraphResources* vkResources = new VulkanRenderGraphResources;
+
+		if (!vkResources->CreateResources(_Device, _SwapChain, _Graph))
+		{
+			delete vkResources;
+			return nullptr;
+		}
+
+		return vkResources;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "RHI/VulkanRHI/VulkanTypes/VulkanBarrierBuilder.h"
+
+#include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanImage.h"
+
+namespace Core
+{
+	void VulkanBarrierBuilder::AddMemoryBarrier(VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess)
+	{
+		VkMemoryBarrier2KHR barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR;
+		barrier.srcStageMask = _SrcStage;
+		barrier.srcAccessMask = _SrcAccess;
+		barrier.dstStageMask = _DstStage;
+		barrier.dstAccessMask = _DstAccess;
+
+		m_MemoryBarriers.push_back(barrier);
+	}
+
+	void VulkanBarrierBuilder::AddBufferBarrier(VkBuffer _Buffer, VkDeviceSize _Offset, VkDeviceSize _Size, VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess, uint32_t _SrcQueueFamily, uint32_t _DstQueueFamily)
+	{
+		VkBufferMemoryBarrier2KHR barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR;
+		barrier.srcStageMask = _SrcStage;
+		barrier.srcAccessMask = _SrcAccess;
+		barrier.dstStageMask = _DstStage;
+		barrier.dstAccessMask = _DstAccess;
+		barrier.srcQueueFamilyIndex = _SrcQueueFamily;
+		barrier.dstQueueFamilyIndex = _DstQueueFamily;
+		barrier.buffer = _Buffer;
+		barrier.offset = _Offset;
+		barrier.size = _Size;
+
+		m_BufferBarriers.push_back(barrier);
+	}
+
+	void VulkanBarrierBuilder::AddImageBarrier(VkImage _Image, VkImageAspectFlags _Aspect, VkImageLayout _OldLayout, VkImageLayout _NewLayout, VkPipelineStageFlags2KHR _SrcStage, VkAccessFlags2KHR _SrcAccess, VkPipelineStageFlags2KHR _DstStage, VkAccessFlags2KHR _DstAccess, uint32_t _SrcQueueFamily, uint32_t _DstQueueFamily)
+	{
+		VkImageMemoryBarrier2KHR barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+		barrier.srcStageMask = _SrcStage;
+		barrier.srcAccessMask = _SrcAccess;
+		barrier.dstStageMask = _DstStage;
+		barrier.dstAccessMask = _DstAccess;
+		// Specifies the old layout and the new layout
+		barrier.oldLayout = _OldLayout;
+		barrier.newLayout = _NewLayout;
+		// Used to change queue families
+		barrier.srcQueueFamilyIndex = _SrcQueueFamily;
+		barrier.dstQueueFamilyIndex = _DstQueueFamily;
+		// Base data of the image
+		barrier.image = _Image;
+		barrier.subresourceRange.aspectMask = _Aspect;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+
+		m_ImageBarriers.push_back(barrier);
+	}
+
+	void VulkanBarrierBuilder::AddImageTransition(VkImage _Image, VkFormat _Format, VkImageLayout _OldLayout, VkImageLayout _NewLayout)
+	{
+		VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+
+		// For depth buffer
+		if (_NewLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+		{
+			aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+			if (VulkanImage::HasStencilComponent(_Format))
+			{
+				aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+			}
+		}
+
+		// Handles some transitions
+		if (_OldLayout == VK_IMAGE_LAYOUT_UNDEFINED && _NewLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+		{
+			AddImageBarrier(_Image, aspect, _OldLayout, _NewLayout, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT_KHR, 0, VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR);
+		}
+		else if (_OldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && _NewLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+		{
+			AddImageBarrier(_Image, aspect, _OldLayout, _NewLayout, VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR);
+		}
+		else if (_OldLayout == VK_IMAGE_LAYOUT_UNDEFINED && _NewLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
+		{
+			// Also for depth buffer
+			AddImageBarrier(_Image, aspect, _OldLayout, _NewLayout, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT_KHR, 0, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR,
+				VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR);
+		}
+		else
+		{
+			DEBUG_ERROR("Unsupported layout transition !");
+		}
+	}
+
+	void VulkanBarrierBuilder::Flush(VulkanDevice* _Device, VkCommandBuffer _CommandBuffer)
+	{
+		if (IsEmpty())
+			return;
+
+		PFN_vkCmdPipelineBarrier2KHR cmdPipelineBarrier2 = _Device->GetCmdPipelineBarrier2();
+
+		if (cmdPipelineBarrier2 != nullptr)
+		{
+			// Every barrier keeps its own stages with synchronization2
+			VkDependencyInfoKHR dependencyInfo{};
+			dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+			dependencyInfo.memoryBarrierCount = static_cast<uint32_t>(m_MemoryBarriers.size());
+			dependencyInfo.pMemoryBarriers = m_MemoryBarriers.data();
+			dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(m_BufferBarriers.size());
+			dependencyInfo.pBufferMemoryBarriers = m_BufferBarriers.data();
+			dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(m_ImageBarriers.size());
+			dependencyInfo.pImageMemoryBarriers = m_ImageBarriers.data();
+
+			cmdPipelineBarrier2(_CommandBuffer, &dependencyInfo);
+		}
+		else
+		{
+			FlushLegacy(_CommandBuffer);
+		}
+
+		Clear();
+	}
+
+	void VulkanBarrierBuilder::FlushLegacy(VkCommandBuffer _CommandBuffer)
+	{
+		// Only the stages and accesses existing in Vulkan 1.0 are used by the builder, their bits are the same in both APIs
+		VkPipelineStageFlags sourceStage = 0;
+		VkPipelineStageFlags destinationStage = 0;
+
+		std::vector<VkMemoryBarrier> memoryBarriers(m_MemoryBarriers.size());
+		std::vector<VkBufferMemoryBarrier> bufferBarriers(m_BufferBarriers.size());
+		std::vector<VkImageMemoryBarrier> imageBarriers(m_ImageBarriers.size());
+
+		for (size_t i = 0; i < m_MemoryBarriers.size(); ++i)
+		{
+			const VkMemoryBarrier2KHR& barrier = m_MemoryBarriers[i];
+
+			memoryBarriers[i] = {};
+			memoryBarriers[i].sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			memoryBarriers[i].srcAccessMask = static_cast<VkAccessFlags>(barrier.srcAccessMask);
+			memoryBarriers[i].dstAccessMask = static_cast<VkAccessFlags>(barrier.dstAccessMask);
+
+			sourceStage |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+			destinationStage |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+		}
+
+		for (size_t i = 0; i < m_BufferBarriers.size(); ++i)
+		{
+			const VkBufferMemoryBarrier2KHR& barrier = m_BufferBarriers[i];
+
+			bufferBarriers[i] = {};
+			bufferBarriers[i].sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			bufferBarriers[i].srcAccessMask = static_cast<VkAccessFlags>(barrier.srcAccessMask);
+			bufferBarriers[i].dstAccessMask = static_cast<VkAccessFlags>(barrier.dstAccessMask);
+			bufferBarriers[i].srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+			bufferBarriers[i].dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+			bufferBarriers[i].buffer = barrier.buffer;
+			bufferBarriers[i].offset = barrier.offset;
+			bufferBarriers[i].size = barrier.size;
+
+			sourceStage |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+			destinationStage |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+		}
+
+		for (size_t i = 0; i < m_ImageBarriers.size(); ++i)
+		{
+			const VkImageMemoryBarrier2KHR& barrier = m_ImageBarriers[i];
+
+			imageBarriers[i] = {};
+			imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageBarriers[i].srcAccessMask = static_cast<VkAccessFlags>(barrier.srcAccessMask);
+			imageBarriers[i].dstAccessMask = static_cast<VkAccessFlags>(barrier.dstAccessMask);
+			imageBarriers[i].oldLayout = barrier.oldLayout;
+			imageBarriers[i].newLayout = barrier.newLayout;
+			imageBarriers[i].srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+			imageBarriers[i].dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+			imageBarriers[i].image = barrier.image;
+			imageBarriers[i].subresourceRange = barrier.subresourceRange;
+
+			sourceStage |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+			destinationStage |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+		}
+
+		// Empty stage masks are not allowed without synchronization2
+		if (sourceStage == 0)
+			sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+		if (destinationStage == 0)
+			destinationStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+		vkCmdPipelineBarrier(_CommandBuffer, sourceStage, destinationStage, 0,
+			static_cast<uint32_t>(memoryBarriers.size()), memoryBarriers.data(),
+			static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+			static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+	}
+
+	void VulkanBarrierBuilder::Clear()
+	{
+		m_MemoryBarriers.clear();
+		m_BufferBarriers.clear();
+		m_ImageBarriers.clear();
+	}
+}
\ No newline at end of file
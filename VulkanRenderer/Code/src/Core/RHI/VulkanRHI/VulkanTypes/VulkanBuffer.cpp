@@ -30,7 +30,7 @@ namespace Core
 
 	void VulkanBuffer::UpdateUBO(IDevice* _Device, void* _Data, size_t _DataSize)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		void* mappedMemory;
 		VkResult result = vkMapMemory(device.GetLogicalDevice(), m_BufferMemory, 0, _DataSize, 0, &mappedMemory);
@@ -111,7 +111,7 @@ namespace Core
 
 	const RHI_RESULT VulkanBuffer::DestroyBuffer(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyBuffer(device.GetLogicalDevice(), m_Buffer, nullptr);
 		vkFreeMemory(device.GetLogicalDevice(), m_BufferMemory, nullptr);
@@ -128,7 +128,7 @@ namespace Core
 
 	void VulkanBuffer::CreateBuffer(IDevice* _Device, VkDeviceSize _Size, VkBufferUsageFlags _Usage, VkMemoryPropertyFlags _Properties, VkBuffer& _Buffer, VkDeviceMemory& _BufferMemory)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Buffer infos
 		VkBufferCreateInfo bufferInfo{};
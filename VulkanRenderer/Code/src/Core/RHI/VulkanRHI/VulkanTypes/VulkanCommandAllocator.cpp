@@ -13,7 +13,7 @@ namespace Core
 
 	const RHI_RESULT VulkanCommandAllocator::CreateCommandAllocator(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Gets the queue families
 		QueueFamilyIndices queueFamilyIndices = VulkanQueue::FindQueueFamilies(device.GetPhysicalDevice(), device.GetSurface());
@@ -39,7 +39,7 @@ namespace Core
 
 	const RHI_RESULT VulkanCommandAllocator::DestroyCommandAllocator(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyCommandPool(device.GetLogicalDevice(), m_CommandPool, nullptr);
 		return RHI_RESULT();
@@ -47,7 +47,7 @@ namespace Core
 
 	ICommandBuffer* VulkanCommandAllocator::CreateCommandBuffer(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		VkCommandBufferAllocateInfo allocInfo{};
 		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -78,7 +78,7 @@ namespace Core
 
 	std::vector<ICommandBuffer*> VulkanCommandAllocator::CreateCommandBuffers(IDevice* _Device, int _CommandBuffersNbr)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		VkCommandBufferAllocateInfo allocInfo{};
 		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -174,29 +174,37 @@ namespace Core
 
 	void VulkanCommandBuffer::BindVertexBuffer(IMesh* _Mesh) const
 	{
-		VulkanMesh mesh = *_Mesh->CastToVulkan();
+		VulkanMesh* mesh = _Mesh->CastToVulkan();
 
-		VkBuffer vertexBuffers[] = { mesh.GetVertexBuffer().GetBuffer() };
-		VkDeviceSize offsets[] = { 0 };
+		// Interleaved attributes on binding 0, the colors on binding 1 when the format stores them apart
+		VkBuffer vertexBuffers[] = { mesh->GetVertexBuffer().GetBuffer(), mesh->HasColorStream() ? mesh->GetColorBuffer().GetBuffer() : VK_NULL_HANDLE };
+		VkDeviceSize offsets[] = { 0, 0 };
+		uint32_t bufferCount = mesh->HasColorStream() ? 2 : 1;
 
-		// Binds the vertex buffer
-		vkCmdBindVertexBuffers(m_CommandBuffer, 0, 1, vertexBuffers, offsets);
+		// Binds the vertex buffers
+		vkCmdBindVertexBuffers(m_CommandBuffer, 0, bufferCount, vertexBuffers, offsets);
 	}
 
 	void VulkanCommandBuffer::BindIndexBuffer(IMesh* _Mesh) const
 	{
-		VkBuffer buffer = _Mesh->CastToVulkan()->GetIndexBuffer().GetBuffer();
+		VulkanMesh* mesh = _Mesh->CastToVulkan();
 
-		// Binds the index buffer
-		vkCmdBindIndexBuffer(m_CommandBuffer, buffer, 0, VK_INDEX_TYPE_UINT32);
+		// Binds the index buffer, 16 bits indices when the mesh has few enough vertices
+		vkCmdBindIndexBuffer(m_CommandBuffer, mesh->GetIndexBuffer().GetBuffer(), 0, mesh->GetVulkanIndexType());
 	}
 
 	void VulkanCommandBuffer::DrawIndexed(IMesh* _Mesh) const
 	{
-		VulkanMesh mesh = *_Mesh->CastToVulkan();
+		// Draws the vertex buffer with indices, the indices of every submesh are relative to its first vertex
+		DrawIndexed(_Mesh->GetSubmeshes());
+	}
 
-		// Draws the vertex buffer with indices
-		vkCmdDrawIndexed(m_CommandBuffer, static_cast<uint32_t>(mesh.GetIndexNumber()), 1, 0, 0, 0);
+	void VulkanCommandBuffer::DrawIndexed(const std::vector<Submesh>& _Ranges) const
+	{
+		for (const Submesh& range : _Ranges)
+		{
+			vkCmdDrawIndexed(m_CommandBuffer, range.indexCount, 1, range.firstIndex, static_cast<int32_t>(range.vertexOffset), 0);
+		}
 	}
 
 	void VulkanCommandBuffer::EndRenderPass() const
@@ -20,7 +20,7 @@ namespace Core
 
 	const RHI_RESULT VulkanDescriptorAllocator::CreateDescriptorAllocator(IDevice* _Device, ISwapChain* _Swapchain)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VulkanSwapChain swapchain = *_Swapchain->CastToVulkan();
 
 		// Describes the pool size
@@ -54,7 +54,7 @@ namespace Core
 
 	const RHI_RESULT VulkanDescriptorAllocator::DestroyDescriptorAllocator(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyDescriptorPool(device.GetLogicalDevice(), m_DescriptorPool, nullptr);
 
@@ -63,7 +63,7 @@ namespace Core
 
 	std::vector<IDescriptor*> VulkanDescriptorAllocator::CreateTextureDescriptor(IDevice* _Device, int _DescriptorNbr, ITexture* _Texture, IDescriptorLayout* _Layout)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VulkanDescriptorLayout layout = *_Layout->CastToVulkan();
 
 		std::vector<VkDescriptorSetLayout> layouts(_DescriptorNbr, layout.GetType());
@@ -119,7 +119,7 @@ namespace Core
 
 	std::vector<IDescriptor*> VulkanDescriptorAllocator::CreateUBODescriptor(IDevice* _Device, int _DescriptorNbr, std::vector<IBuffer*> _Buffer, size_t _BufferSize, IDescriptorLayout* _Layout)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VulkanDescriptorLayout layout = *_Layout->CastToVulkan();
 
 		std::vector<VkDescriptorSetLayout> layouts(_DescriptorNbr, layout.GetType());
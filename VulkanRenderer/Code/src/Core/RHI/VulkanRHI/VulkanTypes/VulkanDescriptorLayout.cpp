@@ -1,6 +1,7 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDescriptorLayout.h"
 
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
+#include "RHI/ShaderReflection.h"
 #include <iostream>
 
 namespace Core
@@ -10,12 +11,14 @@ namespace Core
 	}
 	const RHI_RESULT VulkanDescriptorLayout::CreateDescriptorSetLayout(IDevice* _Device, std::vector<DescriptorLayoutInfos> _Infos)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		// All the bindings of the set are in the same layout
+		std::vector<VkDescriptorSetLayoutBinding> layoutBindings(_Infos.size());
 
 		for (size_t i = 0; i < _Infos.size(); ++i)
 		{
-			// Descriptor Set layout binding for ubo
-			VkDescriptorSetLayoutBinding layoutBinding{};
+			VkDescriptorSetLayoutBinding& layoutBinding = layoutBindings[i];
 			// Describe the biding of the descriptors sets (binding = 0 but for ubo samplers etc)
 			layoutBinding.binding = static_cast<uint32_t>(_Infos[i].binding);
 
@@ -28,39 +31,42 @@ namespace Core
 			case RHI_DESCRIPTOR_SAMPLER:
 				layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 				break;
+			case RHI_DESCRIPTOR_STORAGE_BUFFER:
+				layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				break;
 			}
 
 			// Can specifies if it is an array of descriptor
-			layoutBinding.descriptorCount = 1;
+			layoutBinding.descriptorCount = static_cast<uint32_t>(_Infos[i].count);
+
+			unsigned int stages = _Infos[i].stages != 0 ? _Infos[i].stages : GetShaderStageBit(_Infos[i].entryShader);
 
 			// Describes which stages can access the UBO can also be VK_SHADER_STAGE_ALL_GRAPHICS
-			switch (_Infos[i].entryShader)
-			{
-			default:
-			case RHI_VERTEX:
-				layoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-				break;
-			case RHI_FRAGMENT:
-				layoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-				break;
-			}
+			layoutBinding.stageFlags = 0;
+
+			if (stages & GetShaderStageBit(RHI_VERTEX))
+				layoutBinding.stageFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+			if (stages & GetShaderStageBit(RHI_FRAGMENT))
+				layoutBinding.stageFlags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+			if (stages & GetShaderStageBit(RHI_GEOMETRY))
+				layoutBinding.stageFlags |= VK_SHADER_STAGE_GEOMETRY_BIT;
+		}
 
-			// Layout info
-			VkDescriptorSetLayoutCreateInfo layoutInfo{};
-			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-			// Nbr of bindings
-			layoutInfo.bindingCount = 1;
-			// Bindings data
-			layoutInfo.pBindings = &layoutBinding;
+		// Layout info
+		VkDescriptorSetLayoutCreateInfo layoutInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		// Nbr of bindings
+		layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+		// Bindings data
+		layoutInfo.pBindings = layoutBindings.data();
 
-			// Creates the Descriptor set layout
-			VkResult result = vkCreateDescriptorSetLayout(device.GetLogicalDevice(), &layoutInfo, nullptr, &m_DescriptorSetLayout);
+		// Creates the Descriptor set layout
+		VkResult result = vkCreateDescriptorSetLayout(device.GetLogicalDevice(), &layoutInfo, nullptr, &m_DescriptorSetLayout);
 
-			if (result != VK_SUCCESS)
-			{
-				DEBUG_ERROR("Failed to create descriptor set layout, Error Code: %d", result);
-				return RHI_FAILED_UNKNOWN;
-			}
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create descriptor set layout, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
 		}
 
 		return RHI_SUCCESS;
@@ -68,8 +74,75 @@ namespace Core
 
 	const void VulkanDescriptorLayout::DestroyDescriptorSetLayout(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyDescriptorSetLayout(device.GetLogicalDevice(), m_DescriptorSetLayout, nullptr);
+		m_DescriptorSetLayout = VK_NULL_HANDLE;
+	}
+
+	std::string VulkanDescriptorLayout::ComputeSharedKey(const std::vector<DescriptorLayoutInfos>& _Infos)
+	{
+		std::string key;
+
+		for (const DescriptorLayoutInfos& infos : _Infos)
+		{
+			unsigned int stages = infos.stages != 0 ? infos.stages : GetShaderStageBit(infos.entryShader);
+
+			key += std::to_string(infos.binding) + ":" + std::to_string(infos.type) + ":" + std::to_string(infos.count) + ":" + std::to_string(stages) + ";";
+		}
+
+		return key;
+	}
+
+	VulkanDescriptorLayout* VulkanDescriptorLayout::Acquire(IDevice* _Device, const std::vector<DescriptorLayoutInfos>& _Infos)
+	{
+		std::string key = ComputeSharedKey(_Infos);
+
+		std::lock_guard<std::mutex> lock(m_SharedLayoutsMutex);
+
+		SharedLayout& shared = m_SharedLayouts[key];
+
+		if (shared.layout == nullptr)
+		{
+			VulkanDescriptorLayout* layout = new VulkanDescriptorLayout();
+
+			if (!layout->CreateDescriptorSetLayout(_Device, _Infos))
+			{
+				delete layout;
+				m_SharedLayouts.erase(key);
+				return nullptr;
+			}
+
+			layout->m_SharedKey = key;
+			shared.layout = layout;
+		}
+
+		++shared.referenceCount;
+
+		return shared.layout;
+	}
+
+	void VulkanDescriptorLayout::Release(IDevice* _Device, VulkanDescriptorLayout* _Layout)
+	{
+		if (_Layout == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_SharedLayoutsMutex);
+
+		std::unordered_map<std::string, SharedLayout>::iterator shared = m_SharedLayouts.find(_Layout->m_SharedKey);
+
+		if (shared == m_SharedLayouts.end() || shared->second.layout != _Layout)
+		{
+			DEBUG_WARN("Released a descriptor set layout that was not acquired");
+			return;
+		}
+
+		if (--shared->second.referenceCount > 0)
+			return;
+
+		_Layout->DestroyDescriptorSetLayout(_Device);
+		delete _Layout;
+
+		m_SharedLayouts.erase(shared);
 	}
 }
\ No newline at end of file
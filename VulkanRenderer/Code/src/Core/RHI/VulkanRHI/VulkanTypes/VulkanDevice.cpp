@@ -4,6 +4,7 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanSwapChain.h"
 
 #include <set>
+#include <fstream>
 
 namespace Core
 {
@@ -23,7 +24,8 @@ namespace Core
 		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 		appInfo.pEngineName = "No Engine";
 		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-		appInfo.apiVersion = VK_API_VERSION_1_0;
+		// 1.1 for vkGetPhysicalDeviceFeatures2, used to query optional features
+		appInfo.apiVersion = VK_API_VERSION_1_1;
 
 		VkInstanceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -276,7 +278,7 @@ namespace Core
 		QueueFamilyIndices indices = VulkanQueue::FindQueueFamilies(m_PhysicalDevice, m_Surface);
 		float queuePriority = 1.0f;
 
-		std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+		std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value(), indices.transfertFamily.value() };
 
 		// References our queues in a create info for the device
 		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -295,14 +297,29 @@ namespace Core
 		VkPhysicalDeviceFeatures deviceFeatures{};
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+		std::vector<const char*> enabledExtensions = m_DeviceExtensions;
+
+		// Optional, barriers fall back on vkCmdPipelineBarrier without it
+		const bool isSynchronization2Supported = CheckSynchronization2Support(m_PhysicalDevice);
+
+		VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{};
+		synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+		synchronization2Features.synchronization2 = VK_TRUE;
+
+		if (isSynchronization2Supported)
+		{
+			enabledExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+		}
+
 		// Specifies the information for the logical device (extensions and queues)
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		createInfo.pNext = isSynchronization2Supported ? &synchronization2Features : nullptr;
 		createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
 		createInfo.pEnabledFeatures = &deviceFeatures;
-		createInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+		createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
 		// Specifies the validations layers if enabled
 		if (m_EnableValidationLayers)
@@ -327,7 +344,13 @@ namespace Core
 		// References the queues
 		vkGetDeviceQueue(m_LogicalDevice, indices.graphicsFamily.value(), 0, &m_GraphicsQueue);
 		vkGetDeviceQueue(m_LogicalDevice, indices.presentFamily.value(), 0, &m_PresentationQueue);
-		//vkGetDeviceQueue(m_LogicalDevice, indices.transfertFamily.value(), 0, &m_TransferQueue);
+		vkGetDeviceQueue(m_LogicalDevice, indices.transfertFamily.value(), 0, &m_TransferQueue);
+
+		// Extension commands have to be loaded manually
+		if (isSynchronization2Supported)
+		{
+			m_CmdPipelineBarrier2 = (PFN_vkCmdPipelineBarrier2KHR)vkGetDeviceProcAddr(m_LogicalDevice, "vkCmdPipelineBarrier2KHR");
+		}
 
 		return RHI_SUCCESS;
 	}
@@ -394,6 +417,202 @@ namespace Core
 		return requiredExtensions.empty();
 	}
 
+	const bool VulkanDevice::CheckSynchronization2Support(VkPhysicalDevice _Device)
+	{
+		uint32_t extensionsNbr;
+		vkEnumerateDeviceExtensionProperties(_Device, nullptr, &extensionsNbr, nullptr);
+
+		std::vector<VkExtensionProperties> availableExtensions(extensionsNbr);
+		vkEnumerateDeviceExtensionProperties(_Device, nullptr, &extensionsNbr, availableExtensions.data());
+
+		bool isExtensionAvailable = false;
+
+		for (const VkExtensionProperties& extension : availableExtensions)
+		{
+			if (strcmp(extension.extensionName, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) == 0)
+			{
+				isExtensionAvailable = true;
+				break;
+			}
+		}
+
+		if (!isExtensionAvailable)
+			return false;
+
+		// The extension can be exposed without the feature being usable
+		VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{};
+		synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+
+		VkPhysicalDeviceFeatures2 features{};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &synchronization2Features;
+
+		vkGetPhysicalDeviceFeatures2(_Device, &features);
+
+		return synchronization2Features.synchronization2 == VK_TRUE;
+	}
+
+	const RHI_RESULT VulkanDevice::CreatePipelineCache()
+	{
+		std::vector<char> cacheData;
+
+		std::ifstream file(m_PipelineCachePath, std::ios::binary | std::ios::ate);
+
+		if (file.is_open())
+		{
+			cacheData.resize(static_cast<size_t>(file.tellg()));
+
+			file.seekg(0);
+			file.read(cacheData.data(), cacheData.size());
+
+			if (!file || !IsPipelineCacheDataValid(cacheData))
+			{
+				DEBUG_WARN("Ignoring pipeline cache written by another device: %s", m_PipelineCachePath.string().c_str());
+				cacheData.clear();
+			}
+		}
+
+		VkPipelineCacheCreateInfo cacheInfo{};
+		cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		// An empty cache is created on the first run
+		cacheInfo.initialDataSize = cacheData.size();
+		cacheInfo.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+
+		VkResult result = vkCreatePipelineCache(m_LogicalDevice, &cacheInfo, nullptr, &m_PipelineCache);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create pipeline cache, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		DEBUG_LOG("Pipeline cache created with %u bytes from the previous run", static_cast<unsigned int>(cacheData.size()));
+
+		return RHI_SUCCESS;
+	}
+
+	const bool VulkanDevice::IsPipelineCacheDataValid(const std::vector<char>& _Data)
+	{
+		// Some drivers do not check the data they are given, a cache of another GPU can make them crash
+		VkPipelineCacheHeaderVersionOne header{};
+
+		if (_Data.size() < sizeof(header))
+			return false;
+
+		memcpy(&header, _Data.data(), sizeof(header));
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
+
+		return header.headerSize >= sizeof(header)
+			&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties.vendorID
+			&& header.deviceID == properties.deviceID
+			&& memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	void VulkanDevice::DestroyPipelineCache()
+	{
+		if (m_PipelineCache == VK_NULL_HANDLE)
+			return;
+
+		MergeWorkerPipelineCaches();
+
+		std::unique_lock<std::shared_mutex> cacheLock(m_PipelineCacheMutex);
+
+		size_t dataSize = 0;
+		vkGetPipelineCacheData(m_LogicalDevice, m_PipelineCache, &dataSize, nullptr);
+
+		std::vector<char> cacheData(dataSize);
+		VkResult result = vkGetPipelineCacheData(m_LogicalDevice, m_PipelineCache, &dataSize, cacheData.data());
+
+		vkDestroyPipelineCache(m_LogicalDevice, m_PipelineCache, nullptr);
+		m_PipelineCache = VK_NULL_HANDLE;
+
+		if (result != VK_SUCCESS || dataSize == 0)
+		{
+			DEBUG_WARN("Failed to read the pipeline cache, it is not saved");
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(m_PipelineCachePath.parent_path(), error);
+
+		// Written next to the previous cache then renamed so a crash never leaves a partial file
+		std::filesystem::path temporaryPath = m_PipelineCachePath;
+		temporaryPath += ".tmp";
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			file.write(cacheData.data(), dataSize);
+
+			if (!file)
+			{
+				DEBUG_WARN("Failed to write pipeline cache: %s", temporaryPath.string().c_str());
+				return;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, m_PipelineCachePath, error);
+
+		if (error)
+		{
+			DEBUG_WARN("Failed to write pipeline cache: %s", m_PipelineCachePath.string().c_str());
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	VkPipelineCache VulkanDevice::CreateWorkerPipelineCache()
+	{
+		VkPipelineCacheCreateInfo cacheInfo{};
+		cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+		VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+
+		// Without a cache the pipeline is still created
+		if (vkCreatePipelineCache(m_LogicalDevice, &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+			return VK_NULL_HANDLE;
+
+		return pipelineCache;
+	}
+
+	void VulkanDevice::SubmitWorkerPipelineCache(VkPipelineCache _PipelineCache)
+	{
+		if (_PipelineCache == VK_NULL_HANDLE)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_WorkerPipelineCachesMutex);
+		m_WorkerPipelineCaches.push_back(_PipelineCache);
+	}
+
+	void VulkanDevice::MergeWorkerPipelineCaches()
+	{
+		std::vector<VkPipelineCache> workerCaches;
+
+		{
+			std::lock_guard<std::mutex> lock(m_WorkerPipelineCachesMutex);
+			workerCaches.swap(m_WorkerPipelineCaches);
+		}
+
+		if (workerCaches.empty())
+			return;
+
+		std::unique_lock<std::shared_mutex> cacheLock(m_PipelineCacheMutex);
+
+		VkResult result = vkMergePipelineCaches(m_LogicalDevice, m_PipelineCache, static_cast<uint32_t>(workerCaches.size()), workerCaches.data());
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_WARN("Failed to merge the pipeline caches of the workers, Error Code: %d", result);
+		}
+
+		for (VkPipelineCache workerCache : workerCaches)
+		{
+			vkDestroyPipelineCache(m_LogicalDevice, workerCache, nullptr);
+		}
+	}
+
 	VulkanDevice::~VulkanDevice()
 	{}
 
@@ -403,12 +622,15 @@ namespace Core
 		CreateSurface(_Window);
 		PickPhysicalDevice();
 		CreateLogicalDevice();
+		CreatePipelineCache();
 
 		return RHI_SUCCESS;
     }
 
 	const RHI_RESULT VulkanDevice::Terminate()
     {
+		DestroyPipelineCache();
+
 		vkDestroyDevice(m_LogicalDevice, nullptr);
 
 		if (m_EnableValidationLayers)
@@ -9,7 +9,7 @@ namespace Core
 
 	RHI_RESULT VulkanFence::CreateFenceSync(IDevice * _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Fence create info - for CPU / GPU synchronization
 		VkFenceCreateInfo fenceInfo{};
@@ -30,7 +30,7 @@ namespace Core
 
 	RHI_RESULT VulkanFence::DestroyFenceSync(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyFence(device.GetLogicalDevice(), m_Fence, nullptr);
 
@@ -39,14 +39,14 @@ namespace Core
 
 	void VulkanFence::WaitFence(IDevice* _Device, unsigned int _CancelDelay)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkWaitForFences(device.GetLogicalDevice(), 1, &m_Fence, VK_TRUE, _CancelDelay);
 	}
 
 	void VulkanFence::ResetFence(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkResetFences(device.GetLogicalDevice(), 1, &m_Fence);
 	}
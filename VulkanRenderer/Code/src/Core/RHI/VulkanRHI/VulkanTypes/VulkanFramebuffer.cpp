@@ -7,7 +7,7 @@ namespace Core
 {
 	const RHI_RESULT VulkanFramebuffer::CreateFramebuffer(IDevice* _Device, IPipeline* _CompatiblePipeline, int _Width, int _Height, VkImageView& _ColorBufer, VkImageView& _DepthBuffer)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VulkanPipeline pipeline = *_CompatiblePipeline->CastToVulkan();
 
 		// Specifies the attachments for each frame buffer
@@ -42,7 +42,7 @@ namespace Core
 
 	const RHI_RESULT VulkanFramebuffer::DestroyFramebuffer(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyFramebuffer(device.GetLogicalDevice(), m_FrameBuffer, nullptr);
 
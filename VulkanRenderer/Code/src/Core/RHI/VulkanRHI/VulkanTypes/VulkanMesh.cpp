@@ -3,73 +3,52 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
 
 #include "RHI/VulkanRHI/VulkanTypes/VulkanBuffer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanUploadManager.h"
 
 #include "Renderer.h"
 
 namespace Core
 {
-	RHI_RESULT VulkanMesh::CreateVertexBuffer(Core::IDevice* _Device, std::vector<Vertex>& _VerticesList)
+	RHI_RESULT VulkanMesh::CreateVertexStreams(Core::IDevice* _Device, const void* _VertexData, size_t _VertexDataSize, const void* _ColorData, size_t _ColorDataSize)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
-
-		VkDeviceSize bufferSize = sizeof(_VerticesList[0]) * _VerticesList.size();
-
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingBufferMemory;
-
-		m_VertexBuffer.CreateBuffer(_Device, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-
-		// Maps the data into the GPU Memory and copy the data into the memory
-		void* data;
-		vkMapMemory(device.GetLogicalDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, _VerticesList.data(), (size_t)bufferSize);
-		vkUnmapMemory(device.GetLogicalDevice(), stagingBufferMemory);
+		VkDeviceSize bufferSize = _VertexDataSize;
 
 		// Creates the vertex buffer
 		// VK_BUFFER_USAGE_TRANSFER_DST_BIT specifies that the buffer can only receive data from memory of the GPU and that it is a VERTEX_BUFFER
 		// VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT specifies that the memory is only for GPU and optimized for GPU
 		m_VertexBuffer.CreateBuffer(_Device, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_VertexBuffer.m_Buffer, m_VertexBuffer.m_BufferMemory);
 
-		// Copies the data from the staging buffer to the vertex buffer
-		VulkanBuffer::CopyBuffer(&device, Core::Renderer::GetCommandAllocator()->CastToVulkan(), stagingBuffer, m_VertexBuffer.m_Buffer, bufferSize);
+		// Records the copy in the current upload batch, the data is copied in the staging ring so it can be released right after
+		Core::Renderer::GetUploadManager()->CastToVulkan()->UploadToBuffer(m_VertexBuffer.m_Buffer, _VertexData, bufferSize);
 
-		// Destroys the stagging buffer and free the memory
-		vkDestroyBuffer(device.GetLogicalDevice(), stagingBuffer, nullptr);
-		vkFreeMemory(device.GetLogicalDevice(), stagingBufferMemory, nullptr);
-
-		return RHI_SUCCESS;
-	}
+		m_HasColorStream = _ColorData != nullptr && _ColorDataSize > 0;
 
-	RHI_RESULT VulkanMesh::CreateIndexBuffer(Core::IDevice* _Device, std::vector<uint32_t>& _IndicesList)
-	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		if (m_HasColorStream)
+		{
+			VkDeviceSize colorSize = _ColorDataSize;
 
-		m_IndexNbr = _IndicesList.size();
+			m_ColorBuffer.CreateBuffer(_Device, colorSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_ColorBuffer.m_Buffer, m_ColorBuffer.m_BufferMemory);
 
-		VkDeviceSize bufferSize = sizeof(_IndicesList[0]) * _IndicesList.size();
+			Core::Renderer::GetUploadManager()->CastToVulkan()->UploadToBuffer(m_ColorBuffer.m_Buffer, _ColorData, colorSize);
+		}
 
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingBufferMemory;
+		return RHI_SUCCESS;
+	}
 
-		m_VertexBuffer.CreateBuffer(_Device, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+	RHI_RESULT VulkanMesh::CreateIndexStream(Core::IDevice* _Device, const void* _Indices, size_t _IndexCount, IndexType _IndexType)
+	{
+		m_IndexNbr = _IndexCount;
+		m_IndexType = _IndexType == RHI_INDEX_UINT16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
 
-		// Maps the data into the GPU Memory and copy the data into the memory
-		void* data;
-		vkMapMemory(device.GetLogicalDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, _IndicesList.data(), (size_t)bufferSize);
-		vkUnmapMemory(device.GetLogicalDevice(), stagingBufferMemory);
+		VkDeviceSize bufferSize = (_IndexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t)) * _IndexCount;
 
 		// Creates the index buffer
-		// VK_BUFFER_USAGE_TRANSFER_DST_BIT specifies that the buffer can only receive data from memory of the GPU and that it is a VERTEX_BUFFER
+		// VK_BUFFER_USAGE_TRANSFER_DST_BIT specifies that the buffer can only receive data from memory of the GPU and that it is an INDEX_BUFFER
 		// VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT specifies that the memory is only for GPU and optimized for GPU
-		m_VertexBuffer.CreateBuffer(_Device, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_IndexBuffer.m_Buffer, m_IndexBuffer.m_BufferMemory);
-
-		// Copies the data from the staging buffer to the vertex buffer
-		VulkanBuffer::CopyBuffer(&device, Core::Renderer::GetCommandAllocator()->CastToVulkan(), stagingBuffer, m_IndexBuffer.m_Buffer, bufferSize);
+		m_IndexBuffer.CreateBuffer(_Device, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_IndexBuffer.m_Buffer, m_IndexBuffer.m_BufferMemory);
 
-		// Destroys the stagging buffer and free the memory
-		vkDestroyBuffer(device.GetLogicalDevice(), stagingBuffer, nullptr);
-		vkFreeMemory(device.GetLogicalDevice(), stagingBufferMemory, nullptr);
+		// Records the copy in the current upload batch
+		Core::Renderer::GetUploadManager()->CastToVulkan()->UploadToBuffer(m_IndexBuffer.m_Buffer, _Indices, bufferSize);
 
 		return RHI_SUCCESS;
 	}
@@ -79,6 +58,12 @@ namespace Core
 		m_VertexBuffer.DestroyBuffer(_Device);
 		m_IndexBuffer.DestroyBuffer(_Device);
 
+		if (m_HasColorStream)
+		{
+			m_ColorBuffer.DestroyBuffer(_Device);
+			m_HasColorStream = false;
+		}
+
 		return RHI_SUCCESS;
 	}
 }
\ No newline at end of file
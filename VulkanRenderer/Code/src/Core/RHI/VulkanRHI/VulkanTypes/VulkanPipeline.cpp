@@ -5,30 +5,120 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanSwapChain.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanImage.h"
 
+#include "Renderer.h"
+
 namespace Core
 {
 	VulkanPipeline::~VulkanPipeline()
 	{}
 
-	RHI_RESULT VulkanPipeline::CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, std::vector<PipelineShaderInfos> _ShadersInfos)
+	RHI_RESULT VulkanPipeline::CreatePipeline(IDevice* _Device, ISwapChain* _Swapchain, const PipelineDescription& _Description)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
-		VulkanSwapChain swapchain = *_Swapchain->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		p_Description = _Description;
+		p_DescriptionHash = _Description.ComputeHash();
+
+		if (!ReflectShaders(p_Description.shaders, p_Reflection))
+			return RHI_FAILED_UNKNOWN;
+
+		// Pipelines with the same formats have compatible render passes and can draw in the same framebuffers
+		VkFormat colorFormat = p_Description.colorFormat != 0 ? static_cast<VkFormat>(p_Description.colorFormat) : _Swapchain->CastToVulkan()->GetSwapChainFormat();
+		VkFormat depthFormat = p_Description.depthFormat != 0 ? static_cast<VkFormat>(p_Description.depthFormat) : VulkanImage::FindDepthFormat(device.GetPhysicalDevice());
+
+		CreateRenderPass(&device, colorFormat, depthFormat);
+
+		if (!CreateDescriptorSetLayout(&device))
+			return RHI_FAILED_UNKNOWN;
+
+		if (!CreatePipelineLayout(&device))
+			return RHI_FAILED_UNKNOWN;
+
+		return CreateGraphicsPipeline(&device, p_Description, p_Reflection, device.GetPipelineCache(), m_GraphicsPipeline);
+	}
+
+	RHI_RESULT VulkanPipeline::CreatePipelineLayout(VulkanDevice* _Device)
+	{
+		std::vector<VkDescriptorSetLayout> layouts(p_DescriptorSetLayouts.size());
+
+		for (size_t i = 0; i < p_DescriptorSetLayouts.size(); ++i)
+		{
+			layouts[i] = p_DescriptorSetLayouts[i]->CastToVulkan()->GetType();
+		}
+
+		std::vector<VkPushConstantRange> pushConstantRanges(p_Reflection.pushConstants.size());
+
+		for (size_t i = 0; i < p_Reflection.pushConstants.size(); ++i)
+		{
+			pushConstantRanges[i].offset = p_Reflection.pushConstants[i].offset;
+			pushConstantRanges[i].size = p_Reflection.pushConstants[i].size;
+			pushConstantRanges[i].stageFlags = 0;
+
+			if (p_Reflection.pushConstants[i].stages & GetShaderStageBit(RHI_VERTEX))
+				pushConstantRanges[i].stageFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+			if (p_Reflection.pushConstants[i].stages & GetShaderStageBit(RHI_FRAGMENT))
+				pushConstantRanges[i].stageFlags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+			if (p_Reflection.pushConstants[i].stages & GetShaderStageBit(RHI_GEOMETRY))
+				pushConstantRanges[i].stageFlags |= VK_SHADER_STAGE_GEOMETRY_BIT;
+		}
+
+		// Pipeline layout infos
+		// Describes all uniform buffers present in our pipeline
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		// References the Descriptors set layout (UBO) or global variables
+		pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
+		pipelineLayoutInfo.pSetLayouts = layouts.data();
+		pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+		pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
+
+		// Creates the pipeline layout
+		VkResult result = vkCreatePipelineLayout(_Device->GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout);
 
-		CreateRenderPass(&device, &swapchain);
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create pipeline layout, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
 
-		CreateDescriptorSetLayout(&device);
+		return RHI_SUCCESS;
+	}
+
+	static VkCompareOp GetCompareOp(CompareOperation _CompareOperation)
+	{
+		switch (_CompareOperation)
+		{
+		case RHI_COMPARE_NEVER:
+			return VK_COMPARE_OP_NEVER;
+		case RHI_COMPARE_LESS: default:
+			return VK_COMPARE_OP_LESS;
+		case RHI_COMPARE_EQUAL:
+			return VK_COMPARE_OP_EQUAL;
+		case RHI_COMPARE_LESS_OR_EQUAL:
+			return VK_COMPARE_OP_LESS_OR_EQUAL;
+		case RHI_COMPARE_GREATER:
+			return VK_COMPARE_OP_GREATER;
+		case RHI_COMPARE_GREATER_OR_EQUAL:
+			return VK_COMPARE_OP_GREATER_OR_EQUAL;
+		case RHI_COMPARE_ALWAYS:
+			return VK_COMPARE_OP_ALWAYS;
+		}
+	}
+
+	RHI_RESULT VulkanPipeline::CreateGraphicsPipeline(VulkanDevice* _Device, const PipelineDescription& _Description, const PipelineReflection& _Reflection, VkPipelineCache _PipelineCache, VkPipeline& _Pipeline) const
+	{
+		const std::vector<PipelineShaderInfos>& shadersInfos = _Description.shaders;
 
 		std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
 
-		for (size_t i = 0; i < _ShadersInfos.size(); ++i)
+		for (size_t i = 0; i < shadersInfos.size(); ++i)
 		{
 			// Creates vertex shader infos
 			VkPipelineShaderStageCreateInfo shaderStageInfo{};
 			shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 			// Stage of the pipeline (Which momement the shader will be called)
 
-			switch (_ShadersInfos[i].shaderType)
+			switch (shadersInfos[i].shaderType)
 			{
 			case RHI_VERTEX: default:
 				shaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
@@ -42,27 +132,34 @@ namespace Core
 			}
 
 			// Shader module
-			shaderStageInfo.module = _ShadersInfos[i].shader->CastToVulkan()->GetShaderModule();
+			shaderStageInfo.module = shadersInfos[i].shader->CastToVulkan()->GetShaderModule();
 			// Start function of the shader
-			shaderStageInfo.pName = _ShadersInfos[i].functionEntry;
+			shaderStageInfo.pName = shadersInfos[i].functionEntry;
 
 			shaderStages.push_back(shaderStageInfo);
 		}
 
-		// Gets the vertex binding and attribute descriptions
-		VkVertexInputBindingDescription bindingDescription = Core::Vertex::GetBindingDescription();
-		std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = Core::Vertex::GetAttributeDescriptions();
+		// Gets the vertex streams of the format of the description and the attributes read by the vertex shader
+		VertexLayout vertexLayout = VertexLayout::Get(_Description.vertexFormat);
+
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+
+		Core::Vertex::GetBindingDescriptions(vertexLayout, bindingDescriptions);
+
+		if (!Core::Vertex::GetAttributeDescriptions(vertexLayout, _Reflection.vertexInputs, attributeDescriptions))
+			return RHI_FAILED_UNKNOWN;
 
 		// Describes how the vertex will be inputted in the first shader 
 		// (Correspond to the layout(binding=0) position etc in the shader)
 		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		// How much vertices we are describing
-		vertexInputInfo.vertexBindingDescriptionCount = 1;
+		// How much vertex streams we are describing
+		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
 		// The number of attribute per vertex (Position, Color, Normal ...)
 		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-		// The binding description ()
-		vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+		// The binding descriptions (stride of every stream)
+		vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 		// The attributes description (Binding, size, offset, type)
 		vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -99,16 +196,28 @@ namespace Core
 		// Desactivates rasterizer and steps after
 		rasterizer.rasterizerDiscardEnable = VK_FALSE;
 		// Defines how the polygons are drawn (Fill, poins, lines)
-		rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+		rasterizer.polygonMode = _Description.raster.isWireframe ? VK_POLYGON_MODE_LINE : VK_POLYGON_MODE_FILL;
 		rasterizer.lineWidth = 1.f;
 		// Defines culling
-		rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-		rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+		switch (_Description.raster.cullMode)
+		{
+		case RHI_CULL_NONE:
+			rasterizer.cullMode = VK_CULL_MODE_NONE;
+			break;
+		case RHI_CULL_BACK: default:
+			rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+			break;
+		case RHI_CULL_FRONT:
+			rasterizer.cullMode = VK_CULL_MODE_FRONT_BIT;
+			break;
+		}
+
+		rasterizer.frontFace = _Description.raster.isFrontFaceCounterClockwise ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE;
 		// Modifies the depth acording to a fragment (usefull for shadow mapping)
-		rasterizer.depthBiasEnable = VK_FALSE;
-		rasterizer.depthBiasConstantFactor = 0.f;
+		rasterizer.depthBiasEnable = _Description.raster.isDepthBiasEnabled ? VK_TRUE : VK_FALSE;
+		rasterizer.depthBiasConstantFactor = _Description.raster.depthBiasConstantFactor;
 		rasterizer.depthBiasClamp = 0.f;
-		rasterizer.depthBiasSlopeFactor = 0.f;
+		rasterizer.depthBiasSlopeFactor = _Description.raster.depthBiasSlopeFactor;
 
 		// Multisampling infos
 		VkPipelineMultisampleStateCreateInfo multisampling{};
@@ -124,25 +233,41 @@ namespace Core
 		// Activate depth test
 		VkPipelineDepthStencilStateCreateInfo depthStencil{};
 		depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-		depthStencil.depthTestEnable = VK_TRUE;
-		depthStencil.depthWriteEnable = VK_TRUE;
+		depthStencil.depthTestEnable = _Description.depth.isTestEnabled ? VK_TRUE : VK_FALSE;
+		depthStencil.depthWriteEnable = _Description.depth.isWriteEnabled ? VK_TRUE : VK_FALSE;
 		// Comparison test to eleminate or keep frag
-		depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+		depthStencil.depthCompareOp = GetCompareOp(_Description.depth.compareOperation);
 		depthStencil.depthBoundsTestEnable = VK_FALSE;
 		depthStencil.stencilTestEnable = VK_FALSE;
 
 		// Color blending infos (The color given by the fragshader is blend with the other color at the same fragment)
 		// This structure describes how it should be blend
 		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-		colorBlendAttachment.blendEnable = VK_FALSE;
-		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+		// RGBA bits of the description have the same values as the Vulkan ones
+		colorBlendAttachment.colorWriteMask = static_cast<VkColorComponentFlags>(_Description.blend.colorWriteMask);
+		colorBlendAttachment.blendEnable = _Description.blend.mode != RHI_BLEND_OPAQUE ? VK_TRUE : VK_FALSE;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
 		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
 		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
 		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
 		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
 		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
+		switch (_Description.blend.mode)
+		{
+		case RHI_BLEND_ALPHA:
+			colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+			colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+			break;
+		case RHI_BLEND_ADDITIVE:
+			colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+			colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+			break;
+		default:
+			break;
+		}
+
 		// Specifies how the color blend with many frame buffers
 		VkPipelineColorBlendStateCreateInfo colorBlending{};
 		colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
@@ -155,32 +280,6 @@ namespace Core
 		colorBlending.blendConstants[2] = 0.f;
 		colorBlending.blendConstants[3] = 0.f;
 
-		std::vector<VkDescriptorSetLayout> layouts(p_DescriptorSetLayouts.size());
-
-		for (size_t i = 0; i < p_DescriptorSetLayouts.size(); ++i)
-		{
-			layouts[i] = p_DescriptorSetLayouts[i]->CastToVulkan()->GetType();
-		}
-
-		// Pipeline layout infos
-		// Describes all uniform buffers present in our pipeline
-		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		// References the Descriptors set layout (UBO) or global variables
-		pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(layouts.size());
-		pipelineLayoutInfo.pSetLayouts = layouts.data();
-		pipelineLayoutInfo.pushConstantRangeCount = 0;
-		pipelineLayoutInfo.pPushConstantRanges = nullptr;
-
-		// Creates the pipeline layout
-		VkResult result = vkCreatePipelineLayout(device.GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout);
-
-		if (result != VK_SUCCESS)
-		{
-			DEBUG_ERROR("Failed to create pipeline layout, Error Code: %d", result);
-			return RHI_FAILED_UNKNOWN;
-		}
-
 		// References all the information created
 		VkGraphicsPipelineCreateInfo pipelineInfo{};
 		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -205,8 +304,11 @@ namespace Core
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 		pipelineInfo.basePipelineIndex = -1;
 
-		// Creates the pipeline
-		result = vkCreateGraphicsPipelines(device.GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline);
+		// Creates the pipeline, the driver skips the compilation if the cache already contains it
+		// The cache is synchronized by the driver, the lock only prevents a merge into it at the same time
+		std::shared_lock<std::shared_mutex> cacheLock(_Device->GetPipelineCacheMutex());
+
+		VkResult result = vkCreateGraphicsPipelines(_Device->GetLogicalDevice(), _PipelineCache, 1, &pipelineInfo, nullptr, &_Pipeline);
 
 		if (result != VK_SUCCESS)
 		{
@@ -219,62 +321,142 @@ namespace Core
 
 	RHI_RESULT VulkanPipeline::DestroyPipeline(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
+		// Layouts are shared with the other pipelines using the same sets
 		for (size_t i = 0; i < p_DescriptorSetLayouts.size(); ++i)
 		{
-			p_DescriptorSetLayouts[i]->DestroyDescriptorSetLayout(_Device);
-		}
-
-		for (auto& layout : p_DescriptorSetLayouts) 
-		{
-			delete layout;
+			VulkanDescriptorLayout::Release(_Device, p_DescriptorSetLayouts[i]->CastToVulkan());
 		}
 
 		p_DescriptorSetLayouts.clear();
 
 		vkDestroyPipeline(device.GetLogicalDevice(), m_GraphicsPipeline, nullptr);
+		vkDestroyPipeline(device.GetLogicalDevice(), m_ReloadedPipeline, nullptr);
+		m_ReloadedPipeline = VK_NULL_HANDLE;
 		vkDestroyPipelineLayout(device.GetLogicalDevice(), m_PipelineLayout, nullptr);
 		vkDestroyRenderPass(device.GetLogicalDevice(), m_RenderPass, nullptr);
 
 		return RHI_SUCCESS;
 	}
 
-	void VulkanPipeline::CreateDescriptorSetLayout(IDevice* _Device)
+	RHI_RESULT VulkanPipeline::CreateReloadedPipeline(IDevice* _Device, const std::vector<PipelineShaderInfos>& _ShadersInfos)
 	{
-		p_DescriptorSetLayouts.resize(3);
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		// Same states with the new shaders
+		PipelineDescription description = p_Description;
+		description.shaders = _ShadersInfos;
+
+		PipelineReflection reflection;
+
+		if (!ReflectShaders(_ShadersInfos, reflection))
+			return RHI_FAILED_UNKNOWN;
 
-		std::vector<DescriptorLayoutInfos> UBOinfos;
-		std::vector<DescriptorLayoutInfos> SamplerInfos;
+		// The descriptor sets and the command buffers are bound to the current layout
+		if (!reflection.IsLayoutCompatible(p_Reflection))
+		{
+			DEBUG_ERROR("Reloaded shaders do not match the layout of the pipeline, restart to apply them");
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		VkPipeline reloadedPipeline = VK_NULL_HANDLE;
 
-		DescriptorLayoutInfos uniformInfo;
-		uniformInfo.binding = 0;
-		uniformInfo.type = DescriptorType::RHI_DESCRIPTOR_UNIRFORM;
-		uniformInfo.entryShader = ShaderType::RHI_VERTEX;
+		// Merged into the device cache by the main thread
+		VkPipelineCache workerCache = device.CreateWorkerPipelineCache();
 
-		UBOinfos.push_back(uniformInfo);
+		RHI_RESULT result = CreateGraphicsPipeline(&device, description, reflection, workerCache, reloadedPipeline);
 
-		p_DescriptorSetLayouts[0] = new VulkanDescriptorLayout();
-		p_DescriptorSetLayouts[0]->CreateDescriptorSetLayout(_Device, UBOinfos);
-		p_DescriptorSetLayouts[1] = new VulkanDescriptorLayout();
-		p_DescriptorSetLayouts[1]->CreateDescriptorSetLayout(_Device, UBOinfos);
+		device.SubmitWorkerPipelineCache(workerCache);
 
-		DescriptorLayoutInfos sampInfo;
-		sampInfo.binding = 0;
-		sampInfo.type = DescriptorType::RHI_DESCRIPTOR_SAMPLER;
-		sampInfo.entryShader = ShaderType::RHI_FRAGMENT;
+		if (!result)
+			return RHI_FAILED_UNKNOWN;
+
+		// A reload not swapped yet is replaced by the newest one
+		if (m_ReloadedPipeline != VK_NULL_HANDLE)
+			vkDestroyPipeline(device.GetLogicalDevice(), m_ReloadedPipeline, nullptr);
 
-		SamplerInfos.push_back(sampInfo);
-		p_DescriptorSetLayouts[2] = new VulkanDescriptorLayout();
-		p_DescriptorSetLayouts[2]->CreateDescriptorSetLayout(_Device, SamplerInfos);
+		m_ReloadedPipeline = reloadedPipeline;
+		m_ReloadedDescription = description;
+
+		return RHI_SUCCESS;
+	}
+
+	void VulkanPipeline::SwapReloadedPipeline()
+	{
+		if (m_ReloadedPipeline == VK_NULL_HANDLE)
+			return;
+
+		VkPipeline previousPipeline = m_GraphicsPipeline;
+		m_GraphicsPipeline = m_ReloadedPipeline;
+		m_ReloadedPipeline = VK_NULL_HANDLE;
+
+		// The previous shaders may be destroyed after the swap, the description must not point to them
+		p_Description = std::move(m_ReloadedDescription);
+		p_DescriptionHash = p_Description.ComputeHash();
+		m_ReloadedDescription = PipelineDescription();
+
+		// Between two frames, nothing uses the device cache
+		Core::Renderer::GetDevice()->CastToVulkan()->MergeWorkerPipelineCaches();
+
+		// The frames in flight may still execute the previous pipeline
+		Core::Renderer::DeferDestruction([previousPipeline]()
+			{
+				VulkanDevice& device = *Core::Renderer::GetDevice()->CastToVulkan();
+				vkDestroyPipeline(device.GetLogicalDevice(), previousPipeline, nullptr);
+			});
+	}
+
+	const bool VulkanPipeline::ReflectShaders(const std::vector<PipelineShaderInfos>& _ShadersInfos, PipelineReflection& _Reflection)
+	{
+		std::vector<const ShaderReflection*> stages(_ShadersInfos.size());
+
+		for (size_t i = 0; i < _ShadersInfos.size(); ++i)
+		{
+			stages[i] = &_ShadersInfos[i].shader->GetReflection();
+		}
+
+		return SpirVReflection::MergeStages(stages, _Reflection);
+	}
+
+	RHI_RESULT VulkanPipeline::CreateDescriptorSetLayout(IDevice* _Device)
+	{
+		p_DescriptorSetLayouts.resize(p_Reflection.sets.size());
+
+		for (size_t set = 0; set < p_Reflection.sets.size(); ++set)
+		{
+			// Sets skipped by the shaders get an empty layout
+			std::vector<DescriptorLayoutInfos> infos(p_Reflection.sets[set].size());
+
+			for (size_t i = 0; i < p_Reflection.sets[set].size(); ++i)
+			{
+				const ReflectedDescriptorBinding& binding = p_Reflection.sets[set][i];
+
+				infos[i].binding = binding.binding;
+				infos[i].type = binding.type;
+				infos[i].entryShader = RHI_VERTEX;
+				infos[i].count = binding.count;
+				infos[i].stages = binding.stages;
+			}
+
+			p_DescriptorSetLayouts[set] = VulkanDescriptorLayout::Acquire(_Device, infos);
+
+			if (p_DescriptorSetLayouts[set] == nullptr)
+			{
+				p_DescriptorSetLayouts.resize(set);
+				return RHI_FAILED_UNKNOWN;
+			}
+		}
+
+		return RHI_SUCCESS;
 	}
 
-	void VulkanPipeline::CreateRenderPass(VulkanDevice* _Device, VulkanSwapChain* _Swapchain)
+	void VulkanPipeline::CreateRenderPass(VulkanDevice* _Device, VkFormat _ColorFormat, VkFormat _DepthFormat)
 	{
 		// Describes the color buffer attachment
 		VkAttachmentDescription colorAttachment{};
-		// Same format as the swap chain
-		colorAttachment.format = _Swapchain->GetSwapChainFormat();
+		// Same format as the swap chain unless the description gives another one
+		colorAttachment.format = _ColorFormat;
 		// Samples (usefull for multisampling)
 		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
 		// LoadOp and StoreOp describes how we interact with the data of the buffer before loading and after rendering
@@ -285,8 +467,9 @@ namespace Core
 		// For the stencil buffer we juste dont care about what will be load and unload
 		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		// The render graph moves the attachments to their layouts before the pass and to the present layout after the frame
+		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
 		// Describe the color attachment
 		VkAttachmentReference colorAttachmentRef{};
@@ -295,13 +478,13 @@ namespace Core
 
 		// Describes the depth buffer attachment - Check above for more infos (Similar to color attachment)
 		VkAttachmentDescription depthAttachment{};
-		depthAttachment.format = VulkanImage::FindDepthFormat(_Device->GetPhysicalDevice());
+		depthAttachment.format = _DepthFormat;
 		depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
 		depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 		depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 		depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		depthAttachment.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 		depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
 		// Describe the depth attachment
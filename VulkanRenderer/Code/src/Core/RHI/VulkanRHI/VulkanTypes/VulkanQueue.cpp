@@ -29,13 +29,17 @@ namespace Core
 		for (const VkQueueFamilyProperties& queueFamily : queueFamilies)
 		{
 			// Checks for a queue supporting transfer queues but that is not a graphics queue
-			//if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT))
-			//{
-			//	indices.transfertFamily = index;
-			//}
+			// Compute capable families are only kept until a pure transfer family (DMA engine) is found
+			if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT))
+			{
+				if (!indices.transfertFamily.has_value() || !(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT))
+				{
+					indices.transfertFamily = index;
+				}
+			}
 
 			// Checks for a queue supporting graphic queues
-			if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+			if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value())
 			{
 				indices.graphicsFamily = index;
 			}
@@ -45,22 +49,22 @@ namespace Core
 			vkGetPhysicalDeviceSurfaceSupportKHR(_Device, index, _Surface, &presentSupport);
 
 			// Reference the queue if it can support presentation
-			if (presentSupport)
+			if (presentSupport && !indices.presentFamily.has_value())
 			{
 				indices.presentFamily = index;
 			}
 
-			// Return the queues if graphics and presentation queues have been found
-			if (indices.graphicsFamily.has_value() && indices.presentFamily.has_value())
-			{
-				break;
-			}
-
 			++index;
 		}
 
+		// Without a dedicated family the transfers go through the graphics queue
+		if (!indices.transfertFamily.has_value())
+		{
+			indices.transfertFamily = indices.graphicsFamily;
+		}
+
 		// bool describing if the two types of families are supported on our device
-		indices.isComplete = indices.graphicsFamily.has_value() && indices.presentFamily.has_value();//&& indices.transfertFamily.has_value();
+		indices.isComplete = indices.graphicsFamily.has_value() && indices.presentFamily.has_value() && indices.transfertFamily.has_value();
 
 		return indices;
 	}
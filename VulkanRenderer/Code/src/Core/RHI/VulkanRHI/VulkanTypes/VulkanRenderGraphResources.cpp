@@ -0,0 +1,335 @@
+#include "RHI/VulkanRHI/VulkanTypes/VulkanRenderGraphResources.h"
+
+#include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanSwapChain.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanCommandBuffer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanBuffer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanImage.h"
+
+#include <algorithm>
+
+namespace Core
+{
+	// Depth uses the same format as the depth attachment of the render passes
+	static VkFormat GetRenderGraphFormat(RenderGraphFormat _Format, VkPhysicalDevice _PhysicalDevice)
+	{
+		switch (_Format)
+		{
+		case RG_FORMAT_RGBA16F:
+			return VK_FORMAT_R16G16B16A16_SFLOAT;
+		case RG_FORMAT_DEPTH32:
+			return VulkanImage::FindDepthFormat(_PhysicalDevice);
+		case RG_FORMAT_RGBA8: default:
+			return VK_FORMAT_R8G8B8A8_UNORM;
+		}
+	}
+
+	static VkImageUsageFlags GetRenderGraphUsage(RenderGraphAccess _Access)
+	{
+		switch (_Access)
+		{
+		case RG_ACCESS_COLOR_ATTACHMENT:
+			return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		case RG_ACCESS_DEPTH_ATTACHMENT:
+			return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		case RG_ACCESS_SHADER_READ:
+			return VK_IMAGE_USAGE_SAMPLED_BIT;
+		case RG_ACCESS_TRANSFER_READ:
+			return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		case RG_ACCESS_TRANSFER_WRITE:
+			return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		default:
+			return 0;
+		}
+	}
+
+	void VulkanRenderGraphResources::GetAccessInfos(RenderGraphAccessFlags _Access, bool _IsDepth, VkImageLayout& _Layout, VkPipelineStageFlags2KHR& _Stages, VkAccessFlags2KHR& _Accesses)
+	{
+		_Layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		_Stages = 0;
+		_Accesses = 0;
+
+		unsigned int accessCount = 0;
+
+		if (_Access & RG_ACCESS_COLOR_ATTACHMENT)
+		{
+			_Layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			_Stages |= VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR;
+			_Accesses |= VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR;
+			++accessCount;
+		}
+
+		if (_Access & RG_ACCESS_DEPTH_ATTACHMENT)
+		{
+			_Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+			_Stages |= VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR;
+			_Accesses |= VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR;
+			++accessCount;
+		}
+
+		if (_Access & RG_ACCESS_SHADER_READ)
+		{
+			_Layout = _IsDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			_Stages |= VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR;
+			_Accesses |= VK_ACCESS_2_SHADER_READ_BIT_KHR;
+			++accessCount;
+		}
+
+		if (_Access & RG_ACCESS_TRANSFER_READ)
+		{
+			_Layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			_Stages |= VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR;
+			_Accesses |= VK_ACCESS_2_TRANSFER_READ_BIT_KHR;
+			++accessCount;
+		}
+
+		if (_Access & RG_ACCESS_TRANSFER_WRITE)
+		{
+			_Layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			_Stages |= VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR;
+			_Accesses |= VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR;
+			++accessCount;
+		}
+
+		if (_Access & RG_ACCESS_PRESENT)
+		{
+			// The present waits for the semaphore, the barrier only has to change the layout
+			_Layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+			_Stages |= VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT_KHR;
+			++accessCount;
+		}
+
+		// A pass reading and writing the texture in different ways needs a layout allowing all of them
+		if (accessCount > 1)
+			_Layout = VK_IMAGE_LAYOUT_GENERAL;
+	}
+
+	const RHI_RESULT VulkanRenderGraphResources::CreateResources(IDevice* _Device, ISwapChain* _SwapChain, const RenderGraph& _Graph)
+	{
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		if (!_Graph.IsCompiled())
+		{
+			DEBUG_ERROR("Render graph resources created from a graph that is not compiled");
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		m_SwapChain = _SwapChain->CastToVulkan();
+		m_Textures.assign(_Graph.GetResourceCount(), VulkanRenderGraphTexture());
+
+		// The usage of an image is every way the passes access it
+		std::vector<VkImageUsageFlags> usages(_Graph.GetResourceCount(), 0);
+
+		for (RenderGraphPassHandle passIndex : _Graph.GetExecutionOrder())
+		{
+			const RenderGraphPass& pass = _Graph.GetPass(passIndex);
+
+			for (const RenderGraphResourceAccess& read : pass.reads)
+				usages[read.resource] |= GetRenderGraphUsage(read.access);
+
+			for (const RenderGraphResourceAccess& write : pass.writes)
+				usages[write.resource] |= GetRenderGraphUsage(write.access);
+		}
+
+		const std::vector<RenderGraphPhysicalResource>& physicalResources = _Graph.GetPhysicalResources();
+
+		// A block is as large and as aligned as its largest texture, in a memory type accepted by all of them
+		std::vector<VkMemoryRequirements> blockRequirements(physicalResources.size(), { 0, 1, UINT32_MAX });
+		std::vector<unsigned int> blockTextureCounts(physicalResources.size(), 0);
+		VkDeviceSize unaliasedSize = 0;
+
+		for (RenderGraphResource i = 0; i < _Graph.GetResourceCount(); ++i)
+		{
+			const RenderGraphResourceNode& resource = _Graph.GetResource(i);
+			VulkanRenderGraphTexture& texture = m_Textures[i];
+
+			texture.extent = { resource.desc.width, resource.desc.height };
+
+			if (resource.imported)
+			{
+				texture.imported = true;
+				texture.format = m_SwapChain->GetSwapChainFormat();
+				continue;
+			}
+
+			// Culled with all the passes using it
+			if (resource.physicalIndex < 0)
+				continue;
+
+			texture.format = GetRenderGraphFormat(resource.desc.format, device.GetPhysicalDevice());
+
+			if (resource.desc.format == RG_FORMAT_DEPTH32)
+			{
+				texture.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+				if (VulkanImage::HasStencilComponent(texture.format))
+					texture.aspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+			}
+
+			VkImageCreateInfo imageInfo{};
+			imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageInfo.extent.width = resource.desc.width;
+			imageInfo.extent.height = resource.desc.height;
+			imageInfo.extent.depth = 1;
+			imageInfo.mipLevels = 1;
+			imageInfo.arrayLayers = 1;
+			imageInfo.format = texture.format;
+			imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			// The content of an aliased texture is never kept, the first barrier of every frame starts from undefined
+			imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageInfo.usage = usages[i];
+			imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			VkResult result = vkCreateImage(device.GetLogicalDevice(), &imageInfo, nullptr, &texture.image);
+
+			if (result != VK_SUCCESS)
+			{
+				DEBUG_ERROR("Failed to create render graph texture %s, Error Code: %d", resource.name.c_str(), result);
+				DestroyResources(_Device);
+				return RHI_FAILED_UNKNOWN;
+			}
+
+			VkMemoryRequirements requirements;
+			vkGetImageMemoryRequirements(device.GetLogicalDevice(), texture.image, &requirements);
+
+			VkMemoryRequirements& block = blockRequirements[resource.physicalIndex];
+			block.size = std::max(block.size, requirements.size);
+			block.alignment = std::max(block.alignment, requirements.alignment);
+			block.memoryTypeBits &= requirements.memoryTypeBits;
+
+			++blockTextureCounts[resource.physicalIndex];
+			unaliasedSize += requirements.size;
+		}
+
+		m_Memories.assign(physicalResources.size(), VK_NULL_HANDLE);
+		VkDeviceSize aliasedSize = 0;
+
+		for (size_t i = 0; i < physicalResources.size(); ++i)
+		{
+			if (blockTextureCounts[i] == 0)
+				continue;
+
+			if (blockRequirements[i].memoryTypeBits == 0)
+			{
+				DEBUG_ERROR("The textures of a render graph memory block have no memory type in common");
+				DestroyResources(_Device);
+				return RHI_FAILED_UNKNOWN;
+			}
+
+			VkMemoryAllocateInfo allocInfo{};
+			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			allocInfo.allocationSize = blockRequirements[i].size;
+			allocInfo.memoryTypeIndex = VulkanBuffer::FindMemoryType(device.GetPhysicalDevice(), blockRequirements[i].memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+			VkResult result = vkAllocateMemory(device.GetLogicalDevice(), &allocInfo, nullptr, &m_Memories[i]);
+
+			if (result != VK_SUCCESS)
+			{
+				DEBUG_ERROR("Failed to allocate render graph memory, Error Code: %d", result);
+				DestroyResources(_Device);
+				return RHI_FAILED_UNKNOWN;
+			}
+
+			aliasedSize += blockRequirements[i].size;
+		}
+
+		for (RenderGraphResource i = 0; i < _Graph.GetResourceCount(); ++i)
+		{
+			VulkanRenderGraphTexture& texture = m_Textures[i];
+
+			if (texture.image == VK_NULL_HANDLE)
+				continue;
+
+			int physicalIndex = _Graph.GetResource(i).physicalIndex;
+
+			// Every texture starts at the beginning of its block, the block is as large as the largest of them
+			vkBindImageMemory(device.GetLogicalDevice(), texture.image, m_Memories[physicalIndex], 0);
+
+			texture.isAliased = blockTextureCounts[physicalIndex] > 1;
+
+			VulkanImageView imageView;
+			imageView.CreateImageView(device.GetLogicalDevice(), texture.image, texture.format, texture.aspect);
+			texture.imageView = imageView.GetType();
+		}
+
+		DEBUG_LOG("Render graph textures bound to %u memory blocks, %u KB instead of %u KB without aliasing", static_cast<unsigned int>(std::count_if(m_Memories.begin(), m_Memories.end(), [](VkDeviceMemory _Memory) { return _Memory != VK_NULL_HANDLE; })),
+			static_cast<unsigned int>(aliasedSize / 1024), static_cast<unsigned int>(unaliasedSize / 1024));
+
+		return RHI_SUCCESS;
+	}
+
+	const RHI_RESULT VulkanRenderGraphResources::DestroyResources(IDevice* _Device)
+	{
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		for (VulkanRenderGraphTexture& texture : m_Textures)
+		{
+			if (texture.image == VK_NULL_HANDLE)
+				continue;
+
+			vkDestroyImageView(device.GetLogicalDevice(), texture.imageView, nullptr);
+			vkDestroyImage(device.GetLogicalDevice(), texture.image, nullptr);
+		}
+
+		for (VkDeviceMemory memory : m_Memories)
+		{
+			if (memory != VK_NULL_HANDLE)
+				vkFreeMemory(device.GetLogicalDevice(), memory, nullptr);
+		}
+
+		m_Textures.clear();
+		m_Memories.clear();
+		m_Barriers.Clear();
+
+		return RHI_SUCCESS;
+	}
+
+	void VulkanRenderGraphResources::RecordBarriers(IDevice* _Device, ICommandBuffer* _CommandBuffer, const std::vector<RenderGraphBarrier>& _Barriers, unsigned int _ImageIndex)
+	{
+		for (const RenderGraphBarrier& barrier : _Barriers)
+		{
+			const VulkanRenderGraphTexture& texture = m_Textures[barrier.resource];
+			VkImage image = texture.imported ? m_SwapChain->GetSwapchainImage(_ImageIndex) : texture.image;
+
+			bool isDepth = (texture.aspect & VK_IMAGE_ASPECT_DEPTH_BIT) != 0;
+
+			VkImageLayout oldLayout, newLayout;
+			VkPipelineStageFlags2KHR srcStages, dstStages;
+			VkAccessFlags2KHR srcAccesses, dstAccesses;
+
+			GetAccessInfos(barrier.srcAccess, isDepth, oldLayout, srcStages, srcAccesses);
+			GetAccessInfos(barrier.dstAccess, isDepth, newLayout, dstStages, dstAccesses);
+
+			// First use in the frame, the content is discarded but the previous users of the memory still have to be finished
+			if (barrier.srcAccess == RG_ACCESS_NONE)
+			{
+				if (texture.isAliased)
+				{
+					// Any earlier pass may have used the block through another texture
+					srcStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR;
+					srcAccesses = VK_ACCESS_2_MEMORY_WRITE_BIT_KHR;
+				}
+				else
+				{
+					// The previous frame used the texture in the same way, this also chains with the semaphore of the swap chain image
+					srcStages = dstStages;
+					srcAccesses = dstAccesses & (VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR | VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR);
+				}
+			}
+
+			m_Barriers.AddImageBarrier(image, texture.aspect, oldLayout, newLayout, srcStages, srcAccesses, dstStages, dstAccesses);
+		}
+
+		m_Barriers.Flush(_Device->CastToVulkan(), _CommandBuffer->CastToVulkan()->GetCommandBuffer());
+	}
+
+	const VulkanRenderGraphTexture* VulkanRenderGraphResources::GetTexture(RenderGraphResource _Resource) const
+	{
+		if (_Resource >= m_Textures.size() || m_Textures[_Resource].image == VK_NULL_HANDLE)
+			return nullptr;
+
+		return &m_Textures[_Resource];
+	}
+}
\ No newline at end of file
@@ -9,7 +9,7 @@ namespace Core
 
 	RHI_RESULT VulkanSemaphore::CreateSemaphoreSync(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Semaphore create info - for GPU/ GPU synchronization
 		VkSemaphoreCreateInfo smaphoreInfo{};
@@ -29,7 +29,7 @@ namespace Core
 
 	RHI_RESULT VulkanSemaphore::DestroySemaphoreSync(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroySemaphore(device.GetLogicalDevice(), m_Semaphore, nullptr);
 		return RHI_SUCCESS;
@@ -1,82 +1,151 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanShader.h"
 
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
+#include "RHI/ShaderCache.h"
+
+#ifdef SHADER_RUNTIME_COMPILATION
+#include "RHI/ShaderIncluder.h"
+#endif
+
+#include <fstream>
 
 namespace Core
 {
-	RHI_RESULT VulkanShader::PreprocessShader(shaderc::Compiler& _Compiler, CompilationInfos _Infos)
+#ifdef SHADER_RUNTIME_COMPILATION
+	shaderc::Compiler& VulkanShader::GetCompiler()
+	{
+		// Compilations can run concurrently on the same compiler
+		static shaderc::Compiler compiler;
+		return compiler;
+	}
+
+	const shaderc::CompileOptions& VulkanShader::GetCompileOptions()
+	{
+		static const shaderc::CompileOptions options = []()
+			{
+				shaderc::CompileOptions compileOptions;
+
+				// Same version as the one requested by the instance
+				compileOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1);
+
+#ifdef NDEBUG
+				// The optimizer strips the names, the descriptor sets are found by their set and binding
+				compileOptions.SetOptimizationLevel(shaderc_optimization_level_performance);
+#else
+				// Keeps the names and the lines for the debuggers
+				compileOptions.SetOptimizationLevel(shaderc_optimization_level_zero);
+				compileOptions.SetGenerateDebugInfo();
+#endif
+
+				return compileOptions;
+			}();
+
+		return options;
+	}
+
+	const std::string& VulkanShader::GetCompileOptionsDescription()
+	{
+#ifdef NDEBUG
+		static const std::string description = "vulkan1.1;performance";
+#else
+		static const std::string description = "vulkan1.1;zero;debuginfo";
+#endif
+
+		return description;
+	}
+
+	RHI_RESULT VulkanShader::PreprocessShader(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos)
 	{
 		// First step - Preprocessing GLSL
-		shaderc::PreprocessedSourceCompilationResult result = _Compiler.PreprocessGlsl(*_Infos.sourceCode, _Infos.shaderKind, _Infos.fileName, _Infos.options);
+		shaderc::PreprocessedSourceCompilationResult result = _Compiler.PreprocessGlsl(*_Infos.sourceCode, _Infos.shaderKind, _Infos.fileName, *_Infos.options);
 
 		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
 		{
-			DEBUG_ERROR("Failed to preprocessed shader, %s", result.GetErrorMessage());
+			DEBUG_ERROR("Failed to preprocessed shader, %s", result.GetErrorMessage().c_str());
 			return RHI_FAILED_UNKNOWN;
 		}
 
-		// Copy the precompiled code in the buffer
-		const char* src = result.cbegin();
-		size_t newSize = result.cend() - src;
-		_Infos.sourceCode->resize(newSize);
-		memcpy(_Infos.sourceCode->data(), src, newSize);
+		// Replaces the source by the preprocessed code
+		_Infos.sourceCode->assign(result.cbegin(), result.cend());
 
 		return RHI_SUCCESS;
 	}
 
-	RHI_RESULT VulkanShader::SpirVAssemblyCompilation(shaderc::Compiler& _Compiler, CompilationInfos _Infos)
+	std::vector<uint32_t> VulkanShader::SpirVBinaryCompilation(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos)
 	{
-		// Second step - SPIR-V Assembly compilation
-		shaderc::AssemblyCompilationResult sResult = _Compiler.CompileGlslToSpvAssembly(*_Infos.sourceCode, _Infos.shaderKind, _Infos.fileName, _Infos.options);
+		// Second step - SPIR-V Binary compilation
+		shaderc::SpvCompilationResult result = _Compiler.CompileGlslToSpv(*_Infos.sourceCode, _Infos.shaderKind, _Infos.fileName, *_Infos.options);
 
-		if (sResult.GetCompilationStatus() != shaderc_compilation_status_success)
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
 		{
-			DEBUG_ERROR("Failed to compiled in assembly shader, %s", sResult.GetErrorMessage());
-			return RHI_FAILED_UNKNOWN;
+			DEBUG_ERROR("Failed to compiled in binary shader, %s", result.GetErrorMessage().c_str());
+			return std::vector<uint32_t>();
 		}
 
-		// Copy the SPRIV Assembly code in the buffer
-		const char* src = sResult.cbegin();
-		size_t newSize = sResult.cend() - src;
-		_Infos.sourceCode->resize(newSize);
-		memcpy(_Infos.sourceCode->data(), src, newSize);
-
-		return RHI_SUCCESS;
+		return std::vector<uint32_t>(result.cbegin(), result.cend());
 	}
 
-	std::vector<uint32_t> VulkanShader::SpirVBinaryCompilation(shaderc::Compiler& _Compiler, CompilationInfos _Infos)
+	RHI_RESULT VulkanShader::DumpSpirVAssembly(shaderc::Compiler& _Compiler, const CompilationInfos& _Infos)
 	{
-		// Third step - SPIR-V Binary compilation
-		shaderc::SpvCompilationResult tResult = _Compiler.AssembleToSpv(_Infos.sourceCode->data(), _Infos.sourceCode->size(), _Infos.options);
+		shaderc::AssemblyCompilationResult result = _Compiler.CompileGlslToSpvAssembly(*_Infos.sourceCode, _Infos.shaderKind, _Infos.fileName, *_Infos.options);
 
-		if (tResult.GetCompilationStatus() != shaderc_compilation_status_success)
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
 		{
-			DEBUG_ERROR("Failed to compiled in binary shader, %s", tResult.GetErrorMessage());
+			DEBUG_ERROR("Failed to compiled in assembly shader, %s", result.GetErrorMessage().c_str());
+			return RHI_FAILED_UNKNOWN;
 		}
 
-		// Copy the SPIRV Binary code in the output buffer
-		const uint32_t* srcBinary = tResult.cbegin();
-		size_t wordCount = tResult.cend() - srcBinary;
-		std::vector<uint32_t> output(wordCount);
-		memcpy(output.data(), srcBinary, wordCount * sizeof(uint32_t));
+		std::error_code error;
+		std::filesystem::create_directories(ShaderCache::GetCacheDirectory(), error);
 
-		return output;
+		std::filesystem::path dumpPath = ShaderCache::GetCacheDirectory() / (std::string(_Infos.fileName) + ".spvasm");
+		std::ofstream dumpFile(dumpPath, std::ios::trunc);
+
+		if (!dumpFile.is_open())
+		{
+			DEBUG_WARN("Failed to write SPIR-V assembly: %s", dumpPath.string().c_str());
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		dumpFile.write(result.cbegin(), result.cend() - result.cbegin());
+
+		return RHI_SUCCESS;
 	}
 
 	const bool VulkanShader::CompileShader(Core::IDevice* _Device, const char* _ShaderName, std::string _ShaderSourceCode, Core::ShaderType _ShaderType)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
+
+		std::chrono::high_resolution_clock::time_point compileStart = std::chrono::high_resolution_clock::now();
+
+		shaderc::Compiler& compiler = GetCompiler();
+
+		// Files included by the shader, filled by the includer or read from the dependency record
+		std::vector<SourceDependency> includes;
+
+		// Copied for every shader, the includer records the files included by this one only
+		shaderc::CompileOptions options = GetCompileOptions();
+		std::string optionsDescription = GetCompileOptionsDescription();
+
+		for (const std::string& definition : p_MacroDefinitions)
+		{
+			size_t separator = definition.find('=');
+
+			if (separator == std::string::npos)
+				options.AddMacroDefinition(definition);
+			else
+				options.AddMacroDefinition(definition.substr(0, separator), definition.substr(separator + 1));
 
-		// Causes memory leaks, thx
-		shaderc::Compiler compiler;
+			optionsDescription += ";" + definition;
+		}
+
+		options.SetIncluder(std::make_unique<ShaderIncluder>(p_SourcePath, _ShaderName, includes));
 
 		// Fill a struct of informations about the shader
 		CompilationInfos infos{};
 		infos.fileName = _ShaderName;
 		infos.sourceCode = &_ShaderSourceCode;
-		// TODO: Checks the optimizations
-		//infos.options.SetOptimizationLevel(shaderc_optimization_level_performance);
-		//infos.options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
+		infos.options = &options;
 
 		switch (_ShaderType)
 		{
@@ -91,30 +160,96 @@ namespace Core
 			break;
 		}
 
-		if (!PreprocessShader(compiler, infos))
-			return false;
+		ShaderCacheKeyInfos keyInfos;
+		keyInfos.source = infos.sourceCode;
+		keyInfos.sourcePath = p_SourcePath.string();
+		keyInfos.shaderKind = static_cast<int>(infos.shaderKind);
+		keyInfos.options = optionsDescription;
+		shaderc_get_spv_version(&keyInfos.compilerVersion, &keyInfos.compilerRevision);
 
-		if (!SpirVAssemblyCompilation(compiler, infos))
-			return false;
+		// Computed before the preprocessing replaces the source
+		unsigned long long dependencyKey = ShaderCache::ComputeDependencyKey(keyInfos);
+		SourceDependency mainFile = { p_SourcePath, SourceFileCache::ComputeHash(_ShaderSourceCode) };
+
+		unsigned long long cacheKey = 0;
+
+		// None of the included files changed since the last compilation, the key of the SPIR-V is already known
+		bool isRecordValid = ShaderCache::LoadDependencies(dependencyKey, cacheKey, includes) && SourceFileCache::IsUpToDate(includes);
+
+		if (!isRecordValid)
+		{
+			includes.clear();
+
+			if (!PreprocessShader(compiler, infos))
+				return false;
+
+			// The preprocessed source already contains the includes and the macros
+			cacheKey = ShaderCache::ComputeKey(keyInfos);
+
+			ShaderCache::StoreDependencies(dependencyKey, cacheKey, includes);
+		}
+
+		// The key covers everything the SPIR-V depends on
+		p_CodeHash = cacheKey;
+
+		p_Dependencies = { mainFile };
+		p_Dependencies.insert(p_Dependencies.end(), includes.begin(), includes.end());
+
+		std::vector<uint32_t> cachedShader;
 
+		if (ShaderCache::Load(cacheKey, cachedShader))
+		{
+			if (!SpirVReflection::Reflect(cachedShader.data(), cachedShader.size(), p_Reflection))
+				return false;
+
+			return CreateShaderModule(device, cachedShader) == RHI_SUCCESS;
+		}
+
+		// Without preprocessing the includes are resolved again by the compilation
 		std::vector<uint32_t> compiledShader = SpirVBinaryCompilation(compiler, infos);
 
 		if (compiledShader.empty())
 			return false;
 
-		CreateShaderModule(device, compiledShader);
+		if (!SpirVReflection::Reflect(compiledShader.data(), compiledShader.size(), p_Reflection))
+			return false;
 
-		return true;
+		std::chrono::duration<double, std::milli> compileTime = std::chrono::high_resolution_clock::now() - compileStart;
+		DEBUG_LOG("Shader %s compiled in %f ms", _ShaderName, compileTime.count());
+
+		if (m_DumpAssembly)
+			DumpSpirVAssembly(compiler, infos);
+
+		ShaderCache::Store(cacheKey, compiledShader);
+
+		return CreateShaderModule(device, compiledShader) == RHI_SUCCESS;
+	}
+#else
+	const bool VulkanShader::CompileShader(Core::IDevice* _Device, const char* _ShaderName, std::string _ShaderSourceCode, Core::ShaderType _ShaderType)
+	{
+		DEBUG_ERROR("Cannot compile shader %s, the renderer is built without runtime compilation", _ShaderName);
+		return false;
+	}
+#endif
+
+	const bool VulkanShader::CreateFromSpirV(Core::IDevice* _Device, const uint32_t* _Code, size_t _WordCount)
+	{
+		return CreateShaderModule(*_Device->CastToVulkan(), _Code, _WordCount) == RHI_SUCCESS;
+	}
+
+	RHI_RESULT VulkanShader::CreateShaderModule(VulkanDevice& _Device, const std::vector<uint32_t>& _ShaderBinaryCode)
+	{
+		return CreateShaderModule(_Device, _ShaderBinaryCode.data(), _ShaderBinaryCode.size());
 	}
 
-	RHI_RESULT VulkanShader::CreateShaderModule(VulkanDevice _Device, const std::vector<uint32_t>& _ShaderBinaryCode)
+	RHI_RESULT VulkanShader::CreateShaderModule(VulkanDevice& _Device, const uint32_t* _Code, size_t _WordCount)
 	{
 		// Create info of the shader
 		VkShaderModuleCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 		// Specifies the size and the code of the source code
-		createInfo.codeSize = _ShaderBinaryCode.size() * sizeof(uint32_t);
-		createInfo.pCode = _ShaderBinaryCode.data();
+		createInfo.codeSize = _WordCount * sizeof(uint32_t);
+		createInfo.pCode = _Code;
 
 		VkResult result = vkCreateShaderModule(_Device.GetLogicalDevice(), &createInfo, nullptr, &m_ShaderModule);
 
@@ -129,7 +264,7 @@ namespace Core
 
 	RHI_RESULT VulkanShader::DestroyShaderModule(Core::IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroyShaderModule(device.GetLogicalDevice(), m_ShaderModule, nullptr);
 
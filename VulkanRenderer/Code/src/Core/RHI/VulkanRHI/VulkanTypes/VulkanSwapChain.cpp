@@ -4,13 +4,14 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanSemaphore.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanFence.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanCommandBuffer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanRenderGraphResources.h"
 #include "RHI/RHITypes/IPipeline.h"
 
 #include <set>
 
 namespace Core
 {
-	const bool VulkanSwapChain::CheckDeviceExtensionSupport(VulkanDevice _Device, const std::vector<const char*> _DeviceExtensions)
+	const bool VulkanSwapChain::CheckDeviceExtensionSupport(VulkanDevice& _Device, const std::vector<const char*> _DeviceExtensions)
 	{
 		// Gets the number of extensions supported by our device
 		uint32_t extensionsNbr;
@@ -75,7 +76,7 @@ namespace Core
 
 	void VulkanSwapChain::AcquireNextImage(Window* _Window, IDevice* _Device, IPipeline* _Pipeline, unsigned int _Timeout, ISemaphore* _ImageAvailableSemaphore, unsigned int& _ImageIndex)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VulkanSemaphore semaphore = *_ImageAvailableSemaphore->CastToVulkan();
 
 		// Acquires an image from the swap chain
@@ -97,7 +98,7 @@ namespace Core
 
 	RHI_RESULT VulkanSwapChain::SubmitGraphicsQueue(IDevice* _Device, ICommandBuffer* _CommandBuffer, ISemaphore* _ImageAvailableSemaphore, ISemaphore* _RenderFinishSemaphore, IFence* _InFlightFence)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 		VkCommandBuffer commandbuffer = _CommandBuffer->CastToVulkan()->GetCommandBuffer();
 
 		VulkanSemaphore imageAvailableSync = *_ImageAvailableSemaphore->CastToVulkan();
@@ -143,7 +144,7 @@ namespace Core
 
 	RHI_RESULT VulkanSwapChain::SubmitPresentQueue(Window* _Window, IDevice* _Device, IPipeline* _Pipeline, ISemaphore* _RenderFinishSemaphore, unsigned int _ImageIndex)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		VulkanSemaphore renderFinishSync = *_RenderFinishSemaphore->CastToVulkan();
 
@@ -245,17 +246,53 @@ namespace Core
 
 	RHI_RESULT VulkanSwapChain::CreateSwapChainFramebuffers(IDevice* _Device, IPipeline* _Pipeline)
 	{
+		// The depth of the render graph is smaller than the swap chain until the graph is rebuilt at the new size
+		if (m_DepthImageView == VK_NULL_HANDLE || m_DepthExtent.width < m_SwapChainExtent.width || m_DepthExtent.height < m_SwapChainExtent.height)
+		{
+			m_SwapChainFramebuffers.clear();
+			return RHI_FAILED_UNKNOWN;
+		}
+
 		m_SwapChainFramebuffers.resize(m_SwapChainImageViews.size());
 
 		// Loop going through every image view of the swap chain
 		for (size_t i = 0; i < m_SwapChainFramebuffers.size(); ++i)
 		{
-			m_SwapChainFramebuffers[i].CreateFramebuffer(_Device, _Pipeline, m_SwapChainExtent.width, m_SwapChainExtent.height, m_SwapChainImageViews[i].GetType(), m_DepthImageView.GetType());
+			m_SwapChainFramebuffers[i].CreateFramebuffer(_Device, _Pipeline, m_SwapChainExtent.width, m_SwapChainExtent.height, m_SwapChainImageViews[i].GetType(), m_DepthImageView);
 		}
 
 		return RHI_SUCCESS;
 	}
 
+	RHI_RESULT VulkanSwapChain::SetDepthAttachment(IDevice* _Device, IPipeline* _Pipeline, IRenderGraphResources* _Resources, RenderGraphResource _Depth)
+	{
+		const VulkanRenderGraphTexture* depth = _Resources->CastToVulkan()->GetTexture(_Depth);
+
+		if (depth == nullptr)
+		{
+			DEBUG_ERROR("The depth resource of the render graph has no texture");
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		// The previous framebuffers use the depth texture of the previous graph, the caller waited for the GPU
+		for (VulkanFramebuffer framebuffer : m_SwapChainFramebuffers)
+		{
+			framebuffer.DestroyFramebuffer(_Device);
+		}
+
+		m_DepthImageView = depth->imageView;
+		m_DepthExtent = depth->extent;
+
+		RHI_RESULT result = CreateSwapChainFramebuffers(_Device, _Pipeline);
+
+		if (!result)
+		{
+			DEBUG_ERROR("The depth of the render graph is smaller than the swap chain");
+		}
+
+		return result;
+	}
+
 	void VulkanSwapChain::CreateSwapChainImageViews(VkDevice _Device)
 	{
 		m_SwapChainImageViews.resize(m_SwapChainImages.size());
@@ -277,7 +314,7 @@ namespace Core
 
 	const RHI_RESULT VulkanSwapChain::CreateSwapChain(Window* _Window, IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Gets all the capabilities and information the swapchain can support
 		SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(device.GetPhysicalDevice(), device.GetSurface());
@@ -366,7 +403,7 @@ namespace Core
 
 	const RHI_RESULT VulkanSwapChain::RecreateSwapChain(Window* _Window, IDevice* _Device, IPipeline* _Pipeline)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		// Gets the current size of the window
 		int width = 0, height = 0;
@@ -391,7 +428,7 @@ namespace Core
 		// Recreates the swap chain
 		RHI_RESULT result = CreateSwapChain(_Window, _Device);
 
-		VulkanImage::CreateDepthRessources(_Device, m_SwapChainExtent.width, m_SwapChainExtent.height, &m_DepthImage, &m_DepthImageView, m_DepthImageMemory);
+		// Without a depth texture large enough, the framebuffers wait for the render graph to be rebuilt with the new size
 		CreateSwapChainFramebuffers(_Device, _Pipeline);
 
 		return result;
@@ -399,13 +436,9 @@ namespace Core
 
 	const RHI_RESULT VulkanSwapChain::DestroySwapChain(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
-
-		// Destroys data linked to the swap chain
-		vkDestroyImageView(device.GetLogicalDevice(), m_DepthImageView.GetType(), nullptr);
-		vkDestroyImage(device.GetLogicalDevice(), m_DepthImage.GetImage(), nullptr);
-		vkFreeMemory(device.GetLogicalDevice(), m_DepthImageMemory, nullptr);
+		VulkanDevice& device = *_Device->CastToVulkan();
 
+		// Destroys data linked to the swap chain, the depth texture belongs to the render graph
 		for (VulkanFramebuffer framebuffer : m_SwapChainFramebuffers)
 		{
 			framebuffer.DestroyFramebuffer(_Device);
@@ -2,6 +2,7 @@
 #include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanBuffer.h"
 #include "RHI/VulkanRHI/VulkanTypes/VulkanCommandAllocator.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanUploadManager.h"
 #include "Renderer.h"
 
 namespace Core
@@ -10,36 +11,11 @@ namespace Core
 	{
 		VkDeviceSize imageSize = _Width * _Height * 4;
 
-		// Creates transfer buffers
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingBufferMemory;
-
-		VulkanBuffer buffer;
-
-		// Creates buffer that can transfer memory from CPU to GPU
-		buffer.CreateBuffer(_Device, imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
-
-		// Map the data into the buffer
-		void* data;
-		vkMapMemory(_Device->GetLogicalDevice(), stagingBufferMemory, 0, imageSize, 0, &data);
-		memcpy(data, _TextureData, static_cast<size_t>(imageSize));
-		vkUnmapMemory(_Device->GetLogicalDevice(), stagingBufferMemory);
-
 		// Creates the image object
 		m_TextureImage.CreateImage(_Device, static_cast<uint32_t>(_Width), static_cast<uint32_t>(_Height), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage.GetImage(), m_TextureImageMemory);
 
-		// Transition the image layout a first time
-		m_TextureImage.TransitionImageLayout(_Device, m_TextureImage.GetImage(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-		// Copy the texture in the good buffer
-		VulkanBuffer::CopyBufferToImage(_Device, Core::Renderer::GetCommandAllocator()->CastToVulkan(), stagingBuffer, m_TextureImage, static_cast<uint32_t>(_Width), static_cast<uint32_t>(_Height));
-
-		// Transition the image layout a second time
-		m_TextureImage.TransitionImageLayout(_Device, m_TextureImage.GetImage(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-		// Destroys the transfer buffer
-		vkDestroyBuffer(_Device->GetLogicalDevice(), stagingBuffer, nullptr);
-		vkFreeMemory(_Device->GetLogicalDevice(), stagingBufferMemory, nullptr);
+		// Records the layout transitions and the copy of the pixels in the current upload batch
+		Core::Renderer::GetUploadManager()->CastToVulkan()->UploadToImage(m_TextureImage, VK_FORMAT_R8G8B8A8_SRGB, _TextureData, imageSize, static_cast<uint32_t>(_Width), static_cast<uint32_t>(_Height));
 	}
 
 	void VulkanTexture::CreateTextureImageView(VulkanDevice* _Device)
@@ -89,7 +65,7 @@ namespace Core
 
 	RHI_RESULT VulkanTexture::CreateTexture(IDevice* _Device, unsigned char* _TextureData, int _Width, int _Height)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		CreateTextureImage(&device, _TextureData, _Width, _Height);
 		CreateTextureImageView(&device);
@@ -100,7 +76,7 @@ namespace Core
 
 	RHI_RESULT VulkanTexture::DestroyTexture(IDevice* _Device)
 	{
-		VulkanDevice device = *_Device->CastToVulkan();
+		VulkanDevice& device = *_Device->CastToVulkan();
 
 		vkDestroySampler(device.GetLogicalDevice(), m_TextureSampler, nullptr);
 		vkDestroyImageView(device.GetLogicalDevice(), m_TextureImageView.GetType(), nullptr);
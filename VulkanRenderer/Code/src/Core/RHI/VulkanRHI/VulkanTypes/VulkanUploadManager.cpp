@@ -0,0 +1,578 @@
+#include "RHI/VulkanRHI/VulkanTypes/VulkanUploadManager.h"
+
+#include "RHI/VulkanRHI/VulkanTypes/VulkanDevice.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanBuffer.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanImage.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanQueue.h"
+#include "RHI/VulkanRHI/VulkanTypes/VulkanCommandBuffer.h"
+
+#include "Renderer.h"
+
+namespace Core
+{
+	VulkanUploadManager::~VulkanUploadManager()
+	{}
+
+	const RHI_RESULT VulkanUploadManager::CreateUploadManager(IDevice* _Device, size_t _StagingSize)
+	{
+		VulkanDevice* device = _Device->CastToVulkan();
+
+		m_Device = _Device;
+		m_LogicalDevice = device->GetLogicalDevice();
+
+		QueueFamilyIndices queueFamilyIndices = VulkanQueue::FindQueueFamilies(device->GetPhysicalDevice(), device->GetSurface());
+
+		m_GraphicsFamily = queueFamilyIndices.graphicsFamily.value();
+		m_TransferFamily = queueFamilyIndices.transfertFamily.value();
+		m_DedicatedTransferQueue = m_TransferFamily != m_GraphicsFamily;
+
+		m_GraphicsQueue = device->GetGraphicsQueue();
+		m_TransferQueue = m_DedicatedTransferQueue ? device->GetTransferQueue() : m_GraphicsQueue;
+
+		// Pool owning the command buffers of the batches - they are reset and reused once retired
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		poolInfo.queueFamilyIndex = m_TransferFamily;
+
+		VkResult result = vkCreateCommandPool(m_LogicalDevice, &poolInfo, nullptr, &m_CommandPool);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create upload command pool, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		// The ownership of the resources is acquired by command buffers of the graphics family
+		if (m_DedicatedTransferQueue)
+		{
+			poolInfo.queueFamilyIndex = m_GraphicsFamily;
+
+			result = vkCreateCommandPool(m_LogicalDevice, &poolInfo, nullptr, &m_AcquireCommandPool);
+
+			if (result != VK_SUCCESS)
+			{
+				DEBUG_ERROR("Failed to create upload acquire command pool, Error Code: %d", result);
+				return RHI_FAILED_UNKNOWN;
+			}
+		}
+
+		// Creates the staging ring, it stays mapped for the whole life of the upload manager
+		m_Capacity = static_cast<VkDeviceSize>(_StagingSize);
+
+		VulkanBuffer buffer;
+		buffer.CreateBuffer(_Device, m_Capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_StagingBuffer, m_StagingMemory);
+
+		void* data;
+		result = vkMapMemory(m_LogicalDevice, m_StagingMemory, 0, m_Capacity, 0, &data);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to map upload staging buffer, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		m_StagingData = static_cast<unsigned char*>(data);
+
+		return RHI_SUCCESS;
+	}
+
+	const RHI_RESULT VulkanUploadManager::DestroyUploadManager(IDevice* _Device)
+	{
+		WaitUploads(_Device);
+
+		for (UploadBatch& batch : m_FreeBatches)
+		{
+			vkDestroyFence(m_LogicalDevice, batch.fence, nullptr);
+
+			if (batch.semaphore != VK_NULL_HANDLE)
+				vkDestroySemaphore(m_LogicalDevice, batch.semaphore, nullptr);
+		}
+
+		m_FreeBatches.clear();
+
+		// Destroying the pools frees all the command buffers allocated from them
+		vkDestroyCommandPool(m_LogicalDevice, m_CommandPool, nullptr);
+
+		if (m_AcquireCommandPool != VK_NULL_HANDLE)
+			vkDestroyCommandPool(m_LogicalDevice, m_AcquireCommandPool, nullptr);
+
+		vkUnmapMemory(m_LogicalDevice, m_StagingMemory);
+		vkDestroyBuffer(m_LogicalDevice, m_StagingBuffer, nullptr);
+		vkFreeMemory(m_LogicalDevice, m_StagingMemory, nullptr);
+
+		m_StagingData = nullptr;
+
+		return RHI_SUCCESS;
+	}
+
+	void VulkanUploadManager::FlushUploads(IDevice* _Device)
+	{
+		SubmitCurrentBatch();
+
+		// Frees the ring space of the batches already finished
+		RetireBatches(false);
+	}
+
+	void VulkanUploadManager::WaitUploads(IDevice* _Device)
+	{
+		SubmitCurrentBatch();
+
+		while (!m_InFlightBatches.empty())
+		{
+			RetireBatches(true);
+		}
+	}
+
+	void VulkanUploadManager::SetImmediateUploads(const bool _IsImmediate)
+	{
+		// The uploads already recorded keep their batch
+		if (_IsImmediate)
+			SubmitCurrentBatch();
+
+		m_IsImmediate = _IsImmediate;
+	}
+
+	const RHI_RESULT VulkanUploadManager::CreateBatch(UploadBatch& _Batch)
+	{
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = m_CommandPool;
+		allocInfo.commandBufferCount = 1;
+
+		VkResult result = vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &_Batch.commandBuffer);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to allocate upload command buffer, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		// Fence created unsignaled, it is only signaled by the submission of the batch
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+		result = vkCreateFence(m_LogicalDevice, &fenceInfo, nullptr, &_Batch.fence);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create upload fence, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		if (!m_DedicatedTransferQueue)
+			return RHI_SUCCESS;
+
+		allocInfo.commandPool = m_AcquireCommandPool;
+
+		result = vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &_Batch.acquireCommandBuffer);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to allocate upload acquire command buffer, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		result = vkCreateSemaphore(m_LogicalDevice, &semaphoreInfo, nullptr, &_Batch.semaphore);
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to create upload semaphore, Error Code: %d", result);
+			return RHI_FAILED_UNKNOWN;
+		}
+
+		return RHI_SUCCESS;
+	}
+
+	VkCommandBuffer VulkanUploadManager::GetBatchCommandBuffer()
+	{
+		if (m_CurrentBatch.commandBuffer != VK_NULL_HANDLE)
+			return m_CurrentBatch.commandBuffer;
+
+		// Reuses a retired batch if possible
+		if (!m_FreeBatches.empty())
+		{
+			m_CurrentBatch = m_FreeBatches.back();
+			m_FreeBatches.pop_back();
+
+			vkResetCommandBuffer(m_CurrentBatch.commandBuffer, 0);
+			vkResetFences(m_LogicalDevice, 1, &m_CurrentBatch.fence);
+
+			if (m_CurrentBatch.acquireCommandBuffer != VK_NULL_HANDLE)
+				vkResetCommandBuffer(m_CurrentBatch.acquireCommandBuffer, 0);
+		}
+		else if (!CreateBatch(m_CurrentBatch))
+		{
+			return VK_NULL_HANDLE;
+		}
+
+		// The command buffer is recorded once and submitted once
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		vkBeginCommandBuffer(m_CurrentBatch.commandBuffer, &beginInfo);
+
+		return m_CurrentBatch.commandBuffer;
+	}
+
+	const bool VulkanUploadManager::TryAllocateRing(VkDeviceSize _Size, VkDeviceSize _Alignment, VkDeviceSize& _Offset)
+	{
+		VkDeviceSize start = (m_Head + _Alignment - 1) & ~(_Alignment - 1);
+
+		// Used space goes from the tail to the head, free space is after the head and before the tail
+		if (m_Head >= m_Tail)
+		{
+			if (start + _Size <= m_Capacity)
+			{
+				_Offset = start;
+				m_Head = start + _Size;
+				return true;
+			}
+
+			// Wraps around - the head must stay strictly behind the tail to not look empty
+			if (_Size < m_Tail)
+			{
+				_Offset = 0;
+				m_Head = _Size;
+				return true;
+			}
+
+			return false;
+		}
+
+		if (start + _Size < m_Tail)
+		{
+			_Offset = start;
+			m_Head = start + _Size;
+			return true;
+		}
+
+		return false;
+	}
+
+	unsigned char* VulkanUploadManager::AllocateStaging(VkDeviceSize _Size, VkDeviceSize _Alignment, VkBuffer& _Buffer, VkDeviceSize& _Offset)
+	{
+		// Data bigger than the ring gets its own staging buffer released with the batch
+		if (_Size > m_Capacity)
+		{
+			UploadOverflowBuffer overflow;
+
+			VulkanBuffer buffer;
+			buffer.CreateBuffer(m_Device, _Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, overflow.buffer, overflow.memory);
+
+			void* data;
+			vkMapMemory(m_LogicalDevice, overflow.memory, 0, _Size, 0, &data);
+
+			GetBatchCommandBuffer();
+			m_CurrentBatch.overflowBuffers.push_back(overflow);
+
+			_Buffer = overflow.buffer;
+			_Offset = 0;
+
+			return static_cast<unsigned char*>(data);
+		}
+
+		RetireBatches(false);
+
+		while (!TryAllocateRing(_Size, _Alignment, _Offset))
+		{
+			// The ring is full - submits what is recorded and waits for the oldest batch to free some space
+			SubmitCurrentBatch();
+			RetireBatches(true);
+		}
+
+		_Buffer = m_StagingBuffer;
+
+		return m_StagingData + _Offset;
+	}
+
+	void VulkanUploadManager::SubmitCurrentBatch()
+	{
+		if (m_CurrentBatch.commandBuffer == VK_NULL_HANDLE)
+			return;
+
+		VulkanDevice* device = m_Device->CastToVulkan();
+
+		// All the images of the batch go to the transfer layout with a single barrier
+		m_CurrentBatch.preCopyBarriers.Flush(device, m_CurrentBatch.commandBuffer);
+
+		for (const UploadBufferCopy& copy : m_CurrentBatch.bufferCopies)
+		{
+			vkCmdCopyBuffer(m_CurrentBatch.commandBuffer, copy.source, copy.destination, 1, &copy.region);
+		}
+
+		for (const UploadImageCopy& copy : m_CurrentBatch.imageCopies)
+		{
+			vkCmdCopyBufferToImage(m_CurrentBatch.commandBuffer, copy.source, copy.destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy.region);
+		}
+
+		m_CurrentBatch.bufferCopies.clear();
+		m_CurrentBatch.imageCopies.clear();
+
+		// Makes the copies visible to the graphics queue, or releases the resources when they have to change of family
+		m_CurrentBatch.postCopyBarriers.Flush(device, m_CurrentBatch.commandBuffer);
+
+		vkEndCommandBuffer(m_CurrentBatch.commandBuffer);
+
+		VkResult result;
+
+		if (!m_DedicatedTransferQueue)
+		{
+			VkSubmitInfo submitInfo{};
+			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &m_CurrentBatch.commandBuffer;
+
+			// The fence replaces the old vkQueueWaitIdle, the CPU only waits on it when the ring is full
+			result = vkQueueSubmit(m_TransferQueue, 1, &submitInfo, m_CurrentBatch.fence);
+			++m_SubmissionCount;
+		}
+		else
+		{
+			// Acquire half of the ownership transfers, executed on the graphics queue
+			VkCommandBufferBeginInfo beginInfo{};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+			vkBeginCommandBuffer(m_CurrentBatch.acquireCommandBuffer, &beginInfo);
+
+			m_CurrentBatch.acquireBarriers.Flush(device, m_CurrentBatch.acquireCommandBuffer);
+
+			vkEndCommandBuffer(m_CurrentBatch.acquireCommandBuffer);
+
+			// The transfer queue signals the semaphore, the graphics queue waits for it on the GPU only
+			VkSubmitInfo transferSubmitInfo{};
+			transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			transferSubmitInfo.commandBufferCount = 1;
+			transferSubmitInfo.pCommandBuffers = &m_CurrentBatch.commandBuffer;
+			transferSubmitInfo.signalSemaphoreCount = 1;
+			transferSubmitInfo.pSignalSemaphores = &m_CurrentBatch.semaphore;
+
+			result = vkQueueSubmit(m_TransferQueue, 1, &transferSubmitInfo, VK_NULL_HANDLE);
+			++m_SubmissionCount;
+
+			if (result != VK_SUCCESS)
+			{
+				DEBUG_ERROR("Failed to submit upload batch to the transfer queue, Error Code: %d", result);
+			}
+
+			VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+			VkSubmitInfo acquireSubmitInfo{};
+			acquireSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			acquireSubmitInfo.waitSemaphoreCount = 1;
+			acquireSubmitInfo.pWaitSemaphores = &m_CurrentBatch.semaphore;
+			acquireSubmitInfo.pWaitDstStageMask = &waitStage;
+			acquireSubmitInfo.commandBufferCount = 1;
+			acquireSubmitInfo.pCommandBuffers = &m_CurrentBatch.acquireCommandBuffer;
+
+			// The fence is signaled once both halves are executed, the acquire waiting for the transfer
+			result = vkQueueSubmit(m_GraphicsQueue, 1, &acquireSubmitInfo, m_CurrentBatch.fence);
+			++m_SubmissionCount;
+		}
+
+		if (result != VK_SUCCESS)
+		{
+			DEBUG_ERROR("Failed to submit upload batch, Error Code: %d", result);
+		}
+
+		m_CurrentBatch.ringEnd = m_Head;
+		m_InFlightBatches.push_back(m_CurrentBatch);
+
+		m_CurrentBatch = UploadBatch();
+	}
+
+	void VulkanUploadManager::RetireBatches(const bool _WaitOldest)
+	{
+		if (_WaitOldest && !m_InFlightBatches.empty())
+		{
+			vkWaitForFences(m_LogicalDevice, 1, &m_InFlightBatches.front().fence, VK_TRUE, UINT64_MAX);
+		}
+
+		// Batches are retired in submission order so the tail only moves forward
+		while (!m_InFlightBatches.empty() && vkGetFenceStatus(m_LogicalDevice, m_InFlightBatches.front().fence) == VK_SUCCESS)
+		{
+			UploadBatch batch = m_InFlightBatches.front();
+			m_InFlightBatches.pop_front();
+
+			for (UploadOverflowBuffer& overflow : batch.overflowBuffers)
+			{
+				vkDestroyBuffer(m_LogicalDevice, overflow.buffer, nullptr);
+				vkFreeMemory(m_LogicalDevice, overflow.memory, nullptr);
+			}
+
+			batch.overflowBuffers.clear();
+
+			m_Tail = batch.ringEnd;
+
+			m_FreeBatches.push_back(batch);
+		}
+
+		// Nothing left in the ring - restarts from the beginning to keep big free blocks
+		if (m_InFlightBatches.empty() && m_CurrentBatch.commandBuffer == VK_NULL_HANDLE)
+		{
+			m_Head = 0;
+			m_Tail = 0;
+		}
+	}
+
+	void VulkanUploadManager::CreateImmediateStaging(const void* _Data, VkDeviceSize _Size, UploadOverflowBuffer& _Staging)
+	{
+		VulkanBuffer buffer;
+		buffer.CreateBuffer(m_Device, _Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _Staging.buffer, _Staging.memory);
+
+		void* data;
+		vkMapMemory(m_LogicalDevice, _Staging.memory, 0, _Size, 0, &data);
+		memcpy(data, _Data, static_cast<size_t>(_Size));
+		vkUnmapMemory(m_LogicalDevice, _Staging.memory);
+	}
+
+	void VulkanUploadManager::UploadToBufferImmediate(VkBuffer _Destination, const void* _Data, VkDeviceSize _Size, VkDeviceSize _DestinationOffset)
+	{
+		UploadOverflowBuffer staging;
+		CreateImmediateStaging(_Data, _Size, staging);
+
+		VulkanDevice* device = m_Device->CastToVulkan();
+		VulkanCommandAllocator* commandAllocator = Core::Renderer::GetCommandAllocator()->CastToVulkan();
+
+		// Submitted on the graphics queue which is waited idle, no ownership transfer and no barrier needed
+		VkCommandBuffer commandBuffer = VulkanCommandBuffer::BeginSingleTimeCommands(device, commandAllocator);
+
+		VkBufferCopy region{};
+		region.dstOffset = _DestinationOffset;
+		region.size = _Size;
+
+		vkCmdCopyBuffer(commandBuffer, staging.buffer, _Destination, 1, &region);
+
+		VulkanCommandBuffer::EndSingleTimeCommands(device, commandAllocator, commandBuffer);
+		++m_SubmissionCount;
+
+		vkDestroyBuffer(m_LogicalDevice, staging.buffer, nullptr);
+		vkFreeMemory(m_LogicalDevice, staging.memory, nullptr);
+	}
+
+	void VulkanUploadManager::UploadToImageImmediate(VulkanImage& _Image, VkFormat _Format, const void* _Data, VkDeviceSize _Size, uint32_t _Width, uint32_t _Height)
+	{
+		UploadOverflowBuffer staging;
+		CreateImmediateStaging(_Data, _Size, staging);
+
+		VulkanDevice* device = m_Device->CastToVulkan();
+		VulkanCommandAllocator* commandAllocator = Core::Renderer::GetCommandAllocator()->CastToVulkan();
+
+		VkCommandBuffer commandBuffer = VulkanCommandBuffer::BeginSingleTimeCommands(device, commandAllocator);
+
+		VulkanBarrierBuilder barriers;
+		barriers.AddImageTransition(_Image.GetImage(), _Format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		barriers.Flush(device, commandBuffer);
+
+		VkBufferImageCopy region{};
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0, 0, 0 };
+		region.imageExtent = { _Width, _Height, 1 };
+
+		vkCmdCopyBufferToImage(commandBuffer, staging.buffer, _Image.GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+		barriers.AddImageTransition(_Image.GetImage(), _Format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		barriers.Flush(device, commandBuffer);
+
+		VulkanCommandBuffer::EndSingleTimeCommands(device, commandAllocator, commandBuffer);
+		++m_SubmissionCount;
+
+		vkDestroyBuffer(m_LogicalDevice, staging.buffer, nullptr);
+		vkFreeMemory(m_LogicalDevice, staging.memory, nullptr);
+	}
+
+	void VulkanUploadManager::UploadToBuffer(VkBuffer _Destination, const void* _Data, VkDeviceSize _Size, VkDeviceSize _DestinationOffset)
+	{
+		if (m_IsImmediate)
+		{
+			UploadToBufferImmediate(_Destination, _Data, _Size, _DestinationOffset);
+			return;
+		}
+
+		UploadBufferCopy copy;
+		copy.destination = _Destination;
+
+		unsigned char* stagingData = AllocateStaging(_Size, 16, copy.source, copy.region.srcOffset);
+		memcpy(stagingData, _Data, static_cast<size_t>(_Size));
+
+		copy.region.dstOffset = _DestinationOffset;
+		copy.region.size = _Size;
+
+		GetBatchCommandBuffer();
+		m_CurrentBatch.bufferCopies.push_back(copy);
+
+		if (!m_DedicatedTransferQueue)
+		{
+			// One global barrier is enough for all the buffers of the batch
+			if (m_CurrentBatch.bufferCopies.size() == 1)
+			{
+				m_CurrentBatch.postCopyBarriers.AddMemoryBarrier(VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR,
+					VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT_KHR | VK_ACCESS_2_INDEX_READ_BIT_KHR);
+			}
+
+			return;
+		}
+
+		// Hands the buffer over to the graphics family - release on the transfer queue, acquire on the graphics queue
+		m_CurrentBatch.postCopyBarriers.AddBufferBarrier(_Destination, _DestinationOffset, _Size, VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR,
+			VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT_KHR, 0, m_TransferFamily, m_GraphicsFamily);
+
+		m_CurrentBatch.acquireBarriers.AddBufferBarrier(_Destination, _DestinationOffset, _Size, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT_KHR, 0,
+			VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT_KHR | VK_ACCESS_2_INDEX_READ_BIT_KHR, m_TransferFamily, m_GraphicsFamily);
+	}
+
+	void VulkanUploadManager::UploadToImage(VulkanImage& _Image, VkFormat _Format, const void* _Data, VkDeviceSize _Size, uint32_t _Width, uint32_t _Height)
+	{
+		if (m_IsImmediate)
+		{
+			UploadToImageImmediate(_Image, _Format, _Data, _Size, _Width, _Height);
+			return;
+		}
+
+		UploadImageCopy copy;
+		copy.destination = _Image.GetImage();
+
+		unsigned char* stagingData = AllocateStaging(_Size, 16, copy.source, copy.region.bufferOffset);
+		memcpy(stagingData, _Data, static_cast<size_t>(_Size));
+
+		copy.region.bufferRowLength = 0;
+		copy.region.bufferImageHeight = 0;
+
+		copy.region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copy.region.imageSubresource.mipLevel = 0;
+		copy.region.imageSubresource.baseArrayLayer = 0;
+		copy.region.imageSubresource.layerCount = 1;
+
+		copy.region.imageOffset = { 0, 0, 0 };
+		copy.region.imageExtent = { _Width, _Height, 1 };
+
+		GetBatchCommandBuffer();
+		m_CurrentBatch.imageCopies.push_back(copy);
+
+		// The image has to be in a transfer layout to receive the copy
+		m_CurrentBatch.preCopyBarriers.AddImageTransition(_Image.GetImage(), _Format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+		// Then in a layout readable by the shaders
+		if (!m_DedicatedTransferQueue)
+		{
+			m_CurrentBatch.postCopyBarriers.AddImageTransition(_Image.GetImage(), _Format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			return;
+		}
+
+		// With a transfer queue the layout transition is done by the ownership transfer, both halves need the same layouts
+		m_CurrentBatch.postCopyBarriers.AddImageBarrier(_Image.GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT_KHR, 0, m_TransferFamily, m_GraphicsFamily);
+
+		m_CurrentBatch.acquireBarriers.AddImageBarrier(_Image.GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT_KHR, 0, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR, m_TransferFamily, m_GraphicsFamily);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace Core
+{
+	ThreadPool::ThreadPool(unsigned int _ThreadCount)
+	{
+		if (_ThreadCount == 0)
+		{
+			unsigned int hardwareThreads = std::thread::hardware_concurrency();
+			_ThreadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		m_Workers.reserve(_ThreadCount);
+
+		for (unsigned int i = 0; i < _ThreadCount; ++i)
+			m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			m_IsStopping = true;
+		}
+
+		m_JobsCondition.notify_all();
+
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock<std::mutex> lock(m_JobsMutex);
+				m_JobsCondition.wait(lock, [this]() { return m_IsStopping || !m_Jobs.empty(); });
+
+				if (m_Jobs.empty())
+					return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			// Exceptions are stored in the future by the packaged task
+			job();
+		}
+	}
+
+	void ThreadPool::ParallelFor(size_t _Count, const std::function<void(size_t)>& _Job)
+	{
+		if (_Count == 0)
+			return;
+
+		// Shared with the jobs, a job starting after the loop returned finds no index left and only touches this state
+		struct LoopState
+		{
+			std::atomic<size_t> nextIndex = 0;
+			std::atomic<size_t> doneCount = 0;
+			size_t count = 0;
+			const std::function<void(size_t)>* job = nullptr;
+
+			// First exception thrown by the job, the indices left are skipped and it is rethrown by the caller
+			std::atomic<bool> hasFailed = false;
+			std::exception_ptr exception;
+
+			std::mutex doneMutex;
+			std::condition_variable doneCondition;
+		};
+
+		std::shared_ptr<LoopState> state = std::make_shared<LoopState>();
+		state->count = _Count;
+		state->job = &_Job;
+
+		auto takeIndices = [state]()
+			{
+				size_t index = 0;
+
+				while ((index = state->nextIndex++) < state->count)
+				{
+					// An exception must not leave a worker, and the index is always counted so the caller never waits forever
+					if (!state->hasFailed)
+					{
+						try
+						{
+							(*state->job)(index);
+						}
+						catch (...)
+						{
+							std::lock_guard<std::mutex> lock(state->doneMutex);
+
+							if (!state->exception)
+								state->exception = std::current_exception();
+
+							state->hasFailed = true;
+						}
+					}
+
+					if (++state->doneCount == state->count)
+					{
+						std::lock_guard<std::mutex> lock(state->doneMutex);
+						state->doneCondition.notify_all();
+					}
+				}
+			};
+
+		size_t helperCount = std::min(m_Workers.size(), _Count - 1);
+
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+
+			for (size_t i = 0; i < helperCount; ++i)
+				m_Jobs.push_back(takeIndices);
+		}
+
+		m_JobsCondition.notify_all();
+
+		takeIndices();
+
+		std::unique_lock<std::mutex> lock(state->doneMutex);
+		state->doneCondition.wait(lock, [&state]() { return state->doneCount == state->count; });
+
+		// Every index is done, no helper uses the job anymore
+		if (state->exception)
+			std::rethrow_exception(state->exception);
+	}
+}
\ No newline at end of file
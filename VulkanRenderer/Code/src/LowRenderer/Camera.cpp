@@ -18,7 +18,7 @@ namespace LowRenderer
 
         p_Descriptors = Core::Renderer::GetDescriptorAllocator()->CreateUBODescriptor(Core::Renderer::GetDevice(),
             Core::Renderer::MAX_FRAMES_IN_FLIGHT, p_UniformBuffers,
-            sizeof(CameraData), Core::Renderer::GetPipeline()->GetDescriptorLayouts()[0]);
+            sizeof(CameraData), Core::Renderer::GetPipeline()->GetDescriptorLayout(DESCRIPTOR_SET, DESCRIPTOR_BINDING));
     }
 
     void Camera::DeleteDescriptors()
@@ -0,0 +1,158 @@
+#include "ClusterCuller.h"
+
+#include <cmath>
+
+namespace LowRenderer
+{
+	static float Determinant3(const float _A[3], const float _B[3], const float _C[3])
+	{
+		return _A[0] * (_B[1] * _C[2] - _B[2] * _C[1]) - _A[1] * (_B[0] * _C[2] - _B[2] * _C[0]) + _A[2] * (_B[0] * _C[1] - _B[1] * _C[0]);
+	}
+
+	ClusterCullingView ClusterCuller::MakeView(Math::Matrix4 _ClipFromModel, bool _IsBackfaceCulled, bool _IsFrontFaceCounterClockwise)
+	{
+		float rows[4][4];
+
+		for (int row = 0; row < 4; ++row)
+		{
+			Math::Vector4 values = _ClipFromModel[row];
+
+			for (int column = 0; column < 4; ++column)
+				rows[row][column] = values[column];
+		}
+
+		ClusterCullingView view;
+
+		// Clip space of Vulkan, -w <= x <= w, -w <= y <= w and 0 <= z <= w, every plane is a row plus or minus another one
+		const int planeRows[6][2] = { { 3, 0 }, { 3, 0 }, { 3, 1 }, { 3, 1 }, { 2, 2 }, { 3, 2 } };
+		const float planeSigns[6] = { 1.f, -1.f, 1.f, -1.f, 0.f, -1.f };
+
+		for (int plane = 0; plane < 6; ++plane)
+		{
+			const float* first = rows[planeRows[plane][0]];
+			const float* second = rows[planeRows[plane][1]];
+
+			for (int component = 0; component < 4; ++component)
+				view.planes[plane][component] = first[component] + planeSigns[plane] * second[component];
+
+			float length = std::sqrt(view.planes[plane][0] * view.planes[plane][0] + view.planes[plane][1] * view.planes[plane][1] + view.planes[plane][2] * view.planes[plane][2]);
+
+			if (length > 0.f)
+			{
+				for (int component = 0; component < 4; ++component)
+					view.planes[plane][component] /= length;
+			}
+		}
+
+		// The eye is the point projected to x = y = w = 0
+		const float* eyeRows[3] = { rows[0], rows[1], rows[3] };
+
+		float columns[4][3];
+
+		for (int column = 0; column < 4; ++column)
+		{
+			for (int row = 0; row < 3; ++row)
+				columns[column][row] = eyeRows[row][column];
+		}
+
+		float translation[3] = { -columns[3][0], -columns[3][1], -columns[3][2] };
+		float determinant = Determinant3(columns[0], columns[1], columns[2]);
+
+		if (determinant != 0.f)
+		{
+			view.eye[0] = Determinant3(translation, columns[1], columns[2]) / determinant;
+			view.eye[1] = Determinant3(columns[0], translation, columns[2]) / determinant;
+			view.eye[2] = Determinant3(columns[0], columns[1], translation) / determinant;
+		}
+
+		if (!_IsBackfaceCulled || determinant == 0.f)
+			return view;
+
+		// Mirroring transforms flip the winding on screen, the sign of the determinant tells whether the front faces still have their normal towards the eye
+		float matrixDeterminant = 0.f;
+
+		for (int column = 0; column < 4; ++column)
+		{
+			float minor[3][3];
+
+			for (int row = 0; row < 3; ++row)
+			{
+				for (int minorColumn = 0, source = 0; source < 4; ++source)
+				{
+					if (source != column)
+						minor[row][minorColumn++] = eyeRows[row][source];
+				}
+			}
+
+			float cofactor = Determinant3(minor[0], minor[1], minor[2]);
+			matrixDeterminant += (column % 2 == 0 ? 1.f : -1.f) * rows[2][column] * cofactor;
+		}
+
+		float facing = matrixDeterminant > 0.f ? 1.f : -1.f;
+
+		view.facing = _IsFrontFaceCounterClockwise ? facing : -facing;
+
+		return view;
+	}
+
+	void ClusterCuller::Cull(const std::vector<Core::Meshlet>& _Meshlets, const ClusterCullingView& _View, std::vector<Core::Submesh>& _Draws, ClusterCullingStatistics* _Statistics)
+	{
+		_Draws.clear();
+
+		ClusterCullingStatistics statistics;
+		statistics.meshletCount = static_cast<unsigned int>(_Meshlets.size());
+
+		for (const Core::Meshlet& meshlet : _Meshlets)
+		{
+			bool isInside = true;
+
+			for (int plane = 0; isInside && plane < 6; ++plane)
+			{
+				const float* equation = _View.planes[plane];
+
+				isInside = equation[0] * meshlet.center[0] + equation[1] * meshlet.center[1] + equation[2] * meshlet.center[2] + equation[3] >= -meshlet.radius;
+			}
+
+			if (!isInside)
+			{
+				++statistics.frustumCulledCount;
+				continue;
+			}
+
+			// Every triangle faces away when the eye is behind the cone widened by the sphere
+			if (_View.facing != 0.f && meshlet.coneCutoff < 1.f)
+			{
+				float toCenter[3] = { meshlet.center[0] - _View.eye[0], meshlet.center[1] - _View.eye[1], meshlet.center[2] - _View.eye[2] };
+				float distance = std::sqrt(toCenter[0] * toCenter[0] + toCenter[1] * toCenter[1] + toCenter[2] * toCenter[2]);
+				float alignment = _View.facing * (toCenter[0] * meshlet.coneAxis[0] + toCenter[1] * meshlet.coneAxis[1] + toCenter[2] * meshlet.coneAxis[2]);
+
+				if (alignment >= meshlet.coneCutoff * distance + meshlet.radius)
+				{
+					++statistics.backfaceCulledCount;
+					continue;
+				}
+			}
+
+			uint32_t indexCount = 3 * meshlet.triangleCount;
+
+			// Meshlets are cut from the submeshes in order, the visible neighbours become one draw
+			if (!_Draws.empty() && _Draws.back().vertexOffset == meshlet.vertexOffset && _Draws.back().firstIndex + _Draws.back().indexCount == meshlet.firstIndex)
+			{
+				_Draws.back().indexCount += indexCount;
+				continue;
+			}
+
+			Core::Submesh draw;
+			draw.firstIndex = meshlet.firstIndex;
+			draw.indexCount = indexCount;
+			draw.vertexOffset = meshlet.vertexOffset;
+
+			_Draws.push_back(draw);
+		}
+
+		statistics.drawCount = static_cast<unsigned int>(_Draws.size());
+
+		if (_Statistics != nullptr)
+			*_Statistics = statistics;
+	}
+}
\ No newline at end of file
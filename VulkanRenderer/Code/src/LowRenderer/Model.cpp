@@ -12,12 +12,12 @@ namespace LowRenderer
 
 		for (size_t i = 0; i < Core::Renderer::MAX_FRAMES_IN_FLIGHT; ++i)
 		{
-			p_UniformBuffers[i] = Core::Renderer::GetRHI()->CreateBuffer(Core::Renderer::GetDevice(), Core::BufferType::RHI_UNIFORM_BUFFER, sizeof(Math::Matrix4));
+			p_UniformBuffers[i] = Core::Renderer::GetRHI()->CreateBuffer(Core::Renderer::GetDevice(), Core::BufferType::RHI_UNIFORM_BUFFER, sizeof(ModelData));
 		}
 
 		p_Descriptors = Core::Renderer::GetDescriptorAllocator()->CreateUBODescriptor(Core::Renderer::GetDevice(), 
 			Core::Renderer::MAX_FRAMES_IN_FLIGHT, p_UniformBuffers, 
-			sizeof(Math::Matrix4), Core::Renderer::GetPipeline()->GetDescriptorLayouts()[0]);
+			sizeof(ModelData), Core::Renderer::GetPipeline()->GetDescriptorLayout(DESCRIPTOR_SET, DESCRIPTOR_BINDING));
 	}
 
 	void Model::DestroyDescriptors()
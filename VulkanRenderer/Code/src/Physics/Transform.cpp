@@ -2,5 +2,14 @@
 
 namespace Physics
 {
+	Math::Matrix4 Transform::GetWorldTRS() const
+	{
+		Math::Matrix4 world = m_LocalTRS;
 
+		// The matrices are transposed, parent * local becomes local * parent
+		for (const Transform* parent = m_Parent; parent != nullptr; parent = parent->m_Parent)
+			world = world.Multiply(parent->m_LocalTRS);
+
+		return world;
+	}
 }
\ No newline at end of file
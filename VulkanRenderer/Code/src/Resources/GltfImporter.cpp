@@ -0,0 +1,1044 @@
+#include "GltfImporter.h"
+
+#include "IMesh.h"
+#include "RHI/IRendererHardware.h"
+#include "RHI/Vertex.h"
+#include "Debug/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace Core
+{
+	// Component types and primitive mode of the glTF specification
+	static const uint32_t GLTF_BYTE = 5120;
+	static const uint32_t GLTF_UNSIGNED_BYTE = 5121;
+	static const uint32_t GLTF_SHORT = 5122;
+	static const uint32_t GLTF_UNSIGNED_SHORT = 5123;
+	static const uint32_t GLTF_UNSIGNED_INT = 5125;
+	static const uint32_t GLTF_FLOAT = 5126;
+	static const int GLTF_TRIANGLES = 4;
+
+	// Attributes of a primitive read by the vertex shader locations
+	struct AttributeSemantic
+	{
+		unsigned int location;
+		const char* name;
+	};
+
+	static const AttributeSemantic ATTRIBUTE_SEMANTICS[] = {
+		{ VertexLayout::POSITION_LOCATION, "POSITION" },
+		{ VertexLayout::COLOR_LOCATION, "COLOR_0" },
+		{ VertexLayout::TEXTCOORD_LOCATION, "TEXCOORD_0" },
+		{ VertexLayout::NORMAL_LOCATION, "NORMAL" }
+	};
+
+	static uint32_t GetComponentSize(uint32_t _ComponentType)
+	{
+		switch (_ComponentType)
+		{
+		case GLTF_BYTE: case GLTF_UNSIGNED_BYTE: return 1;
+		case GLTF_SHORT: case GLTF_UNSIGNED_SHORT: return 2;
+		case GLTF_UNSIGNED_INT: case GLTF_FLOAT: return 4;
+		default: return 0;
+		}
+	}
+
+	static uint32_t GetComponentCount(const std::string& _Type)
+	{
+		if (_Type == "SCALAR") return 1;
+		if (_Type == "VEC2") return 2;
+		if (_Type == "VEC3") return 3;
+		if (_Type == "VEC4") return 4;
+
+		return 0;
+	}
+
+	static uint32_t ReadUint32(const unsigned char* _Data)
+	{
+		uint32_t value;
+		memcpy(&value, _Data, sizeof(value));
+
+		return value;
+	}
+
+	// Points, lines and strips are not drawn by the pipelines of the meshes
+	static bool IsTriangleList(const JsonValue& _Primitive)
+	{
+		return _Primitive["mode"].GetInt(GLTF_TRIANGLES) == GLTF_TRIANGLES;
+	}
+
+	// The textures are flipped on load for the OBJ convention, glTF texture coordinates start at the top
+	static void FlipTextCoords(VertexDequantization& _Dequantization)
+	{
+		_Dequantization.textCoordScaleOffset[3] += _Dequantization.textCoordScaleOffset[1];
+		_Dequantization.textCoordScaleOffset[1] = -_Dequantization.textCoordScaleOffset[1];
+	}
+
+	void GltfScene::Unload(IRendererHardware* _RHI, IDevice* _Device)
+	{
+		for (IMesh* mesh : m_Meshes)
+		{
+			if (mesh == nullptr)
+				continue;
+
+			mesh->Unload(_Device);
+			_RHI->DestroyMesh(mesh);
+		}
+
+		m_Meshes.clear();
+		m_Nodes.clear();
+	}
+
+	const bool GltfImporter::Open(const std::filesystem::path& _Path)
+	{
+		Close();
+
+		m_Path = _Path;
+
+		if (!m_File.Open(_Path))
+		{
+			DEBUG_ERROR("Failed to open glTF file %s", _Path.string().c_str());
+			return false;
+		}
+
+		const unsigned char* data = m_File.GetData();
+		size_t size = m_File.GetSize();
+
+		const char* json = reinterpret_cast<const char*>(data);
+		size_t jsonSize = size;
+		Buffer binaryChunk;
+
+		if (size >= GLB_HEADER_SIZE && ReadUint32(data) == GLB_MAGIC_NUMBER)
+		{
+			uint32_t version = ReadUint32(data + 4);
+			size_t length = std::min<size_t>(ReadUint32(data + 8), size);
+
+			uint32_t jsonChunkSize = length >= GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE ? ReadUint32(data + GLB_HEADER_SIZE) : 0;
+			size_t jsonEnd = GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE + static_cast<size_t>(jsonChunkSize);
+
+			if (version != 2 || jsonChunkSize == 0 || jsonEnd > length || ReadUint32(data + GLB_HEADER_SIZE + 4) != GLB_JSON_CHUNK)
+			{
+				DEBUG_ERROR("Invalid GLB file %s", _Path.string().c_str());
+				Close();
+				return false;
+			}
+
+			json = reinterpret_cast<const char*>(data + GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE);
+			jsonSize = jsonChunkSize;
+
+			// The binary chunk is optional and always second
+			if (jsonEnd + GLB_CHUNK_HEADER_SIZE <= length && ReadUint32(data + jsonEnd + 4) == GLB_BIN_CHUNK)
+			{
+				size_t binarySize = ReadUint32(data + jsonEnd);
+
+				if (binarySize <= length - jsonEnd - GLB_CHUNK_HEADER_SIZE)
+				{
+					binaryChunk.data = data + jsonEnd + GLB_CHUNK_HEADER_SIZE;
+					binaryChunk.size = binarySize;
+				}
+			}
+		}
+
+		if (!m_Document.Parse(json, jsonSize))
+		{
+			DEBUG_ERROR("Failed to parse the JSON of glTF file %s", _Path.string().c_str());
+			Close();
+			return false;
+		}
+
+		const JsonValue& root = m_Document.GetRoot();
+
+		if (root["asset"]["version"].GetString().rfind("2.", 0) != 0)
+		{
+			DEBUG_ERROR("glTF file %s is not glTF 2.0", _Path.string().c_str());
+			Close();
+			return false;
+		}
+
+		const JsonValue& buffers = root["buffers"];
+
+		for (size_t i = 0; i < buffers.GetSize(); ++i)
+		{
+			const JsonValue& buffer = buffers[i];
+			const JsonValue* uri = buffer.Find("uri");
+			size_t byteLength = static_cast<size_t>(buffer["byteLength"].GetNumber());
+
+			Buffer data;
+
+			// The first buffer of a GLB without uri is its binary chunk
+			if (uri == nullptr)
+			{
+				if (i == 0 && byteLength <= binaryChunk.size)
+					data = binaryChunk;
+			}
+			else if (uri->GetString().rfind("data:", 0) == 0)
+			{
+				DEBUG_ERROR("glTF file %s embeds a buffer as base64, only binary buffers are supported", _Path.string().c_str());
+				Close();
+				return false;
+			}
+			else
+			{
+				std::unique_ptr<MappedFile> bufferFile = std::make_unique<MappedFile>();
+
+				if (bufferFile->Open(_Path.parent_path() / std::filesystem::u8path(uri->GetString())) && byteLength <= bufferFile->GetSize())
+				{
+					data.data = bufferFile->GetData();
+					data.size = byteLength;
+				}
+
+				m_BufferFiles.push_back(std::move(bufferFile));
+			}
+
+			if (data.data == nullptr)
+			{
+				DEBUG_ERROR("Failed to read buffer %u of glTF file %s", static_cast<unsigned int>(i), _Path.string().c_str());
+				Close();
+				return false;
+			}
+
+			m_Buffers.push_back(data);
+		}
+
+		if (!ReadBufferViews())
+		{
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void GltfImporter::Close()
+	{
+		m_Buffers.clear();
+		m_BufferViews.clear();
+		m_BufferFiles.clear();
+		m_Document = JsonDocument();
+		m_File.Close();
+	}
+
+	const bool GltfImporter::ReadBufferViews()
+	{
+		const JsonValue& bufferViews = m_Document.GetRoot()["bufferViews"];
+
+		for (size_t i = 0; i < bufferViews.GetSize(); ++i)
+		{
+			const JsonValue& bufferView = bufferViews[i];
+
+			int bufferIndex = bufferView["buffer"].GetInt(-1);
+			size_t byteOffset = static_cast<size_t>(bufferView["byteOffset"].GetNumber());
+			size_t byteLength = static_cast<size_t>(bufferView["byteLength"].GetNumber());
+			size_t byteStride = static_cast<size_t>(bufferView["byteStride"].GetNumber());
+
+			if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= m_Buffers.size() || byteOffset > m_Buffers[bufferIndex].size
+				|| byteLength > m_Buffers[bufferIndex].size - byteOffset || byteStride > 252)
+			{
+				DEBUG_ERROR("Invalid buffer view %u in glTF file %s", static_cast<unsigned int>(i), m_Path.string().c_str());
+				return false;
+			}
+
+			BufferView view;
+			view.data = m_Buffers[bufferIndex].data + byteOffset;
+			view.size = byteLength;
+			view.stride = byteStride;
+
+			m_BufferViews.push_back(view);
+		}
+
+		return true;
+	}
+
+	const bool GltfImporter::GetAccessor(int _Index, Accessor& _Accessor) const
+	{
+		const JsonValue& accessor = m_Document.GetRoot()["accessors"][static_cast<size_t>(std::max(_Index, 0))];
+
+		if (_Index < 0 || !accessor.IsObject())
+			return false;
+
+		// Accessors without buffer view are filled with zeros, sparse ones patch their buffer view
+		if (accessor.Find("bufferView") == nullptr || accessor.Find("sparse") != nullptr)
+		{
+			DEBUG_WARN("Sparse accessor %i of glTF file %s is not supported", _Index, m_Path.string().c_str());
+			return false;
+		}
+
+		_Accessor.bufferView = accessor["bufferView"].GetInt(-1);
+		_Accessor.byteOffset = static_cast<size_t>(accessor["byteOffset"].GetNumber());
+		_Accessor.count = static_cast<size_t>(accessor["count"].GetNumber());
+		_Accessor.componentType = static_cast<uint32_t>(accessor["componentType"].GetInt());
+		_Accessor.componentCount = GetComponentCount(accessor["type"].GetString());
+		_Accessor.isNormalized = accessor["normalized"].GetBool();
+
+		uint32_t elementSize = GetComponentSize(_Accessor.componentType) * _Accessor.componentCount;
+
+		if (_Accessor.bufferView < 0 || static_cast<size_t>(_Accessor.bufferView) >= m_BufferViews.size() || elementSize == 0 || _Accessor.count == 0)
+			return false;
+
+		const BufferView& view = m_BufferViews[_Accessor.bufferView];
+
+		_Accessor.stride = view.stride > 0 ? view.stride : elementSize;
+
+		// The last element only needs its own size, not the whole stride
+		if (_Accessor.byteOffset > view.size || (_Accessor.count - 1) * _Accessor.stride + elementSize > view.size - _Accessor.byteOffset)
+			return false;
+
+		_Accessor.data = view.data + _Accessor.byteOffset;
+
+		return true;
+	}
+
+	void GltfImporter::ReadFloats(const Accessor& _Accessor, size_t _Element, float* _Values, uint32_t _ValueCount)
+	{
+		const unsigned char* element = _Accessor.data + _Element * _Accessor.stride;
+		uint32_t componentSize = GetComponentSize(_Accessor.componentType);
+
+		for (uint32_t i = 0; i < std::min(_ValueCount, _Accessor.componentCount); ++i)
+		{
+			const unsigned char* component = element + i * componentSize;
+
+			switch (_Accessor.componentType)
+			{
+			case GLTF_FLOAT:
+				memcpy(&_Values[i], component, sizeof(float));
+				break;
+			case GLTF_UNSIGNED_BYTE:
+				_Values[i] = _Accessor.isNormalized ? *component / 255.f : *component;
+				break;
+			case GLTF_BYTE:
+			{
+				int8_t value = static_cast<int8_t>(*component);
+				_Values[i] = _Accessor.isNormalized ? std::max(value / 127.f, -1.f) : value;
+				break;
+			}
+			case GLTF_UNSIGNED_SHORT:
+			{
+				uint16_t value;
+				memcpy(&value, component, sizeof(value));
+				_Values[i] = _Accessor.isNormalized ? value / 65535.f : value;
+				break;
+			}
+			case GLTF_SHORT:
+			{
+				int16_t value;
+				memcpy(&value, component, sizeof(value));
+				_Values[i] = _Accessor.isNormalized ? std::max(value / 32767.f, -1.f) : value;
+				break;
+			}
+			case GLTF_UNSIGNED_INT:
+				_Values[i] = static_cast<float>(ReadUint32(component));
+				break;
+			}
+		}
+	}
+
+	uint32_t GltfImporter::ReadIndex(const Accessor& _Accessor, size_t _Element)
+	{
+		const unsigned char* element = _Accessor.data + _Element * _Accessor.stride;
+
+		switch (_Accessor.componentType)
+		{
+		case GLTF_UNSIGNED_BYTE:
+			return *element;
+		case GLTF_UNSIGNED_SHORT:
+		{
+			uint16_t index;
+			memcpy(&index, element, sizeof(index));
+			return index;
+		}
+		default:
+			return ReadUint32(element);
+		}
+	}
+
+	const bool GltfImporter::GetDirectStreams(const JsonValue& _Mesh, VertexFormat _VertexFormat, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const
+	{
+		VertexLayout layout = VertexLayout::Get(_VertexFormat);
+
+		if (layout.HasColorStream())
+			return false;
+
+		uint32_t stride = layout.GetStride();
+
+		// Byte ranges of the primitives in the shared buffer views
+		struct PrimitiveRange
+		{
+			size_t vertexStart;
+			size_t vertexCount;
+			size_t indexStart;
+			size_t indexCount;
+		};
+
+		std::vector<PrimitiveRange> ranges;
+		int vertexView = -1;
+		int indexView = -1;
+		uint32_t indexComponentType = 0;
+
+		const JsonValue& primitives = _Mesh["primitives"];
+		const JsonValue& accessors = m_Document.GetRoot()["accessors"];
+
+		MeshBounds bounds;
+		bool hasBounds = true;
+
+		for (size_t i = 0; i < primitives.GetSize(); ++i)
+		{
+			const JsonValue& primitive = primitives[i];
+
+			if (!IsTriangleList(primitive))
+				continue;
+
+			const JsonValue& attributes = primitive["attributes"];
+
+			Accessor position;
+
+			if (!GetAccessor(attributes["POSITION"].GetInt(-1), position))
+				return false;
+
+			PrimitiveRange range;
+			range.vertexCount = position.count;
+
+			// Every attribute of the layout has to be in the same interleaved buffer view at the same offset in the vertex
+			for (const AttributeSemantic& semantic : ATTRIBUTE_SEMANTICS)
+			{
+				VertexAttribute attribute;
+
+				if (!layout.GetAttribute(semantic.location, attribute))
+					continue;
+
+				Accessor accessor;
+
+				if (!GetAccessor(attributes[semantic.name].GetInt(-1), accessor))
+					return false;
+
+				if (attribute.type != RHI_ATTRIBUTE_FLOAT32 || accessor.componentType != GLTF_FLOAT || accessor.componentCount != attribute.componentCount
+					|| accessor.bufferView != position.bufferView || accessor.stride != stride || accessor.count != position.count || accessor.byteOffset < attribute.offset)
+					return false;
+
+				size_t vertexStart = accessor.byteOffset - attribute.offset;
+
+				if (semantic.location == VertexLayout::POSITION_LOCATION)
+					range.vertexStart = vertexStart;
+				else if (vertexStart != range.vertexStart)
+					return false;
+			}
+
+			if (range.vertexStart + range.vertexCount * stride > m_BufferViews[position.bufferView].size)
+				return false;
+
+			// Primitives without indices get generated ones
+			Accessor indices;
+
+			if (!GetAccessor(primitive["indices"].GetInt(-1), indices) || indices.componentCount != 1 || indices.count % 3 != 0
+				|| (indices.componentType != GLTF_UNSIGNED_SHORT && indices.componentType != GLTF_UNSIGNED_INT) || indices.stride != GetComponentSize(indices.componentType))
+				return false;
+
+			if (vertexView < 0)
+			{
+				vertexView = position.bufferView;
+				indexView = indices.bufferView;
+				indexComponentType = indices.componentType;
+			}
+			else if (position.bufferView != vertexView || indices.bufferView != indexView || indices.componentType != indexComponentType)
+			{
+				return false;
+			}
+
+			// Out of range indices would make the GPU read out of the buffer, they are checked without copying them
+			for (size_t index = 0; index < indices.count; ++index)
+			{
+				if (ReadIndex(indices, index) >= range.vertexCount)
+				{
+					DEBUG_WARN("Primitive %u of glTF file %s has out of range indices", static_cast<unsigned int>(i), m_Path.string().c_str());
+					return false;
+				}
+			}
+
+			range.indexStart = indices.byteOffset;
+			range.indexCount = indices.count;
+			ranges.push_back(range);
+
+			// Bounds of the positions are required by the specification
+			const JsonValue& positionAccessor = accessors[static_cast<size_t>(attributes["POSITION"].GetInt())];
+			const JsonValue& minimum = positionAccessor["min"];
+			const JsonValue& maximum = positionAccessor["max"];
+
+			hasBounds = hasBounds && minimum.GetSize() == 3 && maximum.GetSize() == 3;
+
+			for (size_t axis = 0; hasBounds && axis < 3; ++axis)
+			{
+				float axisMinimum = static_cast<float>(minimum[axis].GetNumber());
+				float axisMaximum = static_cast<float>(maximum[axis].GetNumber());
+
+				bounds.min[axis] = ranges.size() == 1 ? axisMinimum : std::min(bounds.min[axis], axisMinimum);
+				bounds.max[axis] = ranges.size() == 1 ? axisMaximum : std::max(bounds.max[axis], axisMaximum);
+			}
+		}
+
+		if (ranges.empty())
+			return false;
+
+		size_t indexSize = GetComponentSize(indexComponentType);
+		size_t vertexBegin = ranges[0].vertexStart;
+		size_t vertexEnd = 0;
+		size_t indexBegin = ranges[0].indexStart;
+		size_t indexEnd = 0;
+
+		for (const PrimitiveRange& range : ranges)
+		{
+			vertexBegin = std::min(vertexBegin, range.vertexStart);
+			vertexEnd = std::max(vertexEnd, range.vertexStart + range.vertexCount * stride);
+			indexBegin = std::min(indexBegin, range.indexStart);
+			indexEnd = std::max(indexEnd, range.indexStart + range.indexCount * indexSize);
+		}
+
+		// The primitives become submeshes of one draw range, their offsets have to be whole vertices and indices
+		for (const PrimitiveRange& range : ranges)
+		{
+			if ((range.vertexStart - vertexBegin) % stride != 0 || (range.indexStart - indexBegin) % indexSize != 0)
+				return false;
+
+			Submesh submesh;
+			submesh.firstIndex = static_cast<uint32_t>((range.indexStart - indexBegin) / indexSize);
+			submesh.indexCount = static_cast<uint32_t>(range.indexCount);
+			submesh.vertexOffset = static_cast<uint32_t>((range.vertexStart - vertexBegin) / stride);
+
+			_Submeshes.push_back(submesh);
+		}
+
+		const BufferView& vertices = m_BufferViews[vertexView];
+		const BufferView& indices = m_BufferViews[indexView];
+
+		_Streams.vertexFormat = _VertexFormat;
+		FlipTextCoords(_Streams.dequantization);
+
+		_Streams.vertexData = vertices.data + vertexBegin;
+		_Streams.vertexDataSize = vertexEnd - vertexBegin;
+		_Streams.vertexCount = static_cast<uint32_t>((vertexEnd - vertexBegin) / stride);
+		_Streams.bounds = hasBounds ? bounds : MeshOptimizer::ComputeBounds(reinterpret_cast<const float*>(_Streams.vertexData), stride, _Streams.vertexCount);
+
+		// 32 bits indices are kept, shrinking them would be a conversion
+		_Streams.indexData = indices.data + indexBegin;
+		_Streams.indexCount = (indexEnd - indexBegin) / indexSize;
+		_Streams.indexType = indexComponentType == GLTF_UNSIGNED_SHORT ? RHI_INDEX_UINT16 : RHI_INDEX_UINT32;
+
+		_Streams.submeshes = _Submeshes.data();
+		_Streams.submeshCount = _Submeshes.size();
+
+		// The clusters keep the order of the triangles in the file, the positions are read in place
+		const float* positions = reinterpret_cast<const float*>(_Streams.vertexData);
+
+		if (_Streams.indexType == RHI_INDEX_UINT16)
+			MeshOptimizer::BuildMeshlets(reinterpret_cast<const uint16_t*>(_Streams.indexData), _Submeshes.data(), _Submeshes.size(), positions, stride, _Meshlets);
+		else
+			MeshOptimizer::BuildMeshlets(reinterpret_cast<const uint32_t*>(_Streams.indexData), _Submeshes.data(), _Submeshes.size(), positions, stride, _Meshlets);
+
+		_Streams.meshlets = _Meshlets.data();
+		_Streams.meshletCount = _Meshlets.size();
+
+		return true;
+	}
+
+	const bool GltfImporter::ConvertStreams(const JsonValue& _Mesh, VertexFormat _VertexFormat, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData,
+		std::vector<uint32_t>& _Indices, std::vector<uint16_t>& _ShortIndices, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const
+	{
+		VertexLayout layout = VertexLayout::Get(_VertexFormat);
+
+		std::vector<Vertex> vertices;
+		const JsonValue& primitives = _Mesh["primitives"];
+
+		for (size_t i = 0; i < primitives.GetSize(); ++i)
+		{
+			const JsonValue& primitive = primitives[i];
+
+			if (!IsTriangleList(primitive))
+			{
+				DEBUG_WARN("Skipping primitive %u of glTF file %s, only triangle lists are supported", static_cast<unsigned int>(i), m_Path.string().c_str());
+				continue;
+			}
+
+			const JsonValue& attributes = primitive["attributes"];
+
+			Accessor position;
+			Accessor color;
+			Accessor textCoord;
+			Accessor normal;
+
+			if (!GetAccessor(attributes["POSITION"].GetInt(-1), position) || position.componentCount != 3)
+			{
+				DEBUG_ERROR("Primitive %u of glTF file %s has no valid positions", static_cast<unsigned int>(i), m_Path.string().c_str());
+				return false;
+			}
+
+			// Missing or mismatched attributes keep the default values
+			bool hasColor = GetAccessor(attributes["COLOR_0"].GetInt(-1), color) && color.count == position.count;
+			bool hasTextCoord = GetAccessor(attributes["TEXCOORD_0"].GetInt(-1), textCoord) && textCoord.count == position.count;
+			bool hasNormal = GetAccessor(attributes["NORMAL"].GetInt(-1), normal) && normal.count == position.count;
+
+			size_t firstVertex = vertices.size();
+			vertices.resize(firstVertex + position.count);
+
+			for (size_t vertexIndex = 0; vertexIndex < position.count; ++vertexIndex)
+			{
+				Vertex& vertex = vertices[firstVertex + vertexIndex];
+
+				vertex.position = { 0.f, 0.f, 0.f };
+				vertex.color = { 1.f, 1.f, 1.f };
+				vertex.textCoord = { 0.f, 0.f };
+				vertex.normal = { 0.f, 0.f, 0.f };
+
+				ReadFloats(position, vertexIndex, &vertex.position.m_X, 3);
+
+				if (hasColor)
+					ReadFloats(color, vertexIndex, &vertex.color.m_X, 3);
+
+				if (hasTextCoord)
+				{
+					float uv[2] = { 0.f, 0.f };
+					ReadFloats(textCoord, vertexIndex, uv, 2);
+
+					vertex.textCoord = { uv[0], 1.f - uv[1] };
+				}
+
+				if (hasNormal)
+					ReadFloats(normal, vertexIndex, &vertex.normal.m_X, 3);
+			}
+
+			Submesh submesh;
+			submesh.firstIndex = static_cast<uint32_t>(_Indices.size());
+			submesh.vertexOffset = static_cast<uint32_t>(firstVertex);
+
+			Accessor indices;
+
+			if (primitive.Find("indices") == nullptr)
+			{
+				for (uint32_t index = 0; index < position.count; ++index)
+					_Indices.push_back(index);
+			}
+			else if (GetAccessor(primitive["indices"].GetInt(-1), indices) && indices.componentCount == 1
+				&& (indices.componentType == GLTF_UNSIGNED_BYTE || indices.componentType == GLTF_UNSIGNED_SHORT || indices.componentType == GLTF_UNSIGNED_INT))
+			{
+				for (size_t index = 0; index < indices.count; ++index)
+				{
+					uint32_t vertexIndex = ReadIndex(indices, index);
+
+					if (vertexIndex >= position.count)
+					{
+						DEBUG_ERROR("Primitive %u of glTF file %s has out of range indices", static_cast<unsigned int>(i), m_Path.string().c_str());
+						return false;
+					}
+
+					_Indices.push_back(vertexIndex);
+				}
+			}
+			else
+			{
+				DEBUG_ERROR("Primitive %u of glTF file %s has invalid indices", static_cast<unsigned int>(i), m_Path.string().c_str());
+				return false;
+			}
+
+			// A truncated last triangle is dropped
+			_Indices.resize(submesh.firstIndex + (_Indices.size() - submesh.firstIndex) / 3 * 3);
+			submesh.indexCount = static_cast<uint32_t>(_Indices.size()) - submesh.firstIndex;
+
+			// The specification asks for computed normals when there are none, they are the sum of the normals of the triangles weighted by their area
+			if (layout.HasNormal() && !hasNormal)
+			{
+				for (size_t index = submesh.firstIndex; index < _Indices.size(); index += 3)
+				{
+					Vertex* corners[3] = {
+						&vertices[firstVertex + _Indices[index + 0]],
+						&vertices[firstVertex + _Indices[index + 1]],
+						&vertices[firstVertex + _Indices[index + 2]]
+					};
+
+					const float* a = &corners[0]->position.m_X;
+					const float* b = &corners[1]->position.m_X;
+					const float* c = &corners[2]->position.m_X;
+
+					float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+					float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+					float faceNormal[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+
+					for (Vertex* corner : corners)
+					{
+						corner->normal.m_X += faceNormal[0];
+						corner->normal.m_Y += faceNormal[1];
+						corner->normal.m_Z += faceNormal[2];
+					}
+				}
+			}
+
+			if (submesh.indexCount > 0)
+				_Submeshes.push_back(submesh);
+		}
+
+		if (_Submeshes.empty())
+		{
+			DEBUG_ERROR("glTF mesh of %s has no triangles", m_Path.string().c_str());
+			return false;
+		}
+
+		_Streams.vertexFormat = _VertexFormat;
+		_Streams.bounds = MeshOptimizer::ComputeBounds(&vertices[0].position.m_X, sizeof(Vertex), vertices.size());
+
+		VertexEncoder::Encode(vertices, layout, _VertexData, _ColorData, _Streams.dequantization);
+
+		_Streams.vertexData = _VertexData.data();
+		_Streams.vertexDataSize = _VertexData.size();
+		_Streams.vertexCount = static_cast<uint32_t>(vertices.size());
+		_Streams.colorData = _ColorData.empty() ? nullptr : _ColorData.data();
+		_Streams.colorDataSize = _ColorData.size();
+
+		// Indices are relative to their primitive, they fit in 16 bits when every primitive has few enough vertices
+		uint32_t maxIndex = *std::max_element(_Indices.begin(), _Indices.end());
+
+		_ShortIndices.clear();
+
+		if (maxIndex <= UINT16_MAX)
+			_ShortIndices.assign(_Indices.begin(), _Indices.end());
+
+		_Streams.indexType = _ShortIndices.empty() ? RHI_INDEX_UINT32 : RHI_INDEX_UINT16;
+		_Streams.indexData = _ShortIndices.empty() ? static_cast<const void*>(_Indices.data()) : static_cast<const void*>(_ShortIndices.data());
+		_Streams.indexCount = _Indices.size();
+
+		_Streams.submeshes = _Submeshes.data();
+		_Streams.submeshCount = _Submeshes.size();
+
+		MeshOptimizer::BuildMeshlets(_Indices.data(), _Submeshes.data(), _Submeshes.size(), &vertices[0].position.m_X, sizeof(Vertex), _Meshlets);
+
+		_Streams.meshlets = _Meshlets.data();
+		_Streams.meshletCount = _Meshlets.size();
+
+		return true;
+	}
+
+	const bool GltfImporter::DecodeMesh(VertexFormat _VertexFormat, size_t _MeshIndex, DecodedMesh& _Decoded, bool* _IsDirect)
+	{
+		std::chrono::high_resolution_clock::time_point decodeStart = std::chrono::high_resolution_clock::now();
+
+		const JsonValue& mesh = m_Document.GetRoot()["meshes"][_MeshIndex];
+
+		if (!mesh.IsObject())
+		{
+			DEBUG_ERROR("glTF file %s has no mesh %u", m_Path.string().c_str(), static_cast<unsigned int>(_MeshIndex));
+			return false;
+		}
+
+		// The buffer views go to the staging memory as they are mapped when their layout is the one of the mesh
+		bool isDirect = GetDirectStreams(mesh, _VertexFormat, _Decoded.submeshes, _Decoded.meshlets, _Decoded.streams);
+
+		if (!isDirect)
+		{
+			_Decoded.streams = MeshStreams();
+			_Decoded.submeshes.clear();
+			_Decoded.meshlets.clear();
+
+			if (!ConvertStreams(mesh, _VertexFormat, _Decoded.vertexData, _Decoded.colorData, _Decoded.indices, _Decoded.shortIndices, _Decoded.submeshes, _Decoded.meshlets, _Decoded.streams))
+				return false;
+		}
+
+		if (_IsDirect != nullptr)
+			*_IsDirect = isDirect;
+
+		std::chrono::duration<double, std::milli> decodeTime = std::chrono::high_resolution_clock::now() - decodeStart;
+
+		DEBUG_LOG("glTF mesh %u of %s decoded in %f ms, %u primitives %s", static_cast<unsigned int>(_MeshIndex), m_Path.filename().string().c_str(), decodeTime.count(),
+			static_cast<unsigned int>(_Decoded.submeshes.size()), isDirect ? "read from the buffer views" : "converted");
+
+		return true;
+	}
+
+	const bool GltfImporter::LoadMesh(IMesh* _Mesh, IDevice* _Device, size_t _MeshIndex, bool* _IsDirect)
+	{
+		DecodedMesh decoded;
+
+		return DecodeMesh(_Mesh->GetVertexFormat(), _MeshIndex, decoded, _IsDirect) && _Mesh->CreateBuffers(_Device, decoded.streams) == RHI_SUCCESS;
+	}
+
+	void GltfImporter::ReadNodeTransform(const JsonValue& _Node, Physics::Transform& _Transform)
+	{
+		// glTF matrices are column major, read row by row they are already transposed
+		const JsonValue& matrix = _Node["matrix"];
+
+		if (matrix.GetSize() == 16)
+		{
+			std::array<float, 16> values;
+
+			for (size_t i = 0; i < 16; ++i)
+				values[i] = static_cast<float>(matrix[i].GetNumber());
+
+			_Transform.m_LocalTRS = Math::Matrix4(values);
+			return;
+		}
+
+		const JsonValue& translation = _Node["translation"];
+		const JsonValue& rotation = _Node["rotation"];
+		const JsonValue& scale = _Node["scale"];
+
+		float t[3] = { 0.f, 0.f, 0.f };
+		float q[4] = { 0.f, 0.f, 0.f, 1.f };
+		float s[3] = { 1.f, 1.f, 1.f };
+
+		for (size_t i = 0; i < 3 && translation.GetSize() == 3; ++i)
+			t[i] = static_cast<float>(translation[i].GetNumber());
+
+		for (size_t i = 0; i < 4 && rotation.GetSize() == 4; ++i)
+			q[i] = static_cast<float>(rotation[i].GetNumber());
+
+		for (size_t i = 0; i < 3 && scale.GetSize() == 3; ++i)
+			s[i] = static_cast<float>(scale[i].GetNumber(1.0));
+
+		// Rotation matrix of the unit quaternion x, y, z, w
+		float r[3][3] = {
+			{ 1.f - 2.f * (q[1] * q[1] + q[2] * q[2]), 2.f * (q[0] * q[1] - q[2] * q[3]), 2.f * (q[0] * q[2] + q[1] * q[3]) },
+			{ 2.f * (q[0] * q[1] + q[2] * q[3]), 1.f - 2.f * (q[0] * q[0] + q[2] * q[2]), 2.f * (q[1] * q[2] - q[0] * q[3]) },
+			{ 2.f * (q[0] * q[2] - q[1] * q[3]), 2.f * (q[1] * q[2] + q[0] * q[3]), 1.f - 2.f * (q[0] * q[0] + q[1] * q[1]) }
+		};
+
+		// Translate * Rotation * Scale written transposed
+		_Transform.m_LocalTRS = Math::Matrix4({
+			r[0][0] * s[0], r[1][0] * s[0], r[2][0] * s[0], 0.f,
+			r[0][1] * s[1], r[1][1] * s[1], r[2][1] * s[1], 0.f,
+			r[0][2] * s[2], r[1][2] * s[2], r[2][2] * s[2], 0.f,
+			t[0], t[1], t[2], 1.f
+			});
+
+		// Euler angles of Matrix4::GlobalRotation, X * Y * Z
+		float yAngle = asinf(std::clamp(r[0][2], -1.f, 1.f));
+		float xAngle = atan2f(-r[1][2], r[2][2]);
+		float zAngle = atan2f(-r[0][1], r[0][0]);
+
+		_Transform.SetPosition(Math::Vector3(t[0], t[1], t[2]));
+		_Transform.SetRotation(Math::Vector3(xAngle, yAngle, zAngle));
+		_Transform.SetScale(Math::Vector3(s[0], s[1], s[2]));
+	}
+
+	const bool GltfImporter::ImportScene(IRendererHardware* _RHI, IDevice* _Device, VertexFormat _VertexFormat, GltfScene& _Scene)
+	{
+		_Scene.Unload(_RHI, _Device);
+
+		for (size_t i = 0; i < GetMeshCount(); ++i)
+		{
+			IMesh* mesh = _RHI->CreateMesh();
+			mesh->SetVertexFormat(_VertexFormat);
+
+			// The nodes using a mesh that failed to load draw nothing
+			if (!LoadMesh(mesh, _Device, i))
+			{
+				_RHI->DestroyMesh(mesh);
+				mesh = nullptr;
+			}
+
+			_Scene.m_Meshes.push_back(mesh);
+		}
+
+		const JsonValue& nodes = m_Document.GetRoot()["nodes"];
+
+		// Sized once, the transforms point to the transforms of their parents
+		_Scene.m_Nodes.resize(nodes.GetSize());
+
+		for (size_t i = 0; i < nodes.GetSize(); ++i)
+		{
+			const JsonValue& node = nodes[i];
+			GltfNode& sceneNode = _Scene.m_Nodes[i];
+
+			sceneNode.name = node["name"].GetString();
+
+			int meshIndex = node["mesh"].GetInt(-1);
+
+			if (meshIndex >= 0 && static_cast<size_t>(meshIndex) < _Scene.m_Meshes.size())
+				sceneNode.mesh = _Scene.m_Meshes[meshIndex];
+
+			ReadNodeTransform(node, sceneNode.transform);
+
+			const JsonValue& children = node["children"];
+
+			for (size_t child = 0; child < children.GetSize(); ++child)
+			{
+				int childIndex = children[child].GetInt(-1);
+
+				if (childIndex < 0 || static_cast<size_t>(childIndex) >= nodes.GetSize() || static_cast<size_t>(childIndex) == i || _Scene.m_Nodes[childIndex].parent >= 0)
+				{
+					DEBUG_ERROR("Invalid child %i of node %u in glTF file %s", childIndex, static_cast<unsigned int>(i), m_Path.string().c_str());
+					_Scene.Unload(_RHI, _Device);
+					return false;
+				}
+
+				_Scene.m_Nodes[childIndex].parent = static_cast<int>(i);
+			}
+		}
+
+		for (size_t i = 0; i < _Scene.m_Nodes.size(); ++i)
+		{
+			// A hierarchy deeper than the number of nodes loops
+			size_t depth = 0;
+
+			for (int parent = _Scene.m_Nodes[i].parent; parent >= 0 && depth <= _Scene.m_Nodes.size(); parent = _Scene.m_Nodes[parent].parent)
+				++depth;
+
+			if (depth > _Scene.m_Nodes.size())
+			{
+				DEBUG_ERROR("Node hierarchy of glTF file %s has a cycle", m_Path.string().c_str());
+				_Scene.Unload(_RHI, _Device);
+				return false;
+			}
+
+			if (_Scene.m_Nodes[i].parent >= 0)
+				_Scene.m_Nodes[i].transform.SetParent(&_Scene.m_Nodes[_Scene.m_Nodes[i].parent].transform);
+		}
+
+		return true;
+	}
+
+	// Appends a number to the JSON of a written file, floats keep all their digits
+	static void AppendNumber(std::string& _Json, double _Number)
+	{
+		char number[32];
+		snprintf(number, sizeof(number), "%.9g", _Number);
+
+		_Json += number;
+	}
+
+	static void AppendVector(std::string& _Json, const float* _Values, size_t _Count)
+	{
+		_Json += '[';
+
+		for (size_t i = 0; i < _Count; ++i)
+		{
+			if (i > 0)
+				_Json += ',';
+
+			AppendNumber(_Json, _Values[i]);
+		}
+
+		_Json += ']';
+	}
+
+	const bool GltfImporter::WriteGlb(const std::filesystem::path& _Path, const MeshStreams& _Streams)
+	{
+		if (_Streams.vertexFormat != RHI_VERTEX_FORMAT_DEFAULT)
+		{
+			DEBUG_WARN("Only meshes in the default vertex format can be written as GLB: %s", _Path.string().c_str());
+			return false;
+		}
+
+		VertexLayout layout = VertexLayout::Get(_Streams.vertexFormat);
+		uint32_t stride = layout.GetStride();
+		size_t indexSize = _Streams.indexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+		VertexAttribute positionAttribute;
+		VertexAttribute colorAttribute;
+		VertexAttribute textCoordAttribute;
+
+		layout.GetAttribute(VertexLayout::POSITION_LOCATION, positionAttribute);
+		layout.GetAttribute(VertexLayout::COLOR_LOCATION, colorAttribute);
+		layout.GetAttribute(VertexLayout::TEXTCOORD_LOCATION, textCoordAttribute);
+
+		// Vertices then indices, each 4 bytes aligned
+		size_t vertexSize = (_Streams.vertexDataSize + 3) & ~static_cast<size_t>(3);
+		size_t indexDataSize = _Streams.indexCount * indexSize;
+		std::vector<unsigned char> binary(vertexSize + ((indexDataSize + 3) & ~static_cast<size_t>(3)), 0);
+
+		memcpy(binary.data(), _Streams.vertexData, _Streams.vertexDataSize);
+		memcpy(binary.data() + vertexSize, _Streams.indexData, indexDataSize);
+
+		// glTF texture coordinates start at the top
+		for (size_t vertex = 0; vertex < _Streams.vertexCount; ++vertex)
+		{
+			float v;
+			unsigned char* textCoord = binary.data() + vertex * stride + textCoordAttribute.offset + sizeof(float);
+
+			memcpy(&v, textCoord, sizeof(float));
+			v = 1.f - v;
+			memcpy(textCoord, &v, sizeof(float));
+		}
+
+		std::string accessors;
+		std::string primitives;
+
+		for (size_t i = 0; i < _Streams.submeshCount; ++i)
+		{
+			const Submesh& submesh = _Streams.submeshes[i];
+
+			// Vertices of the submesh are the ones its indices reach
+			uint32_t vertexCount = 0;
+
+			for (uint32_t index = 0; index < submesh.indexCount; ++index)
+			{
+				size_t element = submesh.firstIndex + index;
+				uint32_t vertexIndex = indexSize == sizeof(uint16_t) ? static_cast<const uint16_t*>(_Streams.indexData)[element] : static_cast<const uint32_t*>(_Streams.indexData)[element];
+
+				vertexCount = std::max(vertexCount, vertexIndex + 1);
+			}
+
+			const float* positions = reinterpret_cast<const float*>(static_cast<const unsigned char*>(_Streams.vertexData) + static_cast<size_t>(submesh.vertexOffset) * stride);
+			MeshBounds bounds = MeshOptimizer::ComputeBounds(positions, stride, vertexCount);
+
+			size_t vertexStart = static_cast<size_t>(submesh.vertexOffset) * stride;
+			size_t firstAccessor = 4 * i;
+
+			auto appendAccessor = [&accessors](size_t _BufferView, size_t _ByteOffset, uint32_t _ComponentType, size_t _Count, const char* _Type)
+				{
+					if (!accessors.empty())
+						accessors += ',';
+
+					accessors += "{\"bufferView\":" + std::to_string(_BufferView) + ",\"byteOffset\":" + std::to_string(_ByteOffset) + ",\"componentType\":" + std::to_string(_ComponentType)
+						+ ",\"count\":" + std::to_string(_Count) + ",\"type\":\"" + _Type + "\"";
+				};
+
+			appendAccessor(0, vertexStart + positionAttribute.offset, GLTF_FLOAT, vertexCount, "VEC3");
+			accessors += ",\"min\":";
+			AppendVector(accessors, bounds.min, 3);
+			accessors += ",\"max\":";
+			AppendVector(accessors, bounds.max, 3);
+			accessors += '}';
+
+			appendAccessor(0, vertexStart + colorAttribute.offset, GLTF_FLOAT, vertexCount, "VEC3");
+			accessors += '}';
+			appendAccessor(0, vertexStart + textCoordAttribute.offset, GLTF_FLOAT, vertexCount, "VEC2");
+			accessors += '}';
+			appendAccessor(1, submesh.firstIndex * indexSize, indexSize == sizeof(uint16_t) ? GLTF_UNSIGNED_SHORT : GLTF_UNSIGNED_INT, submesh.indexCount, "SCALAR");
+			accessors += '}';
+
+			if (!primitives.empty())
+				primitives += ',';
+
+			primitives += "{\"attributes\":{\"POSITION\":" + std::to_string(firstAccessor) + ",\"COLOR_0\":" + std::to_string(firstAccessor + 1)
+				+ ",\"TEXCOORD_0\":" + std::to_string(firstAccessor + 2) + "},\"indices\":" + std::to_string(firstAccessor + 3) + "}";
+		}
+
+		std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"VulkanRenderer\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],";
+		json += "\"meshes\":[{\"primitives\":[" + primitives + "]}],";
+		json += "\"accessors\":[" + accessors + "],";
+		json += "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" + std::to_string(_Streams.vertexDataSize) + ",\"byteStride\":" + std::to_string(stride) + ",\"target\":34962},";
+		json += "{\"buffer\":0,\"byteOffset\":" + std::to_string(vertexSize) + ",\"byteLength\":" + std::to_string(indexDataSize) + ",\"target\":34963}],";
+		json += "\"buffers\":[{\"byteLength\":" + std::to_string(binary.size()) + "}]}";
+
+		// The JSON chunk is padded with spaces
+		json.resize((json.size() + 3) & ~static_cast<size_t>(3), ' ');
+
+		uint32_t header[3] = { GLB_MAGIC_NUMBER, 2, static_cast<uint32_t>(GLB_HEADER_SIZE + 2 * GLB_CHUNK_HEADER_SIZE + json.size() + binary.size()) };
+		uint32_t jsonChunk[2] = { static_cast<uint32_t>(json.size()), GLB_JSON_CHUNK };
+		uint32_t binaryChunk[2] = { static_cast<uint32_t>(binary.size()), GLB_BIN_CHUNK };
+
+		std::ofstream stream(_Path, std::ios::binary | std::ios::trunc);
+
+		stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(jsonChunk), sizeof(jsonChunk));
+		stream.write(json.data(), json.size());
+		stream.write(reinterpret_cast<const char*>(binaryChunk), sizeof(binaryChunk));
+		stream.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+
+		if (!stream)
+		{
+			DEBUG_WARN("Failed to write GLB file %s", _Path.string().c_str());
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -1,57 +1,431 @@
 #include "IMesh.h"
 
-//#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
-
 #include "RHI/Vertex.h"
+#include "MeshOptimizer.h"
+#include "MeshCache.h"
+#include "ObjParser.h"
+#include "GltfImporter.h"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <unordered_map>
 
 namespace Core
 {
+	// OBJ indices of a corner, the corners with the same key become one vertex
+	struct WeldKey
+	{
+		int position;
+		int textCoord;
+		int normal;
+
+		bool operator==(const WeldKey& _Other) const { return position == _Other.position && textCoord == _Other.textCoord && normal == _Other.normal; }
+	};
+
+	struct WeldKeyHash
+	{
+		size_t operator()(const WeldKey& _Key) const
+		{
+			uint64_t hash = static_cast<uint32_t>(_Key.position);
+			hash = hash * 0x9E3779B97F4A7C15ULL ^ static_cast<uint32_t>(_Key.textCoord);
+			hash = hash * 0x9E3779B97F4A7C15ULL ^ static_cast<uint32_t>(_Key.normal);
+
+			return static_cast<size_t>(hash ^ (hash >> 32));
+		}
+	};
+
+	DecodedMesh::DecodedMesh() = default;
+
+	// The importer is only complete here
+	DecodedMesh::~DecodedMesh() = default;
+
 	const bool IMesh::Load(Core::IDevice* _Device, std::filesystem::path _ResourcePath)
 	{
-		tinyobj::attrib_t attrib;
-		std::vector<tinyobj::shape_t> shapes;
-		std::vector<tinyobj::material_t> materials;
-		std::string warn, error;
+		DecodedMesh decoded;
+
+		return Decode(_ResourcePath, decoded) && Upload(_Device, decoded);
+	}
+
+	const bool IMesh::Decode(const std::filesystem::path& _ResourcePath, DecodedMesh& _Decoded) const
+	{
+		// glTF buffers are already binary, they are mapped instead of cached
+		std::filesystem::path extension = _ResourcePath.extension();
+
+		if (extension == ".glb" || extension == ".gltf")
+		{
+			_Decoded.importer = std::make_unique<GltfImporter>();
+
+			return _Decoded.importer->Open(_ResourcePath) && _Decoded.importer->DecodeMesh(p_VertexFormat, 0, _Decoded);
+		}
+
+		std::chrono::high_resolution_clock::time_point decodeStart = std::chrono::high_resolution_clock::now();
+
+		// The streams point in the mapped entry, they are copied to the staging memory as they are uploaded
+		if (_Decoded.cache.Open(_ResourcePath, p_VertexFormat, _Decoded.streams))
+		{
+			std::chrono::duration<double, std::milli> decodeTime = std::chrono::high_resolution_clock::now() - decodeStart;
+
+			DEBUG_LOG("Mesh %s read from the cache in %f ms, the import took %f ms", _ResourcePath.filename().string().c_str(), decodeTime.count(), _Decoded.streams.importTime);
+
+			return true;
+		}
+
+		if (!Import(_ResourcePath, _Decoded.vertexData, _Decoded.colorData, _Decoded.indices, _Decoded.shortIndices, _Decoded.submeshes, _Decoded.meshlets, _Decoded.streams))
+			return false;
+
+		// Measured up to the same point as a cached read
+		std::chrono::duration<double, std::milli> importTime = std::chrono::high_resolution_clock::now() - decodeStart;
+		_Decoded.streams.importTime = importTime.count();
+
+		MeshCache::Store(_ResourcePath, _Decoded.streams);
+
+		return true;
+	}
+
+	const bool IMesh::Upload(Core::IDevice* _Device, const DecodedMesh& _Decoded)
+	{
+		return CreateBuffers(_Device, _Decoded.streams) == RHI_SUCCESS;
+	}
+
+	const bool IMesh::Import(const std::filesystem::path& _ResourcePath, std::vector<uint8_t>& _VertexData, std::vector<uint8_t>& _ColorData, std::vector<uint32_t>& _Indices,
+		std::vector<uint16_t>& _ShortIndices, std::vector<Submesh>& _Submeshes, std::vector<Meshlet>& _Meshlets, MeshStreams& _Streams) const
+	{
+		std::chrono::high_resolution_clock::time_point importStart = std::chrono::high_resolution_clock::now();
+
+		ObjData objData;
+
+		// Chunks of the file are parsed on the thread pool, tinyobjloader triangulates the polygons the parser does not split
+		ObjParseResult parseResult = ObjParser::Parse(_ResourcePath, objData, Renderer::GetThreadPool());
+
+		if (parseResult == OBJ_PARSE_ERROR || (parseResult == OBJ_PARSE_UNSUPPORTED_POLYGON && !ObjParser::ParseReference(_ResourcePath, objData)))
+		{
+			DEBUG_ERROR("Failed to load model %s", _ResourcePath.string().c_str());
+			return false;
+		}
+
+		std::chrono::duration<double, std::milli> parseTime = std::chrono::high_resolution_clock::now() - importStart;
+
+		const std::vector<float>& positions = objData.positions;
+		const std::vector<float>& textCoords = objData.textCoords;
+		const std::vector<float>& normals = objData.normals;
 
 		std::vector<Core::Vertex> vertices;
-		std::vector<uint32_t> indices;
+		std::vector<uint32_t>& indices = _Indices;
+
+		size_t indexCount = objData.indices.size();
 
-		if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &error, _ResourcePath.string().c_str()))
+		indices.reserve(indexCount);
+
+		// Most corners share an attribute with another one, the vertices are about as many as the positions or the texture coordinates
+		size_t vertexEstimate = std::max(positions.size() / 3, textCoords.size() / 2);
+		vertices.reserve(vertexEstimate);
+
+		VertexLayout layout = VertexLayout::Get(p_VertexFormat);
+		uint32_t vertexStride = layout.GetStride() + layout.GetColorStride();
+
+		// Normals split the vertices on hard edges, they are only part of the key when the layout stores them
+		bool isNormalUsed = layout.HasNormal();
+		std::vector<uint8_t> isNormalMissing;
+		// Position and texture coordinate of every vertex, counts the vertices the default format would weld to
+		std::vector<uint64_t> defaultKeys;
+
+		if (isNormalUsed)
 		{
-			DEBUG_ERROR("Failed to load model!");
+			isNormalMissing.reserve(vertexEstimate);
+			defaultKeys.reserve(vertexEstimate);
 		}
 
-		for (const tinyobj::shape_t& shape : shapes)
+		// Corners sharing the same position, texture coordinate and normal are emitted once
+		std::unordered_map<WeldKey, uint32_t, WeldKeyHash> uniqueVertices;
+		uniqueVertices.reserve(indexCount);
+
+		for (const ObjIndex& index : objData.indices)
 		{
-			for (const tinyobj::index_t& index : shape.mesh.indices)
+			WeldKey key = { index.position, index.textCoord, isNormalUsed ? index.normal : -1 };
+
+			auto [uniqueVertex, isInserted] = uniqueVertices.try_emplace(key, static_cast<uint32_t>(vertices.size()));
+
+			if (isInserted)
 			{
 				Core::Vertex vertex{};
 
 				vertex.position = {
-					attrib.vertices[3 * index.vertex_index + 0],
-					attrib.vertices[3 * index.vertex_index + 1],
-					attrib.vertices[3 * index.vertex_index + 2]
+					positions[3 * index.position + 0],
+					positions[3 * index.position + 1],
+					positions[3 * index.position + 2]
 				};
 
-				vertex.textCoord = {
-					attrib.texcoords[2 * index.texcoord_index + 0],
-					attrib.texcoords[2 * index.texcoord_index + 1]
-				};
+				// Faces without texture coordinates have a negative index
+				if (index.textCoord >= 0)
+				{
+					vertex.textCoord = {
+						textCoords[2 * index.textCoord + 0],
+						textCoords[2 * index.textCoord + 1]
+					};
+				}
 
 				vertex.color = { 1.f, 1.f, 1.f };
 
+				if (isNormalUsed)
+				{
+					if (index.normal >= 0)
+					{
+						vertex.normal = {
+							normals[3 * index.normal + 0],
+							normals[3 * index.normal + 1],
+							normals[3 * index.normal + 2]
+						};
+					}
+
+					isNormalMissing.push_back(index.normal < 0);
+					defaultKeys.push_back((static_cast<uint64_t>(static_cast<uint32_t>(index.position)) << 32) | static_cast<uint32_t>(index.textCoord));
+				}
+
 				vertices.push_back(vertex);
-				indices.push_back(static_cast<uint32_t>(indices.size()));
 			}
+
+			indices.push_back(uniqueVertex->second);
+		}
+
+		// Vertices without normal get the sum of the normals of their triangles weighted by their area, the encoder only keeps the direction
+		if (std::find(isNormalMissing.begin(), isNormalMissing.end(), 1) != isNormalMissing.end())
+		{
+			for (size_t i = 0; i + 2 < indices.size(); i += 3)
+			{
+				const float* a = &vertices[indices[i + 0]].position.m_X;
+				const float* b = &vertices[indices[i + 1]].position.m_X;
+				const float* c = &vertices[indices[i + 2]].position.m_X;
+
+				float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+				float faceNormal[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					uint32_t vertexIndex = indices[i + corner];
+
+					if (!isNormalMissing[vertexIndex])
+						continue;
+
+					vertices[vertexIndex].normal.m_X += faceNormal[0];
+					vertices[vertexIndex].normal.m_Y += faceNormal[1];
+					vertices[vertexIndex].normal.m_Z += faceNormal[2];
+				}
+			}
+		}
+
+		if (indices.empty())
+		{
+			DEBUG_ERROR("Mesh %s has no triangles", _ResourcePath.string().c_str());
+			return false;
 		}
 
-		CreateVertexBuffer(_Device, vertices);
-		CreateIndexBuffer(_Device, indices);
+#ifdef MESH_OPTIMIZATION_STATISTICS
+		VertexCacheStatistics cacheBefore = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+		VertexFetchStatistics fetchBefore = MeshOptimizer::AnalyzeVertexFetch(indices, vertices.size(), vertexStride);
+#endif
+
+		std::chrono::high_resolution_clock::time_point optimizationStart = std::chrono::high_resolution_clock::now();
+
+		std::vector<uint32_t> remap;
+		MeshOptimizer::OptimizeMesh(indices, &vertices[0].position.m_X, sizeof(Core::Vertex), vertices.size(), vertexStride, OVERDRAW_CACHE_THRESHOLD, remap);
+
+		MeshOptimizer::RemapVertices(vertices, remap);
+
+		std::chrono::high_resolution_clock::time_point importEnd = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double, std::milli> importTime = importEnd - importStart;
+		std::chrono::duration<double, std::milli> optimizationTime = importEnd - optimizationStart;
+
+#ifdef MESH_OPTIMIZATION_STATISTICS
+		VertexCacheStatistics cacheAfter = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+		VertexFetchStatistics fetchAfter = MeshOptimizer::AnalyzeVertexFetch(indices, vertices.size(), vertexStride);
+
+		DEBUG_LOG("Mesh %s ACMR %f -> %f, ATVR %f -> %f, overfetch %f -> %f", _ResourcePath.filename().string().c_str(), cacheBefore.acmr, cacheAfter.acmr,
+			cacheBefore.atvr, cacheAfter.atvr, fetchBefore.overfetch, fetchAfter.overfetch);
+
+		// Bytes read by the vertex fetches of one draw compared to the same draw in the default format
+		VertexFetchStatistics fetchDefault = MeshOptimizer::AnalyzeVertexFetch(indices, vertices.size(), VertexLayout::Get(RHI_VERTEX_FORMAT_DEFAULT).GetStride());
+
+		DEBUG_LOG("Mesh %s fetches %u KB per draw, %u KB in the default vertex format", _ResourcePath.filename().string().c_str(),
+			fetchAfter.bytesFetched / 1024, fetchDefault.bytesFetched / 1024);
+#endif
+
+		// Indices of meshes with fewer vertices fit in 16 bits, bigger meshes are split when the vertices duplicated cost less than the halved indices
+		std::vector<Submesh>& submeshes = _Submeshes;
+		size_t duplicatedVertexCount = 0;
+
+		if (vertices.size() > MAX_SHORT_INDEX_VERTEX_COUNT)
+		{
+			std::vector<uint32_t> splitIndices = indices;
+			std::vector<uint32_t> vertexSources;
+
+			MeshOptimizer::SplitSubmeshes(splitIndices, vertices.size(), vertexSources, submeshes, MAX_SHORT_INDEX_VERTEX_COUNT);
+
+			size_t duplicatedSize = (vertexSources.size() - vertices.size()) * vertexStride;
+			size_t savedSize = indices.size() * (sizeof(uint32_t) - sizeof(uint16_t));
+
+			if (duplicatedSize < savedSize)
+			{
+				duplicatedVertexCount = vertexSources.size() - vertices.size();
+
+				indices.swap(splitIndices);
+				MeshOptimizer::GatherVertices(vertices, vertexSources);
+			}
+			else
+			{
+				submeshes.clear();
+			}
+		}
+
+		// Without welding every index had its own vertex
+		size_t weldedSize = vertices.size() * vertexStride + indices.size() * sizeof(uint32_t);
+		size_t unweldedSize = indices.size() * (vertexStride + sizeof(uint32_t));
+
+		DEBUG_LOG("Mesh %s imported in %f ms (%f ms of parsing, %f ms of optimization), %u vertices welded to %u, %u KB instead of %u KB", _ResourcePath.filename().string().c_str(), importTime.count(),
+			parseTime.count(), optimizationTime.count(),
+			static_cast<unsigned int>(indices.size()), static_cast<unsigned int>(vertices.size()), static_cast<unsigned int>(weldedSize / 1024), static_cast<unsigned int>(unweldedSize / 1024));
+
+		VertexEncodingStatistics encodingStatistics;
+
+		_Streams.vertexFormat = p_VertexFormat;
+		_Streams.bounds = MeshOptimizer::ComputeBounds(&vertices[0].position.m_X, sizeof(Core::Vertex), vertices.size());
+
+		VertexEncoder::Encode(vertices, layout, _VertexData, _ColorData, _Streams.dequantization, &encodingStatistics);
+
+		_Streams.vertexData = _VertexData.data();
+		_Streams.vertexDataSize = _VertexData.size();
+		_Streams.vertexCount = static_cast<uint32_t>(vertices.size());
+		_Streams.colorData = _ColorData.empty() ? nullptr : _ColorData.data();
+		_Streams.colorDataSize = _ColorData.size();
+
+		if (submeshes.empty())
+		{
+			Submesh submesh;
+			submesh.indexCount = static_cast<uint32_t>(indices.size());
+
+			submeshes.push_back(submesh);
+		}
+
+		// Clusters follow the order of the triangles optimized for the vertex cache, so their vertices are close to each other
+		MeshOptimizer::BuildMeshlets(indices.data(), submeshes.data(), submeshes.size(), &vertices[0].position.m_X, sizeof(Core::Vertex), _Meshlets);
+
+		_Streams.indexType = ShrinkIndices(indices, _ShortIndices);
+		_Streams.indexData = _Streams.indexType == RHI_INDEX_UINT16 ? static_cast<const void*>(_ShortIndices.data()) : static_cast<const void*>(indices.data());
+		_Streams.indexCount = indices.size();
+		_Streams.submeshes = submeshes.data();
+		_Streams.submeshCount = submeshes.size();
+		_Streams.meshlets = _Meshlets.data();
+		_Streams.meshletCount = _Meshlets.size();
+		_Streams.duplicatedVertexCount = static_cast<uint32_t>(duplicatedVertexCount);
+
+		DEBUG_LOG("Mesh %s indices in %u bits, %u submeshes, %u meshlets, %u vertices duplicated", _ResourcePath.filename().string().c_str(), _Streams.indexType == RHI_INDEX_UINT16 ? 16u : 32u,
+			static_cast<unsigned int>(submeshes.size()), static_cast<unsigned int>(_Meshlets.size()), static_cast<unsigned int>(duplicatedVertexCount));
+
+		if (p_VertexFormat != RHI_VERTEX_FORMAT_DEFAULT)
+		{
+			uint32_t defaultStride = VertexLayout::Get(RHI_VERTEX_FORMAT_DEFAULT).GetStride();
+			size_t defaultVertexCount = vertices.size();
+
+			// The normals split vertices the default format shares
+			if (isNormalUsed)
+			{
+				std::sort(defaultKeys.begin(), defaultKeys.end());
+				defaultVertexCount = std::unique(defaultKeys.begin(), defaultKeys.end()) - defaultKeys.begin();
+			}
+
+			DEBUG_LOG("Mesh %s vertices take %u KB (%u of %u bytes), %u KB in the default format (%u of %u bytes), max errors: position %f, texture coordinate %f, normal %f degrees, color %f",
+				_ResourcePath.filename().string().c_str(), static_cast<unsigned int>(vertices.size() * vertexStride / 1024), static_cast<unsigned int>(vertices.size()), vertexStride,
+				static_cast<unsigned int>(defaultVertexCount * defaultStride / 1024), static_cast<unsigned int>(defaultVertexCount), defaultStride,
+				encodingStatistics.maxPositionError, encodingStatistics.maxTextCoordError, encodingStatistics.maxNormalError, encodingStatistics.maxColorError);
+		}
 
 		return true;
 	}
 
+	RHI_RESULT IMesh::CreateBuffers(Core::IDevice* _Device, const MeshStreams& _Streams)
+	{
+		p_Dequantization = _Streams.dequantization;
+		p_Bounds = _Streams.bounds;
+		p_Submeshes.assign(_Streams.submeshes, _Streams.submeshes + _Streams.submeshCount);
+		p_Meshlets.assign(_Streams.meshlets, _Streams.meshlets + _Streams.meshletCount);
+		p_IndexType = _Streams.indexType;
+		p_VertexMemorySize = _Streams.vertexDataSize + _Streams.colorDataSize;
+		p_IndexMemorySize = _Streams.indexCount * (p_IndexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t));
+
+		VertexLayout layout = VertexLayout::Get(_Streams.vertexFormat);
+
+		if (p_IndexType == RHI_INDEX_UINT16)
+			p_SavedIndexMemory += static_cast<long long>(_Streams.indexCount * (sizeof(uint32_t) - sizeof(uint16_t)));
+
+		p_SavedIndexMemory -= static_cast<long long>(_Streams.duplicatedVertexCount) * (layout.GetStride() + layout.GetColorStride());
+
+		RHI_RESULT result = CreateVertexStreams(_Device, _Streams.vertexData, _Streams.vertexDataSize, _Streams.colorData, _Streams.colorDataSize);
+
+		if (result != RHI_SUCCESS)
+			return result;
+
+		return CreateIndexStream(_Device, _Streams.indexData, _Streams.indexCount, _Streams.indexType);
+	}
+
+	RHI_RESULT IMesh::CreateVertexBuffer(Core::IDevice* _Device, const std::vector<Vertex>& _VerticesList, VertexEncodingStatistics* _Statistics)
+	{
+		std::vector<uint8_t> vertexData;
+		std::vector<uint8_t> colorData;
+
+		VertexEncoder::Encode(_VerticesList, VertexLayout::Get(p_VertexFormat), vertexData, colorData, p_Dequantization, _Statistics);
+
+		p_Bounds = MeshOptimizer::ComputeBounds(&_VerticesList[0].position.m_X, sizeof(Vertex), _VerticesList.size());
+		p_VertexMemorySize = vertexData.size() + colorData.size();
+
+		return CreateVertexStreams(_Device, vertexData.data(), vertexData.size(), colorData.empty() ? nullptr : colorData.data(), colorData.size());
+	}
+
+	RHI_RESULT IMesh::CreateIndexBuffer(Core::IDevice* _Device, const std::vector<uint32_t>& _IndicesList, const std::vector<Submesh>& _Submeshes)
+	{
+		p_Submeshes = _Submeshes;
+		p_Meshlets.clear();
+
+		if (p_Submeshes.empty())
+		{
+			Submesh submesh;
+			submesh.indexCount = static_cast<uint32_t>(_IndicesList.size());
+
+			p_Submeshes.push_back(submesh);
+		}
+
+		std::vector<uint16_t> shortIndices;
+		p_IndexType = ShrinkIndices(_IndicesList, shortIndices);
+		p_IndexMemorySize = _IndicesList.size() * (p_IndexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t));
+
+		if (p_IndexType == RHI_INDEX_UINT32)
+			return CreateIndexStream(_Device, _IndicesList.data(), _IndicesList.size(), p_IndexType);
+
+		p_SavedIndexMemory += static_cast<long long>(_IndicesList.size() * (sizeof(uint32_t) - sizeof(uint16_t)));
+
+		return CreateIndexStream(_Device, shortIndices.data(), shortIndices.size(), p_IndexType);
+	}
+
+	IndexType IMesh::ShrinkIndices(const std::vector<uint32_t>& _Indices, std::vector<uint16_t>& _ShortIndices)
+	{
+		// Indices of a split mesh are relative to their submesh
+		uint32_t maxIndex = 0;
+
+		for (uint32_t index : _Indices)
+			maxIndex = std::max(maxIndex, index);
+
+		_ShortIndices.clear();
+
+		if (maxIndex > UINT16_MAX)
+			return RHI_INDEX_UINT32;
+
+		_ShortIndices.resize(_Indices.size());
+
+		for (size_t i = 0; i < _Indices.size(); ++i)
+			_ShortIndices[i] = static_cast<uint16_t>(_Indices[i]);
+
+		return RHI_INDEX_UINT16;
+	}
+
 	const bool IMesh::Unload(Core::IDevice* _Device)
 	{
 		DestroyBuffers(_Device);
@@ -1,60 +1,101 @@
 #include "IShader.h"
 
 #include "Renderer.h"
+#include "RHI/ShaderArchive.h"
 
 namespace Core
 {
 	const bool IShader::Load(Core::IDevice* _Device, std::filesystem::path _ResourcePath)
 	{
-		const char* ext = _ResourcePath.extension().string().c_str();
-		const char* name = _ResourcePath.filename().string().c_str();
+		// Kept alive for the whole load, the compiler uses the name in its messages
+		std::string name = _ResourcePath.filename().string();
 
 		Core::ShaderType type;
 
+		if (!GetShaderType(_ResourcePath, type))
+			return false;
+
+		if (LoadFromArchive(_Device, name))
+			return true;
+
+#ifdef SHADER_RUNTIME_COMPILATION
+		p_SourcePath = _ResourcePath;
+
+		std::string shaderCode = "";
+
+		if (!ReadShaderSource(_ResourcePath, shaderCode))
+			return false;
+
+		return CompileShader(_Device, name.c_str(), shaderCode, type);
+#else
+		DEBUG_ERROR("Shader %s is not in the shader archive, bake the shaders again", name.c_str());
+		return false;
+#endif
+	}
+
+	const bool IShader::Unload(Core::IDevice* _Device)
+	{
+		DestroyShaderModule(_Device);
+		return false;
+	}
+
+	const bool IShader::LoadFromArchive(Core::IDevice* _Device, const std::string& _Name)
+	{
+		ShaderArchive* archive = ShaderArchive::GetMainArchive();
+
+		if (archive == nullptr)
+			return false;
+
+		const ShaderArchiveEntry* entry = archive->Find(ShaderArchive::ComputeKey(_Name, p_MacroDefinitions));
+
+		if (entry == nullptr)
+			return false;
+
+		// Nothing is parsed, the reflection was read by the baker
+		archive->GetReflection(*entry, p_Reflection);
+		p_CodeHash = entry->key;
+		p_Dependencies.clear();
+
+		return CreateFromSpirV(_Device, archive->GetSpirV(*entry), entry->spirVWordCount);
+	}
+
+	const bool IShader::GetShaderType(const std::filesystem::path& _ResourcePath, Core::ShaderType& _ShaderType)
+	{
 		// Checks shader extension
-		// TODO: add frag verification
 		if (_ResourcePath.extension() == ".vert")
 		{
-			type = Core::ShaderType::RHI_VERTEX;
+			_ShaderType = Core::ShaderType::RHI_VERTEX;
 		}
 		else if (_ResourcePath.extension() == ".frag")
 		{
-			type = Core::ShaderType::RHI_FRAGMENT;
+			_ShaderType = Core::ShaderType::RHI_FRAGMENT;
 		}
 		else if (_ResourcePath.extension() == ".geo")
 		{
-			type = Core::ShaderType::RHI_GEOMETRY;
+			_ShaderType = Core::ShaderType::RHI_GEOMETRY;
 		}
 		else
 		{
-			DEBUG_ERROR("Cannot load shader due to unsuported extension: %s", ext);
+			DEBUG_ERROR("Cannot load shader due to unsuported extension: %s", _ResourcePath.extension().string().c_str());
 			return false;
 		}
 
-		std::ifstream shaderFile(_ResourcePath);
-		std::string line = "";
-		std::string shaderCode = "";
+		return true;
+	}
+
+	const bool IShader::ReadShaderSource(const std::filesystem::path& _ResourcePath, std::string& _ShaderCode)
+	{
+		std::shared_ptr<const SourceFile> shaderFile = SourceFileCache::Read(_ResourcePath);
 
 		// Checks if the shader has been openned
-		if (!shaderFile.is_open())
+		if (shaderFile == nullptr)
 		{
 			DEBUG_ERROR("Failed to open shader file: %s", _ResourcePath.string().c_str());
+			return false;
 		}
 
-		// Reads the shader
-		while (std::getline(shaderFile, line))
-			shaderCode += line + "\n";
-
-		shaderFile.close();
-
-		CompileShader(_Device, name, shaderCode, type);
+		_ShaderCode = shaderFile->content;
 
 		return true;
 	}
-
-	const bool IShader::Unload(Core::IDevice* _Device)
-	{
-		DestroyShaderModule(_Device);
-		return false;
-	}
 }
\ No newline at end of file
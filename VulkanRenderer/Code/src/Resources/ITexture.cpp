@@ -8,24 +8,41 @@ namespace Core
 {
 	const bool ITexture::Load(Core::IDevice* _Device, std::filesystem::path _ResourcePath)
 	{
-		int textWidth, textHeight, textChannels;
-		stbi_set_flip_vertically_on_load(true);
+		DecodedTexture decoded;
 
-		unsigned char* texture = stbi_load(_ResourcePath.string().c_str(), &textWidth, &textHeight, &textChannels, STBI_rgb_alpha);
+		// The pixels are freed on the CPU once copied to the staging memory
+		return Decode(_ResourcePath, decoded) && Upload(_Device, decoded.pixels.get(), decoded.width, decoded.height);
+	}
+
+	const bool ITexture::Decode(const std::filesystem::path& _ResourcePath, DecodedTexture& _Decoded)
+	{
+		int textChannels;
+
+		// The flag of the other functions is shared by all the threads
+		stbi_set_flip_vertically_on_load_thread(true);
+
+		unsigned char* texture = stbi_load(_ResourcePath.string().c_str(), &_Decoded.width, &_Decoded.height, &textChannels, STBI_rgb_alpha);
 
 		if (!texture)
 		{
-			DEBUG_ERROR("Failed to load texture");
+			DEBUG_ERROR("Failed to load texture %s", _ResourcePath.string().c_str());
 			return false;
 		}
 
-		CreateTexture(_Device, texture, textWidth, textHeight);
+		_Decoded.pixels = std::unique_ptr<unsigned char, void(*)(void*)>(texture, stbi_image_free);
+
+		return true;
+	}
+
+	const bool ITexture::Upload(Core::IDevice* _Device, unsigned char* _Pixels, int _Width, int _Height)
+	{
+		if (CreateTexture(_Device, _Pixels, _Width, _Height) != RHI_SUCCESS)
+			return false;
 
-		// Free the texture on the CPU
-		stbi_image_free(texture);
+		p_MemorySize = static_cast<size_t>(_Width) * _Height * 4;
 
 		p_Descriptors = Core::Renderer::GetDescriptorAllocator()->CreateTextureDescriptor(Core::Renderer::GetDevice(),
-			Core::Renderer::MAX_FRAMES_IN_FLIGHT, this, Core::Renderer::GetPipeline()->GetDescriptorLayouts()[2]);
+			Core::Renderer::MAX_FRAMES_IN_FLIGHT, this, Core::Renderer::GetPipeline()->GetDescriptorLayout(DESCRIPTOR_SET, DESCRIPTOR_BINDING));
 
 		return true;
 	}
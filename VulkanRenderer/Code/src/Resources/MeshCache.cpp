@@ -0,0 +1,329 @@
+#include "MeshCache.h"
+
+#include "Debug/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace Core
+{
+	static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	static void HashBytes(unsigned long long& _Hash, const void* _Data, size_t _Size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_Data);
+
+		for (size_t i = 0; i < _Size; ++i)
+		{
+			_Hash ^= bytes[i];
+			_Hash *= FNV_PRIME;
+		}
+	}
+
+	static size_t AlignBlock(size_t _Offset)
+	{
+		return (_Offset + 7) & ~static_cast<size_t>(7);
+	}
+
+	// Appends a block at the next aligned offset
+	static uint64_t AppendBlock(std::vector<unsigned char>& _File, const void* _Data, size_t _Size)
+	{
+		size_t offset = AlignBlock(_File.size());
+
+		_File.resize(offset + _Size);
+
+		if (_Size > 0)
+			memcpy(_File.data() + offset, _Data, _Size);
+
+		return offset;
+	}
+
+	static bool IsBlockInFile(uint64_t _Offset, uint64_t _Size, size_t _FileSize)
+	{
+		return _Offset % 8 == 0 && _Offset <= _FileSize && _Size <= _FileSize - _Offset;
+	}
+
+	static bool AreIndicesInRange(const unsigned char* _IndexData, IndexType _IndexType, uint32_t _FirstIndex, uint32_t _IndexCount, uint64_t _VertexCount)
+	{
+		if (_IndexType == RHI_INDEX_UINT16)
+		{
+			const uint16_t* indices = reinterpret_cast<const uint16_t*>(_IndexData) + _FirstIndex;
+			return std::all_of(indices, indices + _IndexCount, [_VertexCount](uint16_t _Index) { return _Index < _VertexCount; });
+		}
+
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(_IndexData) + _FirstIndex;
+		return std::all_of(indices, indices + _IndexCount, [_VertexCount](uint32_t _Index) { return _Index < _VertexCount; });
+	}
+
+	std::filesystem::path MeshCache::GetEntryPath(const std::filesystem::path& _SourcePath, VertexFormat _VertexFormat)
+	{
+		unsigned long long hash = FNV_OFFSET_BASIS;
+
+		uint32_t vertexFormat = static_cast<uint32_t>(_VertexFormat);
+		HashBytes(hash, &vertexFormat, sizeof(vertexFormat));
+
+		// The same file written with other separators gives the same entry
+		std::string sourcePath = _SourcePath.lexically_normal().generic_string();
+		size_t pathSize = sourcePath.size();
+		HashBytes(hash, &pathSize, sizeof(pathSize));
+		HashBytes(hash, sourcePath.data(), pathSize);
+
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.mesh", hash);
+
+		return m_CacheDirectory / name;
+	}
+
+	const bool MeshCache::GetSourceStatus(const std::filesystem::path& _SourcePath, uint64_t& _Size, int64_t& _WriteTime)
+	{
+		std::error_code error;
+
+		uintmax_t size = std::filesystem::file_size(_SourcePath, error);
+
+		if (error)
+			return false;
+
+		std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(_SourcePath, error);
+
+		if (error)
+			return false;
+
+		_Size = static_cast<uint64_t>(size);
+		_WriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+
+		return true;
+	}
+
+	const bool MeshCache::HashSource(const std::filesystem::path& _SourcePath, uint64_t& _Hash)
+	{
+		MappedFile source;
+
+		if (!source.Open(_SourcePath))
+			return false;
+
+		unsigned long long hash = FNV_OFFSET_BASIS;
+		HashBytes(hash, source.GetData(), source.GetSize());
+
+		_Hash = hash;
+
+		return true;
+	}
+
+	const bool MeshCache::Open(const std::filesystem::path& _SourcePath, VertexFormat _VertexFormat, MeshStreams& _Streams)
+	{
+		Close();
+
+		std::filesystem::path entryPath = GetEntryPath(_SourcePath, _VertexFormat);
+
+		uint64_t sourceSize = 0;
+		int64_t sourceWriteTime = 0;
+
+		if (!GetSourceStatus(_SourcePath, sourceSize, sourceWriteTime) || !m_File.Open(entryPath))
+		{
+			++m_MissCount;
+			return false;
+		}
+
+		const unsigned char* data = m_File.GetData();
+		size_t size = m_File.GetSize();
+
+		const MeshCacheHeader* header = reinterpret_cast<const MeshCacheHeader*>(data);
+
+		// An entry of an older version is overwritten by the next import
+		if (size < sizeof(MeshCacheHeader) || header->magic != CACHE_MAGIC_NUMBER || header->version != CACHE_FORMAT_VERSION)
+		{
+			Close();
+			++m_MissCount;
+			return false;
+		}
+
+		VertexLayout layout = VertexLayout::Get(_VertexFormat);
+		size_t indexSize = header->indexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+		// Checked once here so the streams never point out of the file
+		bool isValid = header->vertexFormat == static_cast<uint32_t>(_VertexFormat)
+			&& header->vertexStride == layout.GetStride()
+			&& header->colorStride == layout.GetColorStride()
+			&& (header->indexType == RHI_INDEX_UINT16 || header->indexType == RHI_INDEX_UINT32)
+			&& header->vertexCount > 0 && header->indexCount > 0 && header->submeshCount > 0
+			&& IsBlockInFile(header->submeshOffset, static_cast<uint64_t>(header->submeshCount) * sizeof(Submesh), size)
+			&& IsBlockInFile(header->lodOffset, static_cast<uint64_t>(header->lodCount) * sizeof(MeshLod), size)
+			&& IsBlockInFile(header->vertexOffset, static_cast<uint64_t>(header->vertexCount) * header->vertexStride, size)
+			&& IsBlockInFile(header->colorOffset, static_cast<uint64_t>(header->vertexCount) * header->colorStride, size)
+			&& IsBlockInFile(header->indexOffset, static_cast<uint64_t>(header->indexCount) * indexSize, size)
+			&& IsBlockInFile(header->meshletOffset, static_cast<uint64_t>(header->meshletCount) * sizeof(Meshlet), size);
+
+		const Submesh* submeshes = reinterpret_cast<const Submesh*>(data + header->submeshOffset);
+
+		const unsigned char* indexData = data + header->indexOffset;
+		IndexType indexType = static_cast<IndexType>(header->indexType);
+
+		// Out of range indices would make the GPU read out of the vertex buffer, they are relative to the vertex offset of their range
+		for (uint32_t i = 0; isValid && i < header->submeshCount; ++i)
+		{
+			isValid = submeshes[i].firstIndex <= header->indexCount && submeshes[i].indexCount <= header->indexCount - submeshes[i].firstIndex
+				&& submeshes[i].vertexOffset < header->vertexCount
+				&& AreIndicesInRange(indexData, indexType, submeshes[i].firstIndex, submeshes[i].indexCount, header->vertexCount - submeshes[i].vertexOffset);
+		}
+
+		const MeshLod* lods = reinterpret_cast<const MeshLod*>(data + header->lodOffset);
+
+		for (uint32_t i = 0; isValid && i < header->lodCount; ++i)
+			isValid = lods[i].firstSubmesh <= header->submeshCount && lods[i].submeshCount <= header->submeshCount - lods[i].firstSubmesh;
+
+		const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(data + header->meshletOffset);
+
+		for (uint32_t i = 0; isValid && i < header->meshletCount; ++i)
+		{
+			isValid = meshlets[i].firstIndex <= header->indexCount && meshlets[i].triangleCount <= (header->indexCount - meshlets[i].firstIndex) / 3
+				&& meshlets[i].vertexOffset < header->vertexCount
+				&& AreIndicesInRange(indexData, indexType, meshlets[i].firstIndex, 3 * meshlets[i].triangleCount, header->vertexCount - meshlets[i].vertexOffset);
+		}
+
+		if (!isValid)
+		{
+			DEBUG_WARN("Ignoring corrupted mesh cache entry: %s", entryPath.string().c_str());
+			Close();
+			++m_MissCount;
+			return false;
+		}
+
+		// A source copied or checked out again gets a new write time with the same content
+		if (header->sourceSize != sourceSize || header->sourceWriteTime != sourceWriteTime)
+		{
+			uint64_t sourceHash = 0;
+
+			if (header->sourceSize != sourceSize || !HashSource(_SourcePath, sourceHash) || header->sourceHash != sourceHash)
+			{
+				Close();
+				++m_MissCount;
+				return false;
+			}
+		}
+
+		_Streams.vertexFormat = _VertexFormat;
+		_Streams.dequantization = header->dequantization;
+		_Streams.bounds = header->bounds;
+
+		_Streams.vertexData = data + header->vertexOffset;
+		_Streams.vertexDataSize = static_cast<size_t>(header->vertexCount) * header->vertexStride;
+		_Streams.vertexCount = header->vertexCount;
+		_Streams.colorData = header->colorStride > 0 ? data + header->colorOffset : nullptr;
+		_Streams.colorDataSize = static_cast<size_t>(header->vertexCount) * header->colorStride;
+
+		_Streams.indexData = indexData;
+		_Streams.indexCount = header->indexCount;
+		_Streams.indexType = indexType;
+
+		_Streams.submeshes = submeshes;
+		_Streams.submeshCount = header->submeshCount;
+		_Streams.lods = lods;
+		_Streams.lodCount = header->lodCount;
+		_Streams.meshlets = header->meshletCount > 0 ? meshlets : nullptr;
+		_Streams.meshletCount = header->meshletCount;
+
+		_Streams.duplicatedVertexCount = header->duplicatedVertexCount;
+		_Streams.importTime = header->importTime;
+
+		++m_HitCount;
+
+		return true;
+	}
+
+	void MeshCache::Close()
+	{
+		m_File.Close();
+	}
+
+	const bool MeshCache::Store(const std::filesystem::path& _SourcePath, const MeshStreams& _Streams)
+	{
+		VertexLayout layout = VertexLayout::Get(_Streams.vertexFormat);
+
+		MeshCacheHeader header;
+		header.magic = CACHE_MAGIC_NUMBER;
+		header.version = CACHE_FORMAT_VERSION;
+
+		if (!GetSourceStatus(_SourcePath, header.sourceSize, header.sourceWriteTime) || !HashSource(_SourcePath, header.sourceHash))
+			return false;
+
+		header.vertexFormat = static_cast<uint32_t>(_Streams.vertexFormat);
+		header.indexType = static_cast<uint32_t>(_Streams.indexType);
+		header.vertexCount = _Streams.vertexCount;
+		header.vertexStride = layout.GetStride();
+		header.colorStride = layout.GetColorStride();
+		header.indexCount = static_cast<uint32_t>(_Streams.indexCount);
+		header.submeshCount = static_cast<uint32_t>(_Streams.submeshCount);
+		header.duplicatedVertexCount = _Streams.duplicatedVertexCount;
+		header.meshletCount = static_cast<uint32_t>(_Streams.meshletCount);
+		header.bounds = _Streams.bounds;
+		header.dequantization = _Streams.dequantization;
+		header.importTime = _Streams.importTime;
+
+		// Full detail only until the import simplifies meshes
+		MeshLod fullDetail;
+		fullDetail.submeshCount = header.submeshCount;
+
+		const MeshLod* lods = _Streams.lodCount > 0 ? _Streams.lods : &fullDetail;
+		header.lodCount = _Streams.lodCount > 0 ? static_cast<uint32_t>(_Streams.lodCount) : 1;
+
+		size_t indexSize = _Streams.indexType == RHI_INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+		std::vector<unsigned char> file(sizeof(MeshCacheHeader));
+		file.reserve(sizeof(MeshCacheHeader) + _Streams.vertexDataSize + _Streams.colorDataSize + _Streams.indexCount * indexSize + _Streams.meshletCount * sizeof(Meshlet) + 64);
+
+		header.submeshOffset = AppendBlock(file, _Streams.submeshes, _Streams.submeshCount * sizeof(Submesh));
+		header.lodOffset = AppendBlock(file, lods, header.lodCount * sizeof(MeshLod));
+		header.vertexOffset = AppendBlock(file, _Streams.vertexData, _Streams.vertexDataSize);
+		header.colorOffset = AppendBlock(file, _Streams.colorData, _Streams.colorDataSize);
+		header.indexOffset = AppendBlock(file, _Streams.indexData, _Streams.indexCount * indexSize);
+		header.meshletOffset = AppendBlock(file, _Streams.meshlets, _Streams.meshletCount * sizeof(Meshlet));
+
+		memcpy(file.data(), &header, sizeof(MeshCacheHeader));
+
+		std::error_code error;
+		std::filesystem::create_directories(m_CacheDirectory, error);
+
+		if (error)
+		{
+			DEBUG_WARN("Failed to create mesh cache directory: %s", m_CacheDirectory.string().c_str());
+			return false;
+		}
+
+		std::filesystem::path entryPath = GetEntryPath(_SourcePath, _Streams.vertexFormat);
+		std::filesystem::path temporaryPath = entryPath;
+		temporaryPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+		{
+			std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			if (!stream.is_open())
+			{
+				DEBUG_WARN("Failed to write mesh cache entry: %s", temporaryPath.string().c_str());
+				return false;
+			}
+
+			stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+
+			if (!stream)
+			{
+				DEBUG_WARN("Failed to write mesh cache entry: %s", temporaryPath.string().c_str());
+				return false;
+			}
+		}
+
+		// The entry may still be mapped by another load on Windows, the next import writes it again
+		std::filesystem::rename(temporaryPath, entryPath, error);
+
+		if (error)
+		{
+			DEBUG_WARN("Failed to write mesh cache entry: %s", entryPath.string().c_str());
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,692 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Core
+{
+	/// <summary>
+	/// FIFO post-transform cache, a vertex is in it while less than size vertices were inserted after it
+	/// </summary>
+	struct PostTransformCache
+	{
+		std::vector<uint32_t> insertTimes;
+		uint32_t time;
+		uint32_t size;
+
+		PostTransformCache(size_t _VertexCount, unsigned int _Size)
+			: insertTimes(_VertexCount, 0), time(_Size + 1), size(_Size)
+		{
+		}
+
+		// Returns 1 when the vertex is shaded again
+		inline unsigned int Access(uint32_t _Vertex)
+		{
+			if (time - insertTimes[_Vertex] <= size)
+				return 0;
+
+			insertTimes[_Vertex] = time++;
+			return 1;
+		}
+
+		inline unsigned int AccessTriangle(const uint32_t* _Triangle)
+		{
+			return Access(_Triangle[0]) + Access(_Triangle[1]) + Access(_Triangle[2]);
+		}
+
+		// Every vertex inserted before is evicted
+		inline void Flush() { time += size + 1; }
+	};
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& _Indices, size_t _VertexCount, unsigned int _CacheSize)
+	{
+		size_t triangleCount = _Indices.size() / 3;
+
+		if (triangleCount == 0)
+			return;
+
+		// Triangles of every vertex, the offsets index the flat list of adjacent triangles
+		std::vector<uint32_t> liveTriangles(_VertexCount, 0);
+
+		for (uint32_t index : _Indices)
+			++liveTriangles[index];
+
+		std::vector<uint32_t> adjacencyOffsets(_VertexCount + 1, 0);
+
+		for (size_t i = 0; i < _VertexCount; ++i)
+			adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+
+		std::vector<uint32_t> adjacency(_Indices.size());
+		std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+		for (size_t i = 0; i < _Indices.size(); ++i)
+			adjacency[adjacencyFill[_Indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+		// Time the vertex entered the cache, starts out of it
+		std::vector<uint32_t> cacheTimes(_VertexCount, 0);
+		uint32_t time = _CacheSize + 1;
+
+		std::vector<bool> isEmitted(triangleCount, false);
+		std::vector<uint32_t> deadEnds;
+		std::vector<uint32_t> candidates;
+
+		std::vector<uint32_t> result;
+		result.reserve(_Indices.size());
+
+		// Next vertex of the input order tried when the dead end stack is empty
+		size_t cursor = 0;
+		int64_t fanningVertex = _Indices[0];
+
+		while (fanningVertex >= 0)
+		{
+			candidates.clear();
+
+			for (uint32_t i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; ++i)
+			{
+				uint32_t triangle = adjacency[i];
+
+				if (isEmitted[triangle])
+					continue;
+
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					uint32_t vertex = _Indices[triangle * 3 + corner];
+
+					result.push_back(vertex);
+					deadEnds.push_back(vertex);
+					candidates.push_back(vertex);
+
+					--liveTriangles[vertex];
+
+					if (time - cacheTimes[vertex] > _CacheSize)
+						cacheTimes[vertex] = time++;
+				}
+
+				isEmitted[triangle] = true;
+			}
+
+			// Prefers the candidate staying the longest in the cache once all its triangles are emitted
+			int64_t nextVertex = -1;
+			int64_t bestPriority = -1;
+
+			for (uint32_t vertex : candidates)
+			{
+				if (liveTriangles[vertex] == 0)
+					continue;
+
+				int64_t priority = 0;
+
+				if (time - cacheTimes[vertex] + 2 * liveTriangles[vertex] <= _CacheSize)
+					priority = time - cacheTimes[vertex];
+
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					nextVertex = vertex;
+				}
+			}
+
+			// Dead end, goes back to a recent vertex then to the input order
+			while (nextVertex < 0 && !deadEnds.empty())
+			{
+				uint32_t vertex = deadEnds.back();
+				deadEnds.pop_back();
+
+				if (liveTriangles[vertex] > 0)
+					nextVertex = vertex;
+			}
+
+			while (nextVertex < 0 && cursor < _VertexCount)
+			{
+				if (liveTriangles[cursor] > 0)
+					nextVertex = static_cast<int64_t>(cursor);
+
+				++cursor;
+			}
+
+			fanningVertex = nextVertex;
+		}
+
+		_Indices.swap(result);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& _Indices, const float* _Positions, size_t _PositionStride, size_t _VertexCount, float _Threshold, unsigned int _CacheSize)
+	{
+		size_t triangleCount = _Indices.size() / 3;
+
+		if (triangleCount == 0)
+			return;
+
+		PostTransformCache cache(_VertexCount, _CacheSize);
+
+		// Hard boundaries - Tipsify restarted where the three vertices of a triangle miss the cache
+		std::vector<size_t> hardClusters;
+
+		for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			if (cache.AccessTriangle(&_Indices[triangle * 3]) == 3)
+				hardClusters.push_back(triangle);
+		}
+
+		if (hardClusters.empty() || hardClusters[0] != 0)
+			hardClusters.insert(hardClusters.begin(), 0);
+
+		// Soft boundaries - a cluster is cut as soon as its miss ratio reaches the one of its hard cluster
+		std::vector<size_t> clusters;
+
+		for (size_t i = 0; i < hardClusters.size(); ++i)
+		{
+			size_t start = hardClusters[i];
+			size_t end = i + 1 < hardClusters.size() ? hardClusters[i + 1] : triangleCount;
+
+			cache.Flush();
+
+			unsigned int clusterMisses = 0;
+
+			for (size_t triangle = start; triangle < end; ++triangle)
+				clusterMisses += cache.AccessTriangle(&_Indices[triangle * 3]);
+
+			float clusterThreshold = _Threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+			clusters.push_back(start);
+			cache.Flush();
+
+			unsigned int runningMisses = 0;
+			unsigned int runningTriangles = 0;
+
+			for (size_t triangle = start; triangle + 1 < end; ++triangle)
+			{
+				runningMisses += cache.AccessTriangle(&_Indices[triangle * 3]);
+				++runningTriangles;
+
+				if (static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold)
+				{
+					clusters.push_back(triangle + 1);
+					cache.Flush();
+
+					runningMisses = 0;
+					runningTriangles = 0;
+				}
+			}
+		}
+
+		auto getPosition = [_Positions, _PositionStride](uint32_t _Vertex)
+			{
+				return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(_Positions) + _Vertex * _PositionStride);
+			};
+
+		float meshCentroid[3] = { 0.f, 0.f, 0.f };
+
+		for (size_t i = 0; i < _VertexCount; ++i)
+		{
+			const float* position = getPosition(static_cast<uint32_t>(i));
+
+			for (size_t axis = 0; axis < 3; ++axis)
+				meshCentroid[axis] += position[axis] / static_cast<float>(_VertexCount);
+		}
+
+		// Clusters far along their own normal are on the outside of the mesh and occlude the others
+		std::vector<float> sortKeys(clusters.size());
+
+		for (size_t i = 0; i < clusters.size(); ++i)
+		{
+			size_t end = i + 1 < clusters.size() ? clusters[i + 1] : triangleCount;
+
+			float centroid[3] = { 0.f, 0.f, 0.f };
+			float normal[3] = { 0.f, 0.f, 0.f };
+			float clusterArea = 0.f;
+
+			for (size_t triangle = clusters[i]; triangle < end; ++triangle)
+			{
+				const float* a = getPosition(_Indices[triangle * 3 + 0]);
+				const float* b = getPosition(_Indices[triangle * 3 + 1]);
+				const float* c = getPosition(_Indices[triangle * 3 + 2]);
+
+				float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+
+				// Cross product, its length is twice the area so the sum weights the normals by the areas
+				float triangleNormal[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+				float area = std::sqrt(triangleNormal[0] * triangleNormal[0] + triangleNormal[1] * triangleNormal[1] + triangleNormal[2] * triangleNormal[2]);
+
+				for (size_t axis = 0; axis < 3; ++axis)
+				{
+					centroid[axis] += (a[axis] + b[axis] + c[axis]) / 3.f * area;
+					normal[axis] += triangleNormal[axis];
+				}
+
+				clusterArea += area;
+			}
+
+			float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			if (clusterArea <= 0.f || normalLength <= 0.f)
+			{
+				sortKeys[i] = 0.f;
+				continue;
+			}
+
+			sortKeys[i] = 0.f;
+
+			for (size_t axis = 0; axis < 3; ++axis)
+				sortKeys[i] += (centroid[axis] / clusterArea - meshCentroid[axis]) * normal[axis] / normalLength;
+		}
+
+		std::vector<size_t> clusterOrder(clusters.size());
+
+		for (size_t i = 0; i < clusterOrder.size(); ++i)
+			clusterOrder[i] = i;
+
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](size_t _A, size_t _B)
+			{
+				return sortKeys[_A] > sortKeys[_B];
+			});
+
+		std::vector<uint32_t> result;
+		result.reserve(_Indices.size());
+
+		for (size_t cluster : clusterOrder)
+		{
+			size_t start = clusters[cluster];
+			size_t end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangleCount;
+
+			result.insert(result.end(), _Indices.begin() + start * 3, _Indices.begin() + end * 3);
+		}
+
+		_Indices.swap(result);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& _Indices, size_t _VertexCount, std::vector<uint32_t>& _Remap)
+	{
+		const uint32_t UNASSIGNED = UINT32_MAX;
+
+		_Remap.assign(_VertexCount, UNASSIGNED);
+
+		uint32_t nextVertex = 0;
+
+		for (uint32_t& index : _Indices)
+		{
+			if (_Remap[index] == UNASSIGNED)
+				_Remap[index] = nextVertex++;
+
+			index = _Remap[index];
+		}
+
+		// Vertices no triangle uses are kept after the others
+		for (uint32_t& remap : _Remap)
+		{
+			if (remap == UNASSIGNED)
+				remap = nextVertex++;
+		}
+	}
+
+	void MeshOptimizer::OptimizeMesh(std::vector<uint32_t>& _Indices, const float* _Positions, size_t _PositionStride, size_t _VertexCount, size_t _VertexSize, float _OverdrawThreshold,
+		std::vector<uint32_t>& _Remap)
+	{
+		// Triangles ordered for the post-transform cache, vertices in the order they are first used
+		OptimizeVertexCache(_Indices, _VertexCount);
+
+		std::vector<uint32_t> overdrawIndices = _Indices;
+		OptimizeOverdraw(overdrawIndices, _Positions, _PositionStride, _VertexCount, _OverdrawThreshold);
+
+		OptimizeVertexFetch(_Indices, _VertexCount, _Remap);
+
+		std::vector<uint32_t> overdrawRemap;
+		OptimizeVertexFetch(overdrawIndices, _VertexCount, overdrawRemap);
+
+		// The clusters against overdraw are kept only if the vertex fetches do not get worse and the cache stays in the budget of the threshold
+		VertexCacheStatistics cacheOrder = AnalyzeVertexCache(_Indices, _VertexCount);
+		VertexCacheStatistics overdrawCacheOrder = AnalyzeVertexCache(overdrawIndices, _VertexCount);
+		VertexFetchStatistics fetchOrder = AnalyzeVertexFetch(_Indices, _VertexCount, _VertexSize);
+		VertexFetchStatistics overdrawFetchOrder = AnalyzeVertexFetch(overdrawIndices, _VertexCount, _VertexSize);
+
+		if (overdrawCacheOrder.acmr <= cacheOrder.acmr * _OverdrawThreshold && overdrawFetchOrder.overfetch <= fetchOrder.overfetch)
+		{
+			_Indices.swap(overdrawIndices);
+			_Remap.swap(overdrawRemap);
+		}
+	}
+
+	void MeshOptimizer::SplitSubmeshes(std::vector<uint32_t>& _Indices, size_t _VertexCount, std::vector<uint32_t>& _VertexSources, std::vector<Submesh>& _Submeshes, size_t _MaxVertexCount)
+	{
+		_VertexSources.clear();
+		_Submeshes.clear();
+
+		if (_Indices.empty())
+			return;
+
+		// Local number of every vertex in the submesh of the same stamp, nothing is cleared between two submeshes
+		std::vector<uint32_t> localVertices(_VertexCount, 0);
+		std::vector<uint32_t> stamps(_VertexCount, 0);
+
+		uint32_t stamp = 1;
+		Submesh submesh;
+
+		for (size_t triangle = 0; triangle + 2 < _Indices.size(); triangle += 3)
+		{
+			size_t newVertexCount = 0;
+
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				uint32_t vertex = _Indices[triangle + corner];
+
+				// A triangle using the same vertex twice counts it once
+				bool isCounted = false;
+
+				for (size_t previous = 0; previous < corner; ++previous)
+					isCounted |= _Indices[triangle + previous] == vertex;
+
+				if (stamps[vertex] != stamp && !isCounted)
+					++newVertexCount;
+			}
+
+			// The triangle does not fit, the next submesh starts with it
+			if (_VertexSources.size() - submesh.vertexOffset + newVertexCount > _MaxVertexCount)
+			{
+				_Submeshes.push_back(submesh);
+
+				submesh.firstIndex = static_cast<uint32_t>(triangle);
+				submesh.indexCount = 0;
+				submesh.vertexOffset = static_cast<uint32_t>(_VertexSources.size());
+				++stamp;
+			}
+
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				uint32_t& index = _Indices[triangle + corner];
+
+				if (stamps[index] != stamp)
+				{
+					stamps[index] = stamp;
+					localVertices[index] = static_cast<uint32_t>(_VertexSources.size()) - submesh.vertexOffset;
+					_VertexSources.push_back(index);
+				}
+
+				index = localVertices[index];
+			}
+
+			submesh.indexCount += 3;
+		}
+
+		_Submeshes.push_back(submesh);
+	}
+
+	VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& _Indices, size_t _VertexCount, unsigned int _CacheSize)
+	{
+		VertexCacheStatistics statistics;
+		statistics.triangleCount = static_cast<unsigned int>(_Indices.size() / 3);
+
+		PostTransformCache cache(_VertexCount, _CacheSize);
+		std::vector<bool> isReferenced(_VertexCount, false);
+
+		for (uint32_t index : _Indices)
+		{
+			statistics.transformCount += cache.Access(index);
+
+			if (!isReferenced[index])
+			{
+				isReferenced[index] = true;
+				++statistics.vertexCount;
+			}
+		}
+
+		if (statistics.triangleCount > 0)
+		{
+			statistics.acmr = static_cast<float>(statistics.transformCount) / static_cast<float>(statistics.triangleCount);
+			statistics.atvr = static_cast<float>(statistics.transformCount) / static_cast<float>(statistics.vertexCount);
+		}
+
+		return statistics;
+	}
+
+	VertexFetchStatistics MeshOptimizer::AnalyzeVertexFetch(const std::vector<uint32_t>& _Indices, size_t _VertexCount, size_t _VertexSize)
+	{
+		const size_t CACHE_LINE_SIZE = 64;
+		const size_t CACHE_LINE_COUNT = 16 * 1024 / CACHE_LINE_SIZE;
+
+		VertexFetchStatistics statistics;
+
+		// Line stored in every slot of the cache, lines are mapped to the slot of their address modulo the line count
+		std::vector<size_t> cachedLines(CACHE_LINE_COUNT, SIZE_MAX);
+		std::vector<bool> isReferenced(_VertexCount, false);
+		size_t referencedCount = 0;
+
+		for (uint32_t index : _Indices)
+		{
+			if (!isReferenced[index])
+			{
+				isReferenced[index] = true;
+				++referencedCount;
+			}
+
+			size_t firstLine = index * _VertexSize / CACHE_LINE_SIZE;
+			size_t lastLine = (index * _VertexSize + _VertexSize - 1) / CACHE_LINE_SIZE;
+
+			for (size_t line = firstLine; line <= lastLine; ++line)
+			{
+				size_t& cachedLine = cachedLines[line % CACHE_LINE_COUNT];
+
+				if (cachedLine != line)
+				{
+					cachedLine = line;
+					statistics.bytesFetched += static_cast<unsigned int>(CACHE_LINE_SIZE);
+				}
+			}
+		}
+
+		if (referencedCount > 0)
+			statistics.overfetch = static_cast<float>(statistics.bytesFetched) / static_cast<float>(referencedCount * _VertexSize);
+
+		return statistics;
+	}
+
+	MeshBounds MeshOptimizer::ComputeBounds(const float* _Positions, size_t _PositionStride, size_t _VertexCount)
+	{
+		MeshBounds bounds;
+
+		for (size_t vertex = 0; vertex < _VertexCount; ++vertex)
+		{
+			const float* position = reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(_Positions) + vertex * _PositionStride);
+
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				bounds.min[axis] = vertex == 0 ? position[axis] : std::min(bounds.min[axis], position[axis]);
+				bounds.max[axis] = vertex == 0 ? position[axis] : std::max(bounds.max[axis], position[axis]);
+			}
+		}
+
+		return bounds;
+	}
+
+	// Sphere around the vertices of the meshlet and cone around the normals of its triangles
+	template<typename Index>
+	static void ComputeMeshletBounds(Meshlet& _Meshlet, const Index* _Indices, const std::vector<uint32_t>& _Vertices, const float* _Positions, size_t _PositionStride)
+	{
+		auto getPosition = [_Positions, _PositionStride](size_t _Vertex)
+			{
+				return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(_Positions) + _Vertex * _PositionStride);
+			};
+
+		float minimum[3] = { 0.f, 0.f, 0.f };
+		float maximum[3] = { 0.f, 0.f, 0.f };
+
+		for (size_t i = 0; i < _Vertices.size(); ++i)
+		{
+			const float* position = getPosition(_Vertices[i]);
+
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				minimum[axis] = i == 0 ? position[axis] : std::min(minimum[axis], position[axis]);
+				maximum[axis] = i == 0 ? position[axis] : std::max(maximum[axis], position[axis]);
+			}
+		}
+
+		// Centered on the box, the radius reaches the farthest vertex instead of the corners of the box
+		float squaredRadius = 0.f;
+
+		for (size_t axis = 0; axis < 3; ++axis)
+			_Meshlet.center[axis] = (minimum[axis] + maximum[axis]) * 0.5f;
+
+		for (uint32_t vertex : _Vertices)
+		{
+			const float* position = getPosition(vertex);
+
+			float dx = position[0] - _Meshlet.center[0];
+			float dy = position[1] - _Meshlet.center[1];
+			float dz = position[2] - _Meshlet.center[2];
+
+			squaredRadius = std::max(squaredRadius, dx * dx + dy * dy + dz * dz);
+		}
+
+		_Meshlet.radius = std::sqrt(squaredRadius);
+
+		// Unit normals of the triangles, the degenerate ones face no direction
+		std::vector<float> normals(3 * _Meshlet.triangleCount, 0.f);
+		float axis[3] = { 0.f, 0.f, 0.f };
+
+		for (uint32_t triangle = 0; triangle < _Meshlet.triangleCount; ++triangle)
+		{
+			const Index* corners = _Indices + _Meshlet.firstIndex + 3 * triangle;
+
+			const float* a = getPosition(_Meshlet.vertexOffset + corners[0]);
+			const float* b = getPosition(_Meshlet.vertexOffset + corners[1]);
+			const float* c = getPosition(_Meshlet.vertexOffset + corners[2]);
+
+			float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+			float* normal = &normals[3 * triangle];
+
+			normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+			normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+			normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+
+			float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			for (size_t component = 0; component < 3; ++component)
+			{
+				normal[component] = length > 0.f ? normal[component] / length : 0.f;
+				axis[component] += normal[component];
+			}
+		}
+
+		float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+
+		_Meshlet.coneCutoff = 1.f;
+
+		if (axisLength <= 0.f)
+			return;
+
+		for (size_t component = 0; component < 3; ++component)
+			_Meshlet.coneAxis[component] = axis[component] / axisLength;
+
+		float minimumDot = 1.f;
+
+		for (uint32_t triangle = 0; triangle < _Meshlet.triangleCount; ++triangle)
+		{
+			const float* normal = &normals[3 * triangle];
+
+			if (normal[0] == 0.f && normal[1] == 0.f && normal[2] == 0.f)
+				continue;
+
+			minimumDot = std::min(minimumDot, normal[0] * _Meshlet.coneAxis[0] + normal[1] * _Meshlet.coneAxis[1] + normal[2] * _Meshlet.coneAxis[2]);
+		}
+
+		// Triangles spread over more than a half space can never all face away
+		if (minimumDot > 0.f)
+			_Meshlet.coneCutoff = std::sqrt(1.f - minimumDot * minimumDot);
+	}
+
+	template<typename Index>
+	static void BuildMeshletsOfIndices(const Index* _Indices, const Submesh* _Submeshes, size_t _SubmeshCount, const float* _Positions, size_t _PositionStride, std::vector<Meshlet>& _Meshlets)
+	{
+		_Meshlets.clear();
+
+		// Meshlet that last used each vertex, numbered from 1, a vertex is counted once per meshlet
+		std::vector<uint32_t> vertexMeshlets;
+		// Vertices of the meshlet being built, with the offset of their submesh
+		std::vector<uint32_t> meshletVertices;
+		meshletVertices.reserve(MeshOptimizer::MESHLET_MAX_VERTICES);
+
+		for (size_t i = 0; i < _SubmeshCount; ++i)
+		{
+			const Submesh& submesh = _Submeshes[i];
+
+			Meshlet meshlet;
+			meshlet.firstIndex = submesh.firstIndex;
+			meshlet.vertexOffset = submesh.vertexOffset;
+
+			auto finishMeshlet = [&](uint32_t _NextIndex)
+				{
+					meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+					ComputeMeshletBounds(meshlet, _Indices, meshletVertices, _Positions, _PositionStride);
+					_Meshlets.push_back(meshlet);
+
+					meshlet.firstIndex = _NextIndex;
+					meshlet.triangleCount = 0;
+					meshletVertices.clear();
+				};
+
+			for (uint32_t index = submesh.firstIndex; index + 3 <= submesh.firstIndex + submesh.indexCount; index += 3)
+			{
+				const Index* triangle = _Indices + index;
+
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					size_t vertex = static_cast<size_t>(submesh.vertexOffset) + triangle[corner];
+
+					if (vertex >= vertexMeshlets.size())
+						vertexMeshlets.resize(vertex + 1, 0);
+				}
+
+				auto countNewVertices = [&]()
+					{
+						uint32_t meshletNumber = static_cast<uint32_t>(_Meshlets.size() + 1);
+						size_t newVertexCount = 0;
+
+						for (size_t corner = 0; corner < 3; ++corner)
+						{
+							bool isUsed = vertexMeshlets[submesh.vertexOffset + triangle[corner]] == meshletNumber;
+
+							for (size_t previous = 0; previous < corner; ++previous)
+								isUsed = isUsed || triangle[previous] == triangle[corner];
+
+							newVertexCount += isUsed ? 0 : 1;
+						}
+
+						return newVertexCount;
+					};
+
+				if (meshlet.triangleCount == MeshOptimizer::MESHLET_MAX_TRIANGLES || meshletVertices.size() + countNewVertices() > MeshOptimizer::MESHLET_MAX_VERTICES)
+					finishMeshlet(index);
+
+				uint32_t meshletNumber = static_cast<uint32_t>(_Meshlets.size() + 1);
+
+				for (size_t corner = 0; corner < 3; ++corner)
+				{
+					uint32_t vertex = submesh.vertexOffset + static_cast<uint32_t>(triangle[corner]);
+
+					if (vertexMeshlets[vertex] != meshletNumber)
+					{
+						vertexMeshlets[vertex] = meshletNumber;
+						meshletVertices.push_back(vertex);
+					}
+				}
+
+				++meshlet.triangleCount;
+			}
+
+			if (meshlet.triangleCount > 0)
+				finishMeshlet(0);
+		}
+	}
+
+	void MeshOptimizer::BuildMeshlets(const uint32_t* _Indices, const Submesh* _Submeshes, size_t _SubmeshCount, const float* _Positions, size_t _PositionStride, std::vector<Meshlet>& _Meshlets)
+	{
+		BuildMeshletsOfIndices(_Indices, _Submeshes, _SubmeshCount, _Positions, _PositionStride, _Meshlets);
+	}
+
+	void MeshOptimizer::BuildMeshlets(const uint16_t* _Indices, const Submesh* _Submeshes, size_t _SubmeshCount, const float* _Positions, size_t _PositionStride, std::vector<Meshlet>& _Meshlets)
+	{
+		BuildMeshletsOfIndices(_Indices, _Submeshes, _SubmeshCount, _Positions, _PositionStride, _Meshlets);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include "ObjParser.h"
+
+#include "Debug/Log.h"
+#include "FileSystem/MappedFile.h"
+#include "Threading/ThreadPool.h"
+
+#include <tiny_obj_loader.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace Core
+{
+	/// <summary>
+	/// Lines of the file parsed by one job
+	/// </summary>
+	struct ObjChunk
+	{
+		const char* begin = nullptr;
+		const char* end = nullptr;
+
+		std::vector<float> positions;
+		std::vector<float> textCoords;
+		std::vector<float> normals;
+
+		// Corners of the faces, the relative indices are resolved from the first vertex of the chunk
+		std::vector<ObjIndex> corners;
+		// Bits 0, 1 and 2 are set when the position, the texture coordinate or the normal is relative
+		std::vector<uint8_t> relativeMasks;
+		// Number of corners of every face, 3 or 4
+		std::vector<uint8_t> faceSizes;
+		size_t triangleCount = 0;
+
+		// Offsets of the chunk in the merged arrays, in vertices and in triangles
+		size_t positionBase = 0;
+		size_t textCoordBase = 0;
+		size_t normalBase = 0;
+		size_t triangleBase = 0;
+
+		ObjParseResult result = OBJ_PARSE_SUCCESS;
+		// Line the parsing stopped at
+		const char* errorLine = nullptr;
+	};
+
+	static inline bool IsSpace(char _Character)
+	{
+		return _Character == ' ' || _Character == '\t';
+	}
+
+	static inline const char* SkipSpaces(const char* _Cursor, const char* _End)
+	{
+		while (_Cursor < _End && IsSpace(*_Cursor))
+			++_Cursor;
+
+		return _Cursor;
+	}
+
+	static inline const char* FindTokenEnd(const char* _Cursor, const char* _End)
+	{
+		while (_Cursor < _End && !IsSpace(*_Cursor) && *_Cursor != '\r')
+			++_Cursor;
+
+		return _Cursor;
+	}
+
+	// Read as a double then rounded like tinyobjloader, a missing value is 0
+	static const char* ParseFloat(const char* _Cursor, const char* _End, float& _Value)
+	{
+		_Cursor = SkipSpaces(_Cursor, _End);
+		const char* tokenEnd = FindTokenEnd(_Cursor, _End);
+
+		if (_Cursor < tokenEnd && *_Cursor == '+')
+			++_Cursor;
+
+		double value = 0.0;
+		std::from_chars(_Cursor, tokenEnd, value);
+
+		_Value = static_cast<float>(value);
+
+		return tokenEnd;
+	}
+
+	// OBJ indices start at 1, negative ones count back from the last vertex read, 0 is invalid
+	static bool ParseIndex(const char*& _Cursor, const char* _End, size_t _ChunkCount, int& _Index, bool& _IsRelative)
+	{
+		if (_Cursor < _End && *_Cursor == '+')
+			++_Cursor;
+
+		int index = 0;
+		std::from_chars_result parsed = std::from_chars(_Cursor, _End, index);
+
+		if (parsed.ec != std::errc() || index == 0)
+			return false;
+
+		_IsRelative = index < 0;
+		_Index = index > 0 ? index - 1 : static_cast<int>(_ChunkCount) + index;
+
+		// Skips what follows the number up to the next separator
+		_Cursor = parsed.ptr;
+
+		while (_Cursor < _End && *_Cursor != '/' && !IsSpace(*_Cursor) && *_Cursor != '\r')
+			++_Cursor;
+
+		return true;
+	}
+
+	// v, v/vt, v//vn or v/vt/vn
+	static bool ParseCorner(const char*& _Cursor, const char* _End, ObjChunk& _Chunk)
+	{
+		ObjIndex corner;
+		uint8_t relativeMask = 0;
+		bool isRelative = false;
+
+		if (!ParseIndex(_Cursor, _End, _Chunk.positions.size() / 3, corner.position, isRelative))
+			return false;
+
+		relativeMask |= isRelative ? 1 : 0;
+
+		if (_Cursor < _End && *_Cursor == '/')
+		{
+			++_Cursor;
+
+			if (_Cursor < _End && *_Cursor != '/')
+			{
+				if (!ParseIndex(_Cursor, _End, _Chunk.textCoords.size() / 2, corner.textCoord, isRelative))
+					return false;
+
+				relativeMask |= isRelative ? 2 : 0;
+			}
+
+			if (_Cursor < _End && *_Cursor == '/')
+			{
+				++_Cursor;
+
+				if (!ParseIndex(_Cursor, _End, _Chunk.normals.size() / 3, corner.normal, isRelative))
+					return false;
+
+				relativeMask |= isRelative ? 4 : 0;
+			}
+		}
+
+		_Chunk.corners.push_back(corner);
+		_Chunk.relativeMasks.push_back(relativeMask);
+
+		return true;
+	}
+
+	static void ParseChunk(ObjChunk& _Chunk)
+	{
+		const char* cursor = _Chunk.begin;
+
+		while (cursor < _Chunk.end)
+		{
+			// The CRT scans for the end of line with vector instructions
+			const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', _Chunk.end - cursor));
+
+			if (lineEnd == nullptr)
+				lineEnd = _Chunk.end;
+
+			const char* line = cursor;
+			cursor = SkipSpaces(cursor, lineEnd);
+
+			if (lineEnd - cursor >= 2 && cursor[0] == 'v')
+			{
+				if (IsSpace(cursor[1]))
+				{
+					float position[3];
+					const char* value = cursor + 2;
+
+					for (float& coordinate : position)
+						value = ParseFloat(value, lineEnd, coordinate);
+
+					_Chunk.positions.insert(_Chunk.positions.end(), position, position + 3);
+				}
+				else if (lineEnd - cursor >= 3 && cursor[1] == 't' && IsSpace(cursor[2]))
+				{
+					float textCoord[2];
+					const char* value = cursor + 3;
+
+					for (float& coordinate : textCoord)
+						value = ParseFloat(value, lineEnd, coordinate);
+
+					_Chunk.textCoords.insert(_Chunk.textCoords.end(), textCoord, textCoord + 2);
+				}
+				else if (lineEnd - cursor >= 3 && cursor[1] == 'n' && IsSpace(cursor[2]))
+				{
+					float normal[3];
+					const char* value = cursor + 3;
+
+					for (float& coordinate : normal)
+						value = ParseFloat(value, lineEnd, coordinate);
+
+					_Chunk.normals.insert(_Chunk.normals.end(), normal, normal + 3);
+				}
+			}
+			else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && IsSpace(cursor[1]))
+			{
+				size_t firstCorner = _Chunk.corners.size();
+				const char* corner = SkipSpaces(cursor + 2, lineEnd);
+
+				while (corner < lineEnd && *corner != '\r')
+				{
+					if (!ParseCorner(corner, lineEnd, _Chunk))
+					{
+						_Chunk.result = OBJ_PARSE_ERROR;
+						_Chunk.errorLine = line;
+						return;
+					}
+
+					corner = SkipSpaces(corner, lineEnd);
+
+					while (corner < lineEnd && *corner == '\r')
+						++corner;
+				}
+
+				size_t faceSize = _Chunk.corners.size() - firstCorner;
+
+				if (faceSize > 4)
+				{
+					_Chunk.result = OBJ_PARSE_UNSUPPORTED_POLYGON;
+					_Chunk.errorLine = line;
+					return;
+				}
+
+				// Faces of less than 3 vertices are dropped
+				if (faceSize < 3)
+				{
+					_Chunk.corners.resize(firstCorner);
+					_Chunk.relativeMasks.resize(firstCorner);
+				}
+				else
+				{
+					_Chunk.faceSizes.push_back(static_cast<uint8_t>(faceSize));
+					_Chunk.triangleCount += faceSize - 2;
+				}
+			}
+
+			cursor = lineEnd + 1;
+		}
+	}
+
+	static bool ResolveIndex(int& _Index, bool _IsRelative, size_t _Base, size_t _Count, bool _IsOptional)
+	{
+		if (_Index == -1 && !_IsRelative && _IsOptional)
+			return true;
+
+		long long index = static_cast<long long>(_Index) + (_IsRelative ? static_cast<long long>(_Base) : 0);
+
+		if (index < 0 || index >= static_cast<long long>(_Count))
+			return false;
+
+		_Index = static_cast<int>(index);
+
+		return true;
+	}
+
+	// Resolves the corners of a chunk against the merged attributes then writes its triangles
+	static void TriangulateChunk(ObjChunk& _Chunk, ObjData& _Data)
+	{
+		size_t positionCount = _Data.positions.size() / 3;
+		size_t textCoordCount = _Data.textCoords.size() / 2;
+		size_t normalCount = _Data.normals.size() / 3;
+
+		for (size_t i = 0; i < _Chunk.corners.size(); ++i)
+		{
+			ObjIndex& corner = _Chunk.corners[i];
+			uint8_t relativeMask = _Chunk.relativeMasks[i];
+
+			bool isValid = ResolveIndex(corner.position, (relativeMask & 1) != 0, _Chunk.positionBase, positionCount, false)
+				&& ResolveIndex(corner.textCoord, (relativeMask & 2) != 0, _Chunk.textCoordBase, textCoordCount, true)
+				&& ResolveIndex(corner.normal, (relativeMask & 4) != 0, _Chunk.normalBase, normalCount, true);
+
+			if (!isValid)
+			{
+				_Chunk.result = OBJ_PARSE_ERROR;
+				return;
+			}
+		}
+
+		ObjIndex* triangles = _Data.indices.data() + _Chunk.triangleBase * 3;
+		const ObjIndex* face = _Chunk.corners.data();
+
+		for (uint8_t faceSize : _Chunk.faceSizes)
+		{
+			if (faceSize == 3)
+			{
+				*triangles++ = face[0];
+				*triangles++ = face[1];
+				*triangles++ = face[2];
+			}
+			else
+			{
+				const float* v0 = &_Data.positions[3 * face[0].position];
+				const float* v1 = &_Data.positions[3 * face[1].position];
+				const float* v2 = &_Data.positions[3 * face[2].position];
+				const float* v3 = &_Data.positions[3 * face[3].position];
+
+				// Split along the shortest diagonal, like tinyobjloader
+				float e02[3] = { v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+				float e13[3] = { v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2] };
+
+				float squared02 = e02[0] * e02[0] + e02[1] * e02[1] + e02[2] * e02[2];
+				float squared13 = e13[0] * e13[0] + e13[1] * e13[1] + e13[2] * e13[2];
+
+				static const uint8_t SPLIT_02[6] = { 0, 1, 2, 0, 2, 3 };
+				static const uint8_t SPLIT_13[6] = { 0, 1, 3, 1, 2, 3 };
+
+				const uint8_t* order = squared02 < squared13 ? SPLIT_02 : SPLIT_13;
+
+				for (size_t corner = 0; corner < 6; ++corner)
+					*triangles++ = face[order[corner]];
+			}
+
+			face += faceSize;
+		}
+	}
+
+	ObjParseResult ObjParser::Parse(const std::filesystem::path& _Path, ObjData& _Data, ThreadPool* _ThreadPool)
+	{
+		MappedFile file;
+
+		if (!file.Open(_Path))
+		{
+			DEBUG_ERROR("Failed to open OBJ file %s", _Path.string().c_str());
+			return OBJ_PARSE_ERROR;
+		}
+
+		const char* data = reinterpret_cast<const char*>(file.GetData());
+		size_t size = file.GetSize();
+
+		size_t threadCount = _ThreadPool != nullptr ? _ThreadPool->GetThreadCount() + 1 : 1;
+		size_t chunkCount = std::max<size_t>(1, std::min(size / MIN_CHUNK_SIZE, threadCount * CHUNKS_PER_THREAD));
+
+		// Chunks start after the end of line following their even share of the file
+		std::vector<ObjChunk> chunks(chunkCount);
+
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			const char* begin = i == 0 ? data : chunks[i - 1].end;
+			const char* end = data + size;
+
+			if (i + 1 < chunkCount)
+			{
+				const char* split = std::max(begin, data + size * (i + 1) / chunkCount);
+				const char* lineEnd = split < end ? static_cast<const char*>(memchr(split, '\n', end - split)) : nullptr;
+
+				end = lineEnd != nullptr ? lineEnd + 1 : end;
+			}
+
+			chunks[i].begin = begin;
+			chunks[i].end = end;
+		}
+
+		auto forEachChunk = [_ThreadPool, chunkCount](const std::function<void(size_t)>& _Job)
+			{
+				if (_ThreadPool != nullptr)
+				{
+					_ThreadPool->ParallelFor(chunkCount, _Job);
+				}
+				else
+				{
+					for (size_t i = 0; i < chunkCount; ++i)
+						_Job(i);
+				}
+			};
+
+		forEachChunk([&chunks](size_t _Chunk) { ParseChunk(chunks[_Chunk]); });
+
+		for (const ObjChunk& chunk : chunks)
+		{
+			if (chunk.result == OBJ_PARSE_SUCCESS)
+				continue;
+
+			size_t lineNumber = std::count(data, chunk.errorLine, '\n') + 1;
+
+			if (chunk.result == OBJ_PARSE_UNSUPPORTED_POLYGON)
+				DEBUG_WARN("OBJ file %s has a polygon of more than 4 vertices at line %u", _Path.string().c_str(), static_cast<unsigned int>(lineNumber));
+			else
+				DEBUG_ERROR("Failed to parse the face at line %u of OBJ file %s", static_cast<unsigned int>(lineNumber), _Path.string().c_str());
+
+			return chunk.result;
+		}
+
+		size_t positionCount = 0;
+		size_t textCoordCount = 0;
+		size_t normalCount = 0;
+		size_t triangleCount = 0;
+
+		for (ObjChunk& chunk : chunks)
+		{
+			chunk.positionBase = positionCount;
+			chunk.textCoordBase = textCoordCount;
+			chunk.normalBase = normalCount;
+			chunk.triangleBase = triangleCount;
+
+			positionCount += chunk.positions.size() / 3;
+			textCoordCount += chunk.textCoords.size() / 2;
+			normalCount += chunk.normals.size() / 3;
+			triangleCount += chunk.triangleCount;
+		}
+
+		_Data.positions.resize(positionCount * 3);
+		_Data.textCoords.resize(textCoordCount * 2);
+		_Data.normals.resize(normalCount * 3);
+		_Data.indices.resize(triangleCount * 3);
+
+		// Every attribute has to be merged before the quads are split
+		for (const ObjChunk& chunk : chunks)
+		{
+			std::copy(chunk.positions.begin(), chunk.positions.end(), _Data.positions.begin() + chunk.positionBase * 3);
+			std::copy(chunk.textCoords.begin(), chunk.textCoords.end(), _Data.textCoords.begin() + chunk.textCoordBase * 2);
+			std::copy(chunk.normals.begin(), chunk.normals.end(), _Data.normals.begin() + chunk.normalBase * 3);
+		}
+
+		forEachChunk([&chunks, &_Data](size_t _Chunk) { TriangulateChunk(chunks[_Chunk], _Data); });
+
+		for (const ObjChunk& chunk : chunks)
+		{
+			if (chunk.result != OBJ_PARSE_SUCCESS)
+			{
+				DEBUG_ERROR("OBJ file %s has a face pointing out of its vertices", _Path.string().c_str());
+				return chunk.result;
+			}
+		}
+
+		return OBJ_PARSE_SUCCESS;
+	}
+
+	const bool ObjParser::ParseReference(const std::filesystem::path& _Path, ObjData& _Data)
+	{
+		tinyobj::attrib_t attrib;
+		std::vector<tinyobj::shape_t> shapes;
+		std::vector<tinyobj::material_t> materials;
+		std::string warn, error;
+
+		if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &error, _Path.string().c_str()))
+		{
+			DEBUG_ERROR("Failed to load OBJ file %s: %s", _Path.string().c_str(), error.c_str());
+			return false;
+		}
+
+		_Data.positions = std::move(attrib.vertices);
+		_Data.textCoords = std::move(attrib.texcoords);
+		_Data.normals = std::move(attrib.normals);
+
+		size_t indexCount = 0;
+
+		for (const tinyobj::shape_t& shape : shapes)
+			indexCount += shape.mesh.indices.size();
+
+		_Data.indices.clear();
+		_Data.indices.reserve(indexCount);
+
+		// Shapes are in the order of the file, their faces too
+		for (const tinyobj::shape_t& shape : shapes)
+		{
+			for (const tinyobj::index_t& index : shape.mesh.indices)
+			{
+				ObjIndex corner;
+				corner.position = index.vertex_index;
+				corner.textCoord = index.texcoord_index;
+				corner.normal = index.normal_index;
+
+				_Data.indices.push_back(corner);
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
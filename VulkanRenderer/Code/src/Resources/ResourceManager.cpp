@@ -0,0 +1,362 @@
+#include "ResourceManager.h"
+
+#include "RHI/IRendererHardware.h"
+
+#include <chrono>
+
+namespace Core
+{
+	size_t ResourceManager::ResourceKeyHash::operator()(const ResourceKey& _Key) const
+	{
+		size_t hash = std::hash<std::string>()(_Key.path);
+		hash ^= (static_cast<size_t>(_Key.settings) << 8 | static_cast<size_t>(_Key.type)) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+
+		return hash;
+	}
+
+	void ResourceManager::Initialize(IRendererHardware* _RHI, IDevice* _Device, ThreadPool* _ThreadPool, const std::function<void(const std::function<void()>&)>& _DeferDestruction)
+	{
+		m_RHI = _RHI;
+		m_Device = _Device;
+		m_ThreadPool = _ThreadPool;
+		m_DeferDestruction = _DeferDestruction;
+	}
+
+	void ResourceManager::Terminate()
+	{
+		// The workers write in the decoded data, the resources are released once they are done
+		for (PendingLoad& load : m_PendingLoads)
+			load.decoded.wait();
+
+		m_PendingLoads.clear();
+
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		// Their handles would destroy them after the device
+		for (std::pair<const ResourceKey, ResourceEntry>& entry : m_Entries)
+		{
+			if (!entry.second.resource.expired())
+				DEBUG_WARN("Resource still used at shutdown: %s", entry.first.path.c_str());
+		}
+
+		m_Entries.clear();
+	}
+
+	std::string ResourceManager::NormalizePath(const std::filesystem::path& _ResourcePath)
+	{
+		std::error_code error;
+		std::filesystem::path path = std::filesystem::weakly_canonical(_ResourcePath, error);
+
+		if (error)
+			path = std::filesystem::absolute(_ResourcePath, error).lexically_normal();
+
+		return path.generic_string();
+	}
+
+	std::shared_ptr<IResource> ResourceManager::FindResource(const ResourceKey& _Key)
+	{
+		std::unordered_map<ResourceKey, ResourceEntry, ResourceKeyHash>::iterator entry = m_Entries.find(_Key);
+
+		return entry != m_Entries.end() ? entry->second.resource.lock() : nullptr;
+	}
+
+	void ResourceManager::Release(const ResourceKey& _Key, IResource* _Resource)
+	{
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		std::unordered_map<ResourceKey, ResourceEntry, ResourceKeyHash>::iterator entry = m_Entries.find(_Key);
+
+		// The file may have been loaded again between the release of the last handle and this call
+		if (entry != m_Entries.end() && entry->second.pointer == _Resource)
+			m_Entries.erase(entry);
+	}
+
+	void ResourceManager::DestroyMesh(IMesh* _Mesh)
+	{
+		IRendererHardware* rhi = m_RHI;
+		IDevice* device = m_Device;
+
+		m_DeferDestruction([rhi, device, _Mesh]()
+			{
+				_Mesh->Unload(device);
+				rhi->DestroyMesh(_Mesh);
+			});
+	}
+
+	void ResourceManager::DestroyTexture(ITexture* _Texture)
+	{
+		IRendererHardware* rhi = m_RHI;
+		IDevice* device = m_Device;
+
+		m_DeferDestruction([rhi, device, _Texture]()
+			{
+				_Texture->Unload(device);
+				rhi->DestroyTexture(_Texture);
+			});
+	}
+
+	void ResourceManager::ShareResource(IResource* _Resource, const LoadCallback& _OnLoaded)
+	{
+		++m_HitCount;
+
+		if (!_OnLoaded)
+			return;
+
+		for (PendingLoad& load : m_PendingLoads)
+		{
+			if (load.resource.get() == _Resource)
+			{
+				load.callbacks.push_back(_OnLoaded);
+				return;
+			}
+		}
+
+		_OnLoaded(_Resource->GetState() == RESOURCE_READY);
+	}
+
+	void ResourceManager::AddPendingLoad(PendingLoad&& _Load, const LoadCallback& _OnLoaded)
+	{
+		++m_MissCount;
+
+		if (_OnLoaded)
+			_Load.callbacks.push_back(_OnLoaded);
+
+		m_PendingLoads.push_back(std::move(_Load));
+	}
+
+	void ResourceManager::FinishLoad(PendingLoad& _Load)
+	{
+		bool isLoaded = _Load.decoded.get() && _Load.upload();
+
+		_Load.resource->SetState(isLoaded ? RESOURCE_READY : RESOURCE_FAILED);
+
+		{
+			std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+			std::unordered_map<ResourceKey, ResourceEntry, ResourceKeyHash>::iterator entry = m_Entries.find(_Load.key);
+
+			if (entry != m_Entries.end() && entry->second.pointer == _Load.resource.get())
+			{
+				// A failed resource is not shared, the next request of the file loads it again
+				if (!isLoaded)
+				{
+					m_Entries.erase(entry);
+				}
+				else
+				{
+					entry->second.memorySize = _Load.key.type == RESOURCE_MESH ? static_cast<IMesh*>(_Load.resource.get())->GetMemorySize()
+						: static_cast<ITexture*>(_Load.resource.get())->GetMemorySize();
+				}
+			}
+		}
+
+		for (const LoadCallback& callback : _Load.callbacks)
+			callback(isLoaded);
+	}
+
+	void ResourceManager::WaitLoad(IResource* _Resource)
+	{
+		for (std::vector<PendingLoad>::iterator load = m_PendingLoads.begin(); load != m_PendingLoads.end(); ++load)
+		{
+			if (load->resource.get() == _Resource)
+			{
+				// Removed first, the callbacks may request other loads
+				PendingLoad finished = std::move(*load);
+				m_PendingLoads.erase(load);
+
+				FinishLoad(finished);
+				return;
+			}
+		}
+	}
+
+	unsigned int ResourceManager::ProcessLoads()
+	{
+		std::vector<PendingLoad> finished;
+
+		for (size_t i = 0; i < m_PendingLoads.size();)
+		{
+			if (m_PendingLoads[i].decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++i;
+				continue;
+			}
+
+			finished.push_back(std::move(m_PendingLoads[i]));
+			m_PendingLoads.erase(m_PendingLoads.begin() + i);
+		}
+
+		// Every upload is recorded before the next flush, they are sent in one submission
+		for (PendingLoad& load : finished)
+			FinishLoad(load);
+
+		return static_cast<unsigned int>(finished.size());
+	}
+
+	void ResourceManager::WaitPendingLoads()
+	{
+		while (!m_PendingLoads.empty())
+		{
+			std::vector<PendingLoad> finished = std::move(m_PendingLoads);
+			m_PendingLoads.clear();
+
+			for (PendingLoad& load : finished)
+				FinishLoad(load);
+		}
+	}
+
+	MeshHandle ResourceManager::LoadMesh(const std::filesystem::path& _ResourcePath, VertexFormat _VertexFormat)
+	{
+		MeshHandle mesh = LoadMeshAsync(_ResourcePath, _VertexFormat);
+		WaitLoad(mesh.get());
+
+		return mesh->IsReady() ? mesh : nullptr;
+	}
+
+	TextureHandle ResourceManager::LoadTexture(const std::filesystem::path& _ResourcePath)
+	{
+		TextureHandle texture = LoadTextureAsync(_ResourcePath);
+		WaitLoad(texture.get());
+
+		return texture->IsReady() ? texture : nullptr;
+	}
+
+	MeshHandle ResourceManager::LoadMeshAsync(const std::filesystem::path& _ResourcePath, VertexFormat _VertexFormat, const LoadCallback& _OnLoaded)
+	{
+		ResourceKey key = { RESOURCE_MESH, NormalizePath(_ResourcePath), static_cast<uint32_t>(_VertexFormat) };
+
+		std::unique_lock<std::mutex> lock(m_EntriesMutex);
+
+		if (std::shared_ptr<IResource> resource = FindResource(key))
+		{
+			lock.unlock();
+
+			ShareResource(resource.get(), _OnLoaded);
+			return std::static_pointer_cast<IMesh>(resource);
+		}
+
+		IMesh* mesh = m_RHI->CreateMesh();
+		mesh->SetVertexFormat(_VertexFormat);
+		mesh->SetState(RESOURCE_LOADING);
+
+		MeshHandle handle(mesh, [this, key](IMesh* _Mesh)
+			{
+				Release(key, _Mesh);
+				DestroyMesh(_Mesh);
+			});
+
+		ResourceEntry& entry = m_Entries[key];
+		entry.resource = handle;
+		entry.pointer = mesh;
+
+		lock.unlock();
+
+		// Shared by the decode and the upload, the mapped files and the arrays are freed by the last one
+		std::shared_ptr<DecodedMesh> decoded = std::make_shared<DecodedMesh>();
+		std::filesystem::path path = _ResourcePath;
+
+		PendingLoad load;
+		load.key = key;
+		load.resource = handle;
+		load.decoded = m_ThreadPool->Submit([mesh, decoded, path]()
+			{
+				return mesh->Decode(path, *decoded);
+			});
+		load.upload = [this, mesh, decoded]()
+			{
+				return mesh->Upload(m_Device, *decoded);
+			};
+
+		AddPendingLoad(std::move(load), _OnLoaded);
+
+		return handle;
+	}
+
+	TextureHandle ResourceManager::LoadTextureAsync(const std::filesystem::path& _ResourcePath, const LoadCallback& _OnLoaded)
+	{
+		ResourceKey key = { RESOURCE_TEXTURE, NormalizePath(_ResourcePath), 0 };
+
+		std::unique_lock<std::mutex> lock(m_EntriesMutex);
+
+		if (std::shared_ptr<IResource> resource = FindResource(key))
+		{
+			lock.unlock();
+
+			ShareResource(resource.get(), _OnLoaded);
+			return std::static_pointer_cast<ITexture>(resource);
+		}
+
+		ITexture* texture = m_RHI->CreateTexture();
+		texture->SetState(RESOURCE_LOADING);
+
+		TextureHandle handle(texture, [this, key](ITexture* _Texture)
+			{
+				Release(key, _Texture);
+				DestroyTexture(_Texture);
+			});
+
+		ResourceEntry& entry = m_Entries[key];
+		entry.resource = handle;
+		entry.pointer = texture;
+
+		lock.unlock();
+
+		std::shared_ptr<DecodedTexture> decoded = std::make_shared<DecodedTexture>();
+		std::filesystem::path path = _ResourcePath;
+
+		PendingLoad load;
+		load.key = key;
+		load.resource = handle;
+		load.decoded = m_ThreadPool->Submit([decoded, path]()
+			{
+				return ITexture::Decode(path, *decoded);
+			});
+		load.upload = [this, texture, decoded]()
+			{
+				return texture->Upload(m_Device, decoded->pixels.get(), decoded->width, decoded->height);
+			};
+
+		AddPendingLoad(std::move(load), _OnLoaded);
+
+		return handle;
+	}
+
+	std::vector<ResourceStatistics> ResourceManager::GetStatistics()
+	{
+		std::lock_guard<std::mutex> lock(m_EntriesMutex);
+
+		std::vector<ResourceStatistics> statistics;
+		statistics.reserve(m_Entries.size());
+
+		for (std::pair<const ResourceKey, ResourceEntry>& entry : m_Entries)
+		{
+			ResourceStatistics resource;
+			resource.type = entry.first.type;
+			resource.path = entry.first.path;
+			resource.memorySize = entry.second.memorySize;
+			resource.useCount = entry.second.resource.use_count();
+
+			if (resource.useCount > 0)
+				statistics.push_back(resource);
+		}
+
+		return statistics;
+	}
+
+	void ResourceManager::LogStatistics()
+	{
+		std::vector<ResourceStatistics> statistics = GetStatistics();
+		size_t totalSize = 0;
+
+		for (const ResourceStatistics& resource : statistics)
+		{
+			DEBUG_LOG("%s %s: %u KB, %u handles", resource.type == RESOURCE_MESH ? "Mesh" : "Texture", resource.path.c_str(),
+				static_cast<unsigned int>(resource.memorySize / 1024), static_cast<unsigned int>(resource.useCount));
+
+			totalSize += resource.memorySize;
+		}
+
+		DEBUG_LOG("%u resources loaded, %u KB, %u requests shared a loaded resource, %u loaded one", static_cast<unsigned int>(statistics.size()),
+			static_cast<unsigned int>(totalSize / 1024), GetHitCount(), GetMissCount());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "ShaderVariantSet.h"
+
+#include "Renderer.h"
+
+namespace Core
+{
+	const bool ShaderVariantSet::Load(const std::filesystem::path& _ResourcePath, const std::vector<std::string>& _Features)
+	{
+		if (_Features.size() > MAX_FEATURES)
+		{
+			DEBUG_ERROR("Too many features for shader %s: %u, maximum is %u", _ResourcePath.string().c_str(), static_cast<unsigned int>(_Features.size()), MAX_FEATURES);
+			return false;
+		}
+
+		if (!IShader::GetShaderType(_ResourcePath, m_ShaderType))
+			return false;
+
+		m_SourceCode.clear();
+
+#ifdef SHADER_RUNTIME_COMPILATION
+		// Only needed for the variants missing from the shader archive
+		if (!IShader::ReadShaderSource(_ResourcePath, m_SourceCode))
+			return false;
+#endif
+
+		m_ResourcePath = _ResourcePath;
+		m_Features = _Features;
+
+		// One slot per combination of features
+		m_VariantCount = static_cast<size_t>(1) << m_Features.size();
+		m_Variants = std::make_unique<std::atomic<IShader*>[]>(m_VariantCount);
+
+		for (size_t i = 0; i < m_VariantCount; ++i)
+			m_Variants[i].store(nullptr, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	void ShaderVariantSet::Unload(IDevice* _Device)
+	{
+		for (size_t i = 0; i < m_VariantCount; ++i)
+		{
+			IShader* variant = m_Variants[i].exchange(nullptr);
+
+			if (variant == nullptr)
+				continue;
+
+			variant->Unload(_Device);
+			Renderer::GetRHI()->DestroyShader(variant);
+		}
+	}
+
+	IShader* ShaderVariantSet::CompileVariant(IDevice* _Device, ShaderVariantKey _Key)
+	{
+		IShader* variant = Renderer::GetRHI()->CreateShader();
+
+		for (size_t i = 0; i < m_Features.size(); ++i)
+		{
+			if (_Key & (1u << i))
+				variant->AddMacroDefinition(m_Features[i]);
+		}
+
+		if (variant->LoadFromArchive(_Device, m_ResourcePath.filename().string()))
+			return variant;
+
+		variant->SetSourcePath(m_ResourcePath);
+
+		// Name shown in the compiler messages
+		std::string name = m_ResourcePath.filename().string() + "#" + std::to_string(_Key);
+
+		if (!variant->CompileShader(_Device, name.c_str(), m_SourceCode, m_ShaderType))
+		{
+			DEBUG_ERROR("Failed to compile variant %u of shader %s", _Key, m_ResourcePath.string().c_str());
+			variant->Unload(_Device);
+			Renderer::GetRHI()->DestroyShader(variant);
+			return nullptr;
+		}
+
+		return variant;
+	}
+
+	IShader* ShaderVariantSet::GetVariant(IDevice* _Device, ShaderVariantKey _Key)
+	{
+		if (_Key >= m_VariantCount)
+		{
+			DEBUG_ERROR("Invalid variant key %u for shader %s", _Key, m_ResourcePath.string().c_str());
+			return nullptr;
+		}
+
+		IShader* variant = m_Variants[_Key].load(std::memory_order_acquire);
+
+		if (variant != nullptr)
+			return variant;
+
+		IShader* compiledVariant = CompileVariant(_Device, _Key);
+
+		if (compiledVariant == nullptr)
+			return nullptr;
+
+		// Another thread may have compiled the same variant meanwhile, the first one stored is kept
+		IShader* expected = nullptr;
+
+		if (!m_Variants[_Key].compare_exchange_strong(expected, compiledVariant, std::memory_order_acq_rel))
+		{
+			compiledVariant->Unload(_Device);
+			Renderer::GetRHI()->DestroyShader(compiledVariant);
+			return expected;
+		}
+
+		return compiledVariant;
+	}
+
+	const bool ShaderVariantSet::Precompile(IDevice* _Device, const std::vector<ShaderVariantKey>& _Keys)
+	{
+		std::vector<std::future<IShader*>> compilations;
+		compilations.reserve(_Keys.size());
+
+		for (ShaderVariantKey key : _Keys)
+		{
+			compilations.push_back(Renderer::GetThreadPool()->Submit([this, _Device, key]()
+				{
+					return GetVariant(_Device, key);
+				}));
+		}
+
+		bool allCompiled = true;
+
+		for (std::future<IShader*>& compilation : compilations)
+		{
+			if (compilation.get() == nullptr)
+				allCompiled = false;
+		}
+
+		return allCompiled;
+	}
+
+	ShaderVariantKey ShaderVariantSet::GetFeatureBit(const std::string& _Feature) const
+	{
+		for (size_t i = 0; i < m_Features.size(); ++i)
+		{
+			if (m_Features[i] == _Feature)
+				return 1u << i;
+		}
+
+		DEBUG_WARN("Shader %s has no feature %s", m_ResourcePath.string().c_str(), _Feature.c_str());
+
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,669 @@
+#include "RHI/RenderGraph.h"
+#include "RHI/VertexLayout.h"
+#include "Threading/ThreadPool.h"
+#include "ObjParser.h"
+#include "MeshOptimizer.h"
+#include "ClusterCuller.h"
+#include "Debug/Log.h"
+
+// Implemented by VulkanRenderer.cpp in the renderer, ObjParser::ParseReference needs it here
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <random>
+#include <tuple>
+
+// Benchmarks and checks of the parts of the renderer running on the CPU only, no window or device is created
+// Usage: Benchmarks [name...], runs every benchmark without a name, the paths are relative to the working directory of the renderer
+// Returns -1 when a check fails
+
+using namespace Core;
+
+static const char* VIKING_ROOM_MESH_PATH = "Assets/Meshes/viking_room.obj";
+static const char* MINECRAFT_MESH_PATH = "Assets/Meshes/minecraft.obj";
+
+// Same threshold as the import of the meshes, IMesh::OVERDRAW_CACHE_THRESHOLD
+static const float OVERDRAW_CACHE_THRESHOLD = 1.05f;
+
+/// <summary>
+/// Compiles a generated render graph with transients, passes to cull, reads and writes, logs the time and checks the result of the compilation
+/// </summary>
+/// <param name="_PassCount">: Passes of the graph, rounded down to groups of 3 plus the present pass </param>
+/// <param name="_RunCount">: Compilations, the fastest is kept </param>
+/// <returns></returns>
+static const bool BenchmarkRenderGraph(unsigned int _PassCount, unsigned int _RunCount)
+{
+	// Groups of 3 passes - one writes a transient, one lights it into an accumulation read by the next group, one writes a debug view nobody reads
+	const unsigned int groupCount = _PassCount > 1 ? (_PassCount - 1) / 3 : 0;
+
+	if (groupCount < 2)
+	{
+		DEBUG_ERROR("Render graph benchmark needs at least 7 passes");
+		return false;
+	}
+
+	RenderGraphTextureDesc desc;
+	desc.width = 1920;
+	desc.height = 1080;
+	desc.format = RG_FORMAT_RGBA8;
+
+	RenderGraph graph;
+
+	RenderGraphResource backbuffer = graph.ImportTexture("Backbuffer", desc, RG_ACCESS_NONE, RG_ACCESS_PRESENT);
+	RenderGraphResource previousAccumulation = 0;
+
+	std::vector<RenderGraphPassHandle> expectedOrder;
+	std::vector<RenderGraphPassHandle> expectedCulled;
+
+	for (unsigned int group = 0; group < groupCount; ++group)
+	{
+		std::string suffix = std::to_string(group);
+
+		RenderGraphResource gbuffer = graph.CreateTexture("GBuffer" + suffix, desc);
+		RenderGraphResource accumulation = graph.CreateTexture("Accumulation" + suffix, desc);
+		RenderGraphResource debugView = graph.CreateTexture("DebugView" + suffix, desc);
+
+		RenderGraphPassHandle gbufferPass = graph.AddPass("GBuffer" + suffix, nullptr);
+		graph.Write(gbufferPass, gbuffer, RG_ACCESS_COLOR_ATTACHMENT);
+
+		RenderGraphPassHandle lightingPass = graph.AddPass("Lighting" + suffix, nullptr);
+		graph.Read(lightingPass, gbuffer, RG_ACCESS_SHADER_READ);
+
+		if (group > 0)
+			graph.Read(lightingPass, previousAccumulation, RG_ACCESS_SHADER_READ);
+
+		graph.Write(lightingPass, accumulation, RG_ACCESS_COLOR_ATTACHMENT);
+
+		RenderGraphPassHandle debugPass = graph.AddPass("Debug" + suffix, nullptr);
+		graph.Read(debugPass, gbuffer, RG_ACCESS_SHADER_READ);
+		graph.Write(debugPass, debugView, RG_ACCESS_COLOR_ATTACHMENT);
+
+		expectedOrder.push_back(gbufferPass);
+		expectedOrder.push_back(lightingPass);
+		expectedCulled.push_back(debugPass);
+
+		previousAccumulation = accumulation;
+	}
+
+	RenderGraphPassHandle presentPass = graph.AddPass("Present", nullptr);
+	graph.Read(presentPass, previousAccumulation, RG_ACCESS_SHADER_READ);
+	graph.Write(presentPass, backbuffer, RG_ACCESS_COLOR_ATTACHMENT);
+	graph.MarkOutput(backbuffer);
+
+	expectedOrder.push_back(presentPass);
+
+	double compileTime = 0.0;
+
+	for (unsigned int run = 0; run < _RunCount; ++run)
+	{
+		graph.Compile();
+		compileTime = run == 0 ? graph.GetCompileTime() : std::min(compileTime, graph.GetCompileTime());
+	}
+
+	bool isOrderValid = graph.GetExecutionOrder() == expectedOrder;
+	bool isCullingValid = true;
+
+	for (RenderGraphPassHandle pass : expectedCulled)
+		isCullingValid &= graph.GetPass(pass).isCulled;
+
+	// One barrier to start the gbuffer, the lighting moves the gbuffer and the previous accumulation to reads and starts its own, the present reads the last accumulation and starts the backbuffer
+	size_t barrierCount = 0;
+
+	for (RenderGraphPassHandle pass = 0; pass < graph.GetPassCount(); ++pass)
+		barrierCount += graph.GetPass(pass).barriers.size();
+
+	size_t expectedBarrierCount = 4 * static_cast<size_t>(groupCount) + 1;
+	bool areBarriersValid = barrierCount == expectedBarrierCount && graph.GetFinalBarriers().size() == 1;
+
+	// A gbuffer, the accumulation it is lit into and the previous accumulation are alive at the same time, every other transient reuses their blocks
+	size_t textureSize = static_cast<size_t>(desc.width) * desc.height * RenderGraph::GetFormatSize(desc.format);
+	bool isAliasingValid = graph.GetTransientMemorySize() == 3 * textureSize && graph.GetUnaliasedMemorySize() == 2 * groupCount * textureSize;
+
+	DEBUG_LOG("Render graph of %u passes compiled in %f ms, %u passes executed, %u culled, %u barriers, %u MB of transients aliased in %u MB", static_cast<unsigned int>(graph.GetPassCount()),
+		compileTime, static_cast<unsigned int>(graph.GetExecutionOrder().size()), static_cast<unsigned int>(graph.GetPassCount() - graph.GetExecutionOrder().size()),
+		static_cast<unsigned int>(barrierCount + graph.GetFinalBarriers().size()), static_cast<unsigned int>(graph.GetUnaliasedMemorySize() / (1024 * 1024)),
+		static_cast<unsigned int>(graph.GetTransientMemorySize() / (1024 * 1024)));
+
+	// A pass reading and writing the same texture gets one barrier with both accesses, not one per access
+	RenderGraph readWriteGraph;
+
+	RenderGraphResource target = readWriteGraph.ImportTexture("Backbuffer", desc, RG_ACCESS_NONE, RG_ACCESS_PRESENT);
+	RenderGraphResource history = readWriteGraph.CreateTexture("History", desc);
+
+	RenderGraphPassHandle writePass = readWriteGraph.AddPass("Write", nullptr);
+	readWriteGraph.Write(writePass, history, RG_ACCESS_COLOR_ATTACHMENT);
+
+	RenderGraphPassHandle readWritePass = readWriteGraph.AddPass("ReadWrite", nullptr);
+	readWriteGraph.Read(readWritePass, history, RG_ACCESS_SHADER_READ);
+	readWriteGraph.Write(readWritePass, history, RG_ACCESS_TRANSFER_WRITE);
+
+	RenderGraphPassHandle resolvePass = readWriteGraph.AddPass("Resolve", nullptr);
+	readWriteGraph.Read(resolvePass, history, RG_ACCESS_SHADER_READ);
+	readWriteGraph.Write(resolvePass, target, RG_ACCESS_COLOR_ATTACHMENT);
+	readWriteGraph.MarkOutput(target);
+
+	readWriteGraph.Compile();
+
+	const std::vector<RenderGraphBarrier>& readWriteBarriers = readWriteGraph.GetPass(readWritePass).barriers;
+	bool isReadWriteValid = readWriteBarriers.size() == 1 && readWriteBarriers[0].resource == history && readWriteBarriers[0].srcAccess == RG_ACCESS_COLOR_ATTACHMENT
+		&& readWriteBarriers[0].dstAccess == (RG_ACCESS_SHADER_READ | RG_ACCESS_TRANSFER_WRITE);
+
+	if (!isOrderValid)
+		DEBUG_ERROR("Render graph benchmark: the execution order is not the expected one");
+
+	if (!isCullingValid)
+		DEBUG_ERROR("Render graph benchmark: a pass writing a resource nobody reads was not culled");
+
+	if (!areBarriersValid)
+		DEBUG_ERROR("Render graph benchmark: %u barriers instead of %u", static_cast<unsigned int>(barrierCount), static_cast<unsigned int>(expectedBarrierCount));
+
+	if (!isAliasingValid)
+		DEBUG_ERROR("Render graph benchmark: %u aliased blocks instead of 3", static_cast<unsigned int>(graph.GetPhysicalResources().size()));
+
+	if (!isReadWriteValid)
+		DEBUG_ERROR("Render graph benchmark: %u barriers for a pass reading and writing the same texture instead of one with both accesses", static_cast<unsigned int>(readWriteBarriers.size()));
+
+	return isOrderValid && isCullingValid && areBarriersValid && isAliasingValid && isReadWriteValid;
+}
+
+/// <summary>
+/// Builds the meshlets of an OBJ file then culls them from cameras turning around it, logs the times and the culled meshlets
+/// </summary>
+/// <param name="_ResourcePath">: OBJ file measured </param>
+/// <param name="_RunCount">: Runs of the meshlet building, the fastest is kept </param>
+/// <returns></returns>
+static const bool BenchmarkClusterCulling(const std::filesystem::path& _ResourcePath, unsigned int _RunCount)
+{
+	ObjData objData;
+
+	if (ObjParser::Parse(_ResourcePath, objData) != OBJ_PARSE_SUCCESS && !ObjParser::ParseReference(_ResourcePath, objData))
+	{
+		DEBUG_ERROR("Failed to open cluster culling benchmark file: %s", _ResourcePath.string().c_str());
+		return false;
+	}
+
+	// Only the positions matter, the triangles are in the order of the import
+	std::vector<uint32_t> indices(objData.indices.size());
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		indices[i] = static_cast<uint32_t>(objData.indices[i].position);
+
+	size_t vertexCount = objData.positions.size() / 3;
+
+	if (indices.empty() || vertexCount == 0)
+	{
+		DEBUG_ERROR("Cluster culling benchmark file has no triangles: %s", _ResourcePath.string().c_str());
+		return false;
+	}
+
+	MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+
+	Submesh submesh;
+	submesh.indexCount = static_cast<uint32_t>(indices.size());
+
+	std::vector<Meshlet> meshlets;
+	double buildTime = 0.0;
+
+	for (unsigned int run = 0; run < _RunCount; ++run)
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		MeshOptimizer::BuildMeshlets(indices.data(), &submesh, 1, objData.positions.data(), 3 * sizeof(float), meshlets);
+
+		std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+		buildTime = run == 0 ? time.count() : std::min(buildTime, time.count());
+	}
+
+	size_t meshletVertexCount = 0;
+
+	for (const Meshlet& meshlet : meshlets)
+		meshletVertexCount += meshlet.vertexCount;
+
+	DEBUG_LOG("%s: %u meshlets built in %f ms (%f M triangles/s), %f triangles and %f vertices per meshlet", _ResourcePath.filename().string().c_str(),
+		static_cast<unsigned int>(meshlets.size()), buildTime, indices.size() / 3 / (buildTime * 1000.0), static_cast<float>(indices.size() / 3) / meshlets.size(),
+		static_cast<float>(meshletVertexCount) / meshlets.size());
+
+	MeshBounds bounds = MeshOptimizer::ComputeBounds(objData.positions.data(), 3 * sizeof(float), vertexCount);
+
+	float center[3];
+	float extent = 0.f;
+
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		center[axis] = (bounds.min[axis] + bounds.max[axis]) * 0.5f;
+		extent = std::max(extent, bounds.max[axis] - bounds.min[axis]);
+	}
+
+	Math::Matrix4 projection = Math::Matrix4::ProjectionPerspectiveMatrix(0.01f, 100.f * extent, 1920.f / 1080.f, 45.f);
+
+	// Cameras turning around the mesh, the whole mesh is in view from the far ones and only a part of it from the near ones
+	const unsigned int viewCount = 64;
+	const float distances[2] = { 2.f * extent, 0.4f * extent };
+
+	for (float distance : distances)
+	{
+		std::vector<Submesh> draws;
+		LowRenderer::ClusterCullingStatistics total;
+		double cullTime = 0.0;
+
+		for (unsigned int run = 0; run < _RunCount; ++run)
+		{
+			LowRenderer::ClusterCullingStatistics sum;
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			for (unsigned int i = 0; i < viewCount; ++i)
+			{
+				float angle = 6.28318530718f * i / viewCount;
+				float forward[3] = { -std::sin(angle), -0.25f, -std::cos(angle) };
+				Math::Vector3 eye(center[0] - forward[0] * distance, center[1] - forward[1] * distance, center[2] - forward[2] * distance);
+
+				// The rotation is built at the origin then moved to the eye, the view looks down its positive z axis like the projection expects
+				Math::Matrix4 view = Math::Matrix4::ViewMatrix(Math::Vector3(0.f, 0.f, 0.f), Math::Vector3(-forward[0], -forward[1], -forward[2]), Math::Vector3(0.f, 1.f, 0.f))
+					.Multiply(Math::Matrix4::Translate(-eye.m_X, -eye.m_Y, -eye.m_Z));
+
+				LowRenderer::ClusterCullingView cullingView = LowRenderer::ClusterCuller::MakeView(projection.Multiply(view), true, true);
+				LowRenderer::ClusterCullingStatistics statistics;
+
+				LowRenderer::ClusterCuller::Cull(meshlets, cullingView, draws, &statistics);
+
+				sum.meshletCount += statistics.meshletCount;
+				sum.frustumCulledCount += statistics.frustumCulledCount;
+				sum.backfaceCulledCount += statistics.backfaceCulledCount;
+				sum.drawCount += statistics.drawCount;
+			}
+
+			std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+			cullTime = run == 0 ? time.count() : std::min(cullTime, time.count());
+			total = sum;
+		}
+
+		DEBUG_LOG("%s seen from %f times its size: %f ns per meshlet, %f percent out of the frustum, %f percent back facing, %f draws per view instead of %u meshlets", _ResourcePath.filename().string().c_str(),
+			distance / extent, cullTime * 1000000.0 / total.meshletCount, 100.f * total.frustumCulledCount / total.meshletCount, 100.f * total.backfaceCulledCount / total.meshletCount,
+			static_cast<float>(total.drawCount) / viewCount, static_cast<unsigned int>(meshlets.size()));
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Parses an OBJ file with 1, 2, 4, 8 and 16 threads then with tinyobjloader, logs the throughputs and checks the geometry is the same
+/// </summary>
+/// <param name="_ResourcePath">: OBJ file parsed </param>
+/// <param name="_RunCount">: Runs per thread count, the fastest is kept </param>
+/// <returns></returns>
+static const bool BenchmarkObjParser(const std::filesystem::path& _ResourcePath, unsigned int _RunCount)
+{
+	std::error_code error;
+	double fileSize = static_cast<double>(std::filesystem::file_size(_ResourcePath, error)) / (1024.0 * 1024.0);
+
+	if (error)
+	{
+		DEBUG_ERROR("Failed to open benchmark OBJ file: %s", _ResourcePath.string().c_str());
+		return false;
+	}
+
+	ObjData reference;
+
+	std::chrono::high_resolution_clock::time_point referenceStart = std::chrono::high_resolution_clock::now();
+
+	if (!ObjParser::ParseReference(_ResourcePath, reference))
+		return false;
+
+	std::chrono::duration<double, std::milli> referenceTime = std::chrono::high_resolution_clock::now() - referenceStart;
+	DEBUG_LOG("%s parsed by tinyobjloader in %f ms, %f MB/s", _ResourcePath.filename().string().c_str(), referenceTime.count(), fileSize * 1000.0 / referenceTime.count());
+
+	const unsigned int threadCounts[] = { 1, 2, 4, 8, 16 };
+	bool isValid = true;
+
+	for (unsigned int threadCount : threadCounts)
+	{
+		// The calling thread parses too
+		std::unique_ptr<ThreadPool> pool = threadCount > 1 ? std::make_unique<ThreadPool>(threadCount - 1) : nullptr;
+
+		double bestTime = 0.0;
+		bool isIdentical = true;
+
+		for (unsigned int run = 0; run < _RunCount; ++run)
+		{
+			ObjData data;
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+			ObjParseResult result = ObjParser::Parse(_ResourcePath, data, pool.get());
+
+			std::chrono::duration<double, std::milli> time = std::chrono::high_resolution_clock::now() - start;
+			bestTime = run == 0 ? time.count() : std::min(bestTime, time.count());
+
+			isIdentical = isIdentical && result == OBJ_PARSE_SUCCESS && data.positions == reference.positions && data.textCoords == reference.textCoords && data.normals == reference.normals
+				&& data.indices.size() == reference.indices.size() && memcmp(data.indices.data(), reference.indices.data(), data.indices.size() * sizeof(ObjIndex)) == 0;
+		}
+
+		DEBUG_LOG("%s parsed with %u threads in %f ms, %f MB/s", _ResourcePath.filename().string().c_str(), threadCount, bestTime, fileSize * 1000.0 / bestTime);
+
+		if (!isIdentical)
+		{
+			DEBUG_ERROR("OBJ parser benchmark: the geometry parsed with %u threads differs from tinyobjloader", threadCount);
+			isValid = false;
+		}
+	}
+
+	return isValid;
+}
+
+// Rounds with double arithmetic, independent from the bit manipulations of VertexEncoder::FloatToHalf
+static uint16_t ReferenceFloatToHalf(float _Value)
+{
+	uint16_t sign = std::signbit(_Value) ? 0x8000 : 0;
+	double magnitude = std::abs(static_cast<double>(_Value));
+
+	if (std::isnan(_Value))
+		return sign | 0x7E00;
+
+	if (magnitude == 0.0)
+		return sign;
+
+	// Subnormal halves share the step of the smallest exponent
+	int exponent = 0;
+	std::frexp(magnitude, &exponent);
+	exponent = std::max(exponent - 1, -14);
+
+	// Ties to even with the default rounding mode, a rounded up mantissa carries into the exponent bits
+	double steps = std::nearbyint(std::ldexp(magnitude, 10 - exponent));
+	double bits = std::ldexp(static_cast<double>(exponent + 14), 10) + steps;
+
+	return sign | static_cast<uint16_t>(std::min(bits, static_cast<double>(0x7C00)));
+}
+
+static float ReferenceHalfToFloat(uint16_t _Half)
+{
+	int exponent = (_Half >> 10) & 0x1F;
+	int mantissa = _Half & 0x3FF;
+	double value = 0.0;
+
+	if (exponent == 31)
+		value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+	else if (exponent == 0)
+		value = std::ldexp(static_cast<double>(mantissa), -24);
+	else
+		value = std::ldexp(static_cast<double>(1024 + mantissa), exponent - 25);
+
+	return static_cast<float>((_Half & 0x8000) != 0 ? -value : value);
+}
+
+/// <summary>
+/// Compares the half conversions of the vertex encoder with a reference conversion and measures the error of the octahedral normals
+/// </summary>
+/// <param name="_FloatStride">: Step between the bit patterns of the floats converted, 171 checks about 25M floats </param>
+/// <param name="_NormalCount">: Random unit vectors encoded and decoded </param>
+/// <returns></returns>
+static const bool TestVertexQuantization(unsigned int _FloatStride, unsigned int _NormalCount)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	unsigned int halfMismatchCount = 0;
+	unsigned int floatMismatchCount = 0;
+	uint64_t floatCount = 0;
+
+	auto checkFloat = [&floatMismatchCount, &floatCount](float _Value)
+		{
+			++floatCount;
+
+			if (!std::isnan(_Value) && VertexEncoder::FloatToHalf(_Value) != ReferenceFloatToHalf(_Value))
+				++floatMismatchCount;
+		};
+
+	for (uint32_t half = 0; half <= 0xFFFF; ++half)
+	{
+		float value = VertexEncoder::HalfToFloat(static_cast<uint16_t>(half));
+		float reference = ReferenceHalfToFloat(static_cast<uint16_t>(half));
+
+		// Any NaN is accepted, the other values have to be the same bits and to convert back to the same half
+		if (std::isnan(reference))
+		{
+			if (!std::isnan(value))
+				++halfMismatchCount;
+
+			continue;
+		}
+
+		if (std::memcmp(&value, &reference, sizeof(value)) != 0 || VertexEncoder::FloatToHalf(value) != half)
+			++halfMismatchCount;
+
+		// The floats half way between two halves and their neighbours check the ties
+		if ((half & 0x7FFF) < 0x7BFF)
+		{
+			float middle = (value + VertexEncoder::HalfToFloat(static_cast<uint16_t>(half + 1))) * 0.5f;
+
+			checkFloat(middle);
+			checkFloat(std::nextafter(middle, 0.f));
+			checkFloat(std::nextafter(middle, std::numeric_limits<float>::infinity() * middle));
+		}
+	}
+
+	// Floats spread over all the exponents, infinities and overflows included
+	for (uint64_t bits = 0; bits <= 0xFFFFFFFFull; bits += _FloatStride)
+	{
+		uint32_t floatBits = static_cast<uint32_t>(bits);
+		float value = 0.f;
+		std::memcpy(&value, &floatBits, sizeof(value));
+
+		checkFloat(value);
+	}
+
+	std::chrono::duration<double, std::milli> halfTime = std::chrono::high_resolution_clock::now() - start;
+
+	DEBUG_LOG("Half conversion: 65536 halves and %u floats checked against the reference in %f ms, %u half mismatches, %u float mismatches", static_cast<unsigned int>(floatCount),
+		halfTime.count(), halfMismatchCount, floatMismatchCount);
+
+	bool isHalfExact = halfMismatchCount == 0 && floatMismatchCount == 0;
+
+	if (!isHalfExact)
+		DEBUG_ERROR("Vertex quantization test: the half conversion is not bit exact");
+
+	// Random directions, uniform on the sphere
+	std::mt19937 generator(42);
+	std::normal_distribution<float> distribution(0.f, 1.f);
+
+	double maxError = 0.0;
+	double errorSum = 0.0;
+	double maxLengthError = 0.0;
+
+	for (unsigned int i = 0; i < _NormalCount; ++i)
+	{
+		float normal[3] = { distribution(generator), distribution(generator), distribution(generator) };
+		double length = std::sqrt(static_cast<double>(normal[0]) * normal[0] + static_cast<double>(normal[1]) * normal[1] + static_cast<double>(normal[2]) * normal[2]);
+
+		if (length < 1e-6)
+			continue;
+
+		int16_t encoded[2] = {};
+		float decoded[3] = {};
+
+		VertexEncoder::EncodeOctahedral(normal, encoded);
+		VertexEncoder::DecodeOctahedral(encoded, decoded);
+
+		double cosine = (normal[0] * static_cast<double>(decoded[0]) + normal[1] * static_cast<double>(decoded[1]) + normal[2] * static_cast<double>(decoded[2])) / length;
+		double decodedLength = std::sqrt(static_cast<double>(decoded[0]) * decoded[0] + static_cast<double>(decoded[1]) * decoded[1] + static_cast<double>(decoded[2]) * decoded[2]);
+
+		// The cosine is divided by the decoded length so the angle does not see its rounding
+		double angle = std::acos(std::clamp(cosine / decodedLength, -1.0, 1.0)) * 57.29577951308232;
+
+		maxError = std::max(maxError, angle);
+		errorSum += angle;
+		maxLengthError = std::max(maxLengthError, std::abs(decodedLength - 1.0));
+	}
+
+	DEBUG_LOG("Octahedral normals: %u vectors, max error %f degrees, mean error %f degrees, max length error %f", _NormalCount, maxError, errorSum / std::max(_NormalCount, 1u), maxLengthError);
+
+	// Two snorm16 components keep the error under 0.01 degrees, anything far above is a folding or rounding bug
+	bool isOctahedralAccurate = maxError <= 0.02 && maxLengthError <= 1e-5;
+
+	if (!isOctahedralAccurate)
+		DEBUG_ERROR("Vertex quantization test: the octahedral error is higher than expected");
+
+	return isHalfExact && isOctahedralAccurate;
+}
+
+/// <summary>
+/// Optimizes the triangles and the vertices of an OBJ file like its import, checks the cache and fetch statistics improve and no triangle is lost or flipped
+/// </summary>
+/// <param name="_ResourcePath">: OBJ file optimized </param>
+/// <returns></returns>
+static const bool TestMeshOptimization(const std::filesystem::path& _ResourcePath)
+{
+	ObjData objData;
+
+	if (ObjParser::Parse(_ResourcePath, objData) != OBJ_PARSE_SUCCESS && !ObjParser::ParseReference(_ResourcePath, objData))
+	{
+		DEBUG_ERROR("Failed to open mesh optimization test file: %s", _ResourcePath.string().c_str());
+		return false;
+	}
+
+	// Welded like the import, one vertex per different position, texture coordinate and normal
+	std::map<std::tuple<int, int, int>, uint32_t> vertexIds;
+	std::vector<float> positions;
+	std::vector<uint32_t> indices(objData.indices.size());
+
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		const ObjIndex& objIndex = objData.indices[i];
+		auto inserted = vertexIds.emplace(std::make_tuple(objIndex.position, objIndex.textCoord, objIndex.normal), static_cast<uint32_t>(vertexIds.size()));
+
+		if (inserted.second)
+			positions.insert(positions.end(), objData.positions.begin() + 3 * objIndex.position, objData.positions.begin() + 3 * objIndex.position + 3);
+
+		indices[i] = inserted.first->second;
+	}
+
+	size_t vertexCount = vertexIds.size();
+
+	if (indices.empty())
+	{
+		DEBUG_ERROR("Mesh optimization test file has no triangles: %s", _ResourcePath.string().c_str());
+		return false;
+	}
+
+	size_t vertexSize = VertexLayout::Get(RHI_VERTEX_FORMAT_DEFAULT).GetStride();
+
+	VertexCacheStatistics cacheBefore = MeshOptimizer::AnalyzeVertexCache(indices, vertexCount);
+	VertexFetchStatistics fetchBefore = MeshOptimizer::AnalyzeVertexFetch(indices, vertexCount, vertexSize);
+
+	// Only the cache order, the order against overdraw must not cost more than the threshold over it
+	std::vector<uint32_t> cacheIndices = indices;
+	std::vector<uint32_t> cacheRemap;
+	MeshOptimizer::OptimizeVertexCache(cacheIndices, vertexCount);
+	MeshOptimizer::OptimizeVertexFetch(cacheIndices, vertexCount, cacheRemap);
+
+	VertexCacheStatistics cacheOnly = MeshOptimizer::AnalyzeVertexCache(cacheIndices, vertexCount);
+	VertexFetchStatistics fetchCacheOnly = MeshOptimizer::AnalyzeVertexFetch(cacheIndices, vertexCount, vertexSize);
+
+	std::vector<uint32_t> optimizedIndices = indices;
+	std::vector<uint32_t> remap;
+	MeshOptimizer::OptimizeMesh(optimizedIndices, positions.data(), 3 * sizeof(float), vertexCount, vertexSize, OVERDRAW_CACHE_THRESHOLD, remap);
+
+	VertexCacheStatistics cacheAfter = MeshOptimizer::AnalyzeVertexCache(optimizedIndices, vertexCount);
+	VertexFetchStatistics fetchAfter = MeshOptimizer::AnalyzeVertexFetch(optimizedIndices, vertexCount, vertexSize);
+
+	DEBUG_LOG("%s: ACMR %f -> %f (%f with the cache order only), ATVR %f -> %f, overfetch %f -> %f (%f with the cache order only)", _ResourcePath.filename().string().c_str(),
+		cacheBefore.acmr, cacheAfter.acmr, cacheOnly.acmr, cacheBefore.atvr, cacheAfter.atvr, fetchBefore.overfetch, fetchAfter.overfetch, fetchCacheOnly.overfetch);
+
+	// Every triangle is still there with the same winding, each one starts at its smallest vertex to compare them
+	std::vector<uint32_t> originalVertices(vertexCount);
+
+	for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+		originalVertices[remap[vertex]] = vertex;
+
+	auto sortTriangles = [](const std::vector<uint32_t>& _Indices, const uint32_t* _Vertices)
+		{
+			std::vector<std::array<uint32_t, 3>> triangles(_Indices.size() / 3);
+
+			for (size_t i = 0; i < triangles.size(); ++i)
+			{
+				std::array<uint32_t, 3> triangle = { _Indices[3 * i], _Indices[3 * i + 1], _Indices[3 * i + 2] };
+
+				if (_Vertices != nullptr)
+					triangle = { _Vertices[triangle[0]], _Vertices[triangle[1]], _Vertices[triangle[2]] };
+
+				std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+				triangles[i] = triangle;
+			}
+
+			std::sort(triangles.begin(), triangles.end());
+
+			return triangles;
+		};
+
+	bool areTrianglesKept = optimizedIndices.size() == indices.size() && sortTriangles(optimizedIndices, originalVertices.data()) == sortTriangles(indices, nullptr);
+	// A mesh sharing no vertex between its faces, like the minecraft one, is transformed once per vertex before any optimization and cannot do better
+	bool isCacheOptimal = cacheBefore.atvr <= 1.0f;
+	bool isCacheBetter = cacheAfter.acmr <= cacheBefore.acmr && cacheAfter.atvr <= cacheBefore.atvr && (isCacheOptimal || cacheAfter.atvr < cacheBefore.atvr)
+		&& cacheAfter.acmr <= cacheOnly.acmr * OVERDRAW_CACHE_THRESHOLD;
+	bool isFetchBetter = fetchAfter.overfetch <= fetchBefore.overfetch && fetchAfter.overfetch <= fetchCacheOnly.overfetch;
+
+	if (!areTrianglesKept)
+		DEBUG_ERROR("Mesh optimization test: the triangles of %s changed", _ResourcePath.filename().string().c_str());
+
+	if (!isCacheBetter)
+		DEBUG_ERROR("Mesh optimization test: the vertex cache of %s is not used better", _ResourcePath.filename().string().c_str());
+
+	if (!isFetchBetter)
+		DEBUG_ERROR("Mesh optimization test: the vertices of %s are fetched more than before", _ResourcePath.filename().string().c_str());
+
+	return areTrianglesKept && isCacheBetter && isFetchBetter;
+}
+
+struct Benchmark
+{
+	const char* name = "";
+	std::function<bool()> run;
+};
+
+int main(int _Argc, char** _Argv)
+{
+	const std::vector<Benchmark> benchmarks = {
+		{ "render_graph", []() { return BenchmarkRenderGraph(100, 10); } },
+		{ "obj_parser", []() { return BenchmarkObjParser(MINECRAFT_MESH_PATH, 5); } },
+		{ "cluster_culling", []() { return BenchmarkClusterCulling(VIKING_ROOM_MESH_PATH, 5) && BenchmarkClusterCulling(MINECRAFT_MESH_PATH, 5); } },
+		{ "vertex_quantization", []() { return TestVertexQuantization(171, 2000000); } },
+		{ "mesh_optimization", []() { return TestMeshOptimization(VIKING_ROOM_MESH_PATH) && TestMeshOptimization(MINECRAFT_MESH_PATH); } }
+	};
+
+	std::vector<std::string> selected(_Argv + std::min(_Argc, 1), _Argv + _Argc);
+
+	for (const std::string& name : selected)
+	{
+		if (std::none_of(benchmarks.begin(), benchmarks.end(), [&name](const Benchmark& _Benchmark) { return name == _Benchmark.name; }))
+		{
+			DEBUG_ERROR("Unknown benchmark: %s", name.c_str());
+			return -1;
+		}
+	}
+
+	unsigned int failedCount = 0;
+
+	for (const Benchmark& benchmark : benchmarks)
+	{
+		if (!selected.empty() && std::find(selected.begin(), selected.end(), benchmark.name) == selected.end())
+			continue;
+
+		if (!benchmark.run())
+		{
+			DEBUG_ERROR("Benchmark failed: %s", benchmark.name);
+			++failedCount;
+		}
+	}
+
+	if (failedCount > 0)
+		return -1;
+
+	DEBUG_LOG("All the benchmarks passed");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "RHI/ShaderArchive.h"
+#include "RHI/ShaderIncluder.h"
+#include "Debug/Log.h"
+
+#include <spirv-tools/libspirv.hpp>
+#include <spirv-tools/optimizer.hpp>
+
+#include <fstream>
+#include <sstream>
+
+// Offline compilation of the shaders listed in a manifest, every variant is optimized and written in one archive mapped by the renderer
+// Usage: ShaderBaker [manifest] [archive], the paths are relative to the working directory of the renderer by default
+
+static const char* DEFAULT_MANIFEST_PATH = "Assets/Shaders/Shaders.manifest";
+static const char* DEFAULT_ARCHIVE_PATH = "Assets/Shaders/Shaders.archive";
+
+// Same limit as the variant sets of the renderer
+static const size_t MAX_FEATURES = 12;
+
+struct ManifestShader
+{
+	std::filesystem::path path;
+	std::vector<std::string> features;
+};
+
+struct BakeStatistics
+{
+	unsigned int variantCount = 0;
+	size_t unoptimizedSize = 0;
+	size_t optimizedSize = 0;
+};
+
+/// <summary>
+/// Reads the manifest, one GLSL file per line followed by its features, '#' starts a comment
+/// </summary>
+/// <param name="_ManifestPath">: Path of the manifest, the shaders are relative to it </param>
+/// <param name="_Shaders">: Receives the shaders to bake </param>
+/// <returns></returns>
+static const bool ReadManifest(const std::filesystem::path& _ManifestPath, std::vector<ManifestShader>& _Shaders)
+{
+	std::ifstream manifest(_ManifestPath);
+
+	if (!manifest.is_open())
+	{
+		DEBUG_ERROR("Failed to open shader manifest: %s", _ManifestPath.string().c_str());
+		return false;
+	}
+
+	std::string line = "";
+
+	while (std::getline(manifest, line))
+	{
+		line = line.substr(0, line.find('#'));
+
+		std::istringstream tokens(line);
+		std::string fileName = "";
+
+		if (!(tokens >> fileName))
+			continue;
+
+		ManifestShader shader;
+		shader.path = _ManifestPath.parent_path() / fileName;
+
+		std::string feature = "";
+
+		while (tokens >> feature)
+			shader.features.push_back(feature);
+
+		if (shader.features.size() > MAX_FEATURES)
+		{
+			DEBUG_ERROR("Too many features for shader %s: %u, maximum is %u", fileName.c_str(), static_cast<unsigned int>(shader.features.size()), static_cast<unsigned int>(MAX_FEATURES));
+			return false;
+		}
+
+		_Shaders.push_back(shader);
+	}
+
+	return true;
+}
+
+static const bool GetShaderKind(const std::filesystem::path& _Path, shaderc_shader_kind& _ShaderKind)
+{
+	if (_Path.extension() == ".vert")
+		_ShaderKind = shaderc_vertex_shader;
+	else if (_Path.extension() == ".frag")
+		_ShaderKind = shaderc_fragment_shader;
+	else if (_Path.extension() == ".geo")
+		_ShaderKind = shaderc_geometry_shader;
+	else
+	{
+		DEBUG_ERROR("Cannot bake shader due to unsuported extension: %s", _Path.extension().string().c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Compiles, reflects and optimizes one variant then adds it to the archive
+/// </summary>
+/// <param name="_Compiler">: Compiler shared by all the variants </param>
+/// <param name="_Shader">: Shader of the manifest </param>
+/// <param name="_ShaderKind">: Stage of the shader </param>
+/// <param name="_SourceCode">: GLSL source </param>
+/// <param name="_MacroDefinitions">: Features enabled in the variant </param>
+/// <param name="_Builder">: Archive receiving the variant </param>
+/// <param name="_Statistics">: Sizes accumulated for the report </param>
+/// <returns></returns>
+static const bool BakeVariant(shaderc::Compiler& _Compiler, const ManifestShader& _Shader, shaderc_shader_kind _ShaderKind, const std::string& _SourceCode,
+	const std::vector<std::string>& _MacroDefinitions, Core::ShaderArchiveBuilder& _Builder, BakeStatistics& _Statistics)
+{
+	std::string name = _Shader.path.filename().string();
+
+	// Only needed by the includer, the archive does not track the includes
+	std::vector<Core::SourceDependency> includes;
+
+	// Same target as the runtime compilation, the unoptimized module keeps every binding for the reflection
+	// No debug info, the descriptor sets are found by their set and binding
+	shaderc::CompileOptions options;
+	options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1);
+	options.SetOptimizationLevel(shaderc_optimization_level_zero);
+
+	for (const std::string& definition : _MacroDefinitions)
+	{
+		size_t separator = definition.find('=');
+
+		if (separator == std::string::npos)
+			options.AddMacroDefinition(definition);
+		else
+			options.AddMacroDefinition(definition.substr(0, separator), definition.substr(separator + 1));
+	}
+
+	options.SetIncluder(std::make_unique<Core::ShaderIncluder>(_Shader.path, name, includes));
+
+	shaderc::SpvCompilationResult result = _Compiler.CompileGlslToSpv(_SourceCode, _ShaderKind, name.c_str(), options);
+
+	if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+	{
+		DEBUG_ERROR("Failed to compile shader %s, %s", name.c_str(), result.GetErrorMessage().c_str());
+		return false;
+	}
+
+	std::vector<uint32_t> spirV(result.cbegin(), result.cend());
+
+	// Read before the optimization, unused bindings removed by it stay in the pipeline layout
+	Core::ShaderReflection reflection;
+
+	if (!Core::SpirVReflection::Reflect(spirV.data(), spirV.size(), reflection))
+		return false;
+
+	spvtools::Optimizer optimizer(SPV_ENV_VULKAN_1_1);
+	optimizer.SetMessageConsumer([](spv_message_level_t _Level, const char*, const spv_position_t& _Position, const char* _Message)
+		{
+			if (_Level <= SPV_MSG_ERROR)
+				DEBUG_ERROR("spirv-opt, word %u: %s", static_cast<unsigned int>(_Position.index), _Message);
+		});
+
+	optimizer.RegisterPerformancePasses();
+	optimizer.RegisterPass(spvtools::CreateStripDebugInfoPass());
+
+	std::vector<uint32_t> optimizedSpirV;
+
+	if (!optimizer.Run(spirV.data(), spirV.size(), &optimizedSpirV))
+	{
+		DEBUG_ERROR("Failed to optimize shader %s", name.c_str());
+		return false;
+	}
+
+	spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_1);
+
+	if (!tools.Validate(optimizedSpirV))
+	{
+		DEBUG_ERROR("Optimized shader %s is not valid", name.c_str());
+		return false;
+	}
+
+	if (!_Builder.AddShader(name, _MacroDefinitions, optimizedSpirV, reflection))
+		return false;
+
+	++_Statistics.variantCount;
+	_Statistics.unoptimizedSize += spirV.size() * sizeof(uint32_t);
+	_Statistics.optimizedSize += optimizedSpirV.size() * sizeof(uint32_t);
+
+	return true;
+}
+
+int main(int _Argc, char** _Argv)
+{
+	std::filesystem::path manifestPath = _Argc > 1 ? _Argv[1] : DEFAULT_MANIFEST_PATH;
+	std::filesystem::path archivePath = _Argc > 2 ? _Argv[2] : DEFAULT_ARCHIVE_PATH;
+
+	std::chrono::high_resolution_clock::time_point bakeStart = std::chrono::high_resolution_clock::now();
+
+	std::vector<ManifestShader> shaders;
+
+	if (!ReadManifest(manifestPath, shaders))
+		return -1;
+
+	shaderc::Compiler compiler;
+	Core::ShaderArchiveBuilder builder;
+	BakeStatistics statistics;
+
+	for (const ManifestShader& shader : shaders)
+	{
+		shaderc_shader_kind shaderKind;
+
+		if (!GetShaderKind(shader.path, shaderKind))
+			return -1;
+
+		std::string sourceCode = "";
+
+		if (!Core::SourceFileCache::ReadFile(shader.path, sourceCode))
+		{
+			DEBUG_ERROR("Failed to open shader file: %s", shader.path.string().c_str());
+			return -1;
+		}
+
+		// Every combination of the features, the macros are in the order of the manifest like in the variant sets
+		size_t variantCount = static_cast<size_t>(1) << shader.features.size();
+
+		for (size_t key = 0; key < variantCount; ++key)
+		{
+			std::vector<std::string> macroDefinitions;
+
+			for (size_t i = 0; i < shader.features.size(); ++i)
+			{
+				if (key & (static_cast<size_t>(1) << i))
+					macroDefinitions.push_back(shader.features[i]);
+			}
+
+			if (!BakeVariant(compiler, shader, shaderKind, sourceCode, macroDefinitions, builder, statistics))
+				return -1;
+		}
+	}
+
+	if (!builder.Write(archivePath))
+		return -1;
+
+	std::error_code error;
+	unsigned int archiveSize = static_cast<unsigned int>(std::filesystem::file_size(archivePath, error));
+
+	std::chrono::duration<double, std::milli> bakeTime = std::chrono::high_resolution_clock::now() - bakeStart;
+	DEBUG_LOG("%u variants baked in %f ms, SPIR-V %u bytes before optimization, %u bytes after", statistics.variantCount, bakeTime.count(),
+		static_cast<unsigned int>(statistics.unoptimizedSize), static_cast<unsigned int>(statistics.optimizedSize));
+	DEBUG_LOG("Shader archive written: %s, %u bytes", archivePath.string().c_str(), archiveSize);
+
+	return 0;
+}
\ No newline at end of file
@@ -15,7 +15,7 @@ extern "C"
 	_declspec(dllexport) int32_t AmdPowerXpressRequestHighPerformance = 1;
 }
 
-int main()
+int main(int _Argc, char** _Argv)
 {
 	// Checks memory leaks
 #ifndef NDEBUG
@@ -25,7 +25,7 @@ int main()
 
 	Core::Application app;
 
-	if (!app.Initialize())
+	if (!app.Initialize(_Argc, _Argv))
 	{
 		return -1;
 	}